@@ -30,6 +30,10 @@ class SrcGlobber
   CMAKE_SRC_DIR = '${SRC_DIR}'
   CMAKE_FILE = 'CMakeLists.txt'
   CMAKE_FUNC = 'target_sources'
+  CMAKE_TARGET = '"${BIN_NAME}"'
+
+  # Dirs for other targets (e.g., `EkoScapeSim`), which aren't part of the main game.
+  EXCLUDE_DIRS = %w[src/bench src/sim src/tools].to_set.freeze
 
   SRC_EXTS = %w[.c .cc .cpp .cxx .c++].to_set(&:downcase).freeze
 
@@ -42,7 +46,7 @@ class SrcGlobber
       op.separator ''
       op.separator "v#{op.version}"
       op.separator ''
-      op.separator "By default, shows diff of source files in '#{CMAKE_FILE}' in func #{CMAKE_FUNC}()."
+      op.separator "By default, shows diff of source files in '#{CMAKE_FILE}' in func #{CMAKE_FUNC}(#{CMAKE_TARGET})."
 
       op.separator ''
       op.separator 'Options'
@@ -156,6 +160,8 @@ class SrcGlobber
 
     # Grab only dirs & src files.
     paths = dir.children.select do |path|
+      next false if EXCLUDE_DIRS.include?(path.to_s)
+
       path.directory? || SRC_EXTS.include?(path.extname.to_s.strip.downcase)
     end
     # - Sort by `block` if given.
@@ -206,8 +212,8 @@ class SrcGlobber
     data = File.read(CMAKE_FILE,mode: 'rt',encoding: 'BOM|UTF-8:UTF-8')
 
     data.scan(
-      # `^func(...)$ ... ^)$`
-      /(?<func_begin>^\s*#{Regexp.quote(CMAKE_FUNC)}\s*\([^\)]+?$)(?<src>.+?)(?<func_end>^\s*\)\s*$)/im
+      # `^func("${BIN_NAME}"...)$ ... ^)$`
+      /(?<func_begin>^\s*#{Regexp.quote(CMAKE_FUNC)}\s*\(\s*#{Regexp.quote(CMAKE_TARGET)}[^\)]*?$)(?<src>.+?)(?<func_end>^\s*\)\s*$)/im
     ) do
       md = Regexp.last_match
       src << md[:src] << "\n"
@@ -9,8 +9,11 @@
 
 #include "cybel/str/utf8/str_util.h"
 #include "cybel/types/cybel_error.h"
+#include "cybel/util/tracer.h"
 #include "cybel/util/util.h"
 
+#include <cmath>
+
 namespace ekoscape {
 
 std::vector<std::filesystem::path> Assets::fetch_base_dirs() {
@@ -75,6 +78,24 @@ std::vector<std::filesystem::path> Assets::fetch_base_dirs() {
   return (dirs.size() == 1) ? dirs : Util::unique(dirs);
 }
 
+std::filesystem::path Assets::fetch_map_index_file() {
+  // Not the base dirs, since they might not be writable (e.g., AppImage or macOS app bundle).
+  char* pref_path = SDL_GetPrefPath("esotericpig","EkoScape");
+
+  if(pref_path == NULL) {
+    std::cerr << "[WARN] Failed to get pref path of game: " + Util::get_sdl_error() +
+                 "; map index won't be saved." << std::endl;
+    return {};
+  }
+
+  std::filesystem::path file{pref_path};
+
+  SDL_free(pref_path);
+  pref_path = NULL;
+
+  return file / MapIndex::kFilename;
+}
+
 Assets::Assets(std::string_view tex_style,bool has_audio_player,bool make_weird)
   : has_audio_player_(has_audio_player) {
   reload_gfx(tex_style,make_weird);
@@ -98,6 +119,8 @@ void Assets::reload_gfx() { reload_gfx(is_weird_); }
 void Assets::reload_gfx(bool make_weird) { reload_gfx(styled_texs_bag_it_->dirname,make_weird); }
 
 void Assets::reload_gfx(std::string_view tex_style,bool make_weird) {
+  const Tracer::Scope trace{"reload_gfx","assets",tex_style};
+
   is_weird_ = make_weird;
 
   reload_styled_texs_bag(tex_style);
@@ -321,46 +344,19 @@ void Assets::make_weird() {
   if(!is_weird_) { reload_gfx(true); }
 }
 
-void Assets::glob_maps_meta(const MapCallback& on_map) const {
-  std::unordered_set<std::string> loaded_maps{};
+std::vector<MapMeta> Assets::glob_maps_meta() { return map_index_.glob(maps_dirs()); }
 
-  for(const auto& base_dir : kBaseDirs) {
-    const auto maps_dir = base_dir / kMapsSubdir;
-    std::error_code err_code{}; // For noexcept overload.
-
-    if(!is_directory(maps_dir,err_code)) { continue; }
-
-    try {
-      for(const auto& group_entry : std::filesystem::directory_iterator(maps_dir)) {
-        if(!group_entry.is_directory()) { continue; }
-
-        const std::string group = group_entry.path().filename().string();
-
-        for(const auto& map_entry : std::filesystem::directory_iterator(group_entry)) {
-          const auto map_file = map_entry.path();
-          const auto map_key = group + '/' + map_file.filename().string();
-
-          if(loaded_maps.contains(map_key)) { continue; }
-          if(!map_entry.is_regular_file() || !Map::is_map_file(map_file)) { continue; }
+void Assets::glob_maps_meta(const MapIndex::BatchCallback& on_batch,const std::atomic<bool>& is_canceled) {
+  map_index_.glob(maps_dirs(),on_batch,is_canceled);
+}
 
-          Map map{};
+std::vector<std::filesystem::path> Assets::maps_dirs() {
+  std::vector<std::filesystem::path> dirs{};
+  dirs.reserve(kBaseDirs.size());
 
-          try {
-            map.load_file_meta(map_file);
-          } catch(const CybelError& e) {
-            std::cerr << "[WARN] " << e.what() << std::endl;
-            continue;
-          }
+  for(const auto& base_dir : kBaseDirs) { dirs.push_back(base_dir / kMapsSubdir); }
 
-          on_map(group,map_file,map);
-          loaded_maps.insert(map_key);
-        }
-      }
-    } catch(const std::filesystem::filesystem_error& e) {
-      std::cerr << "[WARN] Failed to crawl maps folder [" << maps_dir.string() << "]: " << e.what() << '.'
-                << std::endl;
-    }
-  }
+  return dirs;
 }
 
 const std::string& Assets::prev_tex_style() {
@@ -395,6 +391,8 @@ TextureRef Assets::styled_tex_ref(StyledTexId id) {
   return styled_texs_bag_it_->tex_ref(static_cast<asset_id_t>(id));
 }
 
+const SpriteAtlas& Assets::styled_tex_atlas() const { return styled_texs_bag_it_->atlas(); }
+
 FontRenderer& Assets::font_renderer() const { return *font_renderer_; }
 
 Image* Assets::image(ImageId id) { return image(static_cast<asset_id_t>(id)); }
@@ -460,39 +458,84 @@ Music* Assets::music(asset_id_t id) {
 Assets::StyledTextures::StyledTextures(const std::filesystem::path& dir,bool make_weird)
   : dirname(dir.filename().string()),
     name(utf8::StrUtil::ellipsize(dirname,18)) {
-  load_tex(StyledTexId::kCeiling,dir / "ceiling.png",make_weird);
-  load_tex(StyledTexId::kCell,dir / "cell.png",make_weird);
-  load_tex(StyledTexId::kDeadSpace,dir / "dead_space.png",make_weird,kWeirdBlackColor);
-  load_tex(StyledTexId::kDeadSpaceGhost,dir / "dead_space_ghost.png",make_weird,kWeirdBlackColor);
-  load_tex(StyledTexId::kEnd,dir / "end.png",make_weird);
-  load_tex(StyledTexId::kEndWall,dir / "end_wall.png",make_weird);
-  load_tex(StyledTexId::kFloor,dir / "floor.png",make_weird);
-  load_tex(StyledTexId::kFruit,dir / "fruit.png",make_weird);
-  load_tex(StyledTexId::kPortal,dir / "portal.png",make_weird);
-  load_tex(StyledTexId::kRobot,dir / "robot.png",make_weird,kWeirdGrayColor);
-  load_tex(StyledTexId::kWall,dir / "wall.png",make_weird);
-  load_tex(StyledTexId::kWallGhost,dir / "wall_ghost.png",make_weird);
-  load_tex(StyledTexId::kWhite,dir / "white.png",make_weird,kWeirdWhiteColor);
-  load_tex(StyledTexId::kWhiteGhost,dir / "white_ghost.png",make_weird,kWeirdWhiteColor);
-}
-
-void Assets::StyledTextures::load_tex(StyledTexId id,const std::filesystem::path& file,bool make_weird,
-                                      const Color4f& weird_color) {
+  Images imgs{};
+
+  load_tex(imgs,StyledTexId::kCeiling,dir / "ceiling.png",make_weird);
+  load_tex(imgs,StyledTexId::kCell,dir / "cell.png",make_weird);
+  load_tex(imgs,StyledTexId::kDeadSpace,dir / "dead_space.png",make_weird,kWeirdBlackColor);
+  load_tex(imgs,StyledTexId::kDeadSpaceGhost,dir / "dead_space_ghost.png",make_weird,kWeirdBlackColor);
+  load_tex(imgs,StyledTexId::kEnd,dir / "end.png",make_weird);
+  load_tex(imgs,StyledTexId::kEndWall,dir / "end_wall.png",make_weird);
+  load_tex(imgs,StyledTexId::kFloor,dir / "floor.png",make_weird);
+  load_tex(imgs,StyledTexId::kFruit,dir / "fruit.png",make_weird);
+  load_tex(imgs,StyledTexId::kPortal,dir / "portal.png",make_weird);
+  load_tex(imgs,StyledTexId::kRobot,dir / "robot.png",make_weird,kWeirdGrayColor);
+  load_tex(imgs,StyledTexId::kWall,dir / "wall.png",make_weird);
+  load_tex(imgs,StyledTexId::kWallGhost,dir / "wall_ghost.png",make_weird);
+  load_tex(imgs,StyledTexId::kWhite,dir / "white.png",make_weird,kWeirdWhiteColor);
+  load_tex(imgs,StyledTexId::kWhiteGhost,dir / "white_ghost.png",make_weird,kWeirdWhiteColor);
+
+  build_atlas(imgs);
+}
+
+void Assets::StyledTextures::load_tex(Images& imgs,StyledTexId id,const std::filesystem::path& file,
+                                      bool make_weird,const Color4f& weird_color) {
   const auto i = static_cast<std::size_t>(id);
 
   if(i >= texs_.size()) { throw CybelError{"Invalid styled texture ID [",i,"] on load."}; }
 
-  texs_[i] = std::make_unique<Texture>(Image{file,make_weird,weird_color});
+  imgs[i] = std::make_unique<Image>(file,make_weird,weird_color);
+  texs_[i] = std::make_unique<Texture>(*imgs[i]);
+}
+
+void Assets::StyledTextures::build_atlas(const Images& imgs) {
+  // The textures are usually all the same size, but scale any smaller ones up to fit the cells just in case.
+  Size2i cell_size{};
+
+  for(std::size_t id = 0; id < imgs.size(); ++id) {
+    if(!imgs[id]) { throw CybelError{"Styled texture ID [",id,"] was not loaded for the atlas."}; }
+
+    cell_size.w = std::max(cell_size.w,imgs[id]->size().w);
+    cell_size.h = std::max(cell_size.h,imgs[id]->size().h);
+  }
+
+  // Roughly square, to stay well under the max texture size.
+  const auto count = static_cast<int>(imgs.size());
+  const auto cols = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+  const int rows = (count + cols - 1) / cols;
+  const Size2i padded_size{cell_size.w + (kAtlasPadding * 2),cell_size.h + (kAtlasPadding * 2)};
+  Image atlas_img{Size2i{padded_size.w * cols,padded_size.h * rows},dirname + "/atlas"};
+
+  for(int i = 0; i < count; ++i) {
+    const Pos2i pos{
+      ((i % cols) * padded_size.w) + kAtlasPadding,
+      ((i / cols) * padded_size.h) + kAtlasPadding,
+    };
+
+    atlas_img.blit(*imgs[static_cast<std::size_t>(i)],pos,cell_size,kAtlasPadding);
+  }
+
+  atlas_ = std::make_unique<SpriteAtlas>(
+    SpriteAtlas::Builder{}
+      .tex(Texture{atlas_img})
+      .cell_size(padded_size.w,padded_size.h)
+      .cell_padding(kAtlasPadding)
+      .grid_size(cols,rows)
+      .build()
+  );
 }
 
 void Assets::StyledTextures::check_texs() {
   for(std::size_t id = 0; id < texs_.size(); ++id) {
     if(!texs_[id]) { throw CybelError{"Styled texture ID [",id,"] was not loaded."}; }
   }
+
+  if(!atlas_) { throw CybelError{"Styled texture atlas [",dirname,"] was not built."}; }
 }
 
 void Assets::StyledTextures::zombify() {
   for(auto& tex : texs_) { tex->zombify(); }
+  atlas_->zombify();
 }
 
 Texture* Assets::StyledTextures::tex(asset_id_t id) {
@@ -501,4 +544,6 @@ Texture* Assets::StyledTextures::tex(asset_id_t id) {
   return texs_[id].get();
 }
 
+const SpriteAtlas& Assets::StyledTextures::atlas() const { return *atlas_; }
+
 } // namespace ekoscape
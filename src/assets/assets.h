@@ -21,6 +21,7 @@
 #include "assets/styled_tex_id.h"
 #include "assets/texture_id.h"
 #include "map/map.h"
+#include "map/map_index.h"
 
 #include <filesystem>
 #include <functional>
@@ -30,10 +31,6 @@ namespace ekoscape {
 
 class Assets final : AssetMan {
 public:
-  using MapCallback = std::function<
-    void(const std::string& group,const std::filesystem::path& map_file,Map&)
-  >;
-
   static inline const std::filesystem::path kAssetsSubdir{"assets"};
   static inline const std::filesystem::path kIconsSubdir{kAssetsSubdir / "icons"};
   static inline const std::filesystem::path kImagesSubdir{kAssetsSubdir / "images"};
@@ -51,7 +48,11 @@ public:
   void reload_audio();
   void make_weird();
 
-  void glob_maps_meta(const MapCallback& on_map) const;
+  /**
+   * Uses a MapIndex (saved in the user's pref dir), so only new or changed map files are read.
+   */
+  std::vector<MapMeta> glob_maps_meta();
+  void glob_maps_meta(const MapIndex::BatchCallback& on_batch,const std::atomic<bool>& is_canceled);
 
   const std::string& prev_tex_style();
   const std::string& next_tex_style();
@@ -62,6 +63,10 @@ public:
   const Texture& star_tex() const;
   Texture* styled_tex(StyledTexId id);
   TextureRef styled_tex_ref(StyledTexId id);
+  /**
+   * All of the styled textures packed into one texture, indexed by StyledTexId.
+   */
+  const SpriteAtlas& styled_tex_atlas() const;
   FontRenderer& font_renderer() const;
 
   Image* image(ImageId id);
@@ -94,12 +99,20 @@ private:
     void zombify();
 
     Texture* tex(asset_id_t id) override;
+    const SpriteAtlas& atlas() const;
 
   private:
+    using Images = std::array<std::unique_ptr<Image>,static_cast<std::size_t>(StyledTexId::kMax)>;
+
+    // Repeated edge pixels around each texture in the atlas, so that they don't bleed into each other.
+    static constexpr int kAtlasPadding = 1;
+
     std::array<std::unique_ptr<Texture>,static_cast<std::size_t>(StyledTexId::kMax)> texs_{};
+    std::unique_ptr<SpriteAtlas> atlas_{};
 
-    void load_tex(StyledTexId id,const std::filesystem::path& file,bool make_weird,
+    void load_tex(Images& imgs,StyledTexId id,const std::filesystem::path& file,bool make_weird,
                   const Color4f& weird_color = Color4f::kBlack);
+    void build_atlas(const Images& imgs);
   };
 
   using AssetLoader = std::function<void(const std::filesystem::path& base_dir)>;
@@ -111,6 +124,9 @@ private:
   static std::vector<std::filesystem::path> fetch_base_dirs();
   static inline const auto kBaseDirs = fetch_base_dirs();
 
+  static std::filesystem::path fetch_map_index_file();
+  static std::vector<std::filesystem::path> maps_dirs();
+
   static constexpr auto kDefaultFontAtlasId = FontAtlasId::kMonogram;
 
   // For images that don't really work well with make_weird().
@@ -142,6 +158,8 @@ private:
 
   std::array<std::unique_ptr<Music>,static_cast<std::size_t>(MusicId::kMax)> music_bag_{};
 
+  MapIndex map_index_{fetch_map_index_file()};
+
   using AssetMan::tex_ref;
   using AssetMan::sprite_ref;
   using AssetMan::font_atlas_ref;
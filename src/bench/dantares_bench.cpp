@@ -0,0 +1,280 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// Standard console app, so don't let SDL2 hijack main().
+#ifndef SDL_MAIN_HANDLED
+#define SDL_MAIN_HANDLED
+#endif
+
+#include "common.h"
+
+#include "cybel/types/cybel_error.h"
+#include "cybel/util/rando.h"
+#include "cybel/util/tool_util.h"
+
+#include <chrono>
+#include <iomanip>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * Micro-benchmark of Dantares2 (map storage & Draw()) against a recording renderer (no window or GPU),
+ * so that changes to Dantares2 can be compared on build boxes.
+ *
+ * Usage:
+ *   EkoScapeBench [--size N] [--frames N] [--dist N] [--seed N]
+ *
+ * The map is a random maze of several space types (like a weird map), so that each chunk has many
+ * face/texture groups.
+ */
+class DantaresBench {
+public:
+  int run(int argc,char** argv);
+
+private:
+  using clock_t = std::chrono::steady_clock;
+
+  /**
+   * Only records the number of calls & quads, so that Dantares2's own cost is measured.
+   */
+  class RecordingRenderer : public Dantares2::RendererClass {
+  public:
+    std::size_t draw_calls = 0;
+    std::size_t drawn_quads = 0;
+    std::size_t compiled_quads = 0;
+
+    void BeginDraw() override {}
+    void EndDraw() override {}
+
+    void TranslateModelMatrix(float /*X*/,float /*Y*/,float /*Z*/) override {}
+    void RotateModelMatrix(float /*Angle*/,float /*X*/,float /*Y*/,float /*Z*/) override {}
+    void UpdateModelMatrix() override {}
+    void PushModelMatrix() override {}
+    void PopModelMatrix() override {}
+
+    GLuint GenerateQuadBatch() override { return ++next_id_; }
+    void DeleteQuadBatch(GLuint /*ID*/) override {}
+    void CompileQuadBatch(GLuint /*ID*/,const std::vector<QuadListData>& Quads) override {
+      compiled_quads += Quads.size();
+    }
+    void DrawQuadBatch(GLuint /*ID*/,int /*First*/,int Count) override {
+      ++draw_calls;
+      drawn_quads += static_cast<std::size_t>(Count);
+    }
+
+  private:
+    GLuint next_id_ = 0;
+  };
+
+  static constexpr int kEmptySpace = 0; // Uses the master floor & ceiling textures.
+  static constexpr int kChangedSpace = '.';
+  static constexpr int kSpaceTypes[] = {'#','@','!','$','%','&','=','+'}; // Walls.
+
+  int size_ = 256;
+  int frames_ = 20'000;
+  int dist_ = 24; // Same as GameScene.
+  std::uint64_t seed_ = Rando::gen_seed();
+
+  static void print_usage();
+  static void print_phase(std::string_view name,const clock_t::duration& time,long long count,
+                          std::string_view unit);
+
+  bool parse_args(int argc,char** argv);
+
+  std::vector<int> gen_spaces(Rando& rando) const;
+};
+
+int DantaresBench::run(int argc,char** argv) {
+  if(!parse_args(argc,argv)) { return 1; }
+
+  Rando rando{seed_};
+  RecordingRenderer renderer{};
+  Dantares2 dantares{renderer,0.1f,-0.1f,0.1f};
+  const std::vector<int> spaces = gen_spaces(rando);
+  const long long cell_count = static_cast<long long>(size_) * size_;
+
+  std::cout << "[INFO] Seed [" << seed_ << "], size [" << size_ << 'x' << size_ << "], frames [" << frames_
+            << "], dist [" << dist_ << "].\n";
+
+  // Add map.
+  auto start_time = clock_t::now();
+  const int map_id = dantares.AddMap(static_cast<const void*>(spaces.data()),size_,size_);
+  const auto add_map_time = clock_t::now() - start_time;
+
+  dantares.SetCurrentMap(map_id);
+  dantares.SetMasterFloorTexture(1);
+  dantares.SetMasterCeilingTexture(2);
+
+  for(std::size_t i = 0; i < std::size(kSpaceTypes); ++i) {
+    dantares.SetWallTexture(kSpaceTypes[i],static_cast<GLuint>(3 + i));
+  }
+
+  dantares.SetFloorTexture(kChangedSpace,1);
+  dantares.SetCeilingTexture(kChangedSpace,2);
+
+  // Generate map.
+  start_time = clock_t::now();
+  dantares.GenerateMap();
+  const auto gen_map_time = clock_t::now() - start_time;
+
+  // Random walkable positions up front, so that only Dantares2 is timed.
+  std::vector<int> positions{};
+
+  positions.reserve(static_cast<std::size_t>(frames_));
+
+  for(int i = 0; i < frames_; ++i) {
+    int x = 0;
+    int y = 0;
+
+    do {
+      x = rando.rand_int(size_ - 1);
+      y = rando.rand_int(size_ - 1);
+    } while(spaces[static_cast<std::size_t>(x * size_ + y)] != kEmptySpace);
+
+    positions.push_back(y * size_ + x);
+  }
+
+  // Draw (static map).
+  start_time = clock_t::now();
+
+  for(int i = 0; i < frames_; ++i) {
+    const int pos = positions[static_cast<std::size_t>(i)];
+
+    dantares.SetPlayerPosition(pos % size_,pos / size_,i % 4);
+    dantares.Draw(dist_,false);
+  }
+
+  const auto draw_time = clock_t::now() - start_time;
+  const std::size_t draw_calls = renderer.draw_calls;
+  const std::size_t drawn_quads = renderer.drawn_quads;
+
+  // Draw (one changed square per frame, like eating a fruit).
+  start_time = clock_t::now();
+
+  for(int i = 0; i < frames_; ++i) {
+    const int pos = positions[static_cast<std::size_t>(i)];
+    const int x = pos % size_;
+    const int y = pos / size_;
+
+    dantares.ChangeSquare(x,y,(dantares.GetSpace(x,y) == kEmptySpace) ? kChangedSpace : kEmptySpace);
+    dantares.SetPlayerPosition(x,y,i % 4);
+    dantares.Draw(dist_,false);
+  }
+
+  const auto draw_dirty_time = clock_t::now() - start_time;
+
+  // Lookup (like the game checking each square).
+  long long walkable_count = 0;
+  start_time = clock_t::now();
+
+  for(int y = 0; y < size_; ++y) {
+    for(int x = 0; x < size_; ++x) {
+      if(dantares.SpaceIsWalkable(x,y) && dantares.GetSpace(x,y) != '#') { ++walkable_count; }
+    }
+  }
+
+  const auto lookup_time = clock_t::now() - start_time;
+
+  std::cout << "[INFO] Draw calls/frame [" << (static_cast<double>(draw_calls) / frames_)
+            << "], quads/frame [" << (static_cast<double>(drawn_quads) / frames_) << "], compiled quads ["
+            << renderer.compiled_quads << "], walkable [" << walkable_count << "].\n";
+  print_phase("add_map",add_map_time,cell_count,"cell");
+  print_phase("gen_map",gen_map_time,cell_count,"cell");
+  print_phase("draw",draw_time,frames_,"frame");
+  print_phase("draw_dirty",draw_dirty_time,frames_,"frame");
+  print_phase("lookup",lookup_time,cell_count,"cell");
+  std::cout << std::flush;
+
+  return 0;
+}
+
+void DantaresBench::print_usage() {
+  std::cout << "Usage: EkoScapeBench [options]\n"
+               "\n"
+               "Options:\n"
+               "  --size N     Width & height of the map (default: 256).\n"
+               "  --frames N   Frames to draw per phase (default: 20000).\n"
+               "  --dist N     Draw distance (default: 24).\n"
+               "  --seed N     Seed for reproducing a run (default: random).\n"
+               "  --help       Show this help.\n"
+            << std::flush;
+}
+
+void DantaresBench::print_phase(std::string_view name,const clock_t::duration& time,long long count,
+                                std::string_view unit) {
+  const double ms = ToolUtil::to_ms(time);
+  const double ns_per = (count > 0)
+                        ? (std::chrono::duration<double,std::nano>(time).count() / static_cast<double>(count))
+                        : 0.0;
+
+  std::cout << "[INFO]   " << std::left << std::setw(12) << name << std::right
+            << std::fixed << std::setprecision(3)
+            << std::setw(12) << ms << " ms"
+            << std::setw(14) << ns_per << " ns/" << unit << '\n';
+}
+
+bool DantaresBench::parse_args(int argc,char** argv) {
+  for(int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    const std::string_view next_arg = (i + 1 < argc) ? std::string_view{argv[i + 1]} : std::string_view{};
+
+    if(arg == "--help" || arg == "-h") {
+      print_usage();
+      return false;
+    }
+    if(arg == "--size") {
+      if(!ToolUtil::parse_num(arg,next_arg,size_) || size_ < 3) { return false; }
+      ++i;
+    } else if(arg == "--frames") {
+      if(!ToolUtil::parse_num(arg,next_arg,frames_) || frames_ <= 0) { return false; }
+      ++i;
+    } else if(arg == "--dist") {
+      if(!ToolUtil::parse_num(arg,next_arg,dist_) || dist_ < 2) { return false; }
+      ++i;
+    } else if(arg == "--seed") {
+      if(!ToolUtil::parse_num(arg,next_arg,seed_)) { return false; }
+      ++i;
+    } else {
+      std::cerr << "[ERROR] Unknown option [" << arg << "]." << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::vector<int> DantaresBench::gen_spaces(Rando& rando) const {
+  // Column-major (X, then Y), as expected by Dantares2::AddMap().
+  std::vector<int> spaces(static_cast<std::size_t>(size_) * static_cast<std::size_t>(size_),kEmptySpace);
+
+  for(int x = 0; x < size_; ++x) {
+    for(int y = 0; y < size_; ++y) {
+      const bool is_edge = (x == 0 || y == 0 || x == (size_ - 1) || y == (size_ - 1));
+
+      if(is_edge || rando.rand_int(99) < 30) {
+        spaces[static_cast<std::size_t>(x * size_ + y)] = kSpaceTypes[rando.rand_size_t(std::size(kSpaceTypes) - 1)];
+      }
+    }
+  }
+
+  return spaces;
+}
+
+} // namespace ekoscape
+
+int main(int argc,char** argv) {
+  using namespace ekoscape;
+
+  try {
+    DantaresBench bench{};
+    return bench.run(argc,argv);
+  } catch(const CybelError& e) {
+    std::cerr << "[ERROR] " << e.what() << std::endl;
+    return 1;
+  }
+}
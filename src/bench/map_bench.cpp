@@ -0,0 +1,526 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// Standard console app, so don't let SDL2 hijack main().
+#ifndef SDL_MAIN_HANDLED
+#define SDL_MAIN_HANDLED
+#endif
+
+#include "common.h"
+
+#include "cybel/types/cybel_error.h"
+#include "cybel/util/rando.h"
+#include "cybel/util/tool_util.h"
+
+#include "map/map.h"
+
+#include <bit>
+#include <chrono>
+#include <iomanip>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * Micro-benchmark of scanning the 4 neighbors of every Space in a Map (like a BFS or the mini map),
+ * comparing the old storage (a separate allocation per grid, bounds checks, & switch statements)
+ * with MapSpaces (one allocation with a sentinel border & SpaceTypes::kTraits).
+ *
+ * Then searching the Map from the Player (what can be reached, including through Portals,
+ * & the distance to the End), comparing a BFS Space by Space with MapPlanes (64 Spaces per word).
+ *
+ * Usage:
+ *   EkoScapeMapBench [--size N] [--grids N] [--passes N] [--seed N]
+ */
+class MapBench {
+public:
+  int run(int argc,char** argv);
+
+private:
+  using clock_t = std::chrono::steady_clock;
+
+  /**
+   * Same as the old MapGrid (before MapSpaces), for comparison.
+   */
+  class OldGrid {
+  public:
+    Size2i size{};
+    std::vector<Space> spaces{};
+
+    const Space* space(const Pos3i& pos) const;
+  };
+
+  struct ScanResult {
+    long long walkables = 0;
+    long long robots = 0;
+    long long portals = 0;
+
+    ScanResult& operator+=(const ScanResult& other);
+    bool operator==(const ScanResult& other) const = default;
+  };
+
+  static constexpr SpaceType kSpaceTypes[] = {
+    SpaceType::kEmpty,SpaceType::kEmpty,SpaceType::kEmpty,SpaceType::kEmpty,SpaceType::kWall,
+    SpaceType::kWall,SpaceType::kWallGhost,SpaceType::kCell,SpaceType::kRobot,SpaceType::kRobotGhost,
+    SpaceType::kPortal0,SpaceType::kPortal1,SpaceType::kFruit,SpaceType::kDeadSpace,SpaceType::kWhiteFloor,
+  };
+  static inline const std::array<Pos2i,4> kNeighborVels{Pos2i{0,1},Pos2i{0,-1},Pos2i{1,0},Pos2i{-1,0}};
+
+  int size_ = 512;
+  int grids_ = 4;
+  int passes_ = 20;
+  std::uint64_t seed_ = Rando::gen_seed();
+
+  static void print_usage();
+  static void print_phase(std::string_view name,const clock_t::duration& time,long long count);
+  static void print_speedup(std::string_view name,std::string_view base_name,const clock_t::duration& time,
+                            const clock_t::duration& base_time);
+
+  // The old classification funcs (switch statements), before SpaceTypes::kTraits.
+  static bool old_is_robot(SpaceType type);
+  static bool old_is_portal(SpaceType type);
+  static bool old_is_non_walkable(SpaceType type);
+
+  bool parse_args(int argc,char** argv);
+
+  void gen_map(Rando& rando,Map& map) const;
+  static std::vector<std::unique_ptr<OldGrid>> to_old_grids(const Map& map);
+
+  static ScanResult scan_old(const std::vector<std::unique_ptr<OldGrid>>& grids);
+  static ScanResult scan_checked(const Map& map);
+  static ScanResult scan_sentinel(const Map& map);
+
+  static long long reach_bfs(const Map& map,const Pos3i& from_pos);
+  static long long reach_planes(const Map& map,const Pos3i& from_pos);
+  static int dist_bfs(const Map& map,const Pos3i& from_pos,SpaceType thing);
+};
+
+int MapBench::run(int argc,char** argv) {
+  if(!parse_args(argc,argv)) { return 1; }
+
+  Rando rando{seed_};
+  Map map{};
+
+  gen_map(rando,map);
+
+  const auto old_grids = to_old_grids(map);
+  const long long cell_count = static_cast<long long>(size_) * size_ * grids_ * passes_;
+
+  std::cout << "[INFO] Seed [" << seed_ << "], size [" << size_ << 'x' << size_ << "], grids [" << grids_
+            << "], passes [" << passes_ << "].\n";
+
+  const auto time_scan = [&](auto&& scan,ScanResult& result) {
+    const auto start_time = clock_t::now();
+
+    // Sum up each pass, so that the passes can't be optimized away.
+    for(int i = 0; i < passes_; ++i) { result += scan(); }
+
+    return clock_t::now() - start_time;
+  };
+
+  ScanResult old_result{};
+  ScanResult checked_result{};
+  ScanResult sentinel_result{};
+
+  const auto old_time = time_scan([&] { return scan_old(old_grids); },old_result);
+  const auto checked_time = time_scan([&] { return scan_checked(map); },checked_result);
+  const auto sentinel_time = time_scan([&] { return scan_sentinel(map); },sentinel_result);
+
+  if(checked_result != old_result || sentinel_result != old_result) {
+    std::cerr << "[ERROR] Scan results don't match." << std::endl;
+    return 1;
+  }
+
+  std::cout << "[INFO] Walkable neighbors [" << (old_result.walkables / passes_) << "], robots ["
+            << (old_result.robots / passes_) << "], portals [" << (old_result.portals / passes_) << "].\n";
+  print_phase("old",old_time,cell_count);
+  print_phase("checked",checked_time,cell_count);
+  print_phase("sentinel",sentinel_time,cell_count);
+  print_speedup("sentinel","old",sentinel_time,old_time);
+
+  const Pos3i& from_pos = map.player_init_pos();
+  long long bfs_reach = 0;
+  long long planes_reach = 0;
+  long long bfs_dist = 0;
+  long long planes_dist = 0;
+
+  const auto time_search = [&](auto&& search,long long& result) {
+    const auto start_time = clock_t::now();
+
+    for(int i = 0; i < passes_; ++i) { result += search(); }
+
+    return clock_t::now() - start_time;
+  };
+
+  const auto bfs_reach_time = time_search([&] { return reach_bfs(map,from_pos); },bfs_reach);
+  const auto planes_reach_time = time_search([&] { return reach_planes(map,from_pos); },planes_reach);
+  const auto bfs_dist_time = time_search([&] { return dist_bfs(map,from_pos,SpaceType::kEnd); },bfs_dist);
+  const auto planes_dist_time = time_search([&] {
+    return map.planes().dist_to_nearest(from_pos,MapPlanes::Plane::kEnd);
+  },planes_dist);
+
+  if(planes_reach != bfs_reach || planes_dist != bfs_dist) {
+    std::cerr << "[ERROR] Search results don't match." << std::endl;
+    return 1;
+  }
+
+  std::cout << "[INFO] Reachable spaces [" << (bfs_reach / passes_) << "], dist to End ["
+            << (bfs_dist / passes_) << "].\n";
+  print_phase("reach bfs",bfs_reach_time,cell_count);
+  print_phase("reach planes",planes_reach_time,cell_count);
+  print_phase("dist bfs",bfs_dist_time,cell_count);
+  print_phase("dist planes",planes_dist_time,cell_count);
+  print_speedup("reach planes","reach bfs",planes_reach_time,bfs_reach_time);
+  print_speedup("dist planes","dist bfs",planes_dist_time,bfs_dist_time);
+  std::cout << std::flush;
+
+  return 0;
+}
+
+MapBench::ScanResult MapBench::scan_old(const std::vector<std::unique_ptr<OldGrid>>& grids) {
+  ScanResult result{};
+
+  for(int z = 0; z < static_cast<int>(grids.size()); ++z) {
+    const auto& grid = grids[static_cast<std::size_t>(z)];
+
+    for(Pos3i pos{0,0,z}; pos.y < grid->size.h; ++pos.y) {
+      for(pos.x = 0; pos.x < grid->size.w; ++pos.x) {
+        const SpaceType type = grid->space(pos)->type();
+
+        result.robots += old_is_robot(type);
+        result.portals += old_is_portal(type);
+
+        for(const auto& vel : kNeighborVels) {
+          const Space* space = grid->space(Pos3i{pos.x + vel.x,pos.y + vel.y,z});
+
+          result.walkables += (space != nullptr && !old_is_non_walkable(space->empty_type()));
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+MapBench::ScanResult MapBench::scan_checked(const Map& map) {
+  ScanResult result{};
+
+  for(int z = 0; z < map.grid_count(); ++z) {
+    const Size2i size = map.size(z);
+
+    for(Pos3i pos{0,0,z}; pos.y < size.h; ++pos.y) {
+      for(pos.x = 0; pos.x < size.w; ++pos.x) {
+        const SpaceType type = map.space(pos)->type();
+
+        result.robots += SpaceTypes::is_robot(type);
+        result.portals += SpaceTypes::is_portal(type);
+
+        for(const auto& vel : kNeighborVels) {
+          const Space* space = map.space(Pos3i{pos.x + vel.x,pos.y + vel.y,z});
+
+          result.walkables += (space != nullptr && SpaceTypes::is_walkable(space->empty_type()));
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+MapBench::ScanResult MapBench::scan_sentinel(const Map& map) {
+  const MapSpaces& spaces = map.spaces();
+  ScanResult result{};
+
+  for(int z = 0; z < spaces.grid_count(); ++z) {
+    const Size2i& size = spaces.size(z);
+    const auto offsets = spaces.neighbor_offsets(z);
+
+    for(int y = 0; y < size.h; ++y) {
+      std::size_t index = spaces.index_of(Pos3i{0,y,z});
+
+      for(int x = 0; x < size.w; ++x,++index) {
+        const auto traits = SpaceTypes::traits_of(spaces.at(index).type());
+
+        result.robots += ((traits & SpaceTypes::kRobotTrait) != 0);
+        result.portals += ((traits & SpaceTypes::kPortalTrait) != 0);
+
+        // No bounds checks, since the border is never walkable.
+        for(const auto offset : offsets) {
+          const auto next_index = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index) + offset);
+
+          result.walkables += spaces.at(next_index).is_walkable();
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+long long MapBench::reach_bfs(const Map& map,const Pos3i& from_pos) {
+  const MapSpaces& spaces = map.spaces();
+  const int last_z = spaces.grid_count() - 1;
+  const Size2i& last_size = spaces.size(last_z);
+  // Up to the last corner of the border.
+  std::vector<std::uint8_t> visiteds(spaces.index_of(Pos3i{last_size.w,last_size.h,last_z}) + 1,0);
+  std::vector<std::pair<std::size_t,int>> queue{}; // Index & Z.
+  std::array<bool,256> linked_portals{};
+
+  const auto visit = [&](std::size_t index,int z) {
+    // Walkable for the Player (see MapPlanes::Plane::kPlayerWalkable).
+    if(!SpaceTypes::is_walkable(spaces.at(index).type()) || visiteds[index] != 0) { return; }
+
+    visiteds[index] = 1;
+    queue.emplace_back(index,z);
+  };
+
+  visit(spaces.index_of(from_pos),from_pos.z);
+
+  for(std::size_t i = 0; i < queue.size(); ++i) {
+    const auto [index,z] = queue[i];
+    const Space& space = spaces.at(index);
+
+    for(const auto offset : spaces.neighbor_offsets(z)) {
+      visit(static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index) + offset),z);
+    }
+
+    // Warp to all Portal bros, once per Portal type.
+    if(!space.is_portal() || linked_portals[static_cast<unsigned char>(space.empty_type())]) { continue; }
+
+    linked_portals[static_cast<unsigned char>(space.empty_type())] = true;
+
+    for(int bro_z = 0; bro_z < spaces.grid_count(); ++bro_z) {
+      const Size2i& size = spaces.size(bro_z);
+
+      for(Pos3i pos{0,0,bro_z}; pos.y < size.h; ++pos.y) {
+        for(pos.x = 0; pos.x < size.w; ++pos.x) {
+          if(spaces.unsafe_space(pos).empty_type() != space.empty_type()) { continue; }
+
+          visit(spaces.index_of(pos),bro_z);
+        }
+      }
+    }
+  }
+
+  return static_cast<long long>(queue.size());
+}
+
+long long MapBench::reach_planes(const Map& map,const Pos3i& from_pos) {
+  const auto reached = map.planes().reach(map.spaces(),from_pos);
+  long long count = 0;
+
+  for(const auto& bits : reached) {
+    for(const auto word : bits) { count += std::popcount(word); }
+  }
+
+  return count;
+}
+
+int MapBench::dist_bfs(const Map& map,const Pos3i& from_pos,SpaceType thing) {
+  const MapSpaces& spaces = map.spaces();
+  const int z = from_pos.z;
+  const Size2i& size = spaces.size(z);
+  std::vector<int> dists(spaces.index_of(Pos3i{size.w,size.h,z}) + 1,-1);
+  std::vector<std::size_t> queue{};
+
+  const auto from_index = spaces.index_of(from_pos);
+  dists[from_index] = 0;
+  queue.push_back(from_index);
+
+  for(std::size_t i = 0; i < queue.size(); ++i) {
+    const auto index = queue[i];
+
+    if(spaces.at(index).thing_type() == thing) { return dists[index]; }
+
+    for(const auto offset : spaces.neighbor_offsets(z)) {
+      const auto next_index = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index) + offset);
+
+      if(!SpaceTypes::is_walkable(spaces.at(next_index).type()) || dists[next_index] >= 0) { continue; }
+
+      dists[next_index] = dists[index] + 1;
+      queue.push_back(next_index);
+    }
+  }
+
+  return MapPlanes::kUnreachable;
+}
+
+void MapBench::gen_map(Rando& rando,Map& map) const {
+  const auto size = static_cast<std::size_t>(size_);
+  std::vector<std::string> lines(size,std::string(size,' '));
+
+  for(int z = 0; z < grids_; ++z) {
+    for(auto& line : lines) {
+      for(auto& c : line) {
+        c = SpaceTypes::value_of(kSpaceTypes[rando.rand_size_t(std::size(kSpaceTypes) - 1)]);
+      }
+    }
+
+    // Needs a Player, with the End in the opposite corner.
+    if(z == 0) {
+      lines.front().front() = SpaceTypes::value_of(SpaceType::kPlayerNorth);
+      lines.back().back() = SpaceTypes::value_of(SpaceType::kEnd);
+    }
+
+    map.parse_grid(lines);
+  }
+}
+
+std::vector<std::unique_ptr<MapBench::OldGrid>> MapBench::to_old_grids(const Map& map) {
+  std::vector<std::unique_ptr<OldGrid>> grids{};
+
+  for(int z = 0; z < map.grid_count(); ++z) {
+    auto grid = std::make_unique<OldGrid>();
+
+    grid->size = map.size(z);
+    grid->spaces.reserve(static_cast<std::size_t>(grid->size.area()));
+
+    for(Pos3i pos{0,0,z}; pos.y < grid->size.h; ++pos.y) {
+      for(pos.x = 0; pos.x < grid->size.w; ++pos.x) { grid->spaces.push_back(*map.space(pos)); }
+    }
+
+    grids.push_back(std::move(grid));
+  }
+
+  return grids;
+}
+
+MapBench::ScanResult& MapBench::ScanResult::operator+=(const ScanResult& other) {
+  walkables += other.walkables;
+  robots += other.robots;
+  portals += other.portals;
+
+  return *this;
+}
+
+const Space* MapBench::OldGrid::space(const Pos3i& pos) const {
+  if(pos.x < 0 || pos.x >= size.w || pos.y < 0 || pos.y >= size.h) { return nullptr; }
+
+  return &spaces[static_cast<std::size_t>(pos.x + (pos.y * size.w))];
+}
+
+bool MapBench::old_is_robot(SpaceType type) {
+  switch(type) {
+    case SpaceType::kRobot:
+    case SpaceType::kRobotGhost:
+    case SpaceType::kRobotSnake:
+    case SpaceType::kRobotStatue:
+    case SpaceType::kRobotWorm:
+      return true;
+
+    default: return false;
+  }
+}
+
+bool MapBench::old_is_portal(SpaceType type) {
+  switch(type) {
+    case SpaceType::kPortal0:
+    case SpaceType::kPortal1:
+    case SpaceType::kPortal2:
+    case SpaceType::kPortal3:
+    case SpaceType::kPortal4:
+    case SpaceType::kPortal5:
+    case SpaceType::kPortal6:
+    case SpaceType::kPortal7:
+    case SpaceType::kPortal8:
+    case SpaceType::kPortal9:
+      return true;
+
+    default: return false;
+  }
+}
+
+bool MapBench::old_is_non_walkable(SpaceType type) {
+  switch(type) {
+    case SpaceType::kDeadSpace:
+    case SpaceType::kEndWall:
+    case SpaceType::kVoid:
+    case SpaceType::kWall:
+    case SpaceType::kWhite:
+      return true;
+
+    default: return false;
+  }
+}
+
+void MapBench::print_usage() {
+  std::cout << "Usage: EkoScapeMapBench [options]\n"
+               "\n"
+               "Options:\n"
+               "  --size N     Width & height of each grid (default: 512).\n"
+               "  --grids N    Number of grids (default: 4).\n"
+               "  --passes N   Scans of the whole map per phase (default: 20).\n"
+               "  --seed N     Seed for reproducing a run (default: random).\n"
+               "  --help       Show this help.\n"
+            << std::flush;
+}
+
+void MapBench::print_phase(std::string_view name,const clock_t::duration& time,long long count) {
+  const double ms = ToolUtil::to_ms(time);
+  const double ns_per = (count > 0)
+                        ? (std::chrono::duration<double,std::nano>(time).count() / static_cast<double>(count))
+                        : 0.0;
+
+  std::cout << "[INFO]   " << std::left << std::setw(12) << name << std::right
+            << std::fixed << std::setprecision(3)
+            << std::setw(12) << ms << " ms"
+            << std::setw(14) << ns_per << " ns/cell\n";
+}
+
+void MapBench::print_speedup(std::string_view name,std::string_view base_name,const clock_t::duration& time,
+                             const clock_t::duration& base_time) {
+  std::cout << "[INFO] Speedup of " << name << " over " << base_name << " [" << std::setprecision(2)
+            << (std::chrono::duration<double>(base_time).count() /
+                std::max(std::chrono::duration<double>(time).count(),1e-9))
+            << "x].\n";
+}
+
+bool MapBench::parse_args(int argc,char** argv) {
+  for(int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    const std::string_view next_arg = (i + 1 < argc) ? std::string_view{argv[i + 1]} : std::string_view{};
+
+    if(arg == "--help" || arg == "-h") {
+      print_usage();
+      return false;
+    }
+    if(arg == "--size") {
+      if(!ToolUtil::parse_num(arg,next_arg,size_) || size_ < 1) { return false; }
+      ++i;
+    } else if(arg == "--grids") {
+      if(!ToolUtil::parse_num(arg,next_arg,grids_) || grids_ < 1 || grids_ > Dantares2::MAXMAPS) {
+        return false;
+      }
+      ++i;
+    } else if(arg == "--passes") {
+      if(!ToolUtil::parse_num(arg,next_arg,passes_) || passes_ <= 0) { return false; }
+      ++i;
+    } else if(arg == "--seed") {
+      if(!ToolUtil::parse_num(arg,next_arg,seed_)) { return false; }
+      ++i;
+    } else {
+      std::cerr << "[ERROR] Unknown option [" << arg << "]." << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace ekoscape
+
+int main(int argc,char** argv) {
+  using namespace ekoscape;
+
+  try {
+    MapBench bench{};
+    return bench.run(argc,argv);
+  } catch(const CybelError& e) {
+    std::cerr << "[ERROR] " << e.what() << std::endl;
+    return 1;
+  }
+}
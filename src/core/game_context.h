@@ -11,6 +11,7 @@
 #include "common.h"
 
 #include "cybel/cybel_engine.h"
+#include "cybel/util/rando.h"
 
 #include "assets/assets.h"
 
@@ -22,10 +23,21 @@ public:
   AudioPlayer& audio_player;
   Assets& assets;
 
-  explicit GameContext(CybelEngine& cybel_engine,Assets& assets) noexcept
+  /**
+   * For game logic (not visual effects), so that a recorded run can be replayed with the same seed.
+   */
+  Rando rando;
+  /**
+   * False for replays & headless runs, which need the same work done on the same tick every time,
+   *     so the scenes must not load/glob on worker threads.
+   */
+  bool load_in_bg = true;
+
+  explicit GameContext(CybelEngine& cybel_engine,Assets& assets,std::uint64_t seed) noexcept
     : cybel_engine(cybel_engine),
       audio_player(cybel_engine.audio_player()),
-      assets(assets) {}
+      assets(assets),
+      rando(seed) {}
 };
 
 } // namespace ekoscape
@@ -39,6 +39,7 @@ namespace InputAction {
     kMakeWeird,
     kToggleFps,
     kToggleFrozen,
+    kDumpProfile,
 
     kMax
   };
@@ -9,6 +9,8 @@
 
 #include "cybel/str/utf8/str_util.h"
 #include "cybel/types/cybel_error.h"
+#include "cybel/util/profiler.h"
+#include "cybel/util/tracer.h"
 #include "cybel/util/util.h"
 
 #if defined(CYBEL_RENDERER_GLES)
@@ -124,6 +126,7 @@ CybelEngine::CybelEngine(Scene& main_scene,Config config,const SceneMan::SceneBu
   : title_(config.title),
     avg_fps_(static_cast<float>((config.fps > 0) ? config.fps : kFallbackFps)),
     is_vsync_(config.vsync),
+    is_headless_(config.renderer_type == RendererType::kNull),
     main_scene_(main_scene) {
   init_hints();
 
@@ -137,16 +140,29 @@ CybelEngine::CybelEngine(Scene& main_scene,Config config,const SceneMan::SceneBu
 
   init_config(config);
   init_gui(config);
-  init_context();
-  check_versions();
+
+  if(is_headless_) {
+    auto null_renderer = std::make_unique<RendererNull>(config.size,config.target_size,config.clear_color);
+
+    Texture::set_headless(true);
+    null_renderer_ = null_renderer.get();
+    renderer_ = std::move(null_renderer);
+  } else {
+    init_context();
+    check_versions();
 
 #if defined(CYBEL_RENDERER_GLES)
-  renderer_ = std::make_unique<RendererGles>(config.size,config.target_size,config.clear_color);
+    renderer_ = std::make_unique<RendererGles>(config.size,config.target_size,config.clear_color);
 #else // CYBEL_RENDERER_GL
-  renderer_ = std::make_unique<RendererGl>(config.size,config.target_size,config.clear_color);
+    renderer_ = std::make_unique<RendererGl>(config.size,config.target_size,config.clear_color);
 #endif
+  }
 
-  scene_man_ = std::make_unique<SceneMan>(build_scene,[&](Scene& scene) { init_scene(scene); });
+  scene_man_ = std::make_unique<SceneMan>(
+    build_scene,
+    [&](Scene& scene) { init_scene(scene); },
+    [&](int /*type*/,const std::string& error) { show_error(error); }
+  );
   input_man_ = std::make_unique<InputMan>(config.max_input_id);
   audio_player_ = std::make_unique<AudioPlayer>(config.music_types);
 
@@ -163,6 +179,9 @@ void CybelEngine::init_hints() {
   SDL_SetHint(SDL_HINT_JOYSTICK_ALLOW_BACKGROUND_EVENTS,"1");
   //SDL_SetHint(SDL_HINT_MOUSE_TOUCH_EVENTS,"1");
   //SDL_SetHint(SDL_HINT_TOUCH_MOUSE_EVENTS,"0");
+
+  // So that no display is needed. The env var SDL_VIDEODRIVER has priority over this.
+  if(is_headless_) { SDL_SetHint(SDL_HINT_VIDEODRIVER,"dummy"); }
 }
 
 void CybelEngine::init_config(Config& config) {
@@ -194,6 +213,26 @@ void CybelEngine::init_config(Config& config) {
     // Convert from FPS to Duration (millis) Per Frame.
     target_dpf_.set_from_millis(std::round(1000.0 / static_cast<double>(target_fps_)));
   }
+
+  logic_hz_ = (config.logic_hz >= 0) ? config.logic_hz : kFallbackLogicHz;
+
+  if(logic_hz_ > 0) {
+    // Not rounded (unlike target_dpf_), so that the logic runs at exactly this rate.
+    logic_dpf_.set_from_secs(1.0 / static_cast<double>(logic_hz_));
+    max_logic_time_.set_from_millis(logic_dpf_.millis() * kMaxLogicTicksPerFrame);
+    logic_step_.dpf = logic_dpf_;
+    logic_step_.delta_time = logic_dpf_.secs();
+  }
+
+  // Exactly one logic tick per frame (or one frame of the target FPS, if not using a fixed logic rate).
+  if(logic_hz_ > 0) {
+    headless_step_.dpf = logic_dpf_;
+  } else {
+    const int fps = (target_fps_ > 0) ? target_fps_ : kFallbackFps;
+    headless_step_.dpf.set_from_secs(1.0 / static_cast<double>(fps));
+  }
+
+  headless_step_.delta_time = headless_step_.dpf.secs();
 }
 
 void CybelEngine::init_gui(const Config& config) {
@@ -215,7 +254,7 @@ void CybelEngine::init_gui(const Config& config) {
     SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE,16);
   }
 
-  Uint32 window_flags = SDL_WINDOW_OPENGL | SDL_WINDOW_ALLOW_HIGHDPI;
+  Uint32 window_flags = is_headless_ ? SDL_WINDOW_HIDDEN : (SDL_WINDOW_OPENGL | SDL_WINDOW_ALLOW_HIGHDPI);
 
 #if defined(__EMSCRIPTEN__)
   // NOTE: There is a bug in SDL2 where SDL_SetWindowResizable() doesn't work to enable receiving resize
@@ -315,7 +354,7 @@ void CybelEngine::run_on_web([[maybe_unused]] std::shared_ptr<CybelEngine> cybel
 bool CybelEngine::run_frame() {
   if(!is_running_) { return false; }
 
-  if(res_.context == NULL) {
+  if(res_.context == NULL && !is_headless_) {
     // NOTE: Don't sleep or call SDL_Delay()/stop_frame_timer(), since SDL_Delay()/sleep is just a while-loop
     //       in Emscripten, and because requestAnimationFrame() is used, it won't hog the CPU unnecessarily.
     handle_non_context_events_only();
@@ -331,26 +370,125 @@ bool CybelEngine::run_frame() {
   stop_frame_timer();
   start_frame_timer();
 
-  input_man_->begin_input();
-  handle_events();
-  handle_input();
+  const Tracer::Scope trace{"run_frame","engine"};
+  const auto prev_logic_tick = logic_tick_;
+
+  {
+    static const auto kZoneId = Profiler::it().zone_id("events");
+    const Profiler::Zone zone{kZoneId};
+
+    input_man_->begin_input();
+    handle_events();
+    input_man_->end_input(logic_tick_);
+  }
 
   // Event/Input requested to stop.
   if(!is_running_) { return false; }
 
+  {
+    static const auto kZoneId = Profiler::it().zone_id("update_load");
+    const Profiler::Zone zone{kZoneId};
+
+    // Scene finished loading in the background? Then let the new scene start fresh.
+    if(scene_man_->update_load()) { logic_time_.set_to_zero(); }
+  }
+
   if(is_logic_running_) {
-    main_scene_.update_scene_logic(frame_step_,renderer_->dimens());
-    const int scene_result = scene_man_->curr_scene().update_scene_logic(frame_step_,renderer_->dimens());
+    update_logic();
+  } else {
+    // Input is still needed for pause menus, etc., but no ticks will pass.
+    input_man_->play_back(logic_tick_,on_input_event_);
+    handle_input();
+
+    logic_time_.set_to_zero();
+    logic_alpha_ = 0.0f;
+  }
+
+  Tracer::it().counter("logic_ticks",static_cast<double>(logic_tick_ - prev_logic_tick));
+
+  {
+    static const auto kZoneId = Profiler::it().zone_id("draw_scene");
+    const Profiler::Zone zone{kZoneId};
+    const Tracer::Scope draw_trace{"draw_scene","engine"};
+
+    // Ends the arrow from the scene change (see SceneMan::set_scene()) at the new scene's first draw.
+    if(const auto flow_id = scene_man_->take_trace_flow_id(); flow_id != 0) {
+      Tracer::it().flow_end("scene_change","scene",flow_id);
+    }
+
+    renderer_->clear_view();
+    main_scene_.draw_scene(*renderer_,renderer_->dimens());
+    scene_man_->curr_scene().draw_scene(*renderer_,renderer_->dimens());
+    renderer_->flush();
+
+    const auto& state_counters = renderer_->state_counters();
+    Tracer::it().counter("gl_state_issued",static_cast<double>(state_counters.total_issued()));
+    Tracer::it().counter("gl_state_elided",static_cast<double>(state_counters.total_elided()));
+    renderer_->reset_state_counters();
+  }
+
+  if(null_renderer_ != nullptr) {
+    null_renderer_->end_frame(scene_man_->curr_scene_type());
+  } else {
+    static const auto kZoneId = Profiler::it().zone_id("swap_window");
+    const Profiler::Zone zone{kZoneId};
 
-    if(scene_result != Scene::kNilType) {
-      scene_man_->push_scene(scene_result);
+    SDL_GL_SwapWindow(res_.window);
+  }
+
+  Profiler::it().end_frame();
+
+  return true;
+}
+
+void CybelEngine::update_logic() {
+  if(logic_hz_ <= 0) {
+    tick_logic(frame_step_);
+    return;
+  }
+
+  logic_time_ += frame_step_.dpf;
+
+  // If too far behind (e.g., dragging the window or a long load), then just drop the extra time,
+  //     so that the logic slows down for a moment instead of freezing up trying to catch up.
+  if(logic_time_ > max_logic_time_) { logic_time_ = max_logic_time_; }
+
+  while(is_running_ && logic_time_ >= logic_dpf_) {
+    logic_time_ -= logic_dpf_;
+
+    // Scene changed? Then let the new scene start fresh on the next frame.
+    if(!tick_logic(logic_step_)) {
+      logic_time_.set_to_zero();
+      break;
     }
   }
 
-  renderer_->clear_view();
-  main_scene_.draw_scene(*renderer_,renderer_->dimens());
-  scene_man_->curr_scene().draw_scene(*renderer_,renderer_->dimens());
-  SDL_GL_SwapWindow(res_.window);
+  logic_alpha_ = static_cast<float>(logic_time_.millis() / logic_dpf_.millis());
+}
+
+bool CybelEngine::tick_logic(const FrameStep& step) {
+  // Input is handled per tick (not per frame), so that a replay sees the exact same input on the same tick,
+  //     no matter the FPS.
+  input_man_->play_back(logic_tick_,on_input_event_);
+  handle_input();
+
+  const bool result = update_scene_logic(step);
+  ++logic_tick_;
+
+  return result;
+}
+
+bool CybelEngine::update_scene_logic(const FrameStep& step) {
+  static const auto kZoneId = Profiler::it().zone_id("update_scene_logic");
+  const Profiler::Zone zone{kZoneId};
+
+  main_scene_.update_scene_logic(step,renderer_->dimens());
+  const int scene_result = scene_man_->curr_scene().update_scene_logic(step,renderer_->dimens());
+
+  if(scene_result != Scene::kNilType) {
+    scene_man_->push_scene(scene_result);
+    return false;
+  }
 
   return true;
 }
@@ -358,6 +496,8 @@ bool CybelEngine::run_frame() {
 void CybelEngine::request_stop() { is_running_ = false; }
 
 void CybelEngine::on_context_lost() {
+  scene_man_->cancel_load(); // Its GL work would be lost anyway.
+
   main_scene_.on_scene_exit();
   scene_man_->curr_scene().on_scene_exit();
 
@@ -394,7 +534,12 @@ void CybelEngine::restore_context() {
 void CybelEngine::sync_size(bool force) {
   Size2i size{};
 
-  SDL_GL_GetDrawableSize(res_.window,&size.w,&size.h);
+  if(is_headless_) {
+    SDL_GetWindowSize(res_.window,&size.w,&size.h); // Not an OpenGL window.
+  } else {
+    SDL_GL_GetDrawableSize(res_.window,&size.w,&size.h);
+  }
+
   resize(size,force);
 }
 
@@ -416,7 +561,8 @@ void CybelEngine::stop_frame_timer() {
   frame_step_.dpf = frame_timer_.peek();
 
   // If target_dpf_ (target_fps_) is 0, then will use delta time only (no delay).
-  if(frame_step_.dpf < target_dpf_) {
+  // If headless, nothing is shown, so run faster than real time.
+  if(!is_headless_ && frame_step_.dpf < target_dpf_) {
     SDL_Delay((target_dpf_ - frame_step_.dpf).round_millis());
   }
 
@@ -429,6 +575,9 @@ void CybelEngine::stop_frame_timer() {
   // Exponential Moving Average (EMA) to reduce the effects of hiccups,
   //     instead of a typical average: avg = (avg + fps) / 2.
   avg_fps_ = (avg_fps_ * (1.0f - kAvgFpsSmoothing)) + (fps * kAvgFpsSmoothing);
+
+  // Not the real time, so that a headless run ticks the same every time, no matter the machine's load.
+  if(is_headless_) { frame_step_ = headless_step_; }
 }
 
 void CybelEngine::handle_events() {
@@ -482,6 +631,9 @@ void CybelEngine::on_input_event(input_id_t input_id) {
 }
 
 void CybelEngine::handle_input() {
+  static const auto kZoneId = Profiler::it().zone_id("handle_scene_input");
+  const Profiler::Zone zone{kZoneId};
+
   main_scene_.handle_scene_input(input_man_->states(),*input_man_,renderer_->dimens());
   scene_man_->curr_scene().handle_scene_input(input_man_->states(),*input_man_,renderer_->dimens());
 }
@@ -571,6 +723,10 @@ bool CybelEngine::is_logic_running() const { return is_logic_running_; }
 
 Renderer& CybelEngine::renderer() const { return *renderer_; }
 
+RendererNull* CybelEngine::null_renderer() const { return null_renderer_; }
+
+bool CybelEngine::is_headless() const { return is_headless_; }
+
 const ViewDimens& CybelEngine::dimens() const { return renderer_->dimens(); }
 
 Scene& CybelEngine::main_scene() const { return main_scene_; }
@@ -591,4 +747,12 @@ double CybelEngine::delta_time() const { return frame_step_.delta_time; }
 
 float CybelEngine::avg_fps() const { return avg_fps_; }
 
+int CybelEngine::logic_hz() const { return logic_hz_; }
+
+const Duration& CybelEngine::logic_dpf() const { return logic_dpf_; }
+
+float CybelEngine::logic_alpha() const { return logic_alpha_; }
+
+std::uint64_t CybelEngine::logic_tick() const { return logic_tick_; }
+
 } // namespace cybel
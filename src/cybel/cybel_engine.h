@@ -13,6 +13,7 @@
 #include "cybel/audio/audio_player.h"
 #include "cybel/gfx/image.h"
 #include "cybel/gfx/renderer.h"
+#include "cybel/gfx/renderer_null.h"
 #include "cybel/input/input_man.h"
 #include "cybel/scene/scene.h"
 #include "cybel/scene/scene_man.h"
@@ -49,12 +50,26 @@ class CybelEngine {
   std::unique_ptr<AudioPlayer> audio_player_{};
 
 public:
+  enum class RendererType : std::uint8_t {
+    kDefault, // RendererGl or RendererGles, depending on the build.
+    kNull, // RendererNull, which doesn't need a GPU (no OpenGL context or visible window).
+  };
+
   struct Config {
     std::string title{};
     float scale_factor = 0.0f;
     Size2i size{kFallbackWidth,kFallbackHeight};
     Size2i target_size{0,0};
     int fps = kFallbackFps;
+
+    /**
+     * Fixed rate (ticks per second) of update_scene_logic(), independent of the FPS.
+     * Zero or more ticks are run per frame, so the logic behaves the same at any FPS & during hitches.
+     * Use logic_alpha() when drawing to interpolate between ticks.
+     *
+     * If 0, then update_scene_logic() is called once per frame with a variable step instead.
+     */
+    int logic_hz = kFallbackLogicHz;
     bool vsync = false;
     Color4f clear_color{0.0f,1.0f};
     input_id_t max_input_id = 0;
@@ -79,11 +94,18 @@ public:
      * See: https://wiki.libsdl.org/SDL2_mixer/Mix_Init
      */
     int music_types = MIX_INIT_OGG;
+
+    /**
+     * For kNull, the SDL video driver defaults to "dummy" (unless SDL_VIDEODRIVER is set),
+     *     and textures are headless (see Texture::set_headless()).
+     */
+    RendererType renderer_type = RendererType::kDefault;
   };
 
   static constexpr int kFallbackWidth = 1600;
   static constexpr int kFallbackHeight = 900;
   static constexpr int kFallbackFps = 60;
+  static constexpr int kFallbackLogicHz = 120;
 
   explicit CybelEngine(Scene& main_scene,Config config,const SceneMan::SceneBuilder& build_scene);
 
@@ -124,6 +146,11 @@ public:
   bool is_logic_running() const;
 
   Renderer& renderer() const;
+  /**
+   * Null if not using RendererType::kNull.
+   */
+  RendererNull* null_renderer() const;
+  bool is_headless() const;
   const ViewDimens& dimens() const;
   Scene& main_scene() const;
   SceneMan& scene_man() const;
@@ -135,9 +162,23 @@ public:
   const Duration& dpf() const;
   double delta_time() const;
   float avg_fps() const;
+  int logic_hz() const;
+  const Duration& logic_dpf() const;
+
+  /**
+   * How far (from 0.0 to 1.0) the current frame is between the last logic tick & the next one.
+   * Always 0.0 if not using a fixed logic rate (see Config.logic_hz).
+   */
+  float logic_alpha() const;
+
+  /**
+   * Number of logic ticks run so far, which InputMan uses to tag recorded input.
+   */
+  std::uint64_t logic_tick() const;
 
 private:
   static constexpr float kAvgFpsSmoothing = 0.3f; // Smoothing factor. Usually from 0.1 to 0.3.
+  static constexpr int kMaxLogicTicksPerFrame = 8; // Drop time after this, else a long hitch can snowball.
 
   void on_input_event(input_id_t input_id);
 
@@ -145,9 +186,19 @@ private:
   int target_fps_ = 0;
   Duration target_dpf_{};
   float avg_fps_{};
+  int logic_hz_ = 0;
+  Duration logic_dpf_{};
+  Duration max_logic_time_{};
+  Duration logic_time_{}; // Accumulated frame time not yet consumed by logic ticks.
+  FrameStep logic_step_{};
+  FrameStep headless_step_{}; // Used for every frame if headless (see stop_frame_timer()).
+  float logic_alpha_ = 0.0f;
+  std::uint64_t logic_tick_ = 0;
   bool is_vsync_ = false;
+  bool is_headless_ = false;
 
   std::unique_ptr<Renderer> renderer_{};
+  RendererNull* null_renderer_ = nullptr; // Same as `renderer_`, if using RendererType::kNull.
   Scene& main_scene_;
   std::unique_ptr<SceneMan> scene_man_{}; // Must be defined after `renderer_`.
   std::unique_ptr<InputMan> input_man_{};
@@ -173,6 +224,9 @@ private:
   void handle_events();
   void handle_non_context_events_only();
   void handle_input();
+  void update_logic();
+  bool tick_logic(const FrameStep& step);
+  bool update_scene_logic(const FrameStep& step);
 
   static void show_error_global(const std::string& title,const std::string& error,SDL_Window* window);
 };
@@ -0,0 +1,154 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gl_state_cache.h"
+
+#include <algorithm>
+
+namespace cybel {
+
+std::string_view GlStateCache::state_type_name(StateType type) {
+  switch(type) {
+    case StateType::kProgram: return "program";
+    case StateType::kTexture: return "texture";
+    case StateType::kBlend: return "blend";
+    case StateType::kColor: return "color";
+    case StateType::kMatrix: return "matrix";
+    case StateType::kUniform: return "uniform";
+  }
+
+  return "unknown";
+}
+
+void GlStateCache::invalidate() {
+  has_program_ = false;
+  has_tex_ = false;
+  has_blend_ = false;
+  has_color_ = false;
+
+  for(auto& uniform : uniforms_) { uniform.is_set = false; }
+}
+
+void GlStateCache::invalidate_tex() { has_tex_ = false; }
+
+void GlStateCache::invalidate_color() { has_color_ = false; }
+
+void GlStateCache::reset_counters() { counters_ = Counters{}; }
+
+void GlStateCache::use_program(GLuint handle) {
+  if(!count(StateType::kProgram,has_program_ && handle == program_)) { return; }
+
+  // Uniforms are stored per program.
+  if(has_program_) {
+    for(auto& uniform : uniforms_) { uniform.is_set = false; }
+  }
+
+  has_program_ = true;
+  program_ = handle;
+  glUseProgram(handle);
+}
+
+void GlStateCache::bind_tex(GLuint handle) {
+  if(!count(StateType::kTexture,has_tex_ && handle == tex_)) { return; }
+
+  has_tex_ = true;
+  tex_ = handle;
+  glBindTexture(GL_TEXTURE_2D,handle);
+}
+
+void GlStateCache::blend_func(GLenum src_factor,GLenum dst_factor) {
+  const bool is_same = has_blend_ && src_factor == blend_src_factor_ && dst_factor == blend_dst_factor_;
+
+  if(!count(StateType::kBlend,is_same)) { return; }
+
+  has_blend_ = true;
+  blend_src_factor_ = src_factor;
+  blend_dst_factor_ = dst_factor;
+  glBlendFunc(src_factor,dst_factor);
+}
+
+#if defined(CYBEL_RENDERER_GL)
+void GlStateCache::color(const Color4f& color) {
+  if(!count(StateType::kColor,has_color_ && color == color_)) { return; }
+
+  has_color_ = true;
+  color_ = color;
+  glColor4f(color.r,color.g,color.b,color.a);
+}
+#endif
+
+void GlStateCache::uniform1i(GLint loc,GLint value) {
+  const auto value_f = static_cast<GLfloat>(value);
+
+  if(!set_uniform(StateType::kUniform,loc,&value_f,1)) { return; }
+
+  glUniform1i(loc,value);
+}
+
+void GlStateCache::uniform4f(GLint loc,const Color4f& color) {
+  const GLfloat values[4] = {color.r,color.g,color.b,color.a};
+
+  if(!set_uniform(StateType::kColor,loc,values,4)) { return; }
+
+  glUniform4f(loc,color.r,color.g,color.b,color.a);
+}
+
+void GlStateCache::uniform_mat4(GLint loc,const GLfloat* values) {
+  if(!set_uniform(StateType::kMatrix,loc,values,16)) { return; }
+
+  glUniformMatrix4fv(loc,1,GL_FALSE,values);
+}
+
+bool GlStateCache::count(StateType type,bool is_same) {
+  const auto i = static_cast<std::size_t>(type);
+
+  if(is_same) {
+    ++counters_.elided[i];
+    return false;
+  }
+
+  ++counters_.issued[i];
+  return true;
+}
+
+bool GlStateCache::set_uniform(StateType type,GLint loc,const GLfloat* values,std::size_t value_count) {
+  if(loc < 0) { return count(type,false); }
+
+  const auto i = static_cast<std::size_t>(loc);
+
+  if(i >= uniforms_.size()) { uniforms_.resize(i + 1); }
+
+  auto& uniform = uniforms_[i];
+  const bool is_same = uniform.is_set && std::equal(values,values + value_count,uniform.values.begin());
+
+  if(!count(type,is_same)) { return false; }
+
+  uniform.is_set = true;
+  std::copy(values,values + value_count,uniform.values.begin());
+
+  return true;
+}
+
+const GlStateCache::Counters& GlStateCache::counters() const { return counters_; }
+
+std::size_t GlStateCache::Counters::total_issued() const {
+  std::size_t total = 0;
+
+  for(const auto c : issued) { total += c; }
+
+  return total;
+}
+
+std::size_t GlStateCache::Counters::total_elided() const {
+  std::size_t total = 0;
+
+  for(const auto c : elided) { total += c; }
+
+  return total;
+}
+
+} // namespace cybel
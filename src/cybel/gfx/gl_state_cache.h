@@ -0,0 +1,122 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CYBEL_GFX_GL_STATE_CACHE_H_
+#define CYBEL_GFX_GL_STATE_CACHE_H_
+
+#include "cybel/common.h"
+
+#include "cybel/types/color.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace cybel {
+
+/**
+ * Shadows the OpenGL state that the renderers set the most, so that setting the same state again
+ *     (e.g., the same color for many blocks of the mini map) doesn't make an OpenGL call.
+ *
+ * Each setter makes the call only if the state differs, and counts it as issued or elided.
+ *
+ * Since OpenGL can also be changed outside of this (e.g., Texture binds itself to upload),
+ *     call invalidate() to forget all states, so that the next setters are issued.
+ *     The Renderer does this on each clear_view() (once per frame) & on context restored.
+ */
+class GlStateCache {
+public:
+  enum class StateType : std::uint8_t {
+    kProgram,
+    kTexture,
+    kBlend,
+    kColor,
+    kMatrix,
+    kUniform,
+  };
+
+  static constexpr std::size_t kStateTypeCount = static_cast<std::size_t>(StateType::kUniform) + 1;
+
+  struct Counters {
+    std::size_t issued[kStateTypeCount]{};
+    std::size_t elided[kStateTypeCount]{};
+
+    std::size_t total_issued() const;
+    std::size_t total_elided() const;
+  };
+
+  static std::string_view state_type_name(StateType type);
+
+  void invalidate();
+  /**
+   * For when the texture was changed outside of this (e.g., by a display list).
+   */
+  void invalidate_tex();
+  /**
+   * For when the color was changed outside of this (e.g., per vertex).
+   */
+  void invalidate_color();
+  void reset_counters();
+
+  void use_program(GLuint handle);
+  void bind_tex(GLuint handle);
+  void blend_func(GLenum src_factor,GLenum dst_factor);
+
+#if defined(CYBEL_RENDERER_GL)
+  /**
+   * For the fixed-function pipeline (glColor4f).
+   */
+  void color(const Color4f& color);
+#endif
+
+  void uniform1i(GLint loc,GLint value);
+  /**
+   * Counted as StateType::kColor.
+   */
+  void uniform4f(GLint loc,const Color4f& color);
+  /**
+   * Counted as StateType::kMatrix.
+   */
+  void uniform_mat4(GLint loc,const GLfloat* values);
+
+  const Counters& counters() const;
+
+private:
+  static constexpr std::size_t kMaxUniformValueCount = 16; // mat4.
+
+  // Values are stored as floats, since the int uniforms are small (e.g., bools & texture units).
+  struct Uniform {
+    bool is_set = false;
+    std::array<GLfloat,kMaxUniformValueCount> values{};
+  };
+
+  Counters counters_{};
+
+  bool has_program_ = false;
+  GLuint program_ = 0;
+  bool has_tex_ = false;
+  GLuint tex_ = 0;
+  bool has_blend_ = false;
+  GLenum blend_src_factor_{};
+  GLenum blend_dst_factor_{};
+  bool has_color_ = false;
+  Color4f color_{};
+
+  std::vector<Uniform> uniforms_{}; // Indexed by location.
+
+  bool count(StateType type,bool is_same);
+  /**
+   * Returns true if the values differ (& stores them), or if `loc` is invalid (-1),
+   *     since OpenGL silently ignores it anyway.
+   */
+  bool set_uniform(StateType type,GLint loc,const GLfloat* values,std::size_t value_count);
+};
+
+} // namespace cybel
+#endif
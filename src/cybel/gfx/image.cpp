@@ -35,6 +35,19 @@ Image::Image(const std::filesystem::path& file,bool make_weird,const Color4f& we
   }
 }
 
+Image::Image(const Size2i& size,const std::string& id)
+  : id_(id) {
+  handle_ = SDL_CreateRGBSurfaceWithFormat(0,std::max(size.w,1),std::max(size.h,1),32,SDL_PIXELFORMAT_RGBA32);
+
+  if(handle_ == NULL) {
+    throw CybelError{"Failed to create image [",id_,"] of size ",size.w,'x',size.h,": ",
+                     Util::get_sdl_error(),'.'};
+  }
+
+  size_.w = std::max(handle_->w,0);
+  size_.h = std::max(handle_->h,0);
+}
+
 Image::Image(Image&& other) noexcept {
   move_from(std::move(other));
 }
@@ -128,6 +141,48 @@ void Image::edit_pixels(const EditPixel& edit_pixel) {
   unlock();
 }
 
+void Image::blit(const Image& src,const Pos2i& pos,const Size2i& size,int extrude) {
+  SDL_Rect dest_rect{pos.x,pos.y,size.w,size.h};
+  SDL_BlendMode blend_mode = SDL_BLENDMODE_NONE;
+
+  // Copy the alpha as is, instead of blending it with the (blank) pixels of this image.
+  SDL_GetSurfaceBlendMode(src.handle_,&blend_mode);
+  SDL_SetSurfaceBlendMode(src.handle_,SDL_BLENDMODE_NONE);
+  const int result = SDL_BlitScaled(src.handle_,NULL,handle_,&dest_rect);
+  SDL_SetSurfaceBlendMode(src.handle_,blend_mode);
+
+  if(result != 0) {
+    throw CybelError{"Failed to blit image [",src.id_,"] into image [",id_,"]: ",Util::get_sdl_error(),'.'};
+  }
+  if(extrude <= 0 || size.w <= 0 || size.h <= 0) { return; }
+  if(bytes_per_pixel() != 4) {
+    throw CybelError{"Failed to extrude image [",src.id_,"] in non-32-bit image [",id_,"]."};
+  }
+
+  lock();
+
+  auto* pixels = static_cast<Uint8*>(handle_->pixels);
+  const int pitch = handle_->pitch;
+  const int x1 = std::max(pos.x - extrude,0);
+  const int y1 = std::max(pos.y - extrude,0);
+  const int x2 = std::min(pos.x + size.w + extrude,size_.w);
+  const int y2 = std::min(pos.y + size.h + extrude,size_.h);
+
+  for(int y = y1; y < y2; ++y) {
+    const int src_y = std::clamp(y,pos.y,pos.y + size.h - 1);
+    auto* row = reinterpret_cast<Uint32*>(pixels + (y * pitch));
+    const auto* src_row = reinterpret_cast<const Uint32*>(pixels + (src_y * pitch));
+
+    for(int x = x1; x < x2; ++x) {
+      const int src_x = std::clamp(x,pos.x,pos.x + size.w - 1);
+
+      if(src_x != x || src_y != y) { row[x] = src_row[src_x]; }
+    }
+  }
+
+  unlock();
+}
+
 Image& Image::lock() {
   if(is_locked_ || !SDL_MUSTLOCK(handle_)) { return *this; }
 
@@ -11,6 +11,7 @@
 #include "cybel/common.h"
 
 #include "cybel/types/color.h"
+#include "cybel/types/pos.h"
 #include "cybel/types/size.h"
 
 #include <filesystem>
@@ -27,6 +28,10 @@ public:
 
   explicit Image(const std::filesystem::path& file,bool make_weird = false,
                  const Color4f& weird_color = Color4f::kBlack);
+  /**
+   * Creates a blank (transparent) RGBA image, such as for packing other images into with blit().
+   */
+  explicit Image(const Size2i& size,const std::string& id);
 
   Image(const Image& other) = delete;
   Image(Image&& other) noexcept;
@@ -38,6 +43,14 @@ public:
   void make_weird();
   void colorize(const Color4f& to_color);
   void edit_pixels(const EditPixel& edit_pixel);
+  /**
+   * Copies all of `src` into this image at `pos`, scaled to `size`.
+   *
+   * The edge pixels of `src` are then repeated outward by `extrude` pixels, so that sampling just past
+   *     its edges (e.g., from rounding tex coords) doesn't bleed into its neighbors in an atlas.
+   *     This image must be 32-bit (e.g., from the blank ctor) to extrude.
+   */
+  void blit(const Image& src,const Pos2i& pos,const Size2i& size,int extrude = 0);
 
   Image& lock();
   Image& unlock() noexcept;
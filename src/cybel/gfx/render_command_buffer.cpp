@@ -0,0 +1,149 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "render_command_buffer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace cybel {
+
+void RenderCommandBuffer::clear() {
+  if(commands_.empty()) { return; } // Then the buckets are empty too.
+
+  commands_.clear();
+
+  for(auto& bucket : buckets_) {
+    bucket.cmd_indexes.clear();
+    bucket.min_layer = 0;
+  }
+}
+
+void RenderCommandBuffer::sort() {
+  std::stable_sort(commands_.begin(),commands_.end(),[](const Command& a,const Command& b) {
+    return a.key < b.key;
+  });
+}
+
+void RenderCommandBuffer::add_quad(const Pos4f& src,const Pos5f& dest) {
+  Command cmd{};
+
+  cmd.tex_handle = state_.tex_handle;
+  cmd.blend = state_.blend;
+  cmd.color = state_.color;
+  cmd.src = src;
+  cmd.dest = dest;
+
+  // Every previous command that overlaps this one shares at least one bucket with it.
+  for_each_bucket(cmd.dest,[&](const Bucket& bucket) {
+    cmd.layer = std::max(cmd.layer,bucket.min_layer);
+
+    for(const auto i : bucket.cmd_indexes) {
+      const auto& prev = commands_[i];
+
+      // Can't go any higher from this one.
+      if(prev.layer + 1 <= cmd.layer) { continue; }
+      if(!is_overlap(prev.dest,cmd.dest)) { continue; }
+
+      cmd.layer = std::max(cmd.layer,is_same_batch(prev,cmd) ? prev.layer : (prev.layer + 1));
+    }
+  });
+
+  cmd.key = build_key(cmd);
+
+  const auto index = static_cast<std::uint32_t>(commands_.size());
+  commands_.push_back(cmd);
+
+  for_each_bucket(cmd.dest,[&](Bucket& bucket) {
+    if(bucket.cmd_indexes.size() >= kMaxBucketCount) {
+      for(const auto i : bucket.cmd_indexes) {
+        bucket.min_layer = std::max(bucket.min_layer,commands_[i].layer + 1);
+      }
+
+      bucket.cmd_indexes.clear();
+    }
+
+    bucket.cmd_indexes.push_back(index);
+  });
+}
+
+template <typename Func>
+void RenderCommandBuffer::for_each_bucket(const Pos5f& dest,const Func& func) {
+  const auto to_cell = [](float value) {
+    // Clamp first, so that a huge pos can't overflow the int.
+    return static_cast<int>(std::floor(std::clamp(value / kCellSize,-1.0e6f,1.0e6f)));
+  };
+
+  const int x1 = to_cell(std::min(dest.x1,dest.x2));
+  const int y1 = to_cell(std::min(dest.y1,dest.y2));
+  // Any more cells would wrap around to the same buckets.
+  const int x2 = std::min(to_cell(std::max(dest.x1,dest.x2)),x1 + kGridSide - 1);
+  const int y2 = std::min(to_cell(std::max(dest.y1,dest.y2)),y1 + kGridSide - 1);
+
+  for(int y = y1; y <= y2; ++y) {
+    const auto row = (static_cast<unsigned int>(y) % kGridSide) * kGridSide;
+
+    for(int x = x1; x <= x2; ++x) {
+      func(buckets_[row + (static_cast<unsigned int>(x) % kGridSide)]);
+    }
+  }
+}
+
+bool RenderCommandBuffer::is_overlap(const Pos5f& a,const Pos5f& b) {
+  // Just touching (e.g., runes of text w/o spacing) is not an overlap.
+  return std::min(a.x1,a.x2) < std::max(b.x1,b.x2) && std::min(b.x1,b.x2) < std::max(a.x1,a.x2) &&
+         std::min(a.y1,a.y2) < std::max(b.y1,b.y2) && std::min(b.y1,b.y2) < std::max(a.y1,a.y2);
+}
+
+bool RenderCommandBuffer::is_same_batch(const Command& a,const Command& b) {
+  // Depth is included, so that the order of overlapping quads with different depths is never changed.
+  return a.tex_handle == b.tex_handle && a.blend == b.blend && a.dest.z == b.dest.z;
+}
+
+std::uint64_t RenderCommandBuffer::build_key(const Command& cmd) {
+  // Layer (20 bits), blend (4), texture (24), & depth (16).
+  // - The texture & depth only group the commands, so truncating them is fine.
+  const auto depth = static_cast<std::uint64_t>(
+    std::clamp(static_cast<int>(std::lround(cmd.dest.z)),-32768,32767) + 32768
+  );
+
+  return (static_cast<std::uint64_t>(cmd.layer & 0xFFFFFu) << 44) |
+         (static_cast<std::uint64_t>(cmd.blend & 0xFu) << 40) |
+         (static_cast<std::uint64_t>(cmd.tex_handle & 0xFFFFFFu) << 16) |
+         depth;
+}
+
+void RenderCommandBuffer::set_color(const Color4f& color) { state_.color = color; }
+
+void RenderCommandBuffer::set_tex(GLuint handle) { state_.tex_handle = handle; }
+
+void RenderCommandBuffer::set_blend(std::uint8_t blend) { state_.blend = blend; }
+
+std::size_t RenderCommandBuffer::batch_size(std::size_t first) const {
+  if(first >= commands_.size()) { return 0; }
+
+  const auto& first_cmd = commands_[first];
+  std::size_t last = first + 1;
+
+  for(; last < commands_.size(); ++last) {
+    const auto& cmd = commands_[last];
+
+    if(cmd.tex_handle != first_cmd.tex_handle || cmd.blend != first_cmd.blend) { break; }
+  }
+
+  return last - first;
+}
+
+bool RenderCommandBuffer::empty() const { return commands_.empty(); }
+
+bool RenderCommandBuffer::is_full() const { return commands_.size() >= kMaxCount; }
+
+const std::vector<RenderCommandBuffer::Command>& RenderCommandBuffer::commands() const { return commands_; }
+
+const RenderCommandBuffer::State& RenderCommandBuffer::state() const { return state_; }
+
+} // namespace cybel
@@ -0,0 +1,100 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CYBEL_GFX_RENDER_COMMAND_BUFFER_H_
+#define CYBEL_GFX_RENDER_COMMAND_BUFFER_H_
+
+#include "cybel/common.h"
+
+#include "cybel/types/color.h"
+#include "cybel/types/pos.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cybel {
+
+/**
+ * Records 2D quads (with the color, texture, & blend that they were drawn with) for a Renderer,
+ *     so that they can be sorted by state & drawn in as few batches as possible (see Renderer.submit_cmds()),
+ *     instead of changing the state for every few quads (e.g., a colored bg, then text, then a sprite, ...).
+ *
+ * Sorting must not change what's drawn, so each quad is put on a layer above every previous quad
+ *     that it overlaps, unless that quad is in the same batch (which keeps its order, as the sort is stable).
+ *     The sort key is then: layer, blend, texture, & depth.
+ *
+ * To find the overlaps without testing every previous quad, the quads are put into the buckets of a coarse
+ *     grid of the screen (see Bucket). Only the last few quads of a bucket are tested exactly; older ones
+ *     are folded into the bucket's min layer, which can only put a quad on a higher layer (never wrong).
+ *
+ * The commands are kept in a vector that's only cleared (not freed) after each submit, like an arena.
+ */
+class RenderCommandBuffer {
+public:
+  struct State {
+    Color4f color{1.0f};
+    GLuint tex_handle = 0; // 0 if no texture.
+    std::uint8_t blend = 0;
+  };
+
+  struct Command {
+    std::uint64_t key = 0;
+    std::uint32_t layer = 0;
+    GLuint tex_handle = 0; // 0 if no texture.
+    std::uint8_t blend = 0;
+    Color4f color{};
+    Pos4f src{};
+    Pos5f dest{};
+  };
+
+  static constexpr std::size_t kMaxCount = 4096; // Then must submit.
+
+  void clear();
+  void sort();
+
+  void add_quad(const Pos4f& src,const Pos5f& dest);
+
+  void set_color(const Color4f& color);
+  void set_tex(GLuint handle);
+  void set_blend(std::uint8_t blend);
+
+  /**
+   * Returns the number of (sorted) commands starting at `first` that can be drawn together,
+   *     since they have the same texture & blend.
+   */
+  std::size_t batch_size(std::size_t first) const;
+  bool empty() const;
+  bool is_full() const;
+  const std::vector<Command>& commands() const;
+  const State& state() const;
+
+private:
+  struct Bucket {
+    std::vector<std::uint32_t> cmd_indexes{};
+    std::uint32_t min_layer = 0; // Above every command that was folded out of `cmd_indexes`.
+  };
+
+  static constexpr float kCellSize = 64.0f;
+  static constexpr int kGridSide = 32; // Cells wrap around into the buckets (kGridSide x kGridSide).
+  static constexpr std::size_t kMaxBucketCount = 32; // Then the bucket's commands are folded.
+
+  std::vector<Command> commands_{};
+  State state_{};
+  std::array<Bucket,static_cast<std::size_t>(kGridSide * kGridSide)> buckets_{};
+
+  template <typename Func>
+  void for_each_bucket(const Pos5f& dest,const Func& func);
+
+  static bool is_overlap(const Pos5f& a,const Pos5f& b);
+  static bool is_same_batch(const Command& a,const Command& b);
+  static std::uint64_t build_key(const Command& cmd);
+};
+
+} // namespace cybel
+#endif
@@ -35,8 +35,6 @@ Renderer::Renderer(const Size2i& size,const Size2i& target_size,const Color4f& c
   font_colors_["red"] = Color4f::kRed;
   font_colors_["white"] = Color4f::kWhite;
   font_colors_["yellow"] = Color4f::kYellow;
-
-  init_context();
 }
 
 void Renderer::init_context() {
@@ -49,6 +47,7 @@ void Renderer::init_context() {
   glDepthFunc(GL_LEQUAL);
 
   glEnable(GL_BLEND);
+  gl_state_.invalidate(); // New context, or was lost.
   begin_blend(curr_blend_mode_);
 
   const GLenum error = glGetError();
@@ -58,7 +57,11 @@ void Renderer::init_context() {
   }
 }
 
-void Renderer::on_context_lost() {}
+void Renderer::on_context_lost() {
+  // The recorded quads (& any queued by the subclass) can't be drawn w/o the context.
+  cmds_.clear();
+  is_recording_cmds_ = false;
+}
 
 void Renderer::on_context_restored() {
   Util::clear_gl_errors();
@@ -66,9 +69,16 @@ void Renderer::on_context_restored() {
 }
 
 void Renderer::resize(const Size2i& size) {
+  flush(); // Before the viewport changes.
+
   // Allow resize even if the width & height haven't changed.
   // - If decide to change this logic, need to allow force resize so can resize on init.
+  resize_dimens(size);
+
+  glViewport(0,0,dimens_.size.w,dimens_.size.h);
+}
 
+void Renderer::resize_dimens(const Size2i& size) {
   // Avoid divides by 0 [e.g., in begin_3d_scene()].
   dimens_.size.w = std::max(size.w,1);
   dimens_.size.h = std::max(size.h,1);
@@ -76,14 +86,86 @@ void Renderer::resize(const Size2i& size) {
   dimens_.scale.x = static_cast<float>(dimens_.size.w) / static_cast<float>(dimens_.target_size.w);
   dimens_.scale.y = static_cast<float>(dimens_.size.h) / static_cast<float>(dimens_.target_size.h);
   dimens_.aspect_scale = std::min(dimens_.scale.x,dimens_.scale.y);
-
-  glViewport(0,0,dimens_.size.w,dimens_.size.h);
 }
 
 void Renderer::clear_view() {
+  flush();
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+  // Re-sync once per frame, in case the state was changed outside of the cache (e.g., by a Texture).
+  gl_state_.invalidate();
 }
 
+void Renderer::flush() { submit_cmds(); }
+
+void Renderer::begin_recording_cmds() {
+  if(is_cmd_sorting_) { is_recording_cmds_ = true; }
+}
+
+void Renderer::end_recording_cmds() {
+  if(!is_recording_cmds_) { return; }
+
+  submit_cmds(); // Also applies the recorded state.
+  is_recording_cmds_ = false;
+}
+
+void Renderer::submit_cmds() {
+  if(!is_recording_cmds_) { return; }
+
+  // Draw right away below (also, so that flush() from apply_blend() doesn't come back here).
+  is_recording_cmds_ = false;
+  cmds_.sort();
+
+  const auto& cmds = cmds_.commands();
+
+  for(std::size_t first = 0; first < cmds.size();) {
+    const std::size_t count = cmds_.batch_size(first);
+
+    apply_blend(blend_mode(cmds[first].blend));
+    draw_cmd_quads(&cmds[first],count);
+
+    first += count;
+  }
+
+  // Even w/o any quads, as the caller is about to draw directly with the recorded state.
+  apply_cmd_state();
+
+  cmds_.clear();
+  is_recording_cmds_ = true;
+}
+
+void Renderer::apply_cmd_state() {
+  const auto& state = cmds_.state();
+
+  apply_blend(blend_mode(state.blend));
+  restore_cmd_state(state.color,state.tex_handle);
+}
+
+bool Renderer::record_color(const Color4f& color) {
+  cmds_.set_color(color); // Always track it, for restore_cmd_state().
+
+  return is_recording_cmds_;
+}
+
+bool Renderer::record_tex(GLuint handle) {
+  cmds_.set_tex(handle);
+
+  return is_recording_cmds_;
+}
+
+bool Renderer::record_quad(const Pos4f& src,const Pos3i& pos,const Size2i& size) {
+  if(!is_recording_cmds_) { return false; }
+  if(cmds_.is_full()) { submit_cmds(); }
+
+  cmds_.add_quad(src,build_dest_pos5f(pos,size));
+
+  return true;
+}
+
+void Renderer::draw_cmd_quads(const RenderCommandBuffer::Command* /*cmds*/,std::size_t /*count*/) {}
+
+void Renderer::restore_cmd_state(const Color4f& /*color*/,GLuint /*tex_handle*/) {}
+
 Renderer& Renderer::begin_auto_center_scale() {
   return begin_auto_anchor_scale(Pos2f{0.5f,0.5f});
 }
@@ -123,12 +205,27 @@ Renderer& Renderer::end_scale() {
 
 Renderer& Renderer::end_color() { return begin_color(Color4f{1.0f}); }
 
+const Renderer::BlendMode& Renderer::blend_mode(std::uint8_t id) {
+  return (id == kAddBlendMode.id) ? kAddBlendMode : kDefaultBlendMode;
+}
+
 Renderer& Renderer::begin_blend(const BlendMode& mode) {
-  glBlendFunc(mode.src_factor,mode.dst_factor);
+  cmds_.set_blend(mode.id);
+
+  if(!is_recording_cmds_) { apply_blend(mode); }
 
   return *this;
 }
 
+void Renderer::apply_blend(const BlendMode& mode) {
+  flush();
+  apply_blend_func(mode.src_factor,mode.dst_factor);
+}
+
+void Renderer::apply_blend_func(GLenum src_factor,GLenum dst_factor) {
+  gl_state_.blend_func(src_factor,dst_factor);
+}
+
 Renderer& Renderer::begin_add_blend() { return begin_blend(kAddBlendMode); }
 
 Renderer& Renderer::end_blend() { return begin_blend(kDefaultBlendMode); }
@@ -250,6 +347,14 @@ void Renderer::set_font_color(const std::string& name,const Color4f& color) {
   font_colors_[name] = color;
 }
 
+void Renderer::set_cmd_sorting(bool enabled) {
+  if(!enabled) { end_recording_cmds(); }
+
+  is_cmd_sorting_ = enabled;
+}
+
+void Renderer::reset_state_counters() { gl_state_.reset_counters(); }
+
 const ViewDimens& Renderer::dimens() const { return dimens_; }
 
 const Color4f& Renderer::clear_color() const { return clear_color_; }
@@ -260,6 +365,8 @@ Color4f* Renderer::font_color(const std::string& name) {
   return (it == font_colors_.end()) ? nullptr : &it->second;
 }
 
+const GlStateCache::Counters& Renderer::state_counters() const { return gl_state_.counters(); }
+
 Renderer::TextureWrapper::TextureWrapper(Renderer& ren,const Texture& tex,const Pos4f& src)
   : ren(ren),tex(tex),src(src) {}
 
@@ -11,6 +11,8 @@
 #include "cybel/common.h"
 
 #include "cybel/gfx/font_atlas.h"
+#include "cybel/gfx/gl_state_cache.h"
+#include "cybel/gfx/render_command_buffer.h"
 #include "cybel/gfx/sprite.h"
 #include "cybel/gfx/sprite_atlas.h"
 #include "cybel/gfx/texture.h"
@@ -19,8 +21,10 @@
 #include "cybel/types/size.h"
 #include "cybel/types/view_dimens.h"
 
+#include <cstdint>
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 namespace cybel {
 
@@ -70,6 +74,10 @@ namespace cybel {
  *     ren.draw_quad({pos.x,(++pos.y) * size.h,0},size);
  *   ren.end_color();
  *   @endcode
+ *
+ * In a 2D scene, the quads are not drawn right away, but recorded, and then sorted by state
+ *     & drawn in batches on the next flush (e.g., end of frame, model matrix change, or 3D scene).
+ *     See RenderCommandBuffer.
  */
 class Renderer {
 public:
@@ -167,6 +175,7 @@ public:
 
   struct QuadBufferData {
     GLuint tex_handle = 0;
+    Pos4f src{0.0f,0.0f,1.0f,1.0f}; // Of the texture (e.g., a cell of an atlas).
     Pos3f normal{};
     Pos3f vertices[4] = {Pos3f{},Pos3f{},Pos3f{},Pos3f{}};
   };
@@ -191,7 +200,16 @@ public:
   virtual void on_context_lost();
   virtual void on_context_restored();
   virtual void resize(const Size2i& size);
-  void clear_view();
+  virtual void clear_view();
+  /**
+   * Draws anything that has been recorded (see submit_cmds()) or that the subclass has queued up
+   *     (e.g., instanced quads).
+   * Must be called after drawing each frame (before swapping the window).
+   *
+   * Queued quads are drawn with the current state (texture, matrices, blend, etc.), so the subclass must
+   *     call this before changing any of it, except for what each quad stores itself (e.g., its color).
+   */
+  virtual void flush();
 
   virtual Renderer& begin_2d_scene() = 0;
   virtual Renderer& begin_3d_scene() = 0;
@@ -204,8 +222,8 @@ public:
   virtual Renderer& begin_color(const Color4f& color) = 0;
   virtual Renderer& end_color();
 
-  Renderer& begin_add_blend();
-  Renderer& end_blend();
+  virtual Renderer& begin_add_blend();
+  virtual Renderer& end_blend();
 
   virtual Renderer& begin_tex(const Texture& tex) = 0;
   virtual Renderer& end_tex() = 0;
@@ -242,11 +260,37 @@ public:
   virtual void compile_quad_buffer(GLuint id,int index,const QuadBufferData& data) = 0;
   virtual void draw_quad_buffer(GLuint id,int index) = 0;
 
+  /**
+   * A quad batch stores many quads (in world space) in one buffer, so that they can be drawn with one call,
+   * instead of one call (and model matrix update) per quad buffer.
+   */
+  virtual GLuint gen_quad_batch() = 0;
+  virtual void delete_quad_batch(GLuint id) = 0;
+  /**
+   * Replaces all of the quads in the batch.
+   */
+  virtual void compile_quad_batch(GLuint id,const std::vector<QuadBufferData>& quads) = 0;
+  /**
+   * Draws `count` quads starting at `first`, all with the texture of the `first` quad,
+   * so the quads should be grouped by texture when compiled.
+   */
+  virtual void draw_quad_batch(GLuint id,int first,int count) = 0;
+
   void set_font_color(const std::string& name,const Color4f& color);
+  /**
+   * If disabled, the quads of 2D scenes are drawn right away, in the order that they were drawn,
+   *     instead of being recorded & sorted (e.g., for comparing the draw calls).
+   */
+  void set_cmd_sorting(bool enabled);
+  void reset_state_counters();
 
   const ViewDimens& dimens() const;
   const Color4f& clear_color() const;
   Color4f* font_color(const std::string& name);
+  /**
+   * The OpenGL calls of state changes that were issued vs elided (since they were the same state).
+   */
+  const GlStateCache::Counters& state_counters() const;
 
 protected:
   ViewDimens dimens_{};
@@ -255,27 +299,78 @@ protected:
   float aspect_scale_ = 1.0f;
   Pos2f offset_{0.0f,0.0f};
   Color4f clear_color_{};
+  GlStateCache gl_state_{};
 
   Color4f curr_color_{1.0f};
   // This would be safer as a shared_ptr, but I think fine,
   //     as it would require refactoring all of the methods & callers.
   const Texture* curr_tex_ = nullptr;
 
+  /**
+   * Sets up the common OpenGL state.
+   * Must be called by the subclass's ctor (if it uses OpenGL), since it's not called here.
+   */
+  void init_context();
+  void resize_dimens(const Size2i& size);
+
+  /**
+   * The subclass calls these in begin_2d_scene() & begin_3d_scene(),
+   *     if it implements draw_cmd_quads() & restore_cmd_state().
+   */
+  void begin_recording_cmds();
+  void end_recording_cmds();
+  /**
+   * Draws the recorded commands in batches of the same texture & blend, and then clears them.
+   * Called on flush(), so the subclass must flush before any state that the commands don't store changes
+   *     (e.g., the model matrix).
+   */
+  void submit_cmds();
+
+  /**
+   * The subclass's begin_color(), begin_tex(), end_tex(), & draw_quad() must call these first,
+   *     and return right away if they return true (recorded, so nothing to draw yet).
+   */
+  bool record_color(const Color4f& color);
+  bool record_tex(GLuint handle); // 0 for no texture.
+  bool record_quad(const Pos4f& src,const Pos3i& pos,const Size2i& size);
+
+  /**
+   * Draws quads that have the same texture (`cmds[0].tex_handle`) & blend (already set),
+   *     each with its own color.
+   */
+  virtual void draw_cmd_quads(const RenderCommandBuffer::Command* cmds,std::size_t count);
+  /**
+   * Sets the color & texture back to the current (recorded) states, after drawing the commands.
+   */
+  virtual void restore_cmd_state(const Color4f& color,GLuint tex_handle);
+  /**
+   * Called with the factors of each blend that's applied (after flushing),
+   *     such as for each batch of commands.
+   */
+  virtual void apply_blend_func(GLenum src_factor,GLenum dst_factor);
+
 private:
   struct BlendMode {
+    std::uint8_t id = 0; // For RenderCommandBuffer.
     GLenum src_factor{};
     GLenum dst_factor{};
   };
 
-  static constexpr BlendMode kDefaultBlendMode{GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA};
-  static constexpr BlendMode kAddBlendMode{GL_ONE,GL_ONE};
+  static constexpr BlendMode kDefaultBlendMode{0,GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA};
+  static constexpr BlendMode kAddBlendMode{1,GL_ONE,GL_ONE};
 
   BlendMode curr_blend_mode_ = kDefaultBlendMode;
   std::unordered_map<std::string,Color4f> font_colors_{};
 
-  void init_context();
+  bool is_cmd_sorting_ = true;
+  bool is_recording_cmds_ = false;
+  RenderCommandBuffer cmds_{};
+
+  static const BlendMode& blend_mode(std::uint8_t id);
 
   Renderer& begin_blend(const BlendMode& mode);
+  void apply_blend(const BlendMode& mode);
+  void apply_cmd_state();
 
   Renderer& wrap_tex(const Texture& tex,const WrapCallback& callback);
 };
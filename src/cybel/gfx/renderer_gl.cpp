@@ -12,10 +12,14 @@
 #include "cybel/types/cybel_error.h"
 #include "cybel/util/util.h"
 
+#include <cstdint>
+#include <cstring>
+
 namespace cybel {
 
 RendererGl::RendererGl(const Size2i& size,const Size2i& target_size,const Color4f& clear_color)
   : Renderer(size,target_size,clear_color) {
+  init_context();
   init();
 }
 
@@ -32,6 +36,12 @@ void RendererGl::init() {
   glMatrixMode(GL_MODELVIEW);
   glLoadIdentity();
 
+  quad_stream_.init();
+
+  for(auto& quad_batch : quad_batches_) {
+    if(quad_batch) { quad_batch->init(); }
+  }
+
   const auto error = glGetError();
 
   if(error != GL_NO_ERROR) {
@@ -39,12 +49,37 @@ void RendererGl::init() {
   }
 }
 
+void RendererGl::on_context_lost() {
+  Renderer::on_context_lost();
+  quad_stream_.clear();
+  quad_stream_.zombify();
+
+  for(auto& quad_batch : quad_batches_) {
+    if(quad_batch) { quad_batch->zombify(); }
+  }
+}
+
 void RendererGl::on_context_restored() {
   Renderer::on_context_restored();
   init();
 }
 
+void RendererGl::flush() {
+  Renderer::flush(); // Submit the recorded commands (if any) into the quad stream.
+
+  if(quad_stream_.empty()) { return; }
+
+  quad_stream_.draw();
+
+  // Drawing with the color array leaves the current color undefined, which the quad buffers & batches use.
+  gl_state_.invalidate_color();
+  gl_state_.color(color_);
+}
+
 Renderer& RendererGl::begin_2d_scene() {
+  end_recording_cmds();
+  flush(); // Before the matrices change.
+
   glMatrixMode(GL_PROJECTION);
   glLoadIdentity();
 
@@ -53,10 +88,15 @@ Renderer& RendererGl::begin_2d_scene() {
   glMatrixMode(GL_MODELVIEW);
   glLoadIdentity();
 
+  begin_recording_cmds();
+
   return *this;
 }
 
 Renderer& RendererGl::begin_3d_scene() {
+  end_recording_cmds();
+  flush(); // Before the matrices change.
+
   glMatrixMode(GL_PROJECTION);
   glLoadIdentity();
 
@@ -70,56 +110,62 @@ Renderer& RendererGl::begin_3d_scene() {
 }
 
 Renderer& RendererGl::begin_color(const Color4f& color) {
-  glColor4f(color.r,color.g,color.b,color.a);
+  if(record_color(color)) { return *this; }
+
+  // No flush, since the streamed quads store the color.
+  // The current color is still set for the quad buffers & batches.
+  color_ = color;
+  gl_state_.color(color);
 
   return *this;
 }
 
 Renderer& RendererGl::begin_tex(const Texture& tex) {
-  glEnable(GL_TEXTURE_2D);
-  glBindTexture(GL_TEXTURE_2D,tex.handle());
+  if(record_tex(tex.handle())) { return *this; }
+
+  bind_tex(tex.handle());
 
   return *this;
 }
 
 Renderer& RendererGl::end_tex() {
-  glBindTexture(GL_TEXTURE_2D,0); // Unbind.
+  if(record_tex(0)) { return *this; }
+
+  bind_tex(0); // Unbind.
   // glDisable(GL_TEXTURE_2D);
 
   return *this;
 }
 
-Renderer& RendererGl::draw_quad(const Pos3i& pos,const Size2i& size) {
-  const auto [x1,y1,x2,y2,z] = build_dest_pos5f(pos,size);
+void RendererGl::bind_tex(GLuint handle) {
+  // Usually the same texture for many quads in a row (e.g., runes of a font).
+  if(handle != tex_handle_) { flush(); }
 
-  glBegin(GL_QUADS);
-    glVertex3f(x1,y1,z);
-    glVertex3f(x2,y1,z);
-    glVertex3f(x2,y2,z);
-    glVertex3f(x1,y2,z);
-  glEnd();
+  // GL_TEXTURE_2D is enabled in init() & never disabled.
+  tex_handle_ = handle;
+  gl_state_.bind_tex(handle);
+}
 
-  return *this;
+Renderer& RendererGl::draw_quad(const Pos3i& pos,const Size2i& size) {
+  return draw_quad(kDefaultSrc,pos,size);
 }
 
 Renderer& RendererGl::draw_quad(const Pos4f& src,const Pos3i& pos,const Size2i& size) {
-  const auto [x1,y1,x2,y2,z] = build_dest_pos5f(pos,size);
+  if(record_quad(src,pos,size)) { return *this; }
+  if(quad_stream_.is_full()) { flush(); }
 
-  glBegin(GL_QUADS);
-    glTexCoord2f(src.x1,src.y1); glVertex3f(x1,y1,z);
-    glTexCoord2f(src.x2,src.y1); glVertex3f(x2,y1,z);
-    glTexCoord2f(src.x2,src.y2); glVertex3f(x2,y2,z);
-    glTexCoord2f(src.x1,src.y2); glVertex3f(x1,y2,z);
-  glEnd();
+  quad_stream_.add(src,build_dest_pos5f(pos,size),color_);
 
   return *this;
 }
 
 void RendererGl::translate_model_matrix(const Pos3f& pos) {
+  flush(); // The recorded commands use the current matrix.
   glTranslatef(pos.x,pos.y,pos.z);
 }
 
 void RendererGl::rotate_model_matrix(float angle,const Pos3f& axis) {
+  flush();
   glRotatef(angle,axis.x,axis.y,axis.z);
 }
 
@@ -130,6 +176,7 @@ void RendererGl::push_model_matrix() {
 }
 
 void RendererGl::pop_model_matrix() {
+  flush();
   glPopMatrix();
 }
 
@@ -148,21 +195,327 @@ void RendererGl::compile_quad_buffer(GLuint id,int index,const QuadBufferData& d
 
     glBegin(GL_QUADS);
       glNormal3f(data.normal.x,data.normal.y,data.normal.z);
-      glTexCoord2f(0.0f,0.0f);
+      glTexCoord2f(data.src.x1,data.src.y1);
       glVertex3f(data.vertices[0].x,data.vertices[0].y,data.vertices[0].z);
-      glTexCoord2f(1.0f,0.0f);
+      glTexCoord2f(data.src.x2,data.src.y1);
       glVertex3f(data.vertices[1].x,data.vertices[1].y,data.vertices[1].z);
-      glTexCoord2f(1.0f,1.0f);
+      glTexCoord2f(data.src.x2,data.src.y2);
       glVertex3f(data.vertices[2].x,data.vertices[2].y,data.vertices[2].z);
-      glTexCoord2f(0.0f,1.0f);
+      glTexCoord2f(data.src.x1,data.src.y2);
       glVertex3f(data.vertices[3].x,data.vertices[3].y,data.vertices[3].z);
     glEnd();
   glEndList();
 }
 
 void RendererGl::draw_quad_buffer(GLuint id,int index) {
+  flush();
   glCallList(id + static_cast<GLuint>(index));
+  gl_state_.invalidate_tex(); // The list binds its own texture.
+}
+
+GLuint RendererGl::gen_quad_batch() {
+  auto batch = std::make_unique<QuadBatch>();
+  batch->init();
+
+  GLuint id = 0;
+
+  for(auto it = free_quad_batch_ids_.begin(); it != free_quad_batch_ids_.end();) {
+    id = *it;
+    it = free_quad_batch_ids_.erase(it);
+
+    if(id > 0 && (id - 1) < quad_batches_.size()) {
+      quad_batches_[id - 1] = std::move(batch);
+      return id;
+    }
+  }
+
+  quad_batches_.push_back(std::move(batch));
+  id = static_cast<GLuint>(quad_batches_.size());
+
+  return id;
+}
+
+void RendererGl::delete_quad_batch(GLuint id) {
+  if(id == 0) { return; }
+
+  const std::size_t index = id - 1;
+
+  if(index >= quad_batches_.size()) { return; }
+
+  quad_batches_[index] = nullptr;
+  free_quad_batch_ids_.insert(id);
+}
+
+void RendererGl::compile_quad_batch(GLuint id,const std::vector<QuadBufferData>& quads) {
+  auto* batch = quad_batch(id);
+
+  if(batch == nullptr) { return; }
+
+  batch->set_data(quads);
+}
+
+void RendererGl::draw_quad_batch(GLuint id,int first,int count) {
+  auto* batch = quad_batch(id);
+
+  if(batch == nullptr || first < 0 || count <= 0 || (first + count) > batch->size()) { return; }
+
+  flush();
+
+  // Same state as compile_quad_buffer().
+  glEnable(GL_TEXTURE_2D);
+  gl_state_.bind_tex(batch->tex_handle(first));
+
+  batch->draw(first,count);
+}
+
+void RendererGl::draw_cmd_quads(const RenderCommandBuffer::Command* cmds,std::size_t count) {
+  bind_tex(cmds[0].tex_handle);
+
+  for(std::size_t i = 0; i < count; ++i) {
+    const auto& cmd = cmds[i];
+
+    if(quad_stream_.is_full()) { flush(); }
+
+    quad_stream_.add(cmd.src,cmd.dest,cmd.color);
+  }
+}
+
+void RendererGl::restore_cmd_state(const Color4f& color,GLuint tex_handle) {
+  color_ = color;
+  gl_state_.color(color);
+  bind_tex(tex_handle);
+}
+
+RendererGl::QuadBatch* RendererGl::quad_batch(GLuint id) {
+  if(id == 0) { return nullptr; }
+
+  const std::size_t index = id - 1;
+
+  if(index >= quad_batches_.size()) { return nullptr; }
+
+  return quad_batches_[index].get();
+}
+
+void RendererGl::QuadStream::init() {
+  // VBOs are core since OpenGL 1.5, but just in case, can fall back to client-side vertex arrays.
+  if(GLEW_VERSION_1_5) {
+    glGenBuffers(1,&vbo_);
+    glBindBuffer(GL_ARRAY_BUFFER,vbo_);
+    // - Stream since the quads are replaced every draw.
+    glBufferData(GL_ARRAY_BUFFER,kBufferByteCount,nullptr,GL_STREAM_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER,0); // Unbind.
+  }
+
+  vbo_offset_ = 0;
+  can_map_unsync_ = GLEW_VERSION_3_0;
+  vertex_data_.reserve(kMaxCount * kQuadDataCount);
+
+  const auto error = glGetError();
+
+  if(error != GL_NO_ERROR) {
+    destroy();
+    throw CybelError{"Failed to init GL QuadStream: ",Util::get_gl_error(error),'.'};
+  }
+}
+
+RendererGl::QuadStream::~QuadStream() noexcept {
+  destroy();
 }
 
+void RendererGl::QuadStream::destroy() noexcept {
+  if(vbo_ != 0) {
+    glDeleteBuffers(1,&vbo_);
+    vbo_ = 0;
+  }
+}
+
+void RendererGl::QuadStream::zombify() {
+  vbo_ = 0;
+  vbo_offset_ = 0;
+}
+
+void RendererGl::QuadStream::draw() {
+  static constexpr GLsizei kRowByteCount = kVertexDataColCount * sizeof(GLfloat);
+
+  if(vertex_data_.empty()) { return; }
+
+  const std::uintptr_t data = upload();
+  const auto vertex_count = static_cast<GLsizei>(vertex_data_.size() / kVertexDataColCount);
+
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glEnableClientState(GL_COLOR_ARRAY);
+
+  glVertexPointer(3,GL_FLOAT,kRowByteCount,reinterpret_cast<const void*>(data));
+  glTexCoordPointer(2,GL_FLOAT,kRowByteCount,reinterpret_cast<const void*>(data + (3 * sizeof(GLfloat))));
+  glColorPointer(4,GL_FLOAT,kRowByteCount,reinterpret_cast<const void*>(data + (5 * sizeof(GLfloat))));
+
+  glDrawArrays(GL_QUADS,0,vertex_count);
+
+  glDisableClientState(GL_COLOR_ARRAY);
+  glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+
+  if(vbo_ != 0) { glBindBuffer(GL_ARRAY_BUFFER,0); } // Unbind.
+
+  clear();
+}
+
+std::uintptr_t RendererGl::QuadStream::upload() {
+  if(vbo_ == 0) { return reinterpret_cast<std::uintptr_t>(vertex_data_.data()); }
+
+  const std::size_t byte_count = vertex_data_.size() * sizeof(GLfloat);
+
+  glBindBuffer(GL_ARRAY_BUFFER,vbo_);
+
+  if((vbo_offset_ + byte_count) > kBufferByteCount) {
+    // Orphan it: the driver gives new storage, while the previous draws finish with the old storage.
+    glBufferData(GL_ARRAY_BUFFER,kBufferByteCount,nullptr,GL_STREAM_DRAW);
+    vbo_offset_ = 0;
+  }
+
+  const auto offset = static_cast<GLintptr>(vbo_offset_);
+  const auto size = static_cast<GLsizeiptr>(byte_count);
+  void* dst = nullptr;
+
+  // Unsynchronized, since this range hasn't been written to since orphaned (so no need to wait on the GPU).
+  if(can_map_unsync_) {
+    dst = glMapBufferRange(GL_ARRAY_BUFFER,offset,size,
+                           GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+  }
+
+  if(dst != nullptr) {
+    std::memcpy(dst,vertex_data_.data(),byte_count);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+  } else {
+    glBufferSubData(GL_ARRAY_BUFFER,offset,size,vertex_data_.data());
+  }
+
+  vbo_offset_ += byte_count;
+
+  return static_cast<std::uintptr_t>(offset);
+}
+
+void RendererGl::QuadStream::clear() {
+  vertex_data_.clear();
+}
+
+void RendererGl::QuadStream::add(const Pos4f& src,const Pos5f& pos,const Color4f& color) {
+  const auto& c = color;
+
+  vertex_data_.insert(vertex_data_.end(),{
+    // Vertex.            TexCoord.       Color.
+    pos.x1,pos.y1,pos.z,  src.x1,src.y1,  c.r,c.g,c.b,c.a,
+    pos.x2,pos.y1,pos.z,  src.x2,src.y1,  c.r,c.g,c.b,c.a,
+    pos.x2,pos.y2,pos.z,  src.x2,src.y2,  c.r,c.g,c.b,c.a,
+    pos.x1,pos.y2,pos.z,  src.x1,src.y2,  c.r,c.g,c.b,c.a,
+  });
+}
+
+bool RendererGl::QuadStream::empty() const { return vertex_data_.empty(); }
+
+bool RendererGl::QuadStream::is_full() const {
+  return vertex_data_.size() >= (kMaxCount * kQuadDataCount);
+}
+
+void RendererGl::QuadBatch::init() {
+  // Same fallback as QuadStream.
+  if(GLEW_VERSION_1_5) { glGenBuffers(1,&vbo_); }
+
+  // If re-initializing (e.g., context restored), re-upload the previous quads.
+  if(!tex_handles_.empty()) { update_data(); }
+
+  const auto error = glGetError();
+
+  if(error != GL_NO_ERROR) {
+    destroy();
+    throw CybelError{"Failed to init GL QuadBatch: ",Util::get_gl_error(error),'.'};
+  }
+}
+
+RendererGl::QuadBatch::~QuadBatch() noexcept {
+  destroy();
+}
+
+void RendererGl::QuadBatch::destroy() noexcept {
+  if(vbo_ != 0) {
+    glDeleteBuffers(1,&vbo_);
+    vbo_ = 0;
+  }
+}
+
+void RendererGl::QuadBatch::zombify() {
+  vbo_ = 0;
+}
+
+void RendererGl::QuadBatch::draw(int first,int count) {
+  static constexpr GLsizei kRowByteCount = kVertexDataColCount * sizeof(GLfloat);
+
+  std::uintptr_t data = 0; // Offset into the VBO.
+
+  if(vbo_ != 0) {
+    glBindBuffer(GL_ARRAY_BUFFER,vbo_);
+  } else {
+    data = reinterpret_cast<std::uintptr_t>(vertex_data_.data());
+  }
+
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+  glEnableClientState(GL_NORMAL_ARRAY);
+
+  glVertexPointer(3,GL_FLOAT,kRowByteCount,reinterpret_cast<const void*>(data));
+  glTexCoordPointer(2,GL_FLOAT,kRowByteCount,reinterpret_cast<const void*>(data + (3 * sizeof(GLfloat))));
+  glNormalPointer(GL_FLOAT,kRowByteCount,reinterpret_cast<const void*>(data + (5 * sizeof(GLfloat))));
+
+  glDrawArrays(GL_QUADS,first * static_cast<GLint>(kVertexDataRowCount),
+               count * static_cast<GLsizei>(kVertexDataRowCount));
+
+  glDisableClientState(GL_NORMAL_ARRAY);
+  glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+
+  if(vbo_ != 0) { glBindBuffer(GL_ARRAY_BUFFER,0); } // Unbind.
+}
+
+void RendererGl::QuadBatch::set_data(const std::vector<QuadBufferData>& quads) {
+  vertex_data_.clear();
+  vertex_data_.reserve(quads.size() * kVertexDataRowCount * kVertexDataColCount);
+  tex_handles_.clear();
+  tex_handles_.reserve(quads.size());
+
+  for(const auto& quad : quads) {
+    const auto* v = quad.vertices;
+    const auto& n = quad.normal;
+    const auto& src = quad.src;
+
+    vertex_data_.insert(vertex_data_.end(),{
+      // Vertex.             TexCoord.       Normal.
+      v[0].x,v[0].y,v[0].z,  src.x1,src.y1,  n.x,n.y,n.z,
+      v[1].x,v[1].y,v[1].z,  src.x2,src.y1,  n.x,n.y,n.z,
+      v[2].x,v[2].y,v[2].z,  src.x2,src.y2,  n.x,n.y,n.z,
+      v[3].x,v[3].y,v[3].z,  src.x1,src.y2,  n.x,n.y,n.z,
+    });
+    tex_handles_.push_back(quad.tex_handle);
+  }
+
+  update_data();
+}
+
+void RendererGl::QuadBatch::update_data() {
+  if(vbo_ == 0) { return; }
+
+  // - Static since a batch is drawn every frame, but only re-compiled when its quads change.
+  glBindBuffer(GL_ARRAY_BUFFER,vbo_);
+  glBufferData(GL_ARRAY_BUFFER,static_cast<GLsizeiptr>(vertex_data_.size() * sizeof(GLfloat)),
+               vertex_data_.data(),GL_STATIC_DRAW);
+  glBindBuffer(GL_ARRAY_BUFFER,0); // Unbind.
+}
+
+GLuint RendererGl::QuadBatch::tex_handle(int index) const {
+  return tex_handles_[static_cast<std::size_t>(index)];
+}
+
+int RendererGl::QuadBatch::size() const { return static_cast<int>(tex_handles_.size()); }
+
 } // namespace cybel
 #endif // CYBEL_RENDERER_GL
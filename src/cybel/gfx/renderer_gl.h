@@ -14,13 +14,20 @@
 
 #include "cybel/gfx/renderer.h"
 
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
 namespace cybel {
 
 class RendererGl final : public Renderer {
 public:
   explicit RendererGl(const Size2i& size,const Size2i& target_size,const Color4f& clear_color);
 
+  void on_context_lost() override;
   void on_context_restored() override;
+  void flush() override;
 
   Renderer& begin_2d_scene() override;
   Renderer& begin_3d_scene() override;
@@ -44,8 +51,123 @@ public:
   void compile_quad_buffer(GLuint id,int index,const QuadBufferData& data) override;
   void draw_quad_buffer(GLuint id,int index) override;
 
+  GLuint gen_quad_batch() override;
+  void delete_quad_batch(GLuint id) override;
+  void compile_quad_batch(GLuint id,const std::vector<QuadBufferData>& quads) override;
+  void draw_quad_batch(GLuint id,int first,int count) override;
+
+protected:
+  void draw_cmd_quads(const RenderCommandBuffer::Command* cmds,std::size_t count) override;
+  void restore_cmd_state(const Color4f& color,GLuint tex_handle) override;
+
 private:
+  /**
+   * Streams 2D quads (see draw_quad()) through a VBO that's used like a ring buffer, to draw them with
+   *     one call, instead of immediate mode (glBegin()/glEnd()) per quad.
+   *
+   * Each draw writes its quads after the previous draw's, and when full, the VBO is orphaned (new storage),
+   *     so that the driver doesn't have to wait on the previous draws.
+   */
+  class QuadStream {
+  public:
+    static constexpr std::size_t kMaxCount = 4096; // Per draw call.
+
+    explicit QuadStream() = default;
+    void init();
+
+    QuadStream(const QuadStream& other) = delete;
+    QuadStream(QuadStream&& other) noexcept = delete;
+    virtual ~QuadStream() noexcept;
+
+    QuadStream& operator=(const QuadStream& other) = delete;
+    QuadStream& operator=(QuadStream&& other) noexcept = delete;
+
+    void zombify();
+    /**
+     * Draws & clears all of the quads.
+     */
+    void draw();
+    void clear();
+
+    void add(const Pos4f& src,const Pos5f& pos,const Color4f& color);
+
+    bool empty() const;
+    bool is_full() const;
+
+  private:
+    static constexpr std::size_t kVertexDataColCount = 9; // Vertex (3), TexCoord (2), & Color (4).
+    static constexpr std::size_t kQuadDataCount = kVertexDataColCount * 4;
+    static constexpr std::size_t kMaxByteCount = kMaxCount * kQuadDataCount * sizeof(GLfloat);
+    static constexpr std::size_t kBufferByteCount = kMaxByteCount * 4; // Room for 4+ draws before orphaning.
+
+    GLuint vbo_ = 0; // If 0 (no VBO support), uses client-side vertex arrays instead.
+    std::size_t vbo_offset_ = 0; // In bytes.
+    bool can_map_unsync_ = false;
+
+    std::vector<GLfloat> vertex_data_{};
+
+    void destroy() noexcept;
+
+    /**
+     * Returns the address of the vertex data for the gl*Pointer() functions:
+     *     the offset into the VBO, or the client-side pointer if no VBO.
+     */
+    std::uintptr_t upload();
+  };
+
+  /**
+   * The quads are uploaded once into a static VBO (see set_data()), instead of a display list,
+   *     since a display list can't draw a sub-range of its quads.
+   */
+  class QuadBatch {
+  public:
+    explicit QuadBatch() = default;
+    void init();
+
+    QuadBatch(const QuadBatch& other) = delete;
+    QuadBatch(QuadBatch&& other) noexcept = delete;
+    virtual ~QuadBatch() noexcept;
+
+    QuadBatch& operator=(const QuadBatch& other) = delete;
+    QuadBatch& operator=(QuadBatch&& other) noexcept = delete;
+
+    void zombify();
+    void draw(int first,int count);
+
+    void set_data(const std::vector<QuadBufferData>& quads);
+
+    GLuint tex_handle(int index) const;
+    int size() const;
+
+  private:
+    static constexpr std::size_t kVertexDataColCount = 8; // Vertex (3), TexCoord (2), & Normal (3).
+    static constexpr std::size_t kVertexDataRowCount = 4;
+
+    GLuint vbo_ = 0; // If 0 (no VBO support), uses client-side vertex arrays instead.
+
+    // Kept to re-upload (e.g., context restored).
+    std::vector<GLfloat> vertex_data_{};
+    std::vector<GLuint> tex_handles_{}; // Per quad.
+
+    void destroy() noexcept;
+
+    void update_data();
+  };
+
+  // The current states, so that the streamed quads are only drawn when the texture changes,
+  //     & so that each quad has its own color (no flush on color change).
+  Color4f color_{1.0f};
+  GLuint tex_handle_ = 0;
+
+  QuadStream quad_stream_{};
+  std::set<GLuint> free_quad_batch_ids_{};
+  std::vector<std::unique_ptr<QuadBatch>> quad_batches_{};
+
   void init();
+
+  void bind_tex(GLuint handle);
+
+  QuadBatch* quad_batch(GLuint id);
 };
 
 } // namespace cybel
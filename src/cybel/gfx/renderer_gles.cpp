@@ -50,15 +50,19 @@ std::string RendererGles::fetch_info_log(GLuint handle,InfoLogType type) {
 
 RendererGles::RendererGles(const Size2i& size,const Size2i& target_size,const Color4f& clear_color)
   : Renderer(size,target_size,clear_color) {
+  init_context();
   init();
 }
 
 void RendererGles::init() {
   init_prog();
-  quad_buffer_.init();
+  quad_instances_.init();
 
   for(auto& quad_bag : quad_buffer_bags_) {
-    quad_bag->init();
+    if(quad_bag) { quad_bag->init(); }
+  }
+  for(auto& quad_batch : quad_batches_) {
+    if(quad_batch) { quad_batch->init(); }
   }
 
   glDepthRangef(0.0f,1.0f);
@@ -83,17 +87,28 @@ void RendererGles::init_prog() {
     layout(location = 0) in vec3 vertex_pos;
     layout(location = 1) in vec2 tex_coord;
 
+    // Per quad instance (the unit quad is mapped onto these), else the defaults (see reset_attribs()).
+    layout(location = 2) in vec4 inst_dest; // x1,y1,x2,y2.
+    layout(location = 3) in float inst_z;
+    layout(location = 4) in vec4 inst_src; // x1,y1,x2,y2.
+    layout(location = 5) in vec4 inst_color;
+
     out vec2 frag_tex_coord;
+    out vec4 frag_color;
 
     void main() {
-        gl_Position = proj_mat * model_mat * vec4(vertex_pos,1.0);
-        frag_tex_coord = tex_coord;
+        vec3 pos = vec3(mix(inst_dest.xy,inst_dest.zw,vertex_pos.xy),vertex_pos.z + inst_z);
+
+        gl_Position = proj_mat * model_mat * vec4(pos,1.0);
+        frag_tex_coord = mix(inst_src.xy,inst_src.zw,tex_coord);
+        frag_color = inst_color;
     }
   )"};
   const Shader frag_shader{GL_FRAGMENT_SHADER,R"(#version 300 es
     precision mediump float; // Best for colors, normals, & general math.
 
     in vec2 frag_tex_coord;
+    in vec4 frag_color;
 
     uniform vec4 color;
     uniform bool use_tex;
@@ -103,20 +118,20 @@ void RendererGles::init_prog() {
 
     void main() {
       if(use_tex) {
-          out_color = texture(tex_2d,frag_tex_coord) * color;
+          out_color = texture(tex_2d,frag_tex_coord) * color * frag_color;
       } else {
-          out_color = color;
+          out_color = color * frag_color;
       }
 
       // This "could" be slightly faster by avoiding branching, but I dunno.
-      //out_color = mix(color,texture(tex_2d,frag_tex_coord) * color,float(use_tex));
+      //out_color = mix(color,texture(tex_2d,frag_tex_coord) * color,float(use_tex)) * frag_color;
     }
   )"};
   GLenum error = GL_NO_ERROR;
 
   prog_.init(vert_shader,frag_shader);
 
-  glUseProgram(prog_.handle());
+  gl_state_.use_program(prog_.handle());
   error = glGetError();
 
   if(error != GL_NO_ERROR) {
@@ -132,6 +147,10 @@ void RendererGles::init_prog() {
   tex_2d_loc_ = glGetUniformLocation(prog_.handle(),"tex_2d");
 
   // Init Vertex & Fragment shaders' vars.
+  // - Only GL_TEXTURE0 is used, so it's only set here.
+  glActiveTexture(GL_TEXTURE0);
+  gl_state_.uniform1i(tex_2d_loc_,0);
+  QuadInstances::reset_attribs();
   RendererGles::end_color();
   RendererGles::end_tex();
 
@@ -148,10 +167,14 @@ void RendererGles::init_prog() {
 void RendererGles::on_context_lost() {
   Renderer::on_context_lost();
   prog_.zombify();
-  quad_buffer_.zombify();
+  quad_instances_.clear();
+  quad_instances_.zombify();
 
   for(auto& quad_bag : quad_buffer_bags_) {
-    quad_bag->zombify();
+    if(quad_bag) { quad_bag->zombify(); }
+  }
+  for(auto& quad_batch : quad_batches_) {
+    if(quad_batch) { quad_batch->zombify(); }
   }
 }
 
@@ -161,7 +184,7 @@ void RendererGles::on_context_restored() {
 }
 
 void RendererGles::resize(const Size2i& size) {
-  Renderer::resize(size);
+  Renderer::resize(size); // Flushes before the viewport changes.
 
   const auto w = static_cast<float>(dimens_.size.w);
   const auto h = static_cast<float>(dimens_.size.h);
@@ -170,52 +193,82 @@ void RendererGles::resize(const Size2i& size) {
   pers_proj_mat_ = glm::perspective(glm::radians(45.0f),w / h,0.01f,5.0f);
 }
 
+void RendererGles::flush() {
+  Renderer::flush(); // Submit the recorded commands (if any) into the quad instances.
+
+  if(quad_instances_.empty()) { return; }
+
+  apply_state(true);
+  quad_instances_.draw();
+}
+
+void RendererGles::apply_state(bool is_instanced) {
+  // Each quad instance has its own color instead.
+  gl_state_.uniform4f(color_loc_,is_instanced ? Color4f{1.0f} : color_);
+  gl_state_.uniform1i(use_tex_loc_,use_tex_ ? GL_TRUE : GL_FALSE);
+
+  // If not using a texture, then whatever is bound is ignored by the shader.
+  if(use_tex_) { gl_state_.bind_tex(tex_handle_); }
+}
+
 Renderer& RendererGles::begin_2d_scene() {
+  end_recording_cmds();
+  flush();
   model_mat_ = kIdentityMat;
 
-  glUniformMatrix4fv(proj_mat_loc_,1,GL_FALSE,value_ptr(ortho_proj_mat_));
-  glUniformMatrix4fv(model_mat_loc_,1,GL_FALSE,value_ptr(model_mat_));
+  gl_state_.uniform_mat4(proj_mat_loc_,value_ptr(ortho_proj_mat_));
+  gl_state_.uniform_mat4(model_mat_loc_,value_ptr(model_mat_));
+
+  begin_recording_cmds();
 
   return *this;
 }
 
 Renderer& RendererGles::begin_3d_scene() {
+  end_recording_cmds();
+  flush();
   model_mat_ = kIdentityMat;
 
-  glUniformMatrix4fv(proj_mat_loc_,1,GL_FALSE,value_ptr(pers_proj_mat_));
-  glUniformMatrix4fv(model_mat_loc_,1,GL_FALSE,value_ptr(model_mat_));
+  gl_state_.uniform_mat4(proj_mat_loc_,value_ptr(pers_proj_mat_));
+  gl_state_.uniform_mat4(model_mat_loc_,value_ptr(model_mat_));
 
   return *this;
 }
 
 Renderer& RendererGles::begin_color(const Color4f& color) {
-  glUniform4f(color_loc_,color.r,color.g,color.b,color.a);
+  if(record_color(color)) { return *this; }
+
+  // No flush, since the quad instances store the color.
+  // The uniform is set on the next draw (see apply_state()).
+  color_ = color;
 
   return *this;
 }
 
 Renderer& RendererGles::begin_tex(const Texture& tex) {
+  if(record_tex(tex.handle())) { return *this; }
+
   return begin_tex(tex.handle());
 }
 
 Renderer& RendererGles::begin_tex(GLuint handle) {
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D,handle);
+  const bool use_tex = (handle != 0);
+
+  // Usually the same texture for many quads in a row (e.g., runes of a font).
+  if(use_tex != use_tex_ || handle != tex_handle_) { flush(); }
 
-  glUniform1i(tex_2d_loc_,0); // GL_TEXTURE0.
-  glUniform1i(use_tex_loc_,GL_TRUE);
+  // Bound on the next draw (see apply_state()),
+  //     so that switching back & forth between draws (e.g., in draw_quad_batch()) isn't issued.
+  use_tex_ = use_tex;
+  tex_handle_ = handle;
 
   return *this;
 }
 
 Renderer& RendererGles::end_tex() {
-  glUniform1i(use_tex_loc_,GL_FALSE);
-  glUniform1i(tex_2d_loc_,0); // GL_TEXTURE0.
-
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D,0); // Unbind.
+  if(record_tex(0)) { return *this; }
 
-  return *this;
+  return begin_tex(0);
 }
 
 Renderer& RendererGles::draw_quad(const Pos3i& pos,const Size2i& size) {
@@ -223,8 +276,11 @@ Renderer& RendererGles::draw_quad(const Pos3i& pos,const Size2i& size) {
 }
 
 Renderer& RendererGles::draw_quad(const Pos4f& src,const Pos3i& pos,const Size2i& size) {
-  quad_buffer_.set_vertex_data(src,build_dest_pos5f(pos,size));
-  quad_buffer_.draw();
+  if(record_quad(src,pos,size)) { return *this; }
+
+  if(quad_instances_.is_full()) { flush(); }
+
+  quad_instances_.add(src,build_dest_pos5f(pos,size),color_);
 
   return *this;
 }
@@ -238,7 +294,8 @@ void RendererGles::rotate_model_matrix(float angle,const Pos3f& axis) {
 }
 
 void RendererGles::update_model_matrix() {
-  glUniformMatrix4fv(model_mat_loc_,1,GL_FALSE,value_ptr(model_mat_));
+  flush();
+  gl_state_.uniform_mat4(model_mat_loc_,value_ptr(model_mat_));
 }
 
 void RendererGles::push_model_matrix() {
@@ -300,21 +357,111 @@ void RendererGles::draw_quad_buffer(GLuint id,int index) {
 
   if(buffer == nullptr) { return; }
 
+  flush();
+
   if(buffer->tex_handle() != 0) {
-    // This is basically `wrap_tex(GLuint)` w/o the overhead.
-    begin_tex(buffer->tex_handle());
+    // This is basically `wrap_tex(GLuint)` w/o the overhead (or issuing the restore).
+    const bool prev_use_tex = use_tex_;
+    const GLuint prev_tex_handle = tex_handle_;
+
+    use_tex_ = true;
+    tex_handle_ = buffer->tex_handle();
+    apply_state(false);
     buffer->draw();
 
-    if(curr_tex_ != nullptr) {
-      begin_tex(*curr_tex_);
-    } else {
-      end_tex();
-    }
+    use_tex_ = prev_use_tex;
+    tex_handle_ = prev_tex_handle;
   } else {
+    apply_state(false);
     buffer->draw();
   }
 }
 
+GLuint RendererGles::gen_quad_batch() {
+  auto batch = std::make_unique<QuadBatch>();
+  batch->init();
+
+  GLuint id = 0;
+
+  for(auto it = free_quad_batch_ids_.begin(); it != free_quad_batch_ids_.end();) {
+    id = *it;
+    it = free_quad_batch_ids_.erase(it);
+
+    if(id > 0 && (id - 1) < quad_batches_.size()) {
+      quad_batches_[id - 1] = std::move(batch);
+      return id;
+    }
+  }
+
+  quad_batches_.push_back(std::move(batch));
+  id = static_cast<GLuint>(quad_batches_.size());
+
+  return id;
+}
+
+void RendererGles::delete_quad_batch(GLuint id) {
+  if(id == 0) { return; }
+
+  const std::size_t index = id - 1;
+
+  if(index >= quad_batches_.size()) { return; }
+
+  quad_batches_[index] = nullptr;
+  free_quad_batch_ids_.insert(id);
+}
+
+void RendererGles::compile_quad_batch(GLuint id,const std::vector<QuadBufferData>& quads) {
+  auto* batch = quad_batch(id);
+
+  if(batch == nullptr) { return; }
+
+  batch->set_data(quads);
+}
+
+void RendererGles::draw_quad_batch(GLuint id,int first,int count) {
+  auto* batch = quad_batch(id);
+
+  if(batch == nullptr || first < 0 || count <= 0 || (first + count) > batch->size()) { return; }
+
+  flush();
+
+  const GLuint tex_handle = batch->tex_handle(first);
+
+  if(tex_handle != 0) {
+    // This is basically `wrap_tex(GLuint)` w/o the overhead (or issuing the restore).
+    const bool prev_use_tex = use_tex_;
+    const GLuint prev_tex_handle = tex_handle_;
+
+    use_tex_ = true;
+    tex_handle_ = tex_handle;
+    apply_state(false);
+    batch->draw(first,count);
+
+    use_tex_ = prev_use_tex;
+    tex_handle_ = prev_tex_handle;
+  } else {
+    apply_state(false);
+    batch->draw(first,count);
+  }
+}
+
+void RendererGles::draw_cmd_quads(const RenderCommandBuffer::Command* cmds,std::size_t count) {
+  begin_tex(cmds[0].tex_handle);
+
+  for(std::size_t i = 0; i < count; ++i) {
+    const auto& cmd = cmds[i];
+
+    if(quad_instances_.is_full()) { flush(); }
+
+    quad_instances_.add(cmd.src,cmd.dest,cmd.color);
+  }
+}
+
+void RendererGles::restore_cmd_state(const Color4f& color,GLuint tex_handle) {
+  color_ = color;
+  begin_tex(tex_handle);
+}
+
 RendererGles::QuadBufferBag* RendererGles::quad_buffer_bag(GLuint id) {
   if(id == 0) { return nullptr; }
 
@@ -333,6 +480,16 @@ RendererGles::QuadBuffer* RendererGles::quad_buffer(GLuint id,int index) {
   return bag->buffer(index);
 }
 
+RendererGles::QuadBatch* RendererGles::quad_batch(GLuint id) {
+  if(id == 0) { return nullptr; }
+
+  const std::size_t index = id - 1;
+
+  if(index >= quad_batches_.size()) { return nullptr; }
+
+  return quad_batches_[index].get();
+}
+
 RendererGles::Shader::Shader(GLenum type,const std::string& src) {
   handle_ = glCreateShader(type);
 
@@ -532,7 +689,7 @@ void RendererGles::QuadBuffer::draw() {
 
 void RendererGles::QuadBuffer::set_data(const QuadBufferData& data) {
   const auto* v = data.vertices;
-  const auto& src = kDefaultSrc;
+  const auto& src = data.src;
 
   tex_handle_ = data.tex_handle;
   vertex_data_ = {
@@ -546,20 +703,6 @@ void RendererGles::QuadBuffer::set_data(const QuadBufferData& data) {
   update_vertex_data();
 }
 
-void RendererGles::QuadBuffer::set_vertex_data(const Pos4f& src,const Pos5f& pos) {
-  const auto [x1,y1,x2,y2,z] = pos;
-
-  vertex_data_ = {
-    // Vertex.  TexCoord.
-    x1,y1,z,    src.x1,src.y1,
-    x2,y1,z,    src.x2,src.y1,
-    x2,y2,z,    src.x2,src.y2,
-    x1,y2,z,    src.x1,src.y2,
-  };
-
-  update_vertex_data();
-}
-
 void RendererGles::QuadBuffer::update_vertex_data() {
   glBindBuffer(GL_ARRAY_BUFFER,vbo_);
   glBufferSubData(GL_ARRAY_BUFFER,0,kVertexDataByteCount,vertex_data_.data());
@@ -597,5 +740,281 @@ RendererGles::QuadBuffer* RendererGles::QuadBufferBag::buffer(int index) {
 
 std::size_t RendererGles::QuadBufferBag::size() const { return buffers_.size(); }
 
+void RendererGles::QuadBatch::init() {
+  static constexpr std::size_t kRowByteCount = kVertexDataColCount * sizeof(GLfloat);
+  static const auto* kTexCoordOffset = reinterpret_cast<const void*>(3 * sizeof(GLfloat));
+
+  // VAO.
+  glGenVertexArrays(1,&vao_);
+  glBindVertexArray(vao_);
+
+  // VBO & EBO (data is set in update_data()).
+  glGenBuffers(1,&vbo_);
+  glBindBuffer(GL_ARRAY_BUFFER,vbo_);
+  glGenBuffers(1,&ebo_);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,ebo_);
+  ebo_quad_count_ = 0;
+
+  // Vertex pos: `layout(location = 0) in vec3 vertex_pos;`.
+  glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,kRowByteCount,0);
+  glEnableVertexAttribArray(0);
+
+  // TexCoord: `layout(location = 1) in vec2 tex_coord;`.
+  glVertexAttribPointer(1,2,GL_FLOAT,GL_FALSE,kRowByteCount,kTexCoordOffset);
+  glEnableVertexAttribArray(1);
+
+  // If re-initializing (e.g., context restored), re-upload the previous quads.
+  if(!tex_handles_.empty()) { update_data(); }
+
+  glBindVertexArray(0); // Unbind VAO.
+
+  const auto error = glGetError();
+
+  if(error != GL_NO_ERROR) {
+    destroy();
+    throw CybelError{"Failed to init GLES QuadBatch: ",Util::get_gl_error(error),'.'};
+  }
+}
+
+RendererGles::QuadBatch::~QuadBatch() noexcept {
+  destroy();
+}
+
+void RendererGles::QuadBatch::destroy() noexcept {
+  if(ebo_ != 0) {
+    glDeleteBuffers(1,&ebo_);
+    ebo_ = 0;
+  }
+  if(vbo_ != 0) {
+    glDeleteBuffers(1,&vbo_);
+    vbo_ = 0;
+  }
+  if(vao_ != 0) {
+    glDeleteVertexArrays(1,&vao_);
+    vao_ = 0;
+  }
+}
+
+void RendererGles::QuadBatch::zombify() {
+  ebo_ = 0;
+  vbo_ = 0;
+  vao_ = 0;
+}
+
+void RendererGles::QuadBatch::draw(int first,int count) {
+  const auto* offset = reinterpret_cast<const void*>(
+    static_cast<std::size_t>(first) * kIndexCount * sizeof(GLuint)
+  );
+
+  glBindVertexArray(vao_);
+  glDrawElements(GL_TRIANGLES,static_cast<GLsizei>(static_cast<std::size_t>(count) * kIndexCount),
+                 GL_UNSIGNED_INT,offset);
+  glBindVertexArray(0); // Unbind VAO.
+}
+
+void RendererGles::QuadBatch::set_data(const std::vector<QuadBufferData>& quads) {
+  vertex_data_.clear();
+  vertex_data_.reserve(quads.size() * kVertexDataRowCount * kVertexDataColCount);
+  tex_handles_.clear();
+  tex_handles_.reserve(quads.size());
+
+  for(const auto& quad : quads) {
+    const auto* v = quad.vertices;
+    const auto& src = quad.src;
+
+    vertex_data_.insert(vertex_data_.end(),{
+      // Vertex.             TexCoord.
+      v[0].x,v[0].y,v[0].z,  src.x1,src.y1,
+      v[1].x,v[1].y,v[1].z,  src.x2,src.y1,
+      v[2].x,v[2].y,v[2].z,  src.x2,src.y2,
+      v[3].x,v[3].y,v[3].z,  src.x1,src.y2,
+    });
+    tex_handles_.push_back(quad.tex_handle);
+  }
+
+  glBindVertexArray(vao_);
+  update_data();
+  glBindVertexArray(0); // Unbind VAO.
+}
+
+void RendererGles::QuadBatch::update_data() {
+  // - Dynamic since a batch is re-compiled whenever its quads change (e.g., a Robot moved).
+  glBindBuffer(GL_ARRAY_BUFFER,vbo_);
+  glBufferData(GL_ARRAY_BUFFER,static_cast<GLsizeiptr>(vertex_data_.size() * sizeof(GLfloat)),
+               vertex_data_.data(),GL_DYNAMIC_DRAW);
+
+  const std::size_t quad_count = tex_handles_.size();
+
+  if(quad_count <= ebo_quad_count_) { return; }
+
+  std::vector<GLuint> indices{};
+  indices.reserve(quad_count * kIndexCount);
+
+  for(GLuint i = 0; i < quad_count; ++i) {
+    const auto v = static_cast<GLuint>(i * kVertexDataRowCount);
+
+    indices.insert(indices.end(),{
+      v + 0,v + 1,v + 2, // Top triangle.
+      v + 2,v + 3,v + 0, // Bottom triangle.
+    });
+  }
+
+  // The EBO is bound to the VAO, so the VAO must be bound by the caller.
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,ebo_);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,static_cast<GLsizeiptr>(indices.size() * sizeof(GLuint)),
+               indices.data(),GL_STATIC_DRAW);
+  ebo_quad_count_ = quad_count;
+}
+
+GLuint RendererGles::QuadBatch::tex_handle(int index) const {
+  return tex_handles_[static_cast<std::size_t>(index)];
+}
+
+int RendererGles::QuadBatch::size() const { return static_cast<int>(tex_handles_.size()); }
+
+void RendererGles::QuadInstances::reset_attribs() {
+  glVertexAttrib4f(2,0.0f,0.0f,1.0f,1.0f); // Dest rect: `layout(location = 2) in vec4 inst_dest;`.
+  glVertexAttrib1f(3,0.0f); // Z: `layout(location = 3) in float inst_z;`.
+  glVertexAttrib4f(4,0.0f,0.0f,1.0f,1.0f); // Src rect: `layout(location = 4) in vec4 inst_src;`.
+  glVertexAttrib4f(5,1.0f,1.0f,1.0f,1.0f); // Color: `layout(location = 5) in vec4 inst_color;`.
+}
+
+void RendererGles::QuadInstances::init() {
+  static constexpr std::size_t kRowByteCount = kVertexDataColCount * sizeof(GLfloat);
+  static constexpr std::size_t kInstanceByteCount = kInstanceDataColCount * sizeof(GLfloat);
+  static const auto* kTexCoordOffset = reinterpret_cast<const void*>(3 * sizeof(GLfloat));
+  static const auto* kZOffset = reinterpret_cast<const void*>(4 * sizeof(GLfloat));
+  static const auto* kSrcOffset = reinterpret_cast<const void*>(5 * sizeof(GLfloat));
+  static const auto* kColorOffset = reinterpret_cast<const void*>(9 * sizeof(GLfloat));
+
+  // VAO.
+  glGenVertexArrays(1,&vao_);
+  glBindVertexArray(vao_);
+
+  // VBO of the unit quad.
+  glGenBuffers(1,&vbo_);
+  glBindBuffer(GL_ARRAY_BUFFER,vbo_);
+  // - Static since `kVertexData` will be modified once and used many times.
+  glBufferData(GL_ARRAY_BUFFER,kVertexData.size() * sizeof(GLfloat),kVertexData.data(),GL_STATIC_DRAW);
+
+  // EBO.
+  glGenBuffers(1,&ebo_);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER,ebo_);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER,kIndices.size() * sizeof(GLuint),kIndices.data(),GL_STATIC_DRAW);
+
+  // Vertex pos: `layout(location = 0) in vec3 vertex_pos;`.
+  glVertexAttribPointer(0,3,GL_FLOAT,GL_FALSE,kRowByteCount,0);
+  glEnableVertexAttribArray(0);
+
+  // TexCoord: `layout(location = 1) in vec2 tex_coord;`.
+  glVertexAttribPointer(1,2,GL_FLOAT,GL_FALSE,kRowByteCount,kTexCoordOffset);
+  glEnableVertexAttribArray(1);
+
+  // VBO of the instances (data is set in draw()).
+  glGenBuffers(1,&instance_vbo_);
+  glBindBuffer(GL_ARRAY_BUFFER,instance_vbo_);
+
+  // Dest rect: `layout(location = 2) in vec4 inst_dest;`.
+  glVertexAttribPointer(2,4,GL_FLOAT,GL_FALSE,kInstanceByteCount,0);
+  glEnableVertexAttribArray(2);
+  glVertexAttribDivisor(2,1); // Per instance, instead of per vertex.
+
+  // Z: `layout(location = 3) in float inst_z;`.
+  glVertexAttribPointer(3,1,GL_FLOAT,GL_FALSE,kInstanceByteCount,kZOffset);
+  glEnableVertexAttribArray(3);
+  glVertexAttribDivisor(3,1);
+
+  // Src rect: `layout(location = 4) in vec4 inst_src;`.
+  glVertexAttribPointer(4,4,GL_FLOAT,GL_FALSE,kInstanceByteCount,kSrcOffset);
+  glEnableVertexAttribArray(4);
+  glVertexAttribDivisor(4,1);
+
+  // Color: `layout(location = 5) in vec4 inst_color;`.
+  glVertexAttribPointer(5,4,GL_FLOAT,GL_FALSE,kInstanceByteCount,kColorOffset);
+  glEnableVertexAttribArray(5);
+  glVertexAttribDivisor(5,1);
+
+  glBindVertexArray(0); // Unbind VAO.
+
+  instance_data_.reserve(kMaxCount * kInstanceDataColCount);
+
+  const auto error = glGetError();
+
+  if(error != GL_NO_ERROR) {
+    destroy();
+    throw CybelError{"Failed to init GLES QuadInstances: ",Util::get_gl_error(error),'.'};
+  }
+}
+
+RendererGles::QuadInstances::~QuadInstances() noexcept {
+  destroy();
+}
+
+void RendererGles::QuadInstances::destroy() noexcept {
+  if(instance_vbo_ != 0) {
+    glDeleteBuffers(1,&instance_vbo_);
+    instance_vbo_ = 0;
+  }
+  if(ebo_ != 0) {
+    glDeleteBuffers(1,&ebo_);
+    ebo_ = 0;
+  }
+  if(vbo_ != 0) {
+    glDeleteBuffers(1,&vbo_);
+    vbo_ = 0;
+  }
+  if(vao_ != 0) {
+    glDeleteVertexArrays(1,&vao_);
+    vao_ = 0;
+  }
+}
+
+void RendererGles::QuadInstances::zombify() {
+  instance_vbo_ = 0;
+  ebo_ = 0;
+  vbo_ = 0;
+  vao_ = 0;
+}
+
+void RendererGles::QuadInstances::draw() {
+  if(instance_data_.empty()) { return; }
+
+  const std::size_t count = instance_data_.size() / kInstanceDataColCount;
+
+  glBindVertexArray(vao_);
+
+  // - Stream since the instances are replaced every draw (which also orphans the previous buffer,
+  //   so that the driver doesn't have to wait on the previous draw).
+  glBindBuffer(GL_ARRAY_BUFFER,instance_vbo_);
+  glBufferData(GL_ARRAY_BUFFER,static_cast<GLsizeiptr>(instance_data_.size() * sizeof(GLfloat)),
+               instance_data_.data(),GL_STREAM_DRAW);
+
+  glDrawElementsInstanced(GL_TRIANGLES,kIndices.size(),GL_UNSIGNED_INT,0,static_cast<GLsizei>(count));
+  glBindVertexArray(0); // Unbind VAO.
+
+  // Drawing with the arrays enabled can leave the current (default) values undefined.
+  reset_attribs();
+  clear();
+}
+
+void RendererGles::QuadInstances::clear() {
+  instance_data_.clear();
+}
+
+void RendererGles::QuadInstances::add(const Pos4f& src,const Pos5f& pos,const Color4f& color) {
+  instance_data_.insert(instance_data_.end(),{
+    pos.x1,pos.y1,pos.x2,pos.y2,
+    pos.z,
+    src.x1,src.y1,src.x2,src.y2,
+    color.r,color.g,color.b,color.a,
+  });
+}
+
+bool RendererGles::QuadInstances::empty() const { return instance_data_.empty(); }
+
+bool RendererGles::QuadInstances::is_full() const {
+  return instance_data_.size() >= (kMaxCount * kInstanceDataColCount);
+}
+
 } // namespace cybel
 #endif // CYBEL_RENDERER_GLES
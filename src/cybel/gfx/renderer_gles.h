@@ -31,6 +31,7 @@ public:
   void on_context_lost() override;
   void on_context_restored() override;
   void resize(const Size2i& size) override;
+  void flush() override;
 
   Renderer& begin_2d_scene() override;
   Renderer& begin_3d_scene() override;
@@ -54,6 +55,15 @@ public:
   void compile_quad_buffer(GLuint id,int index,const QuadBufferData& data) override;
   void draw_quad_buffer(GLuint id,int index) override;
 
+  GLuint gen_quad_batch() override;
+  void delete_quad_batch(GLuint id) override;
+  void compile_quad_batch(GLuint id,const std::vector<QuadBufferData>& quads) override;
+  void draw_quad_batch(GLuint id,int first,int count) override;
+
+protected:
+  void draw_cmd_quads(const RenderCommandBuffer::Command* cmds,std::size_t count) override;
+  void restore_cmd_state(const Color4f& color,GLuint tex_handle) override;
+
 private:
   enum class InfoLogType { kShader,kProgram };
 
@@ -114,7 +124,6 @@ private:
     void draw();
 
     void set_data(const QuadBufferData& data);
-    void set_vertex_data(const Pos4f& src,const Pos5f& pos);
 
     GLuint tex_handle() const;
 
@@ -162,6 +171,108 @@ private:
     std::vector<QuadBuffer> buffers_;
   };
 
+  class QuadBatch {
+  public:
+    explicit QuadBatch() = default;
+    void init();
+
+    QuadBatch(const QuadBatch& other) = delete;
+    QuadBatch(QuadBatch&& other) noexcept = delete;
+    virtual ~QuadBatch() noexcept;
+
+    QuadBatch& operator=(const QuadBatch& other) = delete;
+    QuadBatch& operator=(QuadBatch&& other) noexcept = delete;
+
+    void zombify();
+    void draw(int first,int count);
+
+    void set_data(const std::vector<QuadBufferData>& quads);
+
+    GLuint tex_handle(int index) const;
+    int size() const;
+
+  private:
+    static constexpr std::size_t kVertexDataColCount = 5;
+    static constexpr std::size_t kVertexDataRowCount = 4;
+    static constexpr std::size_t kIndexCount = 6;
+
+    GLuint vao_ = 0;
+    GLuint vbo_ = 0;
+    GLuint ebo_ = 0;
+    std::size_t ebo_quad_count_ = 0; // The indices are the same pattern for every batch, so only grow it.
+
+    std::vector<GLfloat> vertex_data_{};
+    std::vector<GLuint> tex_handles_{}; // Per quad.
+
+    void destroy() noexcept;
+
+    void update_data();
+  };
+
+  /**
+   * Queues 2D quads (see draw_quad()) to draw them all with one instanced call, instead of one call per quad.
+   *
+   * There's only one unit quad (VBO & EBO) that's shared by all instances. Each instance is just its
+   *     dest rect, z, src (texture) rect, & color, which the vertex shader maps the unit quad onto.
+   */
+  class QuadInstances {
+  public:
+    static constexpr std::size_t kMaxCount = 4096; // Per draw call.
+
+    /**
+     * Sets the instance attributes for when their arrays are not enabled (i.e., all other VAOs),
+     * so that the vertex shader leaves the vertices, tex coords, & color as is.
+     */
+    static void reset_attribs();
+
+    explicit QuadInstances() = default;
+    void init();
+
+    QuadInstances(const QuadInstances& other) = delete;
+    QuadInstances(QuadInstances&& other) noexcept = delete;
+    virtual ~QuadInstances() noexcept;
+
+    QuadInstances& operator=(const QuadInstances& other) = delete;
+    QuadInstances& operator=(QuadInstances&& other) noexcept = delete;
+
+    void zombify();
+    /**
+     * Draws & clears all of the instances.
+     */
+    void draw();
+    void clear();
+
+    void add(const Pos4f& src,const Pos5f& pos,const Color4f& color);
+
+    bool empty() const;
+    bool is_full() const;
+
+  private:
+    static constexpr std::size_t kVertexDataColCount = 5;
+    static constexpr std::size_t kInstanceDataColCount = 13; // Dest rect (4), z (1), src (4), & color (4).
+
+    static inline const std::array<GLfloat,kVertexDataColCount * 4> kVertexData = {
+      // Vertex.       TexCoord.
+      0.0f,0.0f,0.0f,  0.0f,0.0f,
+      1.0f,0.0f,0.0f,  1.0f,0.0f,
+      1.0f,1.0f,0.0f,  1.0f,1.0f,
+      0.0f,1.0f,0.0f,  0.0f,1.0f,
+    };
+    static inline const std::array<GLuint,6> kIndices = {
+      0,1,2, // Top triangle.
+      2,3,0, // Bottom triangle.
+    };
+
+    GLuint vao_ = 0;
+    GLuint vbo_ = 0;
+    GLuint ebo_ = 0;
+    GLuint instance_vbo_ = 0;
+
+    std::vector<GLfloat> instance_data_{};
+
+    void destroy() noexcept;
+  };
+
   static constexpr auto kIdentityMat = glm::mat4(1.0f);
 
   Program prog_{};
@@ -173,25 +284,41 @@ private:
   GLint use_tex_loc_ = -1;
   GLint tex_2d_loc_ = -1;
 
+  // The current states, so that the quad instances are only drawn when a state that they use changes,
+  //     & so that the color & texture are only set right before a draw (see apply_state()).
+  Color4f color_{1.0f};
+  GLuint tex_handle_ = 0;
+  bool use_tex_ = false;
+
   glm::mat4 ortho_proj_mat_ = kIdentityMat;
   glm::mat4 pers_proj_mat_ = kIdentityMat;
   glm::mat4 model_mat_ = kIdentityMat;
   std::stack<glm::mat4> model_mats_{};
 
-  QuadBuffer quad_buffer_{};
+  QuadInstances quad_instances_{};
   // `unordered_set` is more efficient, but using `set` as it's better for debugging.
   std::set<GLuint> free_quad_buffer_ids_{};
   std::vector<std::unique_ptr<QuadBufferBag>> quad_buffer_bags_{};
+  std::set<GLuint> free_quad_batch_ids_{};
+  std::vector<std::unique_ptr<QuadBatch>> quad_batches_{};
 
   static std::string fetch_info_log(GLuint handle,InfoLogType type);
 
   void init();
   void init_prog();
 
+  /**
+   * If `handle` is 0, then no texture is used (same as end_tex()).
+   */
   Renderer& begin_tex(GLuint handle);
+  /**
+   * Sets the (lazy) color & texture states right before a draw, through the state cache.
+   */
+  void apply_state(bool is_instanced);
 
   QuadBufferBag* quad_buffer_bag(GLuint id);
   QuadBuffer* quad_buffer(GLuint id,int index);
+  QuadBatch* quad_batch(GLuint id);
 };
 
 } // namespace cybel
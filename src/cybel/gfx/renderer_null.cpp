@@ -0,0 +1,420 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "renderer_null.h"
+
+#include <iomanip>
+
+namespace cybel {
+
+RendererNull::Counters& RendererNull::Counters::operator+=(const Counters& other) {
+  frames += other.frames;
+  draw_calls += other.draw_calls;
+  quads += other.quads;
+  state_changes += other.state_changes;
+  redundant_state_changes += other.redundant_state_changes;
+
+  for(std::size_t i = 0; i < kCommandTypeCount; ++i) {
+    commands[i] += other.commands[i];
+  }
+
+  return *this;
+}
+
+std::string_view RendererNull::command_name(CommandType type) {
+  switch(type) {
+    case CommandType::kClearView: return "clear_view";
+    case CommandType::kBegin2dScene: return "begin_2d_scene";
+    case CommandType::kBegin3dScene: return "begin_3d_scene";
+    case CommandType::kBeginColor: return "begin_color";
+    case CommandType::kBeginAddBlend: return "begin_add_blend";
+    case CommandType::kEndBlend: return "end_blend";
+    case CommandType::kBeginTex: return "begin_tex";
+    case CommandType::kEndTex: return "end_tex";
+    case CommandType::kDrawQuad: return "draw_quad";
+    case CommandType::kDrawQuadStream: return "draw_quad_stream";
+    case CommandType::kTranslateModelMatrix: return "translate_model_matrix";
+    case CommandType::kRotateModelMatrix: return "rotate_model_matrix";
+    case CommandType::kUpdateModelMatrix: return "update_model_matrix";
+    case CommandType::kPushModelMatrix: return "push_model_matrix";
+    case CommandType::kPopModelMatrix: return "pop_model_matrix";
+    case CommandType::kGenQuadBuffers: return "gen_quad_buffers";
+    case CommandType::kDeleteQuadBuffers: return "delete_quad_buffers";
+    case CommandType::kCompileQuadBuffer: return "compile_quad_buffer";
+    case CommandType::kDrawQuadBuffer: return "draw_quad_buffer";
+    case CommandType::kGenQuadBatch: return "gen_quad_batch";
+    case CommandType::kDeleteQuadBatch: return "delete_quad_batch";
+    case CommandType::kCompileQuadBatch: return "compile_quad_batch";
+    case CommandType::kDrawQuadBatch: return "draw_quad_batch";
+  }
+
+  return "unknown";
+}
+
+RendererNull::RendererNull(const Size2i& size,const Size2i& target_size,const Color4f& clear_color)
+  : Renderer(size,target_size,clear_color) {
+  std::cout << "[INFO] Using the null renderer (no OpenGL calls)." << std::endl;
+}
+
+void RendererNull::on_context_restored() {}
+
+void RendererNull::resize(const Size2i& size) {
+  flush(); // Before the viewport changes.
+  resize_dimens(size);
+}
+
+void RendererNull::clear_view() {
+  flush();
+  record(CommandType::kClearView);
+}
+
+void RendererNull::flush() {
+  Renderer::flush(); // Submit the recorded commands (if any) into the stream.
+
+  if(streamed_quad_count_ == 0) { return; }
+
+  record_draw(CommandType::kDrawQuadStream,tex_handle_,0,static_cast<int>(streamed_quad_count_));
+  streamed_quad_count_ = 0;
+}
+
+Renderer& RendererNull::begin_2d_scene() {
+  end_recording_cmds();
+  flush(); // Before the matrices change.
+
+  // The matrices are always set, so never redundant.
+  record_state(CommandType::kBegin2dScene,false);
+
+  begin_recording_cmds();
+
+  return *this;
+}
+
+Renderer& RendererNull::begin_3d_scene() {
+  end_recording_cmds();
+  flush(); // Before the matrices change.
+
+  record_state(CommandType::kBegin3dScene,false);
+
+  return *this;
+}
+
+Renderer& RendererNull::begin_color(const Color4f& color) {
+  if(record_color(color)) {
+    record(CommandType::kBeginColor);
+    return *this;
+  }
+
+  // No flush, since the streamed quads store the color.
+  record_state(CommandType::kBeginColor,color == color_);
+  color_ = color;
+
+  return *this;
+}
+
+Renderer& RendererNull::begin_tex(const Texture& tex) {
+  if(record_tex(tex.handle())) {
+    record(CommandType::kBeginTex,tex.handle());
+    return *this;
+  }
+
+  bind_tex(tex.handle());
+
+  return *this;
+}
+
+Renderer& RendererNull::end_tex() {
+  if(record_tex(0)) {
+    record(CommandType::kEndTex);
+    return *this;
+  }
+
+  bind_tex(0); // Unbind.
+
+  return *this;
+}
+
+void RendererNull::bind_tex(GLuint handle) {
+  if(handle != tex_handle_) { flush(); }
+
+  record_state((handle != 0) ? CommandType::kBeginTex : CommandType::kEndTex,handle == tex_handle_,handle);
+  tex_handle_ = handle;
+}
+
+Renderer& RendererNull::draw_quad(const Pos3i& pos,const Size2i& size) {
+  return draw_quad(kDefaultSrc,pos,size);
+}
+
+Renderer& RendererNull::draw_quad(const Pos4f& src,const Pos3i& pos,const Size2i& size) {
+  // Only logged, since drawn on submit or flush (see kDrawQuadStream).
+  if(!record_quad(src,pos,size)) {
+    if(streamed_quad_count_ >= kMaxStreamedQuads) { flush(); }
+
+    ++streamed_quad_count_;
+  }
+
+  record(CommandType::kDrawQuad,0,0,1);
+
+  return *this;
+}
+
+void RendererNull::translate_model_matrix(const Pos3f& /*pos*/) {
+  flush(); // The recorded commands use the current matrix.
+  record(CommandType::kTranslateModelMatrix);
+}
+
+void RendererNull::rotate_model_matrix(float /*angle*/,const Pos3f& /*axis*/) {
+  flush();
+  record(CommandType::kRotateModelMatrix);
+}
+
+void RendererNull::update_model_matrix() { record(CommandType::kUpdateModelMatrix); }
+
+void RendererNull::push_model_matrix() { record(CommandType::kPushModelMatrix); }
+
+void RendererNull::pop_model_matrix() {
+  flush();
+  record(CommandType::kPopModelMatrix);
+}
+
+GLuint RendererNull::gen_quad_buffers(int count) {
+  const GLuint id = next_quad_buffers_id_;
+
+  next_quad_buffers_id_ += static_cast<GLuint>(std::max(count,0));
+  record(CommandType::kGenQuadBuffers,id,0,count);
+
+  return id;
+}
+
+void RendererNull::delete_quad_buffers(GLuint id,int count) {
+  record(CommandType::kDeleteQuadBuffers,id,0,count);
+}
+
+void RendererNull::compile_quad_buffer(GLuint id,int index,const QuadBufferData& /*data*/) {
+  record(CommandType::kCompileQuadBuffer,id,index,1);
+}
+
+void RendererNull::draw_quad_buffer(GLuint id,int index) {
+  flush();
+
+  // Each quad buffer binds its own texture (see RendererGl::compile_quad_buffer()).
+  record_draw(CommandType::kDrawQuadBuffer,id,index,1);
+  ++frame_counters_.state_changes;
+}
+
+GLuint RendererNull::gen_quad_batch() {
+  GLuint id = 0;
+
+  if(!free_quad_batch_ids_.empty()) {
+    id = *free_quad_batch_ids_.begin();
+    free_quad_batch_ids_.erase(free_quad_batch_ids_.begin());
+  } else {
+    quad_batch_sizes_.push_back(0);
+    id = static_cast<GLuint>(quad_batch_sizes_.size());
+  }
+
+  record(CommandType::kGenQuadBatch,id);
+
+  return id;
+}
+
+void RendererNull::delete_quad_batch(GLuint id) {
+  if(id == 0 || id > quad_batch_sizes_.size()) { return; }
+
+  quad_batch_sizes_[id - 1] = 0;
+  free_quad_batch_ids_.insert(id);
+  record(CommandType::kDeleteQuadBatch,id);
+}
+
+void RendererNull::compile_quad_batch(GLuint id,const std::vector<QuadBufferData>& quads) {
+  if(id == 0 || id > quad_batch_sizes_.size()) { return; }
+
+  quad_batch_sizes_[id - 1] = quads.size();
+  record(CommandType::kCompileQuadBatch,id,0,static_cast<int>(quads.size()));
+}
+
+void RendererNull::draw_quad_batch(GLuint id,int first,int count) {
+  // Same checks as the real renderers, so that the counts match.
+  if(id == 0 || id > quad_batch_sizes_.size() || first < 0 || count <= 0 ||
+     static_cast<std::size_t>(first + count) > quad_batch_sizes_[id - 1]) {
+    return;
+  }
+
+  flush();
+
+  // Binds the texture of the first quad.
+  record_draw(CommandType::kDrawQuadBatch,id,first,count);
+  ++frame_counters_.state_changes;
+}
+
+void RendererNull::draw_cmd_quads(const RenderCommandBuffer::Command* cmds,std::size_t count) {
+  bind_tex(cmds[0].tex_handle);
+
+  for(std::size_t i = 0; i < count; ++i) {
+    if(streamed_quad_count_ >= kMaxStreamedQuads) { flush(); }
+
+    ++streamed_quad_count_;
+  }
+}
+
+void RendererNull::restore_cmd_state(const Color4f& color,GLuint tex_handle) {
+  record_state(CommandType::kBeginColor,color == color_);
+  color_ = color;
+  bind_tex(tex_handle);
+}
+
+void RendererNull::apply_blend_func(GLenum src_factor,GLenum dst_factor) {
+  const auto blend_type = (src_factor == GL_ONE && dst_factor == GL_ONE) ? BlendType::kAdd
+                                                                          : BlendType::kDefault;
+
+  record_state((blend_type == BlendType::kAdd) ? CommandType::kBeginAddBlend : CommandType::kEndBlend,
+               blend_type == blend_type_);
+  blend_type_ = blend_type;
+}
+
+void RendererNull::record(CommandType type,GLuint id,int index,int count) {
+  ++frame_counters_.commands[static_cast<std::size_t>(type)];
+
+  if(is_log_enabled_) {
+    commands_.push_back(Command{.type = type,.id = id,.index = index,.count = count});
+  }
+}
+
+void RendererNull::record_draw(CommandType type,GLuint id,int index,int count) {
+  record(type,id,index,count);
+
+  ++frame_counters_.draw_calls;
+  frame_counters_.quads += static_cast<std::size_t>(count);
+}
+
+void RendererNull::record_state(CommandType type,bool is_redundant,GLuint id) {
+  record(type,id);
+
+  if(is_redundant) {
+    ++frame_counters_.redundant_state_changes;
+  } else {
+    ++frame_counters_.state_changes;
+  }
+}
+
+void RendererNull::end_frame(int tag) {
+  frame_counters_.frames = 1;
+
+  total_counters_ += frame_counters_;
+  tag_counters_[tag] += frame_counters_;
+  prev_frame_counters_ = frame_counters_;
+
+  check_budget(tag);
+
+  frame_counters_ = Counters{};
+  commands_.clear();
+}
+
+void RendererNull::print_stats(std::ostream& out,const TagNamer& tag_namer) const {
+  const auto print_counters = [&](std::string_view name,const Counters& counters) {
+    const auto frames = static_cast<double>(std::max(counters.frames,std::size_t{1}));
+
+    out << "[INFO]   " << std::left << std::setw(16) << name << std::right
+        << " frames [" << counters.frames << ']'
+        << std::fixed << std::setprecision(1)
+        << ", per frame: draw calls [" << (static_cast<double>(counters.draw_calls) / frames)
+        << "], quads [" << (static_cast<double>(counters.quads) / frames)
+        << "], state changes [" << (static_cast<double>(counters.state_changes) / frames)
+        << "], redundant [" << (static_cast<double>(counters.redundant_state_changes) / frames)
+        << "].\n";
+  };
+
+  out << "[INFO] Null renderer stats:\n";
+  print_counters("total",total_counters_);
+
+  for(const auto& [tag,counters] : tag_counters_) {
+    print_counters(tag_namer ? tag_namer(tag) : std::to_string(tag),counters);
+  }
+
+  out << "[INFO]   Commands per frame:\n";
+
+  const auto frames = static_cast<double>(std::max(total_counters_.frames,std::size_t{1}));
+
+  for(std::size_t i = 0; i < kCommandTypeCount; ++i) {
+    if(total_counters_.commands[i] == 0) { continue; }
+
+    out << "[INFO]     " << std::left << std::setw(24) << command_name(static_cast<CommandType>(i)) << std::right
+        << std::fixed << std::setprecision(1) << std::setw(12)
+        << (static_cast<double>(total_counters_.commands[i]) / frames) << '\n';
+  }
+
+  out << std::flush;
+}
+
+void RendererNull::print_budget_misses(std::ostream& out,const TagNamer& tag_namer) const {
+  const auto print_counter = [&](std::string_view name,std::size_t count,std::size_t max) {
+    if(max > 0 && count > max) { out << ' ' << name << " [" << count << "] > [" << max << "]"; }
+  };
+
+  for(const auto& miss : budget_misses_) {
+    out << "[ERROR] Over budget on frame [" << miss.frame << "] of ["
+        << (tag_namer ? tag_namer(miss.tag) : std::to_string(miss.tag)) << "]:";
+    print_counter("draw calls",miss.counters.draw_calls,miss.budget.draw_calls);
+    print_counter("quads",miss.counters.quads,miss.budget.quads);
+    print_counter("state changes",miss.counters.state_changes,miss.budget.state_changes);
+    out << ".\n";
+  }
+
+  if(budget_miss_count_ > budget_misses_.size()) {
+    out << "[ERROR] ... & [" << (budget_miss_count_ - budget_misses_.size())
+        << "] more frames over budget.\n";
+  }
+
+  out << std::flush;
+}
+
+void RendererNull::set_budget(int tag,const Budget& budget) { budgets_[tag] = budget; }
+
+void RendererNull::check_budget(int tag) {
+  auto it = budgets_.find(tag);
+
+  if(it == budgets_.end()) {
+    it = budgets_.find(kAnyTag);
+    if(it == budgets_.end()) { return; }
+  }
+
+  const auto& budget = it->second;
+  const auto is_over = [](std::size_t count,std::size_t max) { return max > 0 && count > max; };
+
+  if(!is_over(frame_counters_.draw_calls,budget.draw_calls) &&
+     !is_over(frame_counters_.quads,budget.quads) &&
+     !is_over(frame_counters_.state_changes,budget.state_changes)) {
+    return;
+  }
+
+  ++budget_miss_count_;
+
+  if(budget_misses_.size() < kMaxBudgetMisses) {
+    budget_misses_.push_back(BudgetMiss{
+      .frame = total_counters_.frames,.tag = tag,.budget = budget,.counters = frame_counters_
+    });
+  }
+}
+
+void RendererNull::set_log_enabled(bool enabled) {
+  is_log_enabled_ = enabled;
+
+  if(!is_log_enabled_) { commands_.clear(); }
+}
+
+const std::vector<RendererNull::Command>& RendererNull::commands() const { return commands_; }
+
+const RendererNull::Counters& RendererNull::frame_counters() const { return frame_counters_; }
+
+const RendererNull::Counters& RendererNull::prev_frame_counters() const { return prev_frame_counters_; }
+
+const RendererNull::Counters& RendererNull::total_counters() const { return total_counters_; }
+
+const std::map<int,RendererNull::Counters>& RendererNull::tag_counters() const { return tag_counters_; }
+
+std::size_t RendererNull::budget_miss_count() const { return budget_miss_count_; }
+
+} // namespace cybel
@@ -0,0 +1,211 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CYBEL_GFX_RENDERER_NULL_H_
+#define CYBEL_GFX_RENDERER_NULL_H_
+
+#include "cybel/common.h"
+
+#include "cybel/gfx/renderer.h"
+
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <string_view>
+#include <vector>
+
+namespace cybel {
+
+/**
+ * Makes no OpenGL calls, so that the scenes can be run without a GPU (see CybelEngine::Config.renderer_type).
+ *
+ * Instead, it records each command of the current frame into a log, along with counters (draw calls,
+ *     state changes, etc.), which can be used to measure & check the cost of drawing a scene.
+ *
+ * The counters are of what RendererGl would submit: the quads of 2D scenes are recorded & sorted like in the
+ *     other renderers (see Renderer.submit_cmds()), and the quads are drawn as one stream per flush, while
+ *     state changes to the same state are only counted as redundant (since GlStateCache elides them).
+ *
+ * Call end_frame() after drawing each frame, which adds the frame's counters to the totals & clears the log.
+ *
+ * Each frame can also be checked against a budget of its tag (see set_budget()), such as for failing a
+ *     headless run when a scene draws with too many state changes.
+ */
+class RendererNull final : public Renderer {
+public:
+  enum class CommandType : std::uint8_t {
+    kClearView,
+    kBegin2dScene,
+    kBegin3dScene,
+    kBeginColor,
+    kBeginAddBlend,
+    kEndBlend,
+    kBeginTex,
+    kEndTex,
+    kDrawQuad,
+    kDrawQuadStream,
+    kTranslateModelMatrix,
+    kRotateModelMatrix,
+    kUpdateModelMatrix,
+    kPushModelMatrix,
+    kPopModelMatrix,
+    kGenQuadBuffers,
+    kDeleteQuadBuffers,
+    kCompileQuadBuffer,
+    kDrawQuadBuffer,
+    kGenQuadBatch,
+    kDeleteQuadBatch,
+    kCompileQuadBatch,
+    kDrawQuadBatch,
+  };
+
+  static constexpr std::size_t kCommandTypeCount = static_cast<std::size_t>(CommandType::kDrawQuadBatch) + 1;
+
+  struct Command {
+    CommandType type{};
+    GLuint id = 0; // Texture handle, or quad buffer/batch ID.
+    int index = 0; // Quad buffer index, or first quad of a batch.
+    int count = 0; // Quads.
+  };
+
+  struct Counters {
+    std::size_t frames = 0;
+    std::size_t draw_calls = 0;
+    std::size_t quads = 0;
+    std::size_t state_changes = 0; // Color, texture, blend, & scene (projection) changes.
+    std::size_t redundant_state_changes = 0; // Set to the same state as before (e.g., same texture).
+    std::size_t commands[kCommandTypeCount]{};
+
+    Counters& operator+=(const Counters& other);
+  };
+
+  /**
+   * Max counters per frame (0 for no limit).
+   */
+  struct Budget {
+    std::size_t draw_calls = 0;
+    std::size_t quads = 0;
+    std::size_t state_changes = 0;
+  };
+
+  using TagNamer = std::function<std::string(int tag)>;
+
+  static constexpr int kAnyTag = std::numeric_limits<int>::min(); // For the budget of tags w/o their own.
+  static constexpr std::size_t kMaxBudgetMisses = 16; // Kept for printing; the rest are only counted.
+
+  static std::string_view command_name(CommandType type);
+
+  explicit RendererNull(const Size2i& size,const Size2i& target_size,const Color4f& clear_color);
+
+  void on_context_restored() override;
+  void resize(const Size2i& size) override;
+  void clear_view() override;
+  void flush() override;
+
+  Renderer& begin_2d_scene() override;
+  Renderer& begin_3d_scene() override;
+
+  Renderer& begin_color(const Color4f& color) override;
+
+  Renderer& begin_tex(const Texture& tex) override;
+  Renderer& end_tex() override;
+
+  Renderer& draw_quad(const Pos3i& pos,const Size2i& size) override;
+  Renderer& draw_quad(const Pos4f& src,const Pos3i& pos,const Size2i& size) override;
+
+  void translate_model_matrix(const Pos3f& pos) override;
+  void rotate_model_matrix(float angle,const Pos3f& axis) override;
+  void update_model_matrix() override;
+  void push_model_matrix() override;
+  void pop_model_matrix() override;
+
+  GLuint gen_quad_buffers(int count) override;
+  void delete_quad_buffers(GLuint id,int count) override;
+  void compile_quad_buffer(GLuint id,int index,const QuadBufferData& data) override;
+  void draw_quad_buffer(GLuint id,int index) override;
+
+  GLuint gen_quad_batch() override;
+  void delete_quad_batch(GLuint id) override;
+  void compile_quad_batch(GLuint id,const std::vector<QuadBufferData>& quads) override;
+  void draw_quad_batch(GLuint id,int first,int count) override;
+
+  /**
+   * Adds the current frame's counters to the totals & to the totals of `tag` (e.g., the scene type),
+   *     and then clears the log for the next frame.
+   */
+  void end_frame(int tag);
+  void print_stats(std::ostream& out,const TagNamer& tag_namer = nullptr) const;
+  /**
+   * Prints an error for each frame that went over its budget (up to kMaxBudgetMisses).
+   */
+  void print_budget_misses(std::ostream& out,const TagNamer& tag_namer = nullptr) const;
+
+  void set_budget(int tag,const Budget& budget);
+
+  /**
+   * If disabled, only the counters are updated (the log is always empty).
+   */
+  void set_log_enabled(bool enabled);
+
+  const std::vector<Command>& commands() const;
+  const Counters& frame_counters() const;
+  const Counters& prev_frame_counters() const;
+  const Counters& total_counters() const;
+  const std::map<int,Counters>& tag_counters() const;
+  std::size_t budget_miss_count() const;
+
+protected:
+  void draw_cmd_quads(const RenderCommandBuffer::Command* cmds,std::size_t count) override;
+  void restore_cmd_state(const Color4f& color,GLuint tex_handle) override;
+  void apply_blend_func(GLenum src_factor,GLenum dst_factor) override;
+
+private:
+  enum class BlendType : std::uint8_t {
+    kDefault,
+    kAdd,
+  };
+
+  static constexpr std::size_t kMaxStreamedQuads = 4096; // Per draw call, like RendererGl.
+
+  struct BudgetMiss {
+    std::size_t frame = 0; // 1-based.
+    int tag = 0;
+    Budget budget{};
+    Counters counters{};
+  };
+
+  bool is_log_enabled_ = true;
+  std::vector<Command> commands_{};
+  Counters frame_counters_{};
+  Counters prev_frame_counters_{};
+  Counters total_counters_{};
+  std::map<int,Counters> tag_counters_{};
+  std::map<int,Budget> budgets_{};
+  std::vector<BudgetMiss> budget_misses_{};
+  std::size_t budget_miss_count_ = 0;
+
+  // To check for redundant state changes.
+  Color4f color_{1.0f};
+  GLuint tex_handle_ = 0;
+  BlendType blend_type_ = BlendType::kDefault;
+
+  std::size_t streamed_quad_count_ = 0; // Drawn on the next flush.
+
+  GLuint next_quad_buffers_id_ = 1;
+  std::vector<std::size_t> quad_batch_sizes_{}; // Quads per batch ID (- 1).
+  std::set<GLuint> free_quad_batch_ids_{};
+
+  void record(CommandType type,GLuint id = 0,int index = 0,int count = 0);
+  void record_draw(CommandType type,GLuint id,int index,int count);
+  void record_state(CommandType type,bool is_redundant,GLuint id = 0);
+  void bind_tex(GLuint handle);
+  void check_budget(int tag);
+};
+
+} // namespace cybel
+#endif
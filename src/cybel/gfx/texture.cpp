@@ -8,6 +8,7 @@
 #include "texture.h"
 
 #include "cybel/types/cybel_error.h"
+#include "cybel/util/tracer.h"
 #include "cybel/util/util.h"
 
 namespace cybel {
@@ -29,6 +30,19 @@ Texture::Texture(Image& img) {
       throw CybelError{"Unsupported Bytes Per Pixel [",static_cast<int>(bypp),"] for image [",img.id(),"]."};
   }
 
+  size_ = img.size();
+
+  if(is_headless_) {
+    handle_ = ++next_headless_handle_;
+    return;
+  }
+
+  const Tracer::Scope trace{"upload_texture","gfx",img.id()};
+
+  // Restore the bound texture after, since the Renderer caches it (see GlStateCache).
+  GLint prev_handle = 0;
+  glGetIntegerv(GL_TEXTURE_BINDING_2D,&prev_handle);
+
   glGenTextures(1,&handle_);
   glBindTexture(GL_TEXTURE_2D,handle_);
 
@@ -56,7 +70,7 @@ Texture::Texture(Image& img) {
   glTexImage2D(GL_TEXTURE_2D,0,GL_RGBA8,img.size().w,img.size().h,0,img_format,img.gl_type(),img.pixels());
   img.unlock();
 
-  glBindTexture(GL_TEXTURE_2D,0); // Unbind texture.
+  glBindTexture(GL_TEXTURE_2D,static_cast<GLuint>(prev_handle));
 
   const GLenum error = glGetError();
 
@@ -70,8 +84,6 @@ Texture::Texture(Image& img) {
     // throw CybelError{"Failed to gen/bind texture for image [",img.id(),"]; error [",error,"]: ",
     //                  Util::get_gl_error(error),'.'};
   }
-
-  size_ = img.size();
 }
 
 Texture::Texture(Image&& img)
@@ -91,6 +103,15 @@ Texture::Texture(const Color4f& color,bool make_weird) {
 
   constexpr int width = 2;
   constexpr int height = 2;
+
+  size_.w = width;
+  size_.h = height;
+
+  if(is_headless_) {
+    handle_ = ++next_headless_handle_;
+    return;
+  }
+
   constexpr std::uint8_t bypp = 4;
   constexpr int size = width * height * bypp;
   GLubyte pixels[size]{};
@@ -102,6 +123,10 @@ Texture::Texture(const Color4f& color,bool make_weird) {
     p[3] = a;
   }
 
+  // Restore the bound texture after, since the Renderer caches it (see GlStateCache).
+  GLint prev_handle = 0;
+  glGetIntegerv(GL_TEXTURE_BINDING_2D,&prev_handle);
+
   glGenTextures(1,&handle_);
   glBindTexture(GL_TEXTURE_2D,handle_);
 
@@ -117,7 +142,7 @@ Texture::Texture(const Color4f& color,bool make_weird) {
 
   glTexImage2D(GL_TEXTURE_2D,0,GL_RGBA8,width,height,0,GL_RGBA,GL_UNSIGNED_BYTE,pixels);
 
-  glBindTexture(GL_TEXTURE_2D,0); // Unbind texture.
+  glBindTexture(GL_TEXTURE_2D,static_cast<GLuint>(prev_handle));
 
   const GLenum error = glGetError();
 
@@ -135,9 +160,6 @@ Texture::Texture(const Color4f& color,bool make_weird) {
     //                  static_cast<int>(b),',',static_cast<int>(a),
     //                  "); error [",error,"]: ",Util::get_gl_error(error),'.'};
   }
-
-  size_.w = width;
-  size_.h = height;
 }
 
 Texture::Texture(Texture&& other) noexcept {
@@ -157,7 +179,8 @@ Texture::~Texture() noexcept {
 
 void Texture::destroy() noexcept {
   if(handle_ != 0) {
-    glDeleteTextures(1,&handle_);
+    if(!is_headless_) { glDeleteTextures(1,&handle_); }
+
     handle_ = 0;
   }
 }
@@ -170,6 +193,10 @@ Texture& Texture::operator=(Texture&& other) noexcept {
 
 void Texture::zombify() { handle_ = 0; }
 
+void Texture::set_headless(bool headless) { is_headless_ = headless; }
+
+bool Texture::is_headless() { return is_headless_; }
+
 GLuint Texture::handle() const { return handle_; }
 
 const Size2i& Texture::size() const { return size_; }
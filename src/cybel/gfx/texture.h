@@ -37,10 +37,20 @@ public:
    */
   void zombify();
 
+  /**
+   * If headless, no OpenGL calls are made (e.g., for RendererNull when there's no GPU),
+   *     and each texture gets a fake (but unique) handle instead.
+   */
+  static void set_headless(bool headless);
+  static bool is_headless();
+
   GLuint handle() const;
   const Size2i& size() const;
 
 private:
+  static inline bool is_headless_ = false;
+  static inline GLuint next_headless_handle_ = 0;
+
   GLuint handle_ = 0;
   Size2i size_{};
 
@@ -99,13 +99,47 @@ void InputMan::use_mouse_as_finger() {
   SDL_SetHint(SDL_HINT_MOUSE_TOUCH_EVENTS,"1");
 }
 
+void InputMan::start_recording(const std::filesystem::path& file,std::uint64_t seed) {
+  player_.reset();
+  recorder_ = std::make_unique<InputRecorder>(file,seed,id_to_state_.size());
+
+  std::cout << "[INFO] Recording input to ['" << file.string() << "']." << std::endl;
+}
+
+std::uint64_t InputMan::start_playback(const std::filesystem::path& file) {
+  auto player = std::make_unique<InputPlayer>(file);
+
+  if(player->state_count() != id_to_state_.size()) {
+    throw CybelError{"Input replay's state count [",player->state_count(),"] doesn't match the input map's [",
+                     id_to_state_.size(),"] in file ['",file.string(),"']."};
+  }
+
+  recorder_.reset();
+  player_ = std::move(player);
+  reset_states();
+
+  std::cout << "[INFO] Replaying input from ['" << file.string() << "'] with seed [" << player_->seed() << "]."
+            << std::endl;
+
+  return player_->seed();
+}
+
+void InputMan::stop_replay() {
+  recorder_.reset();
+  player_.reset();
+}
+
 void InputMan::begin_input() {
   processed_ids_.clear();
+  frame_ids_.clear();
 }
 
 void InputMan::handle_event(const SDL_Event& event,const OnInputEvent& on_input_event) {
   on_input_event_ = on_input_event;
 
+  // The events come from the replay instead.
+  if(player_) { return; }
+
   if(is_fake_joypad_ && emit_fake_joypad_events(event)) { return; }
 
   switch(event.type) {
@@ -151,6 +185,38 @@ void InputMan::handle_event(const SDL_Event& event,const OnInputEvent& on_input_
   }
 }
 
+void InputMan::end_input(std::uint64_t tick) {
+  if(recorder_) { recorder_->record(tick,frame_ids_,id_to_state_); }
+}
+
+void InputMan::play_back(std::uint64_t tick,const OnInputEvent& on_input_event) {
+  if(!player_) { return; }
+
+  on_input_event_ = on_input_event;
+
+  // Catch up on all frames up to this tick, in case of skipped ticks.
+  while(const auto* frame = player_->next_frame(tick)) {
+    // Each recorded frame had its own begin_input(), so the same ID can be emitted again.
+    processed_ids_.clear();
+    id_to_state_ = frame->states;
+
+    for(const auto id : frame->ids) { emit_input_event(id); }
+  }
+
+  if(player_->is_done()) {
+    std::cout << "[INFO] Replay finished at tick [" << tick << "]." << std::endl;
+    player_.reset();
+  }
+}
+
+void InputMan::emit_input_event(input_id_t id) {
+  // Not inserted? (already processed)
+  if(!processed_ids_.insert(id).second) { return; }
+
+  frame_ids_.push_back(id);
+  if(on_input_event_) { on_input_event_(id); }
+}
+
 void InputMan::handle_key_event(const SDL_KeyboardEvent& key) {
   // Should be the same as `key.type == SDL_KEYDOWN`.
   const bool is_pressed = (key.state == SDL_PRESSED);
@@ -164,12 +230,10 @@ void InputMan::handle_key_event(const SDL_KeyboardEvent& key) {
 
     if(is_pressed) {
       for(auto id : fetch_ids(raw_key)) {
-        // Inserted? (not already processed)
-        if(processed_ids_.insert(id).second) { on_input_event_(id); }
+        emit_input_event(id);
       }
       for(auto id : fetch_ids(sym_key)) {
-        // Inserted? (not already processed)
-        if(processed_ids_.insert(id).second) { on_input_event_(id); }
+        emit_input_event(id);
       }
     }
 
@@ -328,10 +392,7 @@ void InputMan::handle_joypad_event(JoypadInput input,bool state) {
   if(!state) { return; } // Don't emit event.
 
   for(auto id : fetch_ids(input)) {
-    // Not inserted? (already processed)
-    if(!processed_ids_.insert(id).second) { continue; }
-
-    on_input_event_(id);
+    emit_input_event(id);
   }
 }
 
@@ -500,10 +561,7 @@ void InputMan::handle_touch_event(JoypadInput input,bool state) {
   if(!state) { return; } // Don't emit event.
 
   for(auto id : fetch_ids(input)) {
-    // Not inserted? (already processed)
-    if(!processed_ids_.insert(id).second) { continue; }
-
-    on_input_event_(id);
+    emit_input_event(id);
   }
 }
 
@@ -563,6 +621,10 @@ const InputIds& InputMan::fetch_ids(JoypadInput input) const {
 
 const std::vector<bool>& InputMan::states() const { return id_to_state_; }
 
+bool InputMan::is_recording() const { return recorder_ != nullptr; }
+
+bool InputMan::is_playing_back() const { return player_ != nullptr; }
+
 InputMan::InputMapper::InputMapper(InputMan& input_man,input_id_t id)
   : input_man_(input_man),id_(id) {}
 
@@ -11,12 +11,15 @@
 #include "cybel/common.h"
 
 #include "cybel/input/game_ctrl.h"
+#include "cybel/input/input_replay.h"
 #include "cybel/input/input_types.h"
 #include "cybel/input/joypad_input.h"
 #include "cybel/input/joystick.h"
 #include "cybel/input/key_input.h"
 
+#include <filesystem>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -24,6 +27,9 @@
 namespace cybel {
 
 /**
+ * Input can be recorded to a file & played back, so that a run (with a fixed seed & timestep)
+ * can be replayed exactly. While playing back, SDL events are ignored.
+ *
  * TODO: Touch (finger) input is not implemented seriously for now, but just for fun,
  *       and it currently relies on the joypad logic.
  */
@@ -60,8 +66,23 @@ public:
   /// TEST: Only use for testing purposes.
   void use_mouse_as_finger();
 
+  void start_recording(const std::filesystem::path& file,std::uint64_t seed);
+  /**
+   * Returns the seed that was recorded.
+   */
+  std::uint64_t start_playback(const std::filesystem::path& file);
+  void stop_replay();
+
   void begin_input();
   void handle_event(const SDL_Event& event,const OnInputEvent& on_input_event);
+  /**
+   * Records the events & states of this frame (if recording), tagged with `tick`.
+   */
+  void end_input(std::uint64_t tick);
+  /**
+   * Sets the states & emits the events that were recorded up to `tick` (if playing back).
+   */
+  void play_back(std::uint64_t tick,const OnInputEvent& on_input_event);
 
   void set_state(const RawKeyInput& key,bool state);
   void set_state(const SymKeyInput& key,bool state);
@@ -71,6 +92,8 @@ public:
   const InputIds& fetch_ids(const SymKeyInput& key) const;
   const InputIds& fetch_ids(JoypadInput input) const;
   const std::vector<bool>& states() const;
+  bool is_recording() const;
+  bool is_playing_back() const;
 
 private:
   // About 24% of range: SDL_JOYSTICK_AXIS_MAX(32'767) * 0.24f
@@ -80,6 +103,10 @@ private:
   std::vector<bool> id_to_state_{};
   std::unordered_set<input_id_t> processed_ids_{};
   OnInputEvent on_input_event_{};
+  std::vector<input_id_t> frame_ids_{};
+
+  std::unique_ptr<InputRecorder> recorder_{};
+  std::unique_ptr<InputPlayer> player_{};
 
   std::unordered_map<RawKeyInput,InputIds,RawKeyInput::Hash> raw_key_to_ids_{};
   std::unordered_map<SymKeyInput,InputIds,SymKeyInput::Hash> sym_key_to_ids_{};
@@ -98,6 +125,7 @@ private:
   void init_joypad();
   void load_joypads();
 
+  void emit_input_event(input_id_t id);
   void handle_key_event(const SDL_KeyboardEvent& key);
   void handle_joystick_device_event(const SDL_JoyDeviceEvent& jdevice);
   void handle_joystick_axis_event(const SDL_JoyAxisEvent& jaxis);
@@ -0,0 +1,170 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "input_replay.h"
+
+#include "cybel/types/cybel_error.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace cybel {
+
+InputRecorder::InputRecorder(const std::filesystem::path& file,std::uint64_t seed,std::size_t state_count)
+  : out_(file,std::ios::binary | std::ios::trunc),prev_states_(state_count,false) {
+  if(!out_) {
+    throw CybelError{"Failed to open input recording file ['",file.string(),"'] for writing."};
+  }
+
+  buf_.insert(buf_.end(),std::begin(InputReplay::kMagic),std::end(InputReplay::kMagic));
+  buf_.push_back(InputReplay::kVersion);
+
+  for(int i = 0; i < 8; ++i) {
+    buf_.push_back(static_cast<std::uint8_t>(seed >> (i * 8)));
+  }
+
+  write_varint(state_count);
+  flush_buf();
+}
+
+void InputRecorder::record(std::uint64_t tick,const std::vector<input_id_t>& ids,const std::vector<bool>& states) {
+  const bool states_changed = (states != prev_states_);
+
+  if(ids.empty() && !states_changed) { return; }
+
+  write_varint(tick - prev_tick_);
+  write_varint((static_cast<std::uint64_t>(ids.size()) << 1) | (states_changed ? 1 : 0));
+
+  for(const auto id : ids) { write_varint(id); }
+
+  if(states_changed) {
+    std::uint8_t bits = 0;
+
+    for(std::size_t i = 0; i < states.size(); ++i) {
+      if(states[i]) { bits |= static_cast<std::uint8_t>(1 << (i % 8)); }
+
+      if((i % 8) == 7 || i == (states.size() - 1)) {
+        buf_.push_back(bits);
+        bits = 0;
+      }
+    }
+
+    prev_states_ = states;
+  }
+
+  prev_tick_ = tick;
+  ++frame_count_;
+
+  flush_buf();
+}
+
+void InputRecorder::write_varint(std::uint64_t value) {
+  while(value >= 0x80) {
+    buf_.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+
+  buf_.push_back(static_cast<std::uint8_t>(value));
+}
+
+void InputRecorder::flush_buf() {
+  out_.write(reinterpret_cast<const char*>(buf_.data()),static_cast<std::streamsize>(buf_.size()));
+  out_.flush(); // Frames are rare (only on change), so keep the file valid in case of a crash.
+  buf_.clear();
+}
+
+std::size_t InputRecorder::frame_count() const { return frame_count_; }
+
+InputPlayer::InputPlayer(const std::filesystem::path& file) {
+  std::ifstream in{file,std::ios::binary};
+
+  if(!in) {
+    throw CybelError{"Failed to open input replay file ['",file.string(),"'] for reading."};
+  }
+
+  data_.assign(std::istreambuf_iterator<char>{in},std::istreambuf_iterator<char>{});
+
+  constexpr std::size_t magic_size = std::size(InputReplay::kMagic);
+
+  if(data_.size() < (magic_size + 1 + 8) ||
+     !std::equal(std::begin(InputReplay::kMagic),std::end(InputReplay::kMagic),data_.begin())) {
+    throw CybelError{"Invalid input replay file ['",file.string(),"']."};
+  }
+
+  pos_ = magic_size;
+
+  if(const auto version = data_[pos_++]; version != InputReplay::kVersion) {
+    throw CybelError{"Unsupported input replay version [",static_cast<int>(version),"] in file ['",file.string(),
+                     "']."};
+  }
+
+  for(int i = 0; i < 8; ++i) {
+    seed_ |= static_cast<std::uint64_t>(data_[pos_++]) << (i * 8);
+  }
+
+  frame_.states.assign(static_cast<std::size_t>(read_varint()),false);
+  has_frame_ = read_frame();
+}
+
+const InputReplay::Frame* InputPlayer::next_frame(std::uint64_t tick) {
+  if(!has_frame_ || frame_.tick > tick) { return nullptr; }
+
+  // Hand out a copy, since the next frame is read ahead into frame_.
+  curr_frame_ = frame_;
+  has_frame_ = read_frame();
+
+  return &curr_frame_;
+}
+
+bool InputPlayer::read_frame() {
+  if(pos_ >= data_.size()) { return false; }
+
+  frame_.tick += read_varint();
+
+  const std::uint64_t flags = read_varint();
+  const bool states_changed = (flags & 1) != 0;
+
+  frame_.ids.resize(static_cast<std::size_t>(flags >> 1));
+
+  for(auto& id : frame_.ids) {
+    id = static_cast<input_id_t>(read_varint());
+  }
+
+  if(states_changed) {
+    for(std::size_t i = 0; i < frame_.states.size(); ++i) {
+      if(pos_ >= data_.size()) { return false; }
+
+      frame_.states[i] = ((data_[pos_] >> (i % 8)) & 1) != 0;
+
+      if((i % 8) == 7 || i == (frame_.states.size() - 1)) { ++pos_; }
+    }
+  }
+
+  return true;
+}
+
+std::uint64_t InputPlayer::read_varint() {
+  std::uint64_t value = 0;
+
+  for(int shift = 0; pos_ < data_.size() && shift < 64; shift += 7) {
+    const std::uint8_t byte = data_[pos_++];
+
+    value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+
+    if((byte & 0x80) == 0) { break; }
+  }
+
+  return value;
+}
+
+bool InputPlayer::is_done() const { return !has_frame_; }
+
+std::uint64_t InputPlayer::seed() const { return seed_; }
+
+std::size_t InputPlayer::state_count() const { return frame_.states.size(); }
+
+} // namespace cybel
@@ -0,0 +1,107 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CYBEL_INPUT_INPUT_REPLAY_H_
+#define CYBEL_INPUT_INPUT_REPLAY_H_
+
+#include "cybel/common.h"
+
+#include "cybel/input/input_types.h"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace cybel {
+
+/**
+ * Binary format of an input replay (all ints are unsigned LEB128 varints):
+ *   Header:
+ *     - Magic "CYBI" & a version byte.
+ *     - Seed (8 bytes, little endian), so that the game can reproduce its randomness.
+ *     - State count (the size of InputMan.states()).
+ *   Frames (only the frames that had events or changed states):
+ *     - Tick delta since the previous frame.
+ *     - Event count, shifted left by 1, with the lowest bit set if the states changed.
+ *     - Event IDs.
+ *     - States, packed as bits (only if changed).
+ */
+class InputReplay {
+public:
+  static constexpr char kMagic[4] = {'C','Y','B','I'};
+  static constexpr std::uint8_t kVersion = 1;
+
+  class Frame {
+  public:
+    std::uint64_t tick = 0;
+    std::vector<input_id_t> ids{};
+    std::vector<bool> states{};
+  };
+};
+
+class InputRecorder {
+public:
+  explicit InputRecorder(const std::filesystem::path& file,std::uint64_t seed,std::size_t state_count);
+
+  InputRecorder(const InputRecorder& other) = delete;
+  InputRecorder(InputRecorder&& other) noexcept = delete;
+
+  InputRecorder& operator=(const InputRecorder& other) = delete;
+  InputRecorder& operator=(InputRecorder&& other) noexcept = delete;
+
+  /**
+   * Skips the frame if there are no events & the states haven't changed.
+   */
+  void record(std::uint64_t tick,const std::vector<input_id_t>& ids,const std::vector<bool>& states);
+
+  std::size_t frame_count() const;
+
+private:
+  std::ofstream out_{};
+  std::vector<std::uint8_t> buf_{};
+  std::uint64_t prev_tick_ = 0;
+  std::vector<bool> prev_states_{};
+  std::size_t frame_count_ = 0;
+
+  void write_varint(std::uint64_t value);
+  void flush_buf();
+};
+
+class InputPlayer {
+public:
+  explicit InputPlayer(const std::filesystem::path& file);
+
+  InputPlayer(const InputPlayer& other) = delete;
+  InputPlayer(InputPlayer&& other) noexcept = delete;
+
+  InputPlayer& operator=(const InputPlayer& other) = delete;
+  InputPlayer& operator=(InputPlayer&& other) noexcept = delete;
+
+  /**
+   * Returns the next frame if its tick is <= `tick`, else null (not time yet, or done).
+   * The returned frame is only valid until the next call.
+   */
+  const InputReplay::Frame* next_frame(std::uint64_t tick);
+
+  bool is_done() const;
+  std::uint64_t seed() const;
+  std::size_t state_count() const;
+
+private:
+  std::vector<std::uint8_t> data_{};
+  std::size_t pos_ = 0;
+  std::uint64_t seed_ = 0;
+  InputReplay::Frame frame_{};
+  InputReplay::Frame curr_frame_{};
+  bool has_frame_ = false;
+
+  std::uint64_t read_varint();
+  bool read_frame();
+};
+
+} // namespace cybel
+#endif
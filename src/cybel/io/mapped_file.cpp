@@ -0,0 +1,124 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "mapped_file.h"
+
+#include "cybel/types/cybel_error.h"
+
+#if !defined(CYBEL_PLATFORM_WINDOWS)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace cybel {
+
+#if defined(CYBEL_PLATFORM_WINDOWS)
+
+MappedFile::MappedFile(const std::filesystem::path& file) {
+  file_handle_ = CreateFileW(file.c_str(),GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,NULL);
+
+  if(file_handle_ == INVALID_HANDLE_VALUE) {
+    throw CybelError{"Failed to open file [",file.string(),"] for mapping: error [",GetLastError(),"]."};
+  }
+
+  LARGE_INTEGER file_size{};
+
+  if(!GetFileSizeEx(file_handle_,&file_size)) {
+    destroy();
+    throw CybelError{"Failed to get size of file [",file.string(),"] for mapping."};
+  }
+
+  size_ = static_cast<std::size_t>(file_size.QuadPart);
+  if(size_ == 0) { return; } // Can't map an empty file.
+
+  mapping_handle_ = CreateFileMappingW(file_handle_,NULL,PAGE_READONLY,0,0,NULL);
+
+  if(mapping_handle_ == NULL) {
+    destroy();
+    throw CybelError{"Failed to map file [",file.string(),"]: error [",GetLastError(),"]."};
+  }
+
+  data_ = static_cast<const std::byte*>(MapViewOfFile(mapping_handle_,FILE_MAP_READ,0,0,0));
+
+  if(data_ == nullptr) {
+    destroy();
+    throw CybelError{"Failed to map view of file [",file.string(),"]: error [",GetLastError(),"]."};
+  }
+}
+
+void MappedFile::destroy() noexcept {
+  if(data_ != nullptr) {
+    UnmapViewOfFile(data_);
+    data_ = nullptr;
+  }
+  if(mapping_handle_ != NULL) {
+    CloseHandle(mapping_handle_);
+    mapping_handle_ = NULL;
+  }
+  if(file_handle_ != INVALID_HANDLE_VALUE) {
+    CloseHandle(file_handle_);
+    file_handle_ = INVALID_HANDLE_VALUE;
+  }
+
+  size_ = 0;
+}
+
+#else // POSIX
+
+MappedFile::MappedFile(const std::filesystem::path& file) {
+  const int fd = open(file.c_str(),O_RDONLY);
+
+  if(fd == -1) { throw CybelError{"Failed to open file [",file.string(),"] for mapping."}; }
+
+  struct stat file_stat{};
+
+  if(fstat(fd,&file_stat) == -1) {
+    close(fd);
+    throw CybelError{"Failed to get size of file [",file.string(),"] for mapping."};
+  }
+
+  size_ = static_cast<std::size_t>(file_stat.st_size);
+
+  if(size_ == 0) { // Can't map an empty file.
+    close(fd);
+    return;
+  }
+
+  void* data = mmap(nullptr,size_,PROT_READ,MAP_PRIVATE,fd,0);
+  close(fd); // The mapping keeps its own reference.
+
+  if(data == MAP_FAILED) {
+    size_ = 0;
+    throw CybelError{"Failed to map file [",file.string(),"]."};
+  }
+
+  data_ = static_cast<const std::byte*>(data);
+}
+
+void MappedFile::destroy() noexcept {
+  if(data_ != nullptr) {
+    munmap(const_cast<std::byte*>(data_),size_);
+    data_ = nullptr;
+  }
+
+  size_ = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile() noexcept {
+  destroy();
+}
+
+std::span<const std::byte> MappedFile::bytes() const { return std::span<const std::byte>{data_,size_}; }
+
+std::size_t MappedFile::size() const { return size_; }
+
+} // namespace cybel
@@ -0,0 +1,51 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CYBEL_IO_MAPPED_FILE_H_
+#define CYBEL_IO_MAPPED_FILE_H_
+
+#include "cybel/common.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace cybel {
+
+/**
+ * Read-only memory map of a whole file, so that it can be used in place without reading/parsing it.
+ *
+ * An empty file maps to an empty span.
+ */
+class MappedFile {
+public:
+  explicit MappedFile(const std::filesystem::path& file);
+
+  MappedFile(const MappedFile& other) = delete;
+  MappedFile(MappedFile&& other) noexcept = delete;
+  virtual ~MappedFile() noexcept;
+
+  MappedFile& operator=(const MappedFile& other) = delete;
+  MappedFile& operator=(MappedFile&& other) noexcept = delete;
+
+  std::span<const std::byte> bytes() const;
+  std::size_t size() const;
+
+private:
+  const std::byte* data_ = nullptr;
+  std::size_t size_ = 0;
+
+#if defined(CYBEL_PLATFORM_WINDOWS)
+  HANDLE file_handle_ = INVALID_HANDLE_VALUE;
+  HANDLE mapping_handle_ = NULL;
+#endif
+
+  void destroy() noexcept;
+};
+
+} // namespace cybel
+#endif
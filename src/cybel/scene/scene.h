@@ -32,6 +32,24 @@ public:
 
   virtual void init_scene([[maybe_unused]] const ViewDimens& dimens) {}
 
+  /**
+   * If the scene's SceneBag has `load_in_bg` set, then SceneMan calls this on a worker thread
+   *     after building the scene, while the current scene keeps running.
+   * Only do CPU work in here (e.g., parsing files), nothing with GL (e.g., Renderer or Texture)
+   *     nor with anything that the current scene might change.
+   *
+   * Throw a CybelError to cancel the scene change.
+   */
+  virtual void load_scene_bg() {}
+
+  /**
+   * Called on the main thread once per frame after load_scene_bg(), until it returns true,
+   *     for GL work that can be split up over frames (e.g., uploading a chunk at a time).
+   *
+   * Throw a CybelError to cancel the scene change.
+   */
+  virtual bool load_scene_gl() { return true; }
+
   /**
    * If you know that all of your scenes will only either be in 2D or 3D, then you can call
    *     begin_2d_scene()/begin_3d_scene() in resize_scene(), instead of in the main loop with draw_scene().
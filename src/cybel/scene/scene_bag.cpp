@@ -9,8 +9,8 @@
 
 namespace cybel {
 
-SceneBag::SceneBag(int type,std::shared_ptr<Scene> scene,bool persist)
-  : type(type),scene(std::move(scene)),persist(persist) {}
+SceneBag::SceneBag(int type,std::shared_ptr<Scene> scene,bool persist,bool load_in_bg)
+  : type(type),scene(std::move(scene)),persist(persist),load_in_bg(load_in_bg) {}
 
 SceneBag::operator bool() const { return static_cast<bool>(scene); }
 
@@ -19,9 +19,11 @@ public:
   int type = -1;
   std::shared_ptr<Scene> scene{};
   bool persist = false;
+  bool load_in_bg = false; // See Scene::load_scene_bg().
 
   explicit SceneBag() noexcept = default;
-  explicit SceneBag(int type,std::shared_ptr<Scene> scene = nullptr,bool persist = false);
+  explicit SceneBag(int type,std::shared_ptr<Scene> scene = nullptr,bool persist = false,
+                    bool load_in_bg = false);
 
   explicit operator bool() const;
   Scene* operator->() const;
@@ -8,34 +8,49 @@
 #include "scene_man.h"
 
 #include "cybel/types/cybel_error.h"
+#include "cybel/util/tracer.h"
 
 namespace cybel {
 
-SceneMan::SceneMan(const SceneBuilder& build_scene,const SceneIniter& init_scene)
-  : build_scene_(build_scene),init_scene_(init_scene) {}
+SceneMan::SceneMan(const SceneBuilder& build_scene,const SceneIniter& init_scene,
+                   const LoadErrorHandler& on_load_error)
+  : build_scene_(build_scene),init_scene_(init_scene),on_load_error_(on_load_error) {}
 
 bool SceneMan::push_scene(int type) {
   if(type == Scene::kNilType) { return false; }
 
-  SceneBag scene = build_scene_(type);
+  const Tracer::Scope trace{"push_scene","scene",type};
+  cancel_load();
+
+  SceneBag scene = build_scene(type);
   if(!scene.scene) { return false; }
 
+  if(scene.load_in_bg) { return begin_load(LoadAction::kPush,std::move(scene)); }
+
+  push_built_scene(std::move(scene));
+
+  return true;
+}
+
+void SceneMan::push_built_scene(SceneBag scene_bag) {
   SceneBag prev = curr_scene_bag_;
-  set_scene(std::move(scene));
+  set_scene(std::move(scene_bag));
 
   // Don't push kEmptySceneBag.
   if(prev.type != Scene::kNilType) {
     if(!prev.persist) { prev.scene = nullptr; }
     prev_scene_bags_.push_back(std::move(prev));
   }
-
-  return true;
 }
 
 bool SceneMan::pop_scene() {
+  cancel_load();
+
   // Avoid setting scene to kEmptySceneBag over & over.
   if(prev_scene_bags_.empty()) { return false; }
 
+  const Tracer::Scope trace{"pop_scene","scene"};
+
   do {
     SceneBag prev = std::move(prev_scene_bags_.back());
     prev_scene_bags_.pop_back();
@@ -44,8 +59,9 @@ bool SceneMan::pop_scene() {
 
     // Not persisted? (i.e., need to recreate)
     if(!prev.scene) {
-      prev = build_scene_(prev.type);
+      prev = build_scene(prev.type);
       if(!prev.scene) { continue; }
+      if(prev.load_in_bg) { return begin_load(LoadAction::kPop,std::move(prev)); }
     }
 
     set_scene(std::move(prev));
@@ -58,6 +74,8 @@ bool SceneMan::pop_scene() {
 }
 
 void SceneMan::pop_all_scenes() {
+  cancel_load();
+
   if(prev_scene_bags_.empty()) { return; }
 
   prev_scene_bags_.clear();
@@ -65,23 +83,155 @@ void SceneMan::pop_all_scenes() {
 }
 
 bool SceneMan::restart_scene() {
-  SceneBag scene_bag = build_scene_(curr_scene_bag_.type);
+  const Tracer::Scope trace{"restart_scene","scene",curr_scene_bag_.type};
+  cancel_load();
+
+  SceneBag scene_bag = build_scene(curr_scene_bag_.type);
   if(!scene_bag.scene) { return false; }
 
+  if(scene_bag.load_in_bg) { return begin_load(LoadAction::kRestart,std::move(scene_bag)); }
+
   set_scene(std::move(scene_bag));
 
   return true;
 }
 
+bool SceneMan::update_load() {
+  // Destroy the canceled scenes on the main thread, once their worker threads are done.
+  std::erase_if(canceled_loads_,[](const auto& load) {
+    return load.bg_result.wait_for(std::chrono::seconds{0}) != std::future_status::timeout;
+  });
+
+  if(!load_) { return false; }
+
+  const Scene* scene = load_->scene_bag.scene.get();
+  step_load();
+
+  return curr_scene_bag_.scene.get() == scene;
+}
+
+void SceneMan::cancel_load() {
+  if(!load_) { return; }
+
+  end_load_trace(*load_);
+
+  // Still running? Then can't wait on it here, else the frame would freeze.
+  if(load_->bg_result.valid() &&
+     load_->bg_result.wait_for(std::chrono::seconds{0}) == std::future_status::timeout) {
+    canceled_loads_.push_back(std::move(*load_));
+  }
+
+  load_.reset();
+}
+
+void SceneMan::set_load_in_bg(bool load_in_bg) { load_in_bg_ = load_in_bg; }
+
+SceneBag SceneMan::build_scene(int type) {
+  const Tracer::Scope trace{"build_scene","scene",type};
+
+  return build_scene_(type);
+}
+
+bool SceneMan::begin_load(LoadAction action,SceneBag scene_bag) {
+  auto& tracer = Tracer::it();
+  Load& load = load_.emplace(Load{.action = action,.scene_bag = std::move(scene_bag)});
+
+  if(tracer.is_enabled()) {
+    load.trace_id = tracer.next_id();
+    tracer.async_begin("load_scene","scene",load.trace_id,std::to_string(load.scene_bag.type));
+  }
+
+#if defined(__EMSCRIPTEN__)
+  const auto policy = std::launch::deferred; // No threads, so runs on the first step_load() instead.
+#else
+  // Deferred is a fallback for if a thread can't be created.
+  const auto policy = load_in_bg_ ? (std::launch::async | std::launch::deferred) : std::launch::deferred;
+#endif
+
+  // Not the shared_ptr, so that the scene is always destroyed on the main thread.
+  Scene* scene = load.scene_bag.scene.get();
+
+  load.bg_result = std::async(policy,[scene,type = load.scene_bag.type] {
+    const Tracer::Scope trace{"load_scene_bg","scene",type};
+    scene->load_scene_bg();
+  });
+
+  if(load_in_bg_) { return true; }
+
+  while(!step_load()) {}
+
+  return curr_scene_bag_.scene.get() == scene;
+}
+
+bool SceneMan::step_load() {
+  Load& load = *load_;
+
+  try {
+    if(!load.is_bg_done) {
+      if(load.bg_result.wait_for(std::chrono::seconds{0}) == std::future_status::timeout) { return false; }
+
+      load.bg_result.get(); // Runs it now if deferred & rethrows any exception.
+      load.is_bg_done = true;
+    }
+
+    const Tracer::Scope trace{"load_scene_gl","scene",load.scene_bag.type};
+    if(!load.scene_bag->load_scene_gl()) { return false; }
+  } catch(const CybelError& e) {
+    const int type = load.scene_bag.type;
+
+    end_load_trace(load);
+    load_.reset();
+    on_load_error_(type,e.what());
+
+    return true;
+  }
+
+  Load done = std::move(load);
+  load_.reset();
+  end_load_trace(done);
+
+  if(done.action == LoadAction::kPush) {
+    push_built_scene(std::move(done.scene_bag));
+  } else {
+    set_scene(std::move(done.scene_bag));
+  }
+
+  return true;
+}
+
+void SceneMan::end_load_trace(const Load& load) {
+  if(load.trace_id != 0) { Tracer::it().async_end("load_scene","scene",load.trace_id); }
+}
+
 void SceneMan::set_scene(SceneBag scene_bag) {
   if(!scene_bag.scene) { throw CybelError{"Scene is null."}; }
 
+  const Tracer::Scope trace{"set_scene","scene",scene_bag.type};
+  auto& tracer = Tracer::it();
+
   curr_scene_bag_->on_scene_exit();
 
+  if(trace_id_ != 0) {
+    tracer.async_end("scene","scene",trace_id_);
+    trace_id_ = 0;
+  }
+
   curr_scene_bag_ = std::move(scene_bag);
   init_scene_(*curr_scene_bag_.scene);
+
+  if(tracer.is_enabled()) {
+    trace_id_ = tracer.next_id();
+    trace_flow_id_ = tracer.next_id();
+
+    tracer.async_begin("scene","scene",trace_id_,std::to_string(curr_scene_bag_.type));
+    tracer.flow_begin("scene_change","scene",trace_flow_id_);
+  }
 }
 
+bool SceneMan::is_loading() const { return load_.has_value(); }
+
+std::uint64_t SceneMan::take_trace_flow_id() { return std::exchange(trace_flow_id_,0); }
+
 Scene& SceneMan::curr_scene() const { return *curr_scene_bag_.scene; }
 
 int SceneMan::curr_scene_type() const { return curr_scene_bag_.type; }
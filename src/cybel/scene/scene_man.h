@@ -14,14 +14,23 @@
 #include "cybel/scene/scene_bag.h"
 
 #include <functional>
+#include <future>
 #include <vector>
 
 namespace cybel {
 
+/**
+ * If a built SceneBag has `load_in_bg` set, then the scene change is split into two phases,
+ *     so that a slow scene (e.g., a big map) doesn't drop frames:
+ * 1. Scene::load_scene_bg() is called on a worker thread (except on the Web).
+ * 2. Scene::load_scene_gl() is called on the main thread in update_load(), once per frame, until done.
+ * In the meantime, the current scene keeps running. Any other scene change cancels the load.
+ */
 class SceneMan {
 public:
   using SceneBuilder = std::function<SceneBag(int type)>;
   using SceneIniter = std::function<void(Scene&)>;
+  using LoadErrorHandler = std::function<void(int type,const std::string& error)>;
 
   static inline const SceneBag kEmptySceneBag{
     Scene::kNilType,
@@ -29,24 +38,81 @@ public:
     true,
   };
 
-  explicit SceneMan(const SceneBuilder& build_scene,const SceneIniter& init_scene);
+  explicit SceneMan(const SceneBuilder& build_scene,const SceneIniter& init_scene,
+                    const LoadErrorHandler& on_load_error);
+
+  SceneMan(const SceneMan& other) = delete;
+  SceneMan(SceneMan&& other) noexcept = delete;
+  virtual ~SceneMan() noexcept = default;
+
+  SceneMan& operator=(const SceneMan& other) = delete;
+  SceneMan& operator=(SceneMan&& other) noexcept = delete;
 
   bool push_scene(int type);
   bool pop_scene();
   void pop_all_scenes();
   bool restart_scene();
 
+  /**
+   * Continues loading the next scene (if any), & changes to it when done.
+   * Call this once per frame on the main thread.
+   *
+   * Returns true if the scene changed.
+   */
+  bool update_load();
+  void cancel_load();
+
+  /**
+   * If false, the next scene is loaded right away, on the main thread (e.g., for replays,
+   *     which need the scene to change on the same tick).
+   */
+  void set_load_in_bg(bool load_in_bg);
+
+  /**
+   * Returns the ID of the flow (for Tracer) of the last scene change that hasn't been drawn yet, else 0.
+   */
+  std::uint64_t take_trace_flow_id();
+
+  bool is_loading() const;
   Scene& curr_scene() const;
   int curr_scene_type() const;
   std::vector<SceneBag>& prev_scene_bags();
 
 private:
+  enum class LoadAction {
+    kPush,
+    kPop,
+    kRestart,
+  };
+
+  struct Load {
+    LoadAction action = LoadAction::kPush;
+    SceneBag scene_bag{};
+    // Must be after scene_bag, so that it's destroyed first, which waits for the worker thread.
+    std::future<void> bg_result{};
+    bool is_bg_done = false;
+    std::uint64_t trace_id = 0;
+  };
+
   SceneBuilder build_scene_{};
   SceneIniter init_scene_{};
+  LoadErrorHandler on_load_error_{};
 
   SceneBag curr_scene_bag_ = kEmptySceneBag;
   std::vector<SceneBag> prev_scene_bags_{};
 
+  std::optional<Load> load_{};
+  std::vector<Load> canceled_loads_{}; // Still running on a worker thread.
+  bool load_in_bg_ = true;
+
+  std::uint64_t trace_id_ = 0; // Of the current scene's async slice.
+  std::uint64_t trace_flow_id_ = 0;
+
+  SceneBag build_scene(int type);
+  bool begin_load(LoadAction action,SceneBag scene_bag);
+  bool step_load();
+  void end_load_trace(const Load& load);
+  void push_built_scene(SceneBag scene_bag);
   void set_scene(SceneBag scene_bag);
 };
 
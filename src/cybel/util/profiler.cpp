@@ -0,0 +1,266 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "profiler.h"
+
+#include "cybel/types/cybel_error.h"
+
+#include <fstream>
+#include <limits>
+
+namespace cybel {
+
+Profiler::Zone::Zone(zone_id_t id) noexcept
+  : id_(id) {
+  is_enabled_ = Profiler::it().is_enabled_.load(std::memory_order_relaxed);
+
+  if(is_enabled_) { start_time_ = clock_t::now(); }
+}
+
+Profiler::Zone::~Zone() noexcept {
+  if(!is_enabled_) { return; }
+
+  const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - start_time_).count();
+
+  Profiler::it().record(id_,static_cast<std::int64_t>(nanos));
+}
+
+void Profiler::ThreadRing::push(const Event& event) noexcept {
+  const std::size_t h = head.load(std::memory_order_relaxed);
+
+  if((h - tail.load(std::memory_order_acquire)) >= kRingSize) {
+    dropped.fetch_add(1,std::memory_order_relaxed);
+    return;
+  }
+
+  events[h % kRingSize] = event;
+  head.store(h + 1,std::memory_order_release);
+}
+
+Profiler::Samples::Samples(std::string_view name,std::size_t window_size)
+  : name(name) {
+  window.reserve(window_size);
+}
+
+void Profiler::Samples::add(std::int64_t nanos,std::size_t window_size) {
+  if(count == 0) {
+    min_nanos = nanos;
+    max_nanos = nanos;
+  } else {
+    min_nanos = std::min(min_nanos,nanos);
+    max_nanos = std::max(max_nanos,nanos);
+  }
+
+  if(window.size() < window_size) {
+    window.push_back(nanos);
+  } else {
+    window[count % window_size] = nanos;
+  }
+
+  ++count;
+  total_nanos += nanos;
+}
+
+Profiler::Stats Profiler::Samples::to_stats() const {
+  constexpr double kNanosToMs = 1.0 / 1'000'000.0;
+  Stats stats{.name = name,.count = count};
+
+  if(count == 0) { return stats; }
+
+  std::vector<std::int64_t> sorted = window;
+  const auto p99_index = static_cast<std::size_t>(static_cast<double>(sorted.size() - 1) * 0.99);
+
+  std::nth_element(sorted.begin(),sorted.begin() + static_cast<std::ptrdiff_t>(p99_index),sorted.end());
+
+  stats.min_ms = static_cast<double>(min_nanos) * kNanosToMs;
+  stats.avg_ms = static_cast<double>(total_nanos) / static_cast<double>(count) * kNanosToMs;
+  stats.p99_ms = static_cast<double>(sorted[p99_index]) * kNanosToMs;
+  stats.max_ms = static_cast<double>(max_nanos) * kNanosToMs;
+
+  return stats;
+}
+
+Profiler& Profiler::it() {
+  static Profiler it_{};
+
+  return it_;
+}
+
+Profiler::zone_id_t Profiler::zone_id(std::string_view name) {
+  const std::scoped_lock lock{mutex_};
+
+  for(std::size_t i = 0; i < zones_.size(); ++i) {
+    if(zones_[i].name == name) { return static_cast<zone_id_t>(i); }
+  }
+  if(zones_.size() > std::numeric_limits<zone_id_t>::max()) {
+    throw CybelError{"Too many profiler zones to add [",name,"]."};
+  }
+
+  zones_.emplace_back(name,kWindowSize);
+
+  return static_cast<zone_id_t>(zones_.size() - 1);
+}
+
+void Profiler::record(zone_id_t id,std::int64_t nanos) {
+  thread_ring().push(Event{.id = id,.nanos = nanos});
+}
+
+Profiler::ThreadRing& Profiler::thread_ring() {
+  // Shared with rings_, in case the thread exits before the last drain.
+  thread_local std::shared_ptr<ThreadRing> ring{};
+
+  if(!ring) {
+    ring = std::make_shared<ThreadRing>();
+
+    const std::scoped_lock lock{mutex_};
+    rings_.push_back(ring);
+  }
+
+  return *ring;
+}
+
+void Profiler::end_frame() {
+  if(!is_enabled_.load(std::memory_order_relaxed)) { return; }
+
+  const auto now = clock_t::now();
+  const std::scoped_lock lock{mutex_};
+
+  drain_rings();
+
+  if(last_frame_time_ != clock_t::time_point{}) {
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_frame_time_).count();
+    frames_.add(static_cast<std::int64_t>(nanos),kFrameWindowSize);
+  }
+
+  last_frame_time_ = now;
+}
+
+void Profiler::drain_rings() {
+  for(auto& ring : rings_) {
+    const std::size_t head = ring->head.load(std::memory_order_acquire);
+    std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+
+    for(; tail != head; ++tail) {
+      const Event& event = ring->events[tail % kRingSize];
+
+      if(event.id < zones_.size()) { zones_[event.id].add(event.nanos,kWindowSize); }
+    }
+
+    ring->tail.store(tail,std::memory_order_release);
+    dropped_count_ += ring->dropped.exchange(0,std::memory_order_relaxed);
+  }
+
+  // Free the rings of exited threads (only held here), unless an event was pushed after draining it.
+  std::erase_if(rings_,[](const auto& ring) {
+    return ring.use_count() == 1 &&
+           ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire);
+  });
+}
+
+void Profiler::reset() {
+  const std::scoped_lock lock{mutex_};
+
+  drain_rings();
+
+  for(auto& zone : zones_) { zone = Samples{zone.name,kWindowSize}; }
+
+  frames_ = Samples{frames_.name,kFrameWindowSize};
+  last_frame_time_ = clock_t::time_point{};
+  dropped_count_ = 0;
+}
+
+void Profiler::dump_csv(const std::filesystem::path& file) {
+  const auto all_zone_stats = zone_stats();
+  const auto frame_stats = this->frame_stats();
+  const auto histogram = frame_histogram();
+
+  std::ofstream fout{file,std::ios::out | std::ios::trunc};
+
+  if(!fout) { throw CybelError{"Failed to open profile file [",file.string(),"]."}; }
+
+  const auto write_row = [&](std::string_view kind,const Stats& stats) {
+    fout << kind << ',' << stats.name << ',' << stats.count
+         << ',' << stats.min_ms << ',' << stats.avg_ms << ',' << stats.p99_ms << ',' << stats.max_ms << '\n';
+  };
+
+  fout << "kind,name,count,min_ms,avg_ms,p99_ms,max_ms\n";
+
+  for(const auto& stats : all_zone_stats) {
+    if(stats.count > 0) { write_row("zone",stats); }
+  }
+
+  write_row("frame",frame_stats);
+
+  // For the histogram, the name is the bucket's upper bound (ms) & the count is the number of frames.
+  for(std::size_t i = 0; i < histogram.size(); ++i) {
+    fout << "frame_hist,";
+
+    if(i < std::size(kHistogramMaxMs)) {
+      fout << "<=" << kHistogramMaxMs[i];
+    } else {
+      fout << '>' << kHistogramMaxMs[std::size(kHistogramMaxMs) - 1];
+    }
+
+    fout << ',' << histogram[i] << ",,,,\n";
+  }
+
+  fout.flush();
+
+  if(!fout) { throw CybelError{"Failed to write profile file [",file.string(),"]."}; }
+
+  std::cout << "[INFO] Wrote profile [" << file.string() << "] of [" << frame_stats.count << "] frames";
+
+  if(dropped_count_ > 0) { std::cout << ", with [" << dropped_count_ << "] dropped zones"; }
+
+  std::cout << '.' << std::endl;
+}
+
+void Profiler::set_enabled(bool enabled) {
+  is_enabled_.store(enabled,std::memory_order_relaxed);
+
+  if(!enabled) {
+    const std::scoped_lock lock{mutex_};
+    last_frame_time_ = clock_t::time_point{};
+  }
+}
+
+bool Profiler::is_enabled() const { return is_enabled_.load(std::memory_order_relaxed); }
+
+std::vector<Profiler::Stats> Profiler::zone_stats() {
+  const std::scoped_lock lock{mutex_};
+  std::vector<Stats> result{};
+
+  result.reserve(zones_.size());
+
+  for(const auto& zone : zones_) { result.push_back(zone.to_stats()); }
+
+  return result;
+}
+
+Profiler::Stats Profiler::frame_stats() {
+  const std::scoped_lock lock{mutex_};
+
+  return frames_.to_stats();
+}
+
+std::vector<std::size_t> Profiler::frame_histogram() {
+  const std::scoped_lock lock{mutex_};
+  std::vector<std::size_t> result(kHistogramSize,0);
+
+  for(const auto nanos : frames_.window) {
+    const double ms = static_cast<double>(nanos) / 1'000'000.0;
+    std::size_t bucket = 0;
+
+    while(bucket < std::size(kHistogramMaxMs) && ms > kHistogramMaxMs[bucket]) { ++bucket; }
+
+    ++result[bucket];
+  }
+
+  return result;
+}
+
+} // namespace cybel
@@ -0,0 +1,157 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CYBEL_UTIL_PROFILER_H_
+#define CYBEL_UTIL_PROFILER_H_
+
+#include "cybel/common.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace cybel {
+
+/**
+ * Per-frame CPU profiler of scoped zones.
+ *
+ * Each thread records its zones into its own lock-free ring buffer, which are drained on end_frame()
+ *     (called by CybelEngine after each frame) into the stats of each zone.
+ * It does nothing (other than an atomic load) while disabled.
+ *
+ * Usage:
+ *   @code
+ *   static const auto kZoneId = Profiler::it().zone_id("draw_mini_map");
+ *   const Profiler::Zone zone{kZoneId};
+ *   @endcode
+ */
+class Profiler {
+public:
+  using clock_t = std::chrono::steady_clock;
+  using zone_id_t = std::uint16_t;
+
+  class Zone {
+  public:
+    explicit Zone(zone_id_t id) noexcept;
+
+    Zone(const Zone& other) = delete;
+    Zone(Zone&& other) noexcept = delete;
+    ~Zone() noexcept;
+
+    Zone& operator=(const Zone& other) = delete;
+    Zone& operator=(Zone&& other) noexcept = delete;
+
+  private:
+    zone_id_t id_ = 0;
+    bool is_enabled_ = false;
+    clock_t::time_point start_time_{};
+  };
+
+  struct Stats {
+    std::string name{};
+    std::uint64_t count = 0;
+    double min_ms = 0.0;
+    double avg_ms = 0.0;
+    double p99_ms = 0.0; // Of the last kWindowSize samples.
+    double max_ms = 0.0;
+  };
+
+  static constexpr std::size_t kRingSize = 4096; // Per thread; more zones than this per frame are dropped.
+  static constexpr std::size_t kWindowSize = 1024; // Latest samples per zone, for the p99.
+  static constexpr std::size_t kFrameWindowSize = 600; // Latest frame times, for the histogram.
+  static constexpr double kHistogramMaxMs[] = {2.0,4.0,8.0,12.0,16.7,20.0,25.0,33.3,50.0,100.0}; // Then, inf.
+  static constexpr std::size_t kHistogramSize = std::size(kHistogramMaxMs) + 1;
+
+  /**
+   * Global instance.
+   */
+  static Profiler& it();
+
+  Profiler(const Profiler& other) = delete;
+  Profiler(Profiler&& other) noexcept = delete;
+
+  Profiler& operator=(const Profiler& other) = delete;
+  Profiler& operator=(Profiler&& other) noexcept = delete;
+
+  /**
+   * Returns the ID of the zone with `name`, adding it if new.
+   * This locks, so store the ID in a static.
+   */
+  zone_id_t zone_id(std::string_view name);
+
+  /**
+   * Drains the zones of all threads & records the frame time (since the last call).
+   */
+  void end_frame();
+  void reset();
+
+  /**
+   * Writes the stats of each zone & of the frame times (with the histogram of kFrameWindowSize frames).
+   */
+  void dump_csv(const std::filesystem::path& file);
+
+  void set_enabled(bool enabled);
+
+  bool is_enabled() const;
+  std::vector<Stats> zone_stats();
+  Stats frame_stats();
+  std::vector<std::size_t> frame_histogram();
+
+private:
+  struct Event {
+    zone_id_t id = 0;
+    std::int64_t nanos = 0;
+  };
+
+  /**
+   * Single producer (the owner thread), single consumer (end_frame()).
+   */
+  class ThreadRing {
+  public:
+    Event events[kRingSize]{};
+    std::atomic<std::size_t> head{0}; // Only written by the owner thread.
+    std::atomic<std::size_t> tail{0}; // Only written by end_frame().
+    std::atomic<std::uint64_t> dropped{0};
+
+    void push(const Event& event) noexcept;
+  };
+
+  class Samples {
+  public:
+    std::string name{};
+    std::uint64_t count = 0;
+    std::int64_t total_nanos = 0;
+    std::int64_t min_nanos = 0;
+    std::int64_t max_nanos = 0;
+    std::vector<std::int64_t> window{}; // Ring of the latest samples.
+
+    explicit Samples(std::string_view name,std::size_t window_size);
+
+    void add(std::int64_t nanos,std::size_t window_size);
+    Stats to_stats() const;
+  };
+
+  std::atomic<bool> is_enabled_{false};
+  std::mutex mutex_{}; // For the vectors below (not for recording zones).
+  std::vector<std::shared_ptr<ThreadRing>> rings_{};
+  std::vector<Samples> zones_{};
+  Samples frames_{"frame",kFrameWindowSize};
+  clock_t::time_point last_frame_time_{};
+  std::uint64_t dropped_count_ = 0;
+
+  explicit Profiler() = default;
+
+  void record(zone_id_t id,std::int64_t nanos);
+  ThreadRing& thread_ring();
+  void drain_rings();
+};
+
+} // namespace cybel
+#endif
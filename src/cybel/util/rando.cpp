@@ -7,6 +7,8 @@
 
 #include "rando.h"
 
+#include <random>
+
 namespace cybel {
 
 Rando& Rando::it() {
@@ -15,16 +17,104 @@ Rando& Rando::it() {
   return it_;
 }
 
-bool Rando::rand_bool() { return bool_distr_(gen_); }
+std::uint64_t Rando::gen_seed() {
+  std::random_device dev{};
+
+  return (static_cast<std::uint64_t>(dev()) << 32) ^ static_cast<std::uint64_t>(dev());
+}
 
-double Rando::rand_double() { return double_distr_(gen_); }
+std::uint64_t Rando::mix(std::uint64_t x) {
+  // SplitMix64's finalizer.
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
 
-double Rando::rand_double(double max) { return rand_double(0.0,max); }
+  return x ^ (x >> 31);
+}
+
+Rando::Rando()
+  : Rando(gen_seed()) {}
+
+Rando::Rando(std::uint64_t seed) noexcept
+  : key_(mix(seed)) {}
+
+Rando Rando::split(std::uint64_t stream_id) const {
+  Rando stream{0};
+
+  // Mix twice, so that neighboring IDs (e.g., Robot IDs) don't produce related keys.
+  stream.key_ = mix(key_ ^ mix(stream_id + kGolden));
+
+  return stream;
+}
+
+void Rando::seed(std::uint64_t seed) {
+  key_ = mix(seed);
+  counter_ = 0;
+}
+
+Rando::State Rando::state() const { return State{key_,counter_}; }
+
+void Rando::restore(const State& state) {
+  key_ = state.key;
+  counter_ = state.counter;
+}
+
+std::uint64_t Rando::gen_at(std::uint64_t counter) const { return mix(key_ + (counter * kGolden)); }
+
+Rando::result_type Rando::operator()() { return next_u64(); }
+
+std::uint64_t Rando::next_u64() { return gen_at(counter_++); }
+
+std::uint32_t Rando::next_u32() { return static_cast<std::uint32_t>(next_u64() >> 32); }
+
+std::uint64_t Rando::bounded_u64(std::uint64_t bound) {
+  if(bound <= 1) { return 0; }
+  if(bound <= std::numeric_limits<std::uint32_t>::max()) {
+    return bounded_u32(static_cast<std::uint32_t>(bound));
+  }
+
+  // Reject the low numbers that would make the modulo biased.
+  const std::uint64_t threshold = (0 - bound) % bound;
+
+  while(true) {
+    const std::uint64_t x = next_u64();
+
+    if(x >= threshold) { return x % bound; }
+  }
+}
+
+std::uint32_t Rando::bounded_u32(std::uint32_t bound) {
+  // Lemire's multiply-shift, which usually avoids the modulo altogether.
+  std::uint64_t m = static_cast<std::uint64_t>(next_u32()) * bound;
+  auto low = static_cast<std::uint32_t>(m);
+
+  if(low < bound) {
+    const std::uint32_t threshold = (0u - bound) % bound;
 
-double Rando::rand_double(double min,double max) {
-  return double_distr_(gen_,std::uniform_real_distribution<>::param_type(min,max));
+    while(low < threshold) {
+      m = static_cast<std::uint64_t>(next_u32()) * bound;
+      low = static_cast<std::uint32_t>(m);
+    }
+  }
+
+  return static_cast<std::uint32_t>(m >> 32);
+}
+
+double Rando::to_double(std::uint64_t bits) {
+  return static_cast<double>(bits >> 11) * 0x1.0p-53; // 53 bits of mantissa.
 }
 
+float Rando::to_float(std::uint64_t bits) {
+  return static_cast<float>(bits >> 40) * 0x1.0p-24f; // 24 bits of mantissa.
+}
+
+bool Rando::rand_bool() { return (next_u64() >> 63) != 0; }
+
+double Rando::rand_double() { return to_double(next_u64()); }
+
+double Rando::rand_double(double max) { return rand_double(0.0,max); }
+
+double Rando::rand_double(double min,double max) { return min + ((max - min) * rand_double()); }
+
 double Rando::rand_double_vel() { return rand_double() * rand_double_sign(); }
 
 double Rando::rand_double_vel(double max) { return rand_double_vel(0.0,max); }
@@ -33,13 +123,11 @@ double Rando::rand_double_vel(double min,double max) { return rand_double(min,ma
 
 double Rando::rand_double_sign() { return rand_bool() ? 1.0 : -1.0; }
 
-float Rando::rand_float() { return float_distr_(gen_); }
+float Rando::rand_float() { return to_float(next_u64()); }
 
 float Rando::rand_float(float max) { return rand_float(0.0f,max); }
 
-float Rando::rand_float(float min,float max) {
-  return float_distr_(gen_,std::uniform_real_distribution<float>::param_type(min,max));
-}
+float Rando::rand_float(float min,float max) { return min + ((max - min) * rand_float()); }
 
 float Rando::rand_float_vel() { return rand_float() * rand_float_sign(); }
 
@@ -49,12 +137,16 @@ float Rando::rand_float_vel(float min,float max) { return rand_float(min,max) *
 
 float Rando::rand_float_sign() { return rand_bool() ? 1.0f : -1.0f; }
 
-int Rando::rand_int() { return int_distr_(gen_); }
+int Rando::rand_int() { return rand_int(0,100); } // I don't have 99 problems.
 
 int Rando::rand_int(int max) { return rand_int(0,max); }
 
 int Rando::rand_int(int min,int max) {
-  return int_distr_(gen_,std::uniform_int_distribution<>::param_type(min,max - 1));
+  if(max <= min) { return min; }
+
+  const auto range = static_cast<std::uint32_t>(static_cast<std::int64_t>(max) - min);
+
+  return static_cast<int>(static_cast<std::int64_t>(min) + bounded_u32(range));
 }
 
 int Rando::rand_int_vel() { return rand_int() * rand_int_sign(); }
@@ -69,8 +161,46 @@ std::size_t Rando::rand_size_t(std::size_t max) { return rand_size_t(0,max); }
 
 std::size_t Rando::rand_size_t(std::size_t min,std::size_t max) {
   if(max == 0) { return 0; }
+  if(max <= min) { return min; }
+
+  return min + static_cast<std::size_t>(bounded_u64(static_cast<std::uint64_t>(max - min)));
+}
+
+void Rando::fill_floats(std::span<float> out) {
+  const std::uint64_t counter = counter_;
+
+  for(std::size_t i = 0; i < out.size(); ++i) {
+    out[i] = to_float(gen_at(counter + i));
+  }
+
+  counter_ += out.size();
+}
+
+void Rando::fill_floats(std::span<float> out,float min,float max) {
+  const float range = max - min;
+
+  fill_floats(out);
+
+  for(auto& x : out) { x = min + (range * x); }
+}
+
+void Rando::fill_ints(std::span<int> out,int min,int max) {
+  if(max <= min) {
+    std::ranges::fill(out,min);
+    return;
+  }
+
+  const auto range = static_cast<std::uint64_t>(static_cast<std::int64_t>(max) - min);
+  const std::uint64_t counter = counter_;
+
+  // Multiply-shift without rejection for speed; the bias is at most range/2^32, which is negligible here.
+  for(std::size_t i = 0; i < out.size(); ++i) {
+    const std::uint64_t bits = gen_at(counter + i) >> 32;
+
+    out[i] = static_cast<int>(static_cast<std::int64_t>(min) + static_cast<std::int64_t>((bits * range) >> 32));
+  }
 
-  return size_t_distr_(gen_,std::uniform_int_distribution<std::size_t>::param_type(min,max - 1));
+  counter_ += out.size();
 }
 
 } // namespace cybel
@@ -0,0 +1,108 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "tool_util.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace cybel {
+
+bool ToolUtil::parse_path(std::string_view opt,std::string_view str,std::filesystem::path& path) {
+  if(str.empty() || str.starts_with("--")) {
+    std::cerr << "[ERROR] Missing path for option [" << opt << "]." << std::endl;
+    return false;
+  }
+
+  path = str;
+
+  return true;
+}
+
+int ToolUtil::run_jobs(int thread_count,std::size_t job_count,
+                       const std::function<void(std::size_t index)>& run_job) {
+#if defined(__EMSCRIPTEN__)
+  thread_count = 1;
+#else
+  if(thread_count <= 0) { thread_count = static_cast<int>(std::thread::hardware_concurrency()); }
+#endif
+
+  // No more threads than jobs.
+  const auto max_count = std::min(job_count,static_cast<std::size_t>(std::numeric_limits<int>::max()));
+  thread_count = std::clamp(thread_count,1,std::max(static_cast<int>(max_count),1));
+
+  std::atomic<std::size_t> next_job{0};
+  std::mutex error_mutex{};
+  std::exception_ptr error{};
+
+  const auto work = [&] {
+    for(auto i = next_job.fetch_add(1); i < job_count; i = next_job.fetch_add(1)) {
+      try {
+        run_job(i);
+      } catch(...) {
+        const std::scoped_lock lock{error_mutex};
+
+        if(!error) { error = std::current_exception(); }
+        next_job.store(job_count); // Stop the other threads too.
+      }
+    }
+  };
+
+  std::vector<std::thread> threads{};
+  threads.reserve(static_cast<std::size_t>(thread_count - 1));
+
+  for(int i = 1; i < thread_count; ++i) {
+    try {
+      threads.emplace_back(work);
+    } catch(const std::system_error& e) {
+      // Just use the threads that were created.
+      std::cerr << "[WARN] Failed to create thread [" << i << "]: " << e.what() << '.' << std::endl;
+      break;
+    }
+  }
+
+  work(); // This thread is a worker too.
+  for(auto& thread : threads) { thread.join(); }
+
+  if(error) { std::rethrow_exception(error); }
+
+  return static_cast<int>(threads.size()) + 1;
+}
+
+void ToolUtil::write_json_str(std::ostream& out,std::string_view str) {
+  out << '"';
+
+  for(const char c : str) {
+    switch(c) {
+      case '"':  out << "\\\""; break;
+      case '\\': out << "\\\\"; break;
+      case '\n': out << "\\n"; break;
+      case '\r': out << "\\r"; break;
+      case '\t': out << "\\t"; break;
+
+      default:
+        if(static_cast<unsigned char>(c) < 0x20) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+              << std::dec << std::setfill(' ');
+        } else {
+          out << c;
+        }
+        break;
+    }
+  }
+
+  out << '"';
+}
+
+} // namespace cybel
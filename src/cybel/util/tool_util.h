@@ -0,0 +1,78 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CYBEL_UTIL_TOOL_UTIL_H_
+#define CYBEL_UTIL_TOOL_UTIL_H_
+
+#include "cybel/common.h"
+
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+
+namespace cybel {
+
+/**
+ * Shared by the command-line tools (e.g., EkoScapeMapCheck) & the game's command-line args,
+ *     such as for parsing options & writing JSON reports.
+ */
+namespace ToolUtil {
+  /**
+   * Parses all of `str` (the value of option `opt`) into `num`.
+   * If missing or invalid, prints an error & returns false.
+   */
+  template <typename T>
+  bool parse_num(std::string_view opt,std::string_view str,T& num);
+  /**
+   * If `str` (the value of option `opt`) is missing (or is another option), prints an error & returns false.
+   */
+  bool parse_path(std::string_view opt,std::string_view str,std::filesystem::path& path);
+
+  /**
+   * Calls `run_job` for each index in [0,`job_count`) on a pool of `thread_count` threads
+   *     (0 for the number of hardware threads), where each thread takes the next index until none are left,
+   *     so that slow jobs don't hold up the rest. The calling thread is one of the threads.
+   *
+   * If a job throws, no more jobs are started, & the first exception is rethrown after all threads finish.
+   *
+   * Returns the number of threads used (1 on the Web).
+   */
+  int run_jobs(int thread_count,std::size_t job_count,const std::function<void(std::size_t index)>& run_job);
+
+  void write_json_str(std::ostream& out,std::string_view str);
+
+  template <typename Rep,typename Period>
+  double to_ms(const std::chrono::duration<Rep,Period>& duration);
+}
+
+template <typename T>
+bool ToolUtil::parse_num(std::string_view opt,std::string_view str,T& num) {
+  if(str.empty()) {
+    std::cerr << "[ERROR] Missing number for option [" << opt << "]." << std::endl;
+    return false;
+  }
+
+  const auto* end = str.data() + str.size();
+  const auto result = std::from_chars(str.data(),end,num);
+
+  if(result.ec != std::errc{} || result.ptr != end) {
+    std::cerr << "[ERROR] Invalid number [" << str << "] for option [" << opt << "]." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+template <typename Rep,typename Period>
+double ToolUtil::to_ms(const std::chrono::duration<Rep,Period>& duration) {
+  return std::chrono::duration<double,std::milli>(duration).count();
+}
+
+} // namespace cybel
+#endif
@@ -0,0 +1,320 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "tracer.h"
+
+#include "cybel/types/cybel_error.h"
+#include "cybel/util/tool_util.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+namespace cybel {
+
+Tracer::Scope::Scope(std::string_view name,std::string_view cat,std::string_view detail) {
+  auto& tracer = Tracer::it();
+  is_enabled_ = tracer.is_enabled();
+
+  if(is_enabled_) { tracer.begin(name,cat,detail); }
+}
+
+Tracer::Scope::Scope(std::string_view name,std::string_view cat,long long detail) {
+  auto& tracer = Tracer::it();
+  is_enabled_ = tracer.is_enabled();
+
+  if(is_enabled_) { tracer.begin(name,cat,detail); }
+}
+
+Tracer::Scope::~Scope() noexcept {
+  // Must always end if began, even if stopped in between, else the slices won't match up.
+  if(is_enabled_) { Tracer::it().end(); }
+}
+
+void Tracer::ThreadRing::push(const Event& event) noexcept {
+  const std::size_t h = head.load(std::memory_order_relaxed);
+
+  if((h - tail.load(std::memory_order_acquire)) >= kRingSize) {
+    dropped.fetch_add(1,std::memory_order_relaxed);
+    return;
+  }
+
+  events[h % kRingSize] = event;
+  head.store(h + 1,std::memory_order_release);
+}
+
+Tracer& Tracer::it() {
+  static Tracer it_{};
+
+  return it_;
+}
+
+Tracer::~Tracer() noexcept {
+  stop();
+}
+
+void Tracer::start(const std::filesystem::path& file) {
+#if defined(__EMSCRIPTEN__)
+  std::cerr << "[WARN] Tracing is not supported on the Web; ignoring trace file [" << file.string() << "]."
+            << std::endl;
+#else
+  if(is_enabled()) { throw CybelError{"Tracer already started."}; }
+
+  fout_.open(file,std::ios::out | std::ios::trunc);
+  if(!fout_) { throw CybelError{"Failed to open trace file [",file.string(),"]."}; }
+
+  fout_ << std::fixed << std::setprecision(3);
+  fout_ << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  is_first_event_ = true;
+  dropped_count_ = 0;
+
+  {
+    const std::scoped_lock lock{mutex_};
+
+    // Discard any events from after the last stop (e.g., the end of a Scope).
+    for(auto& ring : rings_) {
+      ring->tail.store(ring->head.load(std::memory_order_acquire),std::memory_order_release);
+      ring->dropped.store(0,std::memory_order_relaxed);
+    }
+
+    is_running_ = true;
+  }
+
+  start_time_ = clock_t::now();
+  writer_ = std::thread{[this] { run_writer(); }};
+  is_enabled_.store(true,std::memory_order_release);
+
+  std::cout << "[INFO] Tracing to [" << file.string() << "]." << std::endl;
+#endif
+}
+
+void Tracer::stop() {
+  if(!writer_.joinable()) { return; }
+
+  is_enabled_.store(false,std::memory_order_release);
+
+  {
+    const std::scoped_lock lock{mutex_};
+    is_running_ = false;
+  }
+
+  cond_.notify_one();
+  writer_.join();
+
+  fout_ << "\n]}\n";
+  fout_.close();
+
+  if(dropped_count_ > 0) {
+    std::cerr << "[WARN] Dropped [" << dropped_count_ << "] trace events." << std::endl;
+  }
+}
+
+void Tracer::begin(std::string_view name,std::string_view cat,std::string_view detail) {
+  Event event{.phase = 'B',.name = name,.cat = cat};
+
+  set_detail(event,detail);
+  push(event);
+}
+
+void Tracer::begin(std::string_view name,std::string_view cat,long long detail) {
+  Event event{.phase = 'B',.has_num_detail = true,.num_detail = detail,.name = name,.cat = cat};
+
+  push(event);
+}
+
+void Tracer::end() {
+  Event event{.phase = 'E'};
+
+  push(event);
+}
+
+void Tracer::counter(std::string_view name,double value) {
+  if(!is_enabled()) { return; }
+
+  Event event{.phase = 'C',.value = value,.name = name};
+
+  push(event);
+}
+
+void Tracer::async_begin(std::string_view name,std::string_view cat,std::uint64_t id,std::string_view detail) {
+  if(!is_enabled()) { return; }
+
+  Event event{.phase = 'b',.id = id,.name = name,.cat = cat};
+
+  set_detail(event,detail);
+  push(event);
+}
+
+void Tracer::async_end(std::string_view name,std::string_view cat,std::uint64_t id) {
+  if(!is_enabled()) { return; }
+
+  Event event{.phase = 'e',.id = id,.name = name,.cat = cat};
+
+  push(event);
+}
+
+void Tracer::flow_begin(std::string_view name,std::string_view cat,std::uint64_t id) {
+  if(!is_enabled()) { return; }
+
+  Event event{.phase = 's',.id = id,.name = name,.cat = cat};
+
+  push(event);
+}
+
+void Tracer::flow_end(std::string_view name,std::string_view cat,std::uint64_t id) {
+  if(!is_enabled()) { return; }
+
+  Event event{.phase = 'f',.id = id,.name = name,.cat = cat};
+
+  push(event);
+}
+
+void Tracer::set_thread_name(std::string_view name) {
+  if(!is_enabled()) { return; }
+
+  Event event{.phase = 'M',.name = "thread_name"};
+
+  set_detail(event,name);
+  push(event);
+}
+
+std::uint64_t Tracer::next_id() { return next_id_.fetch_add(1,std::memory_order_relaxed) + 1; }
+
+bool Tracer::is_enabled() const { return is_enabled_.load(std::memory_order_acquire); }
+
+void Tracer::set_detail(Event& event,std::string_view detail) {
+  std::size_t size = std::min(detail.size(),kDetailSize);
+
+  // Don't cut a UTF-8 char in half (i.e., back up over its continuation bytes).
+  if(size < detail.size()) {
+    while(size > 0 && (static_cast<unsigned char>(detail[size]) & 0xC0u) == 0x80u) { --size; }
+  }
+
+  std::memcpy(event.detail,detail.data(),size);
+  event.detail_size = static_cast<std::uint8_t>(size);
+}
+
+void Tracer::push(Event& event) {
+  event.nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - start_time_).count();
+
+  thread_ring().push(event);
+}
+
+Tracer::ThreadRing& Tracer::thread_ring() {
+  // Shared with rings_, in case the thread exits before the last drain.
+  thread_local std::shared_ptr<ThreadRing> ring{};
+
+  if(!ring) {
+    ring = std::make_shared<ThreadRing>();
+
+    const std::scoped_lock lock{mutex_};
+    ring->tid = next_tid_++;
+    rings_.push_back(ring);
+  }
+
+  return *ring;
+}
+
+void Tracer::run_writer() {
+  std::vector<std::shared_ptr<ThreadRing>> rings{};
+
+  while(true) {
+    bool is_running = true;
+
+    {
+      std::unique_lock lock{mutex_};
+
+      cond_.wait_for(lock,kDrainInterval,[&] { return !is_running_; });
+      is_running = is_running_;
+      rings = rings_; // Copy, so that new threads don't wait on the writing.
+    }
+
+    drain_rings(rings);
+    fout_.flush();
+
+    rings.clear(); // Else, every ring would still look held.
+    prune_rings();
+
+    if(!is_running) { break; }
+  }
+}
+
+void Tracer::drain_rings(std::vector<std::shared_ptr<ThreadRing>>& rings) {
+  for(auto& ring : rings) {
+    const std::size_t head = ring->head.load(std::memory_order_acquire);
+    std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+
+    for(; tail != head; ++tail) { write_event(ring->events[tail % kRingSize],ring->tid); }
+
+    ring->tail.store(tail,std::memory_order_release);
+    dropped_count_ += ring->dropped.exchange(0,std::memory_order_relaxed);
+  }
+}
+
+void Tracer::prune_rings() {
+  const std::scoped_lock lock{mutex_};
+
+  // Only held by rings_, so its thread exited & can't push any more events.
+  // If it pushed some after the drain though, then keep it until the next drain.
+  std::erase_if(rings_,[](const auto& ring) {
+    return ring.use_count() == 1 &&
+           ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire);
+  });
+}
+
+void Tracer::write_event(const Event& event,int tid) {
+  const std::string_view detail{event.detail,event.detail_size};
+
+  if(is_first_event_) {
+    is_first_event_ = false;
+  } else {
+    fout_ << ",\n";
+  }
+
+  fout_ << "{\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << tid
+        << ",\"ts\":" << (static_cast<double>(event.nanos) / 1000.0);
+
+  if(!event.name.empty()) {
+    fout_ << ",\"name\":";
+    ToolUtil::write_json_str(fout_,event.name);
+  }
+  if(!event.cat.empty()) {
+    fout_ << ",\"cat\":";
+    ToolUtil::write_json_str(fout_,event.cat);
+  }
+  if(event.id != 0) { fout_ << ",\"id\":" << event.id; }
+
+  switch(event.phase) {
+    case 'C':
+      fout_ << ",\"args\":{\"value\":" << event.value << '}';
+      break;
+
+    case 'M':
+      fout_ << ",\"args\":{\"name\":";
+      ToolUtil::write_json_str(fout_,detail);
+      fout_ << '}';
+      break;
+
+    case 'f':
+      fout_ << ",\"bp\":\"e\""; // Bind to the enclosing slice.
+      break;
+
+    default:
+      if(event.has_num_detail) {
+        fout_ << ",\"args\":{\"detail\":" << event.num_detail << '}';
+      } else if(!detail.empty()) {
+        fout_ << ",\"args\":{\"detail\":";
+        ToolUtil::write_json_str(fout_,detail);
+        fout_ << '}';
+      }
+      break;
+  }
+
+  fout_ << '}';
+}
+
+} // namespace cybel
@@ -0,0 +1,173 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CYBEL_UTIL_TRACER_H_
+#define CYBEL_UTIL_TRACER_H_
+
+#include "cybel/common.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace cybel {
+
+/**
+ * Writes events in the Trace Event Format (JSON), which can be opened in a trace viewer
+ *     (e.g., https://ui.perfetto.dev or chrome://tracing).
+ *
+ * Like Profiler, each thread records its events into its own lock-free ring buffer of fixed-size records,
+ *     which a background thread drains every few ms & formats to the file, so that tracing doesn't affect
+ *     the frame times. It does nothing (other than an atomic load) until start() is called.
+ *
+ * The names & categories aren't copied, so they must be string literals (or outlive the Tracer).
+ *     A detail is copied, but truncated to kDetailSize chars.
+ *
+ * Event types:
+ * - Scope (begin/end): a slice on the thread's track, which can be nested.
+ * - counter(): a value over time (e.g., logic ticks per frame).
+ * - async_begin()/async_end(): a slice on its own track, which can cross frames (e.g., a scene's lifetime).
+ * - flow_begin()/flow_end(): an arrow from the enclosing slice of the begin to the enclosing slice of the end
+ *     (e.g., from pushing a scene to drawing it for the first time).
+ *
+ * Usage:
+ *   @code
+ *   const Tracer::Scope trace{"load_map","map",file.string()};
+ *   @endcode
+ */
+class Tracer {
+public:
+  using clock_t = std::chrono::steady_clock;
+
+  class Scope {
+  public:
+    explicit Scope(std::string_view name,std::string_view cat,std::string_view detail = {});
+    explicit Scope(std::string_view name,std::string_view cat,long long detail);
+
+    Scope(const Scope& other) = delete;
+    Scope(Scope&& other) noexcept = delete;
+    ~Scope() noexcept;
+
+    Scope& operator=(const Scope& other) = delete;
+    Scope& operator=(Scope&& other) noexcept = delete;
+
+  private:
+    bool is_enabled_ = false;
+  };
+
+  static constexpr std::size_t kRingSize = 2048; // Per thread; more events than this per drain are dropped.
+  static constexpr std::size_t kDetailSize = 64;
+  static constexpr auto kDrainInterval = std::chrono::milliseconds{10};
+
+  /**
+   * Global instance.
+   */
+  static Tracer& it();
+
+  Tracer(const Tracer& other) = delete;
+  Tracer(Tracer&& other) noexcept = delete;
+  ~Tracer() noexcept;
+
+  Tracer& operator=(const Tracer& other) = delete;
+  Tracer& operator=(Tracer&& other) noexcept = delete;
+
+  /**
+   * Opens (truncates) `file` & starts the writer thread.
+   */
+  void start(const std::filesystem::path& file);
+  /**
+   * Writes the remaining events & closes the file.
+   */
+  void stop();
+
+  void begin(std::string_view name,std::string_view cat,std::string_view detail = {});
+  void begin(std::string_view name,std::string_view cat,long long detail);
+  void end();
+  void counter(std::string_view name,double value);
+  void async_begin(std::string_view name,std::string_view cat,std::uint64_t id,std::string_view detail = {});
+  void async_end(std::string_view name,std::string_view cat,std::uint64_t id);
+  void flow_begin(std::string_view name,std::string_view cat,std::uint64_t id);
+  void flow_end(std::string_view name,std::string_view cat,std::uint64_t id);
+
+  /**
+   * Names the calling thread's track.
+   */
+  void set_thread_name(std::string_view name);
+
+  /**
+   * Returns a unique ID for async & flow events (never 0).
+   */
+  std::uint64_t next_id();
+
+  bool is_enabled() const;
+
+private:
+  struct Event {
+    char phase = 0;
+    bool has_num_detail = false;
+    std::uint8_t detail_size = 0;
+    std::int64_t nanos = 0;
+    std::uint64_t id = 0;
+    double value = 0.0; // Of a counter.
+    long long num_detail = 0;
+    std::string_view name{};
+    std::string_view cat{};
+    char detail[kDetailSize]{};
+  };
+
+  /**
+   * Single producer (the owner thread), single consumer (the writer thread).
+   */
+  class ThreadRing {
+  public:
+    int tid = 0;
+    Event events[kRingSize]{};
+    std::atomic<std::size_t> head{0}; // Only written by the owner thread.
+    std::atomic<std::size_t> tail{0}; // Only written by the writer thread (or start()).
+    std::atomic<std::uint64_t> dropped{0};
+
+    void push(const Event& event) noexcept;
+  };
+
+  std::atomic<bool> is_enabled_{false};
+  std::atomic<std::uint64_t> next_id_{0};
+  clock_t::time_point start_time_{};
+
+  std::mutex mutex_{}; // For the vars below.
+  std::condition_variable cond_{};
+  std::vector<std::shared_ptr<ThreadRing>> rings_{};
+  int next_tid_ = 1; // Not from the size of rings_, since the rings of exited threads are pruned.
+  bool is_running_ = false;
+
+  // Only used by the writer thread (& start()/stop()).
+  std::thread writer_{};
+  std::ofstream fout_{};
+  bool is_first_event_ = true;
+  std::uint64_t dropped_count_ = 0;
+
+  explicit Tracer() = default;
+
+  static void set_detail(Event& event,std::string_view detail);
+
+  void push(Event& event);
+  ThreadRing& thread_ring();
+  void run_writer();
+  void drain_rings(std::vector<std::shared_ptr<ThreadRing>>& rings);
+  void prune_rings();
+  void write_event(const Event& event,int tid);
+};
+
+} // namespace cybel
+#endif
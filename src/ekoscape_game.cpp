@@ -8,8 +8,11 @@
 #include "ekoscape_game.h"
 
 #include "cybel/input/joypad_input.h"
+#include "cybel/str/utf8/str_util.h"
 #include "cybel/types/cybel_error.h"
+#include "cybel/util/profiler.h"
 #include "cybel/util/rando.h"
+#include "cybel/util/tracer.h"
 
 #include "core/input_action.h"
 #include "scenes/boring_work_scene.h"
@@ -24,12 +27,24 @@ std::unique_ptr<EkoScapeGame> g_eko_game{};
 
 #endif // __EMSCRIPTEN__
 
-EkoScapeGame::EkoScapeGame() {
+EkoScapeGame::EkoScapeGame()
+  : EkoScapeGame(Args{}) {}
+
+EkoScapeGame::EkoScapeGame(const Args& args)
+  : max_frames_(args.max_frames),profile_file_(args.profile_file) {
+  if(!profile_file_.empty()) { Profiler::it().set_enabled(true); }
+  // Start first, so that loading the assets & the first scene is traced too.
+  if(!args.trace_file.empty()) {
+    Tracer::it().start(args.trace_file);
+    Tracer::it().set_thread_name("main");
+  }
+
   CybelEngine::Config config{
     .title = kTitle,
     .scale_factor = 0.8333f, // Arrival?
     //.size = Size2i{740,500}, // For GIFs/screenshots.
     .fps = 60,
+    .logic_hz = 120,
     .vsync = true,
     .max_input_id = InputAction::kMax,
     .image_types = IMG_INIT_PNG,
@@ -45,12 +60,17 @@ EkoScapeGame::EkoScapeGame() {
   // These are fixed values and should not be changed.
   config.target_size = Size2i{1600,900};
 
+  if(args.headless) { config.renderer_type = CybelEngine::RendererType::kNull; }
+
   cybel_engine_ = std::make_shared<CybelEngine>(
     *this,config,[&](int type) { return build_scene(type); }
   );
   scene_man_ = &cybel_engine_->scene_man();
+
+  if(auto* null_ren = cybel_engine_->null_renderer(); null_ren != nullptr) {
+    for(const auto& [tag,budget] : args.budgets) { null_ren->set_budget(tag,budget); }
+  }
   assets_ = std::make_unique<Assets>("realistic",cybel_engine_->audio_player().is_alive());
-  ctx_ = std::make_unique<GameContext>(*cybel_engine_,*assets_);
 
   cybel_engine_->set_icon(*assets_->image(ImageId::kEkoScapeIcon));
 
@@ -61,6 +81,14 @@ EkoScapeGame::EkoScapeGame() {
 
   init_input_map();
 
+  // The input map must be initialized first, since the replay's states must match it.
+  ctx_ = std::make_unique<GameContext>(*cybel_engine_,*assets_,init_replay(args));
+
+  // Replays & headless runs need the scenes to change on the same tick every time.
+  const auto& input_man = cybel_engine_->input_man();
+  ctx_->load_in_bg = !args.headless && !input_man.is_recording() && !input_man.is_playing_back();
+  scene_man_->set_load_in_bg(ctx_->load_in_bg);
+
   if(!scene_man_->push_scene(SceneAction::kGoToMenu)) {
     throw CybelError{"Failed to push the Menu Scene onto the stack."};
   }
@@ -140,6 +168,21 @@ void EkoScapeGame::init_input_map() {
   im.map_input(InputAction::kToggleFrozen,[](auto& i) {
     i.raw_key({{KMOD_CTRL,SDL_SCANCODE_F6}});
   });
+  im.map_input(InputAction::kDumpProfile,[](auto& i) {
+    i.raw_key({SDL_SCANCODE_F9});
+  });
+}
+
+std::uint64_t EkoScapeGame::init_replay(const Args& args) {
+  auto& input_man = cybel_engine_->input_man();
+
+  if(!args.replay_file.empty()) { return input_man.start_playback(args.replay_file); }
+
+  const std::uint64_t seed = Rando::gen_seed();
+
+  if(!args.record_file.empty()) { input_man.start_recording(args.record_file,seed); }
+
+  return seed;
 }
 
 SceneBag EkoScapeGame::build_scene(int type) {
@@ -183,6 +226,7 @@ SceneBag EkoScapeGame::build_scene(int type) {
         try {
           result.scene = std::make_shared<GameScene>(*ctx_,game_scene_state_,map_file);
           result.persist = true; // Preserve GameScene when pausing (e.g., for BoringWorkScene).
+          result.load_in_bg = true; // Big maps can take a while.
         } catch(const CybelError& e) {
           show_error(e.what());
           result.scene = nullptr;
@@ -227,7 +271,28 @@ void EkoScapeGame::pop_scene() {
   }
 }
 
-void EkoScapeGame::run_loop() { cybel_engine_->run_loop(); }
+bool EkoScapeGame::run_loop() {
+  if(max_frames_ > 0) {
+    for(long long i = 0; i < max_frames_ && cybel_engine_->run_frame(); ++i) {}
+  } else {
+    cybel_engine_->run_loop();
+  }
+
+  bool is_in_budget = true;
+
+  if(const auto* null_ren = cybel_engine_->null_renderer(); null_ren != nullptr) {
+    const auto tag_namer = [](int tag) { return std::string{SceneActions::name_of(tag)}; };
+
+    null_ren->print_stats(std::cout,tag_namer);
+    null_ren->print_budget_misses(std::cerr,tag_namer);
+    is_in_budget = (null_ren->budget_miss_count() == 0);
+  }
+  if(!profile_file_.empty()) { dump_profile(); }
+
+  Tracer::it().stop();
+
+  return is_in_budget;
+}
 
 void EkoScapeGame::run_on_web() {
 #if defined(__EMSCRIPTEN__)
@@ -293,6 +358,16 @@ void EkoScapeGame::on_scene_input_event(input_id_t input_id,const ViewDimens& /*
     case InputAction::kToggleFrozen:
       cybel_engine_->set_logic_running(!cybel_engine_->is_logic_running());
       break;
+
+    // If not profiling, start; else, dump the stats so far.
+    case InputAction::kDumpProfile:
+      if(Profiler::it().is_enabled()) {
+        dump_profile();
+      } else {
+        std::cout << "[INFO] Started profiling." << std::endl;
+        Profiler::it().set_enabled(true);
+      }
+      break;
   }
 }
 
@@ -308,7 +383,7 @@ int EkoScapeGame::update_scene_logic(const FrameStep& step,const ViewDimens& /*d
   return SceneAction::kNil;
 }
 
-void EkoScapeGame::draw_scene(Renderer& ren,const ViewDimens& /*dimens*/) {
+void EkoScapeGame::draw_scene(Renderer& ren,const ViewDimens& dimens) {
   if(!star_sys_.is_empty() && SceneActions::is_menu(scene_man_->curr_scene_type())) {
     ren.begin_2d_scene()
        .begin_auto_scale()
@@ -320,6 +395,29 @@ void EkoScapeGame::draw_scene(Renderer& ren,const ViewDimens& /*dimens*/) {
        .end_scale();
   }
 
+  // Keep the current scene going, but let the player know that the next scene is coming.
+  if(scene_man_->is_loading()) {
+    ren.begin_2d_scene()
+       .begin_auto_anchor_scale(Pos2f{1.0f,1.0f}); // Bottom right.
+
+    assets_->font_renderer().wrap(ren,Pos3i{},0.33f,[&](auto& font) {
+      const std::string loading_str = "loading…";
+      const Size2i str_size{static_cast<int>(utf8::StrUtil::count_runes(loading_str)),1};
+
+      font.set_bg_padding(Size2i{5,5});
+
+      const auto total_size = font.font.calc_total_size(str_size);
+
+      font.font.pos.x += (dimens.target_size.w - total_size.w);
+      font.font.pos.y += (dimens.target_size.h - total_size.h);
+
+      font.draw_bg(Color4f{0.0f,0.5f},str_size);
+      font.print(loading_str);
+    });
+
+    ren.end_scale();
+  }
+
   if(avg_fps_age_ >= 0.0f) {
     ren.begin_2d_scene()
        .begin_auto_anchor_scale(Pos2f{0.0f,0.0f}); // Top left.
@@ -361,6 +459,17 @@ void EkoScapeGame::stop_music(bool going_to_boring_work) {
   if(!going_to_boring_work) { was_music_playing_ = false; }
 }
 
+void EkoScapeGame::dump_profile() {
+  const auto& file = profile_file_.empty() ? kDefaultProfileFile : profile_file_;
+
+  // Don't crash the game for a dev feature.
+  try {
+    Profiler::it().dump_csv(file);
+  } catch(const CybelError& e) {
+    std::cerr << "[WARN] " << e.what() << std::endl;
+  }
+}
+
 void EkoScapeGame::show_error(const std::string& error) {
   cybel_engine_->show_error(error);
 }
@@ -10,6 +10,7 @@
 
 #include "common.h"
 
+#include "cybel/gfx/renderer_null.h"
 #include "cybel/scene/scene.h"
 #include "cybel/scene/scene_bag.h"
 #include "cybel/scene/scene_man.h"
@@ -21,6 +22,9 @@
 #include "scenes/menu_play_scene.h"
 #include "world/star_sys.h"
 
+#include <filesystem>
+#include <map>
+
 namespace ekoscape {
 
 class EkoScapeGame final : public Scene {
@@ -30,9 +34,26 @@ class EkoScapeGame final : public Scene {
 public:
   static inline const std::string kTitle = "EkoScape v2.4";
 
+  struct Args {
+    std::filesystem::path record_file{}; // Record input (& the seed) to this file, if not empty.
+    std::filesystem::path replay_file{}; // Replay input (& the seed) from this file, if not empty.
+    bool headless = false; // Use the null renderer (no GPU) & print its stats at the end.
+    long long max_frames = 0; // Stop after this many frames, if > 0.
+    std::filesystem::path profile_file{}; // Profile the CPU & dump the stats (CSV) to this file at exit, if not empty.
+    std::filesystem::path trace_file{}; // Trace events (JSON) to this file, if not empty.
+    // Per scene type (or RendererNull::kAnyTag); a headless run fails if a frame goes over.
+    std::map<int,RendererNull::Budget> budgets{};
+  };
+
+  static inline const std::filesystem::path kDefaultProfileFile = "ekoscape_profile.csv";
+
   explicit EkoScapeGame();
+  explicit EkoScapeGame(const Args& args);
 
-  void run_loop();
+  /**
+   * Returns false if a headless frame went over its budget (see Args.budgets).
+   */
+  bool run_loop();
   static void run_on_web();
 
   void on_scene_context_lost() override;
@@ -47,6 +68,8 @@ public:
 
 private:
   SceneMan* scene_man_ = nullptr;
+  long long max_frames_ = 0;
+  std::filesystem::path profile_file_{};
   bool was_music_playing_ = false;
   std::unique_ptr<Assets> assets_{};
   std::unique_ptr<GameContext> ctx_{};
@@ -59,11 +82,14 @@ private:
   GameScene::State game_scene_state_{};
 
   void init_input_map();
+  std::uint64_t init_replay(const Args& args);
   SceneBag build_scene(int type);
   void pop_scene();
 
   void play_music(bool rand_pos = false);
   void stop_music(bool going_to_boring_work = false);
+
+  void dump_profile();
 };
 
 } // namespace ekoscape
@@ -6,29 +6,121 @@
  */
 
 #include "cybel/types/cybel_error.h"
+#include "cybel/util/tool_util.h"
 
 #include "ekoscape_game.h"
+#include "scenes/scene_action.h"
+
+#include <filesystem>
+#include <map>
+#include <string_view>
+
+/**
+ * Parses `str` (the value of option `opt`) of the form `[SCENE:]COUNTER=MAX` (e.g., `game:state_changes=300`)
+ *     into `budgets`. W/o a scene, it's for all scenes w/o their own budget.
+ * If missing or invalid, prints an error & returns false.
+ */
+static bool parse_budget(std::string_view opt,std::string_view str,
+                         std::map<int,ekoscape::RendererNull::Budget>& budgets) {
+  using namespace ekoscape;
+
+  const auto eq_index = str.find('=');
+
+  if(str.empty() || str.starts_with("--") || eq_index == std::string_view::npos) {
+    std::cerr << "[ERROR] Missing [SCENE:]COUNTER=MAX for option [" << opt << "]." << std::endl;
+    return false;
+  }
+
+  auto counter_name = str.substr(0,eq_index);
+  int tag = RendererNull::kAnyTag;
+
+  if(const auto colon_index = counter_name.find(':'); colon_index != std::string_view::npos) {
+    const auto scene_name = counter_name.substr(0,colon_index);
+
+    tag = SceneActions::value_of(scene_name);
+    counter_name = counter_name.substr(colon_index + 1);
+
+    if(tag == SceneAction::kNil) {
+      std::cerr << "[ERROR] Invalid scene [" << scene_name << "] for option [" << opt << "]." << std::endl;
+      return false;
+    }
+  }
+
+  auto& budget = budgets[tag];
+  std::size_t* max = nullptr;
+
+  if(counter_name == "draw_calls") {
+    max = &budget.draw_calls;
+  } else if(counter_name == "quads") {
+    max = &budget.quads;
+  } else if(counter_name == "state_changes") {
+    max = &budget.state_changes;
+  } else {
+    std::cerr << "[ERROR] Invalid counter [" << counter_name << "] for option [" << opt
+              << "]; must be draw_calls, quads, or state_changes." << std::endl;
+    return false;
+  }
+
+  return ToolUtil::parse_num(opt,str.substr(eq_index + 1),*max);
+}
 
 // SDL2 requires standard main().
 // - https://wiki.libsdl.org/SDL2/FAQWindows#i_get_undefined_reference_to_sdl_main_%2E%2E%2E
 int main(int argc,char** argv) {
   using namespace ekoscape;
 
+  [[maybe_unused]] EkoScapeGame::Args args{}; // Not used on the Web.
+
   for(int i = 1; i < argc; ++i) {
-    if(std::string_view{argv[i]} == "--version") {
+    const std::string_view arg{argv[i]};
+    const std::string_view next_arg = (i + 1 < argc) ? std::string_view{argv[i + 1]} : std::string_view{};
+
+    if(arg == "--version") {
       std::cout << EkoScapeGame::kTitle << std::endl;
       return 0;
     }
+    if(arg == "--headless") {
+      args.headless = true;
+    } else if(arg == "--frames") {
+      if(!ToolUtil::parse_num(arg,next_arg,args.max_frames)) { return 1; }
+      if(args.max_frames < 1) {
+        std::cerr << "[ERROR] Invalid number [" << next_arg << "] for option [" << arg << "]." << std::endl;
+        return 1;
+      }
+
+      ++i;
+    } else if(arg == "--record" || arg == "--replay") {
+      auto& file = (arg == "--record") ? args.record_file : args.replay_file;
+
+      if(!ToolUtil::parse_path(arg,next_arg,file)) { return 1; }
+      ++i;
+    } else if(arg == "--profile") {
+      if(!ToolUtil::parse_path(arg,next_arg,args.profile_file)) { return 1; }
+      ++i;
+    } else if(arg == "--trace") {
+      if(!ToolUtil::parse_path(arg,next_arg,args.trace_file)) { return 1; }
+      ++i;
+    } else if(arg == "--budget") {
+      if(!parse_budget(arg,next_arg,args.budgets)) { return 1; }
+      ++i;
+    }
+  }
+
+  if(!args.budgets.empty() && !args.headless) {
+    std::cerr << "[ERROR] Option [--budget] requires [--headless]." << std::endl;
+    return 1;
   }
 
   try {
 #if defined(__EMSCRIPTEN__)
     EkoScapeGame::run_on_web();
 #else
-    EkoScapeGame eko_game{};
-    eko_game.run_loop();
+    EkoScapeGame eko_game{args};
+    const bool is_in_budget = eko_game.run_loop();
 
     std::cout << "[INFO] Stopping gracefully." << std::endl;
+
+    if(!is_in_budget) { return 1; }
 #endif
   } catch(const CybelError& e) {
     EkoScapeGame::show_error_global(e.what());
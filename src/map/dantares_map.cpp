@@ -8,6 +8,9 @@
 #include "dantares_map.h"
 
 #include "cybel/types/cybel_error.h"
+#include "cybel/util/tracer.h"
+
+#include <limits>
 
 namespace ekoscape {
 
@@ -26,21 +29,28 @@ Map& DantaresMap::clear_grids() {
 }
 
 void DantaresMap::add_to_bridge() {
-  if(grids_.empty()) { throw CybelError{"No grids in map [",title_,"]."}; }
-  if(grid_z_ < 0 || grid_z_ >= static_cast<int>(grids_.size())) {
+  begin_add_to_bridge();
+  while(!add_to_bridge_step(std::numeric_limits<int>::max())) {}
+}
+
+void DantaresMap::begin_add_to_bridge() {
+  const Tracer::Scope trace{"add_to_bridge","map",title_};
+
+  if(spaces_.empty()) { throw CybelError{"No grids in map [",title_,"]."}; }
+  if(grid_z_ < 0 || grid_z_ >= spaces_.grid_count()) {
     throw CybelError{"Invalid grid Z [",grid_z_,"] for map [",title_,"] of size [",
-                     grids_.size(),"]."};
+                     spaces_.grid_count(),"]."};
   }
-  if(player_init_pos_.z < 0 || player_init_pos_.z >= static_cast<int>(grids_.size())) {
+  if(player_init_pos_.z < 0 || player_init_pos_.z >= spaces_.grid_count()) {
     throw CybelError{"Invalid player Z [",player_init_pos_.z,"] for map [",title_,"] of size [",
-                     grids_.size(),"]."};
+                     spaces_.grid_count(),"]."};
   }
 
-  grid_ids_.resize(grids_.size(),-1);
+  grid_ids_.resize(static_cast<std::size_t>(spaces_.grid_count()),-1);
 
-  for(int z = 0; z < static_cast<int>(grids_.size()); ++z) {
-    const auto& grid = grids_[static_cast<std::size_t>(z)];
-    const Size2i& size = grid->size();
+  // No GL calls in here; the quad batches are only created when generating the chunks.
+  for(int z = 0; z < spaces_.grid_count(); ++z) {
+    const Size2i& size = spaces_.size(z);
     std::vector<int> int_spaces(static_cast<std::size_t>(size.area()),0);
 
     // Explicitly casting to ensure use of `const void*` overload.
@@ -55,23 +65,59 @@ void DantaresMap::add_to_bridge() {
 
     grid_ids_[static_cast<std::size_t>(z)] = id;
 
-    for(Pos2i pos{0,0}; pos.y < size.h; ++pos.y) {
+    for(Pos3i pos{0,0,z}; pos.y < size.h; ++pos.y) {
       for(pos.x = 0; pos.x < size.w; ++pos.x) {
-        Space& space = grid->unsafe_space(pos);
+        const Space& space = spaces_.unsafe_space(pos);
         update_bridge_space(pos.x,pos.y,space.type());
       }
     }
+  }
 
-    set_texs_(dantares_,z,id);
+  bridge_z_ = 0;
+  bridge_chunk_ = 0;
+}
 
-    // Must be called after setting the textures.
-    if(!dantares_.GenerateMap()) {
+bool DantaresMap::add_to_bridge_step(int max_chunks) {
+  const auto grid_count = static_cast<int>(grid_ids_.size());
+
+  while(bridge_z_ < grid_count) {
+    const int z = bridge_z_;
+    const int id = grid_ids_[static_cast<std::size_t>(z)];
+
+    if(!dantares_.SetCurrentMap(id)) {
+      throw CybelError{"Failed to make map grid [",z,',',id,':',title_,"] current in Dantares."};
+    }
+
+    // The textures must be set before generating any chunks.
+    if(bridge_chunk_ == 0) { set_texs_(dantares_,z,id); }
+
+    const int chunk_count = dantares_.GetChunkCount();
+    const int count = std::min(max_chunks,chunk_count - bridge_chunk_);
+    const Tracer::Scope gen_trace{"generate_map","map",z};
+
+    if(!dantares_.GenerateMapChunks(bridge_chunk_,count)) {
       throw CybelError{"Failed to generate map grid [",z,',',id,':',title_,"] in Dantares."};
     }
+
+    bridge_chunk_ += count;
+    max_chunks -= count;
+
+    if(bridge_chunk_ < chunk_count) { return false; } // Out of chunks for this step.
+
+    ++bridge_z_;
+    bridge_chunk_ = 0;
+
+    if(max_chunks <= 0 && bridge_z_ < grid_count) { return false; }
   }
 
+  place_player();
+
+  return true;
+}
+
+void DantaresMap::place_player() {
   const int z = player_init_pos_.z;
-  const int id = grid_ids_[static_cast<std::size_t>(z)]; // Bounds checked at top of func.
+  const int id = grid_ids_[static_cast<std::size_t>(z)]; // Bounds checked in begin_add_to_bridge().
   const int dan_facing = Facings::value_of(player_init_facing_);
 
   if(!change_grid(z,true)) {
@@ -134,6 +180,15 @@ void DantaresMap::on_context_restored() {
   }
 }
 
+void DantaresMap::restore(const Snapshot& snapshot) {
+  if(static_cast<int>(grid_ids_.size()) != spaces_.grid_count()) {
+    throw CybelError{"Map [",title_,"] not added to Dantares."};
+  }
+
+  Map::restore(snapshot); // Only changes the squares that differ.
+  place_player(); // Also stops any walking/turning.
+}
+
 bool DantaresMap::move_player(const Pos3i& pos) {
   if(!Map::move_player(pos)) { return false; } // Calls change_grid(z) if necessary.
 
@@ -171,7 +226,7 @@ bool DantaresMap::change_grid(int z,bool force) {
     return false;
   }
 
-  const Size2i& grid_size = grids_[static_cast<std::size_t>(z)]->size();
+  const Size2i& grid_size = spaces_.size(z);
   const Pos3i player_pos = this->player_pos();
 
   if((player_pos.x < 0 || player_pos.x >= grid_size.w) ||
@@ -28,7 +28,7 @@ namespace ekoscape {
  *   }};
  *
  *   map.load_file("map.txt"); // Or build in code w/ parse_grid().
- *   map.add_to_bridge();
+ *   map.add_to_bridge(); // Or begin_add_to_bridge() & add_to_bridge_step() over several frames.
  *   // Now use map normally...
  *   @endcode
  */
@@ -40,7 +40,10 @@ public:
 
   Map& clear_grids() override;
   void add_to_bridge() override;
+  void begin_add_to_bridge() override;
+  bool add_to_bridge_step(int max_chunks) override;
   void on_context_restored() override;
+  void restore(const Snapshot& snapshot) override;
 
   bool move_player(const Pos3i& pos) override;
   bool sync_player_pos() override;
@@ -60,6 +63,11 @@ private:
   TexturesSetter set_texs_{};
   std::vector<int> grid_ids_{};
 
+  // For add_to_bridge_step().
+  int bridge_z_ = 0;
+  int bridge_chunk_ = 0;
+
+  void place_player();
   bool change_grid(int z,bool force);
 };
 
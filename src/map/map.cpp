@@ -7,8 +7,17 @@
 
 #include "map.h"
 
+#include "cybel/io/mapped_file.h"
 #include "cybel/str/utf8/str_util.h"
 #include "cybel/types/cybel_error.h"
+#include "cybel/util/tracer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <ranges>
+#include <type_traits>
 
 namespace ekoscape {
 
@@ -17,6 +26,15 @@ bool Map::is_map_file(const std::filesystem::path& file) {
 
   if(!is_regular_file(file,err_code)) { return false; }
 
+  if(is_bin_map_file(file)) {
+    std::ifstream fin{file,std::ios::in | std::ios::binary};
+    BinHeader header{};
+
+    if(!fin.read(reinterpret_cast<char*>(&header),sizeof(header))) { return false; }
+
+    return check_bin_header(header);
+  }
+
   try {
     TextReader reader{file,24}; // Buffer size based on: "[EkoScape/v1999]\r\n"
     std::string line{};
@@ -52,19 +70,41 @@ bool Map::parse_header(const std::string& line,int& version,bool warn) {
   return true;
 }
 
+bool Map::is_bin_map_file(const std::filesystem::path& file) { return file.extension() == kBinExt; }
+
+bool Map::check_bin_header(const BinHeader& header) {
+  // For reading/writing as raw bytes.
+  static_assert(std::is_trivially_copyable_v<BinHeader> && sizeof(BinHeader) == 112);
+  static_assert(std::is_trivially_copyable_v<BinGrid> && sizeof(BinGrid) == 16);
+  static_assert(std::is_trivially_copyable_v<BinMark> && sizeof(BinMark) == 16);
+
+  return std::memcmp(header.magic,kBinMagic,sizeof(kBinMagic)) == 0 &&
+         header.byte_order == kBinByteOrder &&
+         header.bin_version == kBinVersion &&
+         kSupportedVersions.in_range(header.version);
+}
+
 Map& Map::clear_grids() {
   grid_z_ = -1;
   total_cells_ = 0;
   total_rescues_ = 0;
   player_init_pos_ = Pos3i{};
 
-  grids_.clear();
+  spaces_.clear();
+  planes_.clear();
 
   return *this;
 }
 
 Map& Map::load_file(const std::filesystem::path& file,const SpaceCallback& on_space,
                     const DefaultEmptyCallback& on_default_empty,bool meta_only) {
+  const Tracer::Scope trace{meta_only ? "load_map_meta" : "load_map","map",file.string()};
+
+  if(is_bin_map_file(file)) {
+    load_bin_file(file,on_space,on_default_empty,meta_only);
+    return *this;
+  }
+
   TextReader reader{file};
 
   load_metadata(reader,file.string());
@@ -170,7 +210,7 @@ void Map::load_grids(TextReader& reader,const SpaceCallback& on_space,
 
   shrink_grids_to_fit();
 
-  if(grids_.empty()) {
+  if(spaces_.empty()) {
     throw CybelError{"Missing a grid in map [",file,"]."};
   }
   if(!has_player) {
@@ -189,6 +229,165 @@ void Map::load_grids(TextReader& reader,const SpaceCallback& on_space,
   }
 }
 
+void Map::load_bin_file(const std::filesystem::path& file,const SpaceCallback& on_space,
+                        const DefaultEmptyCallback& on_default_empty,bool meta_only) {
+  const MappedFile mapped_file{file};
+  const auto bytes = mapped_file.bytes();
+
+  const auto check_range = [&](std::uint64_t offset,std::uint64_t size,std::string_view name) {
+    if(offset > bytes.size() || size > (bytes.size() - offset)) {
+      throw CybelError{"Invalid ",name," [",offset,'+',size,"] in binary map [",file.string(),"] of size [",
+                       bytes.size(),"]."};
+    }
+  };
+  const auto read_pod = [&](std::uint64_t offset,auto& pod,std::string_view name) {
+    check_range(offset,sizeof(pod),name);
+    std::memcpy(&pod,bytes.data() + offset,sizeof(pod));
+  };
+  const auto read_str = [&](std::uint64_t offset,std::uint64_t size,std::string_view name) {
+    check_range(offset,size,name);
+    return std::string_view{reinterpret_cast<const char*>(bytes.data() + offset),static_cast<std::size_t>(size)};
+  };
+
+  BinHeader header{};
+  read_pod(0,header,"header");
+
+  if(!check_bin_header(header)) {
+    throw CybelError{"Invalid header or unsupported version [",header.bin_version,',',header.version,
+                     "] in binary map [",file.string(),"]; convert it again with EkoScapeMapConv."};
+  }
+
+  version_ = header.version;
+  set_title(read_str(header.title_offset,header.title_size,"title"));
+  set_author(read_str(header.author_offset,header.author_size,"author"));
+  set_turning_speed(header.turning_speed);
+  set_walking_speed(header.walking_speed);
+  set_default_empty(SpaceTypes::to_space_type(static_cast<char>(header.default_empty)));
+  set_robot_delay(Duration::from_millis(header.robot_delay_millis));
+
+  if(meta_only) { return; }
+
+  clear_grids();
+
+  if(header.grid_count <= 0 || header.grid_count > Dantares2::MAXMAPS) {
+    throw CybelError{"Invalid grid count [",header.grid_count,"] in binary map [",file.string(),"]."};
+  }
+
+  for(int z = 0; z < header.grid_count; ++z) {
+    BinGrid bin_grid{};
+    read_pod(header.grids_offset + (static_cast<std::uint64_t>(z) * sizeof(BinGrid)),bin_grid,"grid");
+
+    if(bin_grid.w <= 0 || bin_grid.h <= 0) {
+      throw CybelError{"Invalid grid size [",bin_grid.w,'x',bin_grid.h,"] in binary map [",file.string(),"]."};
+    }
+
+    const auto spaces_size = static_cast<std::uint64_t>(bin_grid.w) * static_cast<std::uint64_t>(bin_grid.h) *
+                             sizeof(Space);
+    check_range(bin_grid.spaces_offset,spaces_size,"grid spaces");
+
+    spaces_.add_grid(
+      Size2i{bin_grid.w,bin_grid.h},
+      bytes.subspan(static_cast<std::size_t>(bin_grid.spaces_offset),static_cast<std::size_t>(spaces_size))
+    );
+
+    // The bytes are copied as-is, so check every Space (e.g., of a user-submitted map),
+    //    else an unknown type could be walkable.
+    for(Pos3i pos{0,0,z}; pos.y < bin_grid.h; ++pos.y) {
+      for(pos.x = 0; pos.x < bin_grid.w; ++pos.x) {
+        const Space& space = spaces_.unsafe_space(pos);
+        const auto thing = space.thing_type();
+
+        if(!SpaceTypes::is_valid_empty(space.empty_type()) ||
+           (thing != SpaceType::kNil && !SpaceTypes::is_thing(thing))) {
+          throw CybelError{"Invalid space [",static_cast<int>(space.empty_type()),',',static_cast<int>(thing),
+                           "] at [",pos.x,',',pos.y,',',pos.z,"] in binary map [",file.string(),"]."};
+        }
+      }
+    }
+
+    planes_.build_grid(spaces_,z);
+  }
+
+  player_init_pos_.set(header.player_x,header.player_y,header.player_z);
+  player_init_facing_ = Facings::to_facing(header.player_facing);
+
+  if(space(player_init_pos_) == nullptr) {
+    throw CybelError{"Invalid Player pos [",player_init_pos_.x,',',player_init_pos_.y,',',player_init_pos_.z,
+                     "] in binary map [",file.string(),"]."};
+  }
+
+  grid_z_ = (header.grid_z >= 0 && header.grid_z < header.grid_count) ? header.grid_z : player_init_pos_.z;
+
+  // Not from the header, since it could be wrong too (e.g., of a user-submitted map).
+  for(int z = 0; z < spaces_.grid_count(); ++z) {
+    for(const auto word : planes_.bits(MapPlanes::Plane::kCell,z)) { total_cells_ += std::popcount(word); }
+  }
+
+  bool has_player = false;
+
+  for(std::uint32_t i = 0; i < header.mark_count; ++i) {
+    BinMark mark{};
+    read_pod(header.marks_offset + (static_cast<std::uint64_t>(i) * sizeof(BinMark)),mark,"mark");
+
+    const Pos3i pos{mark.x,mark.y,mark.z};
+    const auto raw_type = static_cast<SpaceType>(static_cast<char>(mark.type));
+
+    if(space(pos) == nullptr) {
+      throw CybelError{"Invalid mark pos [",pos.x,',',pos.y,',',pos.z,"] in binary map [",file.string(),"]."};
+    }
+    if(mark.type < 0 || mark.type > 0x7F || !SpaceTypes::is_valid(raw_type)) {
+      throw CybelError{"Invalid mark type [",mark.type,"] at [",pos.x,',',pos.y,',',pos.z,"] in binary map [",
+                       file.string(),"]."};
+    }
+
+    auto type = raw_type;
+
+    if(on_space) {
+      type = on_space(pos,raw_type);
+      if(type != raw_type) { set_bin_mark_type(pos,type); }
+    }
+    if(on_default_empty && (SpaceTypes::is_player(type) || SpaceTypes::is_thing(type))) {
+      on_default_empty(pos,default_empty_);
+    }
+
+    if(SpaceTypes::is_player(type) && pos == player_init_pos_) { has_player = true; }
+  }
+
+  // Same checks as load_grids().
+  if(!has_player) {
+    throw CybelError{"Missing a Player space at [",player_init_pos_.x,',',player_init_pos_.y,',',
+                     player_init_pos_.z,"] in binary map [",file.string(),"]."};
+  }
+
+  const bool has_end = std::ranges::any_of(std::views::iota(0,spaces_.grid_count()),[&](int z) {
+    return std::ranges::any_of(planes_.bits(MapPlanes::Plane::kEnd,z),[](auto word) { return word != 0; });
+  });
+
+  if(!has_end) {
+    throw CybelError{"Missing an End space [",SpaceTypes::value_of(SpaceType::kEnd),
+                     "] in a grid of binary map [",file.string(),"]."};
+  }
+}
+
+void Map::set_bin_mark_type(const Pos3i& pos,SpaceType type) {
+  // Same as parse_grid().
+  Space& space = unsafe_space(pos);
+  const auto old_thing = space.thing_type();
+
+  if(SpaceTypes::is_player(type)) {
+    space.set(default_empty_,SpaceType::kNil);
+    player_init_pos_ = pos;
+    player_init_facing_ = SpaceTypes::to_player_facing(type);
+  } else if(SpaceTypes::is_thing(type)) {
+    space.set(default_empty_,type);
+  } else {
+    space.set(type,SpaceType::kNil);
+  }
+
+  on_raw_thing_updated(old_thing,space.thing_type());
+  planes_.sync(pos,space);
+}
+
 Map& Map::load_file_meta(const std::filesystem::path& file) {
   return load_file(file,nullptr,nullptr,true);
 }
@@ -202,7 +401,7 @@ Map& Map::parse_grid(const std::vector<std::string>& lines,Size2i size,const Spa
                      const DefaultEmptyCallback& on_default_empty,std::string_view file) {
   if(file.empty()) { file = title_; }
 
-  if(grids_.size() >= Dantares2::MAXMAPS) {
+  if(spaces_.grid_count() >= Dantares2::MAXMAPS) {
     throw CybelError{"Too many grids in map [",file,"]; max is ",Dantares2::MAXMAPS,'.'};
   }
 
@@ -223,8 +422,7 @@ Map& Map::parse_grid(const std::vector<std::string>& lines,Size2i size,const Spa
     throw CybelError{"Grid size [",size.w,'x',size.h,"] in map [",file,"] must at least be 1x1."};
   }
 
-  auto grid = std::make_unique<MapGrid>(size);
-  const int z = static_cast<int>(grids_.size());
+  const int z = spaces_.add_grid(size);
   bool has_player = false;
 
   // Dantares expects a map where the origin (0,0) is from the bottom left,
@@ -269,11 +467,11 @@ Map& Map::parse_grid(const std::vector<std::string>& lines,Size2i size,const Spa
         on_raw_thing_updated(SpaceType::kNil,thing_type);
       }
 
-      grid->unsafe_space(dan_pos).set(empty_type,thing_type);
+      spaces_.unsafe_space(dan_pos).set(empty_type,thing_type);
     }
   }
 
-  grids_.push_back(std::move(grid));
+  planes_.build_grid(spaces_,z);
 
   if(has_player) {
     grid_z_ = z;
@@ -285,15 +483,175 @@ Map& Map::parse_grid(const std::vector<std::string>& lines,Size2i size,const Spa
 }
 
 Map& Map::shrink_grids_to_fit() {
-  grids_.shrink_to_fit();
+  spaces_.shrink_to_fit();
 
   return *this;
 }
 
+void Map::save_bin_file(const std::filesystem::path& file) const {
+  if(spaces_.empty()) { throw CybelError{"No grids to save in map [",title_,"]."}; }
+
+  std::vector<BinGrid> bin_grids{};
+  std::vector<BinMark> bin_marks{};
+
+  // Marks are in the same order as parsing a text map (top to bottom), so that the callbacks are the same.
+  for(int z = 0; z < spaces_.grid_count(); ++z) {
+    const Size2i& size = spaces_.size(z);
+
+    bin_grids.push_back(BinGrid{.w = size.w,.h = size.h});
+
+    for(Pos3i pos{0,size.h - 1,z}; pos.y >= 0; --pos.y) {
+      for(pos.x = 0; pos.x < size.w; ++pos.x) {
+        const Space& space = spaces_.unsafe_space(pos);
+        auto type = SpaceType::kNil;
+
+        if(pos == player_init_pos_) {
+          type = SpaceTypes::to_player(player_init_facing_);
+        } else if(space.has_thing()) {
+          type = space.thing_type();
+        } else if(SpaceTypes::is_portal(space.empty_type())) {
+          type = space.empty_type();
+        }
+
+        if(type != SpaceType::kNil) {
+          bin_marks.push_back(BinMark{.x = pos.x,.y = pos.y,.z = pos.z,.type = SpaceTypes::value_of(type)});
+        }
+      }
+    }
+  }
+
+  const auto align = [](std::uint64_t offset) { return (offset + 7) & ~std::uint64_t{7}; };
+
+  BinHeader header{
+    .byte_order = kBinByteOrder,
+    .bin_version = kBinVersion,
+    .version = version_,
+    .turning_speed = turning_speed_,
+    .walking_speed = walking_speed_,
+    .robot_delay_millis = static_cast<std::int32_t>(robot_delay_.round_millis()),
+    .default_empty = SpaceTypes::value_of(default_empty_),
+    .grid_count = spaces_.grid_count(),
+    .grid_z = grid_z_,
+    .player_x = player_init_pos_.x,
+    .player_y = player_init_pos_.y,
+    .player_z = player_init_pos_.z,
+    .player_facing = Facings::value_of(player_init_facing_),
+    .total_cells = total_cells_,
+    .mark_count = static_cast<std::uint32_t>(bin_marks.size()),
+  };
+
+  std::memcpy(header.magic,kBinMagic,sizeof(kBinMagic));
+
+  header.title_offset = sizeof(BinHeader);
+  header.title_size = title_.size();
+  header.author_offset = header.title_offset + header.title_size;
+  header.author_size = author_.size();
+  header.grids_offset = align(header.author_offset + header.author_size);
+  header.marks_offset = header.grids_offset + (bin_grids.size() * sizeof(BinGrid));
+
+  std::uint64_t offset = align(header.marks_offset + (bin_marks.size() * sizeof(BinMark)));
+
+  for(auto& bin_grid : bin_grids) {
+    bin_grid.spaces_offset = offset;
+    const auto spaces_size = static_cast<std::uint64_t>(bin_grid.w) * static_cast<std::uint64_t>(bin_grid.h) *
+                             sizeof(Space);
+    offset = align(offset + spaces_size);
+  }
+
+  std::ofstream fout{file,std::ios::out | std::ios::binary | std::ios::trunc};
+  if(!fout) { throw CybelError{"Failed to open binary map [",file.string(),"] for writing."}; }
+
+  const auto write_bytes = [&](const void* data,std::size_t size) {
+    fout.write(static_cast<const char*>(data),static_cast<std::streamsize>(size));
+  };
+  const auto write_padding = [&](std::uint64_t to_offset) {
+    constexpr char kZeros[8]{};
+    const auto pos = static_cast<std::uint64_t>(fout.tellp());
+
+    if(to_offset > pos) { write_bytes(kZeros,static_cast<std::size_t>(to_offset - pos)); }
+  };
+
+  write_bytes(&header,sizeof(header));
+  write_bytes(title_.data(),title_.size());
+  write_bytes(author_.data(),author_.size());
+  write_padding(header.grids_offset);
+  write_bytes(bin_grids.data(),bin_grids.size() * sizeof(BinGrid));
+  write_bytes(bin_marks.data(),bin_marks.size() * sizeof(BinMark));
+
+  // The rows are written without the sentinel border (see MapSpaces), so that they're contiguous in the file.
+  for(int z = 0; z < spaces_.grid_count(); ++z) {
+    write_padding(bin_grids[static_cast<std::size_t>(z)].spaces_offset);
+
+    for(int y = 0; y < spaces_.size(z).h; ++y) {
+      const auto raw_row = spaces_.raw_row(z,y);
+      write_bytes(raw_row.data(),raw_row.size());
+    }
+  }
+
+  fout.flush();
+  if(!fout) { throw CybelError{"Failed to write binary map [",file.string(),"]."}; }
+}
+
 void Map::add_to_bridge() {}
 
+void Map::begin_add_to_bridge() {}
+
+bool Map::add_to_bridge_step(int /*max_chunks*/) {
+  add_to_bridge();
+  return true;
+}
+
 void Map::on_context_restored() {}
 
+Map::Snapshot Map::snapshot() const {
+  Snapshot snapshot{};
+
+  snapshot.spaces = spaces_;
+  snapshot.grid_z = grid_z_;
+  snapshot.total_cells = total_cells_;
+  snapshot.total_rescues = total_rescues_;
+
+  return snapshot;
+}
+
+void Map::restore(const Snapshot& snapshot) {
+  const Tracer::Scope trace{"restore_map","map",title_};
+
+  const auto& init_spaces = snapshot.spaces;
+
+  if(init_spaces.grid_count() != spaces_.grid_count()) {
+    throw CybelError{"Snapshot of [",init_spaces.grid_count(),"] grids doesn't match map [",title_,
+                     "] of size [",spaces_.grid_count(),"]."};
+  }
+
+  for(int z = 0; z < spaces_.grid_count(); ++z) {
+    const Size2i& size = spaces_.size(z);
+
+    if(init_spaces.size(z) != size) {
+      throw CybelError{"Snapshot of grid [",z,"] of size [",init_spaces.size(z),"] doesn't match map [",
+                       title_,"] of size [",size,"]."};
+    }
+
+    // Usually only a few Spaces changed (e.g., eaten Cells & moved Robots), so don't update the rest.
+    for(Pos3i pos{0,0,z}; pos.y < size.h; ++pos.y) {
+      for(pos.x = 0; pos.x < size.w; ++pos.x) {
+        Space& space = spaces_.unsafe_space(pos);
+        const Space& init_space = init_spaces.unsafe_space(pos);
+
+        if(space == init_space) { continue; }
+
+        space = init_space;
+        planes_.sync(pos,space);
+        update_bridge_space(pos,space.type());
+      }
+    }
+  }
+
+  grid_z_ = snapshot.grid_z;
+  total_cells_ = snapshot.total_cells;
+  total_rescues_ = snapshot.total_rescues;
+}
+
 bool Map::move_thing(const Pos3i& from_pos,const Pos3i& to_pos) {
   Space* from_space = mutable_space(from_pos);
   if(from_space == nullptr || !from_space->has_thing()) { return false; }
@@ -303,6 +661,8 @@ bool Map::move_thing(const Pos3i& from_pos,const Pos3i& to_pos) {
 
   const SpaceType thing_type = from_space->remove_thing();
   to_space->set_thing(thing_type);
+  planes_.sync(from_pos,*from_space);
+  planes_.sync(to_pos,*to_space);
 
   update_bridge_space(from_pos,from_space->empty_type());
   update_bridge_space(to_pos,thing_type);
@@ -324,6 +684,7 @@ bool Map::remove_thing(const Pos3i& pos) {
     default: break;
   }
 
+  planes_.sync(pos,*space);
   update_bridge_space(pos,space->empty_type());
 
   return true;
@@ -336,6 +697,7 @@ bool Map::place_thing(SpaceType thing,const Pos3i& pos) {
   if(space == nullptr || space->has_thing()) { return false; }
 
   space->set_thing(thing);
+  planes_.sync(pos,*space);
   update_bridge_space(pos,thing);
 
   return true;
@@ -350,7 +712,7 @@ bool Map::move_player(const Pos3i& pos) {
 bool Map::sync_player_pos() { return move_player(player_pos()); }
 
 bool Map::change_grid(int z) {
-  if(z < 0 || z >= static_cast<int>(grids_.size())) { return false; }
+  if(z < 0 || z >= spaces_.grid_count()) { return false; }
 
   grid_z_ = z;
 
@@ -407,6 +769,7 @@ bool Map::set_raw_space(const Pos3i& pos,SpaceType empty,SpaceType thing) {
 
   space->set(empty,thing);
   on_raw_thing_updated(old_thing,thing);
+  planes_.sync(pos,*space);
 
   return true;
 }
@@ -418,6 +781,7 @@ bool Map::set_raw_empty(const Pos3i& pos,SpaceType empty) {
   if(space == nullptr) { return false; }
 
   space->set_empty(empty);
+  planes_.sync(pos,*space);
 
   return true;
 }
@@ -432,6 +796,7 @@ bool Map::set_raw_thing(const Pos3i& pos,SpaceType thing) {
 
   space->set_thing(thing);
   on_raw_thing_updated(old_thing,thing);
+  planes_.sync(pos,*space);
 
   return true;
 }
@@ -442,6 +807,7 @@ bool Map::remove_raw_thing(const Pos3i& pos) {
 
   const auto old_thing = space->remove_thing();
   on_raw_thing_updated(old_thing,space->thing_type());
+  planes_.sync(pos,*space);
 
   return true;
 }
@@ -495,37 +861,29 @@ SpaceType Map::default_empty() const { return default_empty_; }
 
 const Duration& Map::robot_delay() const { return robot_delay_; }
 
-int Map::grid_count() const { return static_cast<int>(grids_.size()); }
+int Map::grid_count() const { return spaces_.grid_count(); }
 
 int Map::grid_z() const { return grid_z_; }
 
 Size2i Map::size() const { return size(grid_z_); }
 
 Size2i Map::size(int z) const {
-  if(z < 0 || z >= static_cast<int>(grids_.size())) { return Size2i{}; }
+  if(z < 0 || z >= spaces_.grid_count()) { return Size2i{}; }
 
-  return grids_[static_cast<std::size_t>(z)]->size();
+  return spaces_.size(z);
 }
 
-Space* Map::mutable_space(const Pos3i& pos) {
-  if(pos.z < 0 || pos.z >= static_cast<int>(grids_.size())) { return nullptr; }
+const MapSpaces& Map::spaces() const { return spaces_; }
 
-  return grids_[static_cast<std::size_t>(pos.z)]->space(pos);
-}
+const MapPlanes& Map::planes() const { return planes_; }
 
-const Space* Map::space(const Pos3i& pos) const {
-  if(pos.z < 0 || pos.z >= static_cast<int>(grids_.size())) { return nullptr; }
+Space* Map::mutable_space(const Pos3i& pos) { return spaces_.space(pos); }
 
-  return grids_[static_cast<std::size_t>(pos.z)]->space(pos);
-}
+const Space* Map::space(const Pos3i& pos) const { return spaces_.space(pos); }
 
-Space& Map::unsafe_space(const Pos3i& pos) {
-  return grids_[static_cast<std::size_t>(pos.z)]->unsafe_space(pos);
-}
+Space& Map::unsafe_space(const Pos3i& pos) { return spaces_.unsafe_space(pos); }
 
-const Space& Map::unsafe_space(const Pos3i& pos) const {
-  return grids_[static_cast<std::size_t>(pos.z)]->unsafe_space(pos);
-}
+const Space& Map::unsafe_space(const Pos3i& pos) const { return spaces_.unsafe_space(pos); }
 
 int Map::total_cells() const { return total_cells_; }
 
@@ -555,22 +913,22 @@ std::ostream& Map::print(std::ostream& out,bool rstrip) const {
       << "'" << SpaceTypes::value_of(default_empty_) << "'\n"
       << robot_delay_.round_millis();
 
-  for(int z = 0; z < static_cast<int>(grids_.size()); ++z) {
+  for(int z = 0; z < spaces_.grid_count(); ++z) {
     out << '\n';
 
-    const auto& grid = grids_[static_cast<std::size_t>(z)];
+    const Size2i& size = spaces_.size(z);
 
     // Flip vertically, since internally, we match Dantares where
     //     the origin (0,0) is from the bottom left, instead of the top left.
-    for(Pos2i pos{0,grid->size().h - 1}; pos.y >= 0; --pos.y) {
+    for(Pos3i pos{0,size.h - 1,z}; pos.y >= 0; --pos.y) {
       out << '\n';
 
-      int width = grid->size().w;
+      int width = size.w;
 
       if(rstrip) {
         // Find the last non-Void space to avoid printing trailing Voids.
         for(pos.x = width - 1; pos.x >= 0; --pos.x) {
-          const SpaceType type = grid->unsafe_space(pos).type();
+          const SpaceType type = spaces_.unsafe_space(pos).type();
 
           if(type != SpaceType::kVoid) {
             width = pos.x + 1;
@@ -587,8 +945,8 @@ std::ostream& Map::print(std::ostream& out,bool rstrip) const {
 
         if(z == player_init_pos_.z && pos.x == player_init_pos_.x && pos.y == player_init_pos_.y) {
           type = SpaceTypes::to_player(player_init_facing_);
-        } else if(pos.x < grid->size().w) { // True width might be 0, but our adjusted width is 1.
-          type = grid->unsafe_space(pos).type();
+        } else if(pos.x < size.w) { // True width might be 0, but our adjusted width is 1.
+          type = spaces_.unsafe_space(pos).type();
         }
 
         out << SpaceTypes::value_of(type);
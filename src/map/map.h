@@ -17,7 +17,8 @@
 #include "cybel/types/size.h"
 
 #include "map/facing.h"
-#include "map/map_grid.h"
+#include "map/map_planes.h"
+#include "map/map_spaces.h"
 #include "map/space.h"
 #include "map/space_type.h"
 
@@ -66,6 +67,10 @@ namespace ekoscape {
  *   map.add_to_bridge(); // Call this first before using in the game.
  *   @endcode
  *
+ * Maps can also be saved as binary (see save_bin_file()), with the grids in their in-memory layout,
+ * which load_file() then maps into memory & copies without parsing (based on the file extension, kBinExt).
+ * Use `EkoScapeMapConv` to convert maps between text & binary.
+ *
  * Note that any `raw` function is meant to be used before calling add_to_bridge()
  * and before using the Map in the game:
  * - set_raw_space()
@@ -75,13 +80,29 @@ namespace ekoscape {
  */
 class Map {
 public:
+  /**
+   * For binary maps, this is only called for the Player, things (e.g., Robots & Cells), & portals
+   * (in the same order as text maps), since the other spaces aren't parsed.
+   */
   using SpaceCallback = std::function<SpaceType(const Pos3i&,SpaceType)>;
   using DefaultEmptyCallback = std::function<void(const Pos3i&,SpaceType)>;
 
+  /**
+   * Copy of the grids & counters (see snapshot() & restore()).
+   */
+  struct Snapshot {
+    MapSpaces spaces{};
+    int grid_z = -1;
+    int total_cells = 0;
+    int total_rescues = 0;
+  };
+
   static inline const Range2i kSupportedVersions{1,1};
   static inline const Duration kMinRobotDelay = Duration::from_millis(110);
+  static inline const std::filesystem::path kBinExt = ".ekob";
 
   static bool is_map_file(const std::filesystem::path& file);
+  static bool is_bin_map_file(const std::filesystem::path& file);
 
   virtual ~Map() noexcept = default;
 
@@ -96,9 +117,35 @@ public:
                   const DefaultEmptyCallback& on_default_empty = nullptr,std::string_view file = "");
   Map& shrink_grids_to_fit();
 
+  /**
+   * Saves the metadata, grids, Player, & things/portals (for SpaceCallback) in the binary format,
+   * which is native-endian (so must be converted again on a different endianness).
+   */
+  void save_bin_file(const std::filesystem::path& file) const;
+
   virtual void add_to_bridge();
+  /**
+   * Same as add_to_bridge(), but split up, so that a big map doesn't freeze the game:
+   * begin_add_to_bridge() only does CPU work (so it can be called on a worker thread),
+   * then call add_to_bridge_step() on the GL thread (e.g., once per frame) until it returns true.
+   *
+   * By default, add_to_bridge_step() just calls add_to_bridge().
+   */
+  virtual void begin_add_to_bridge();
+  virtual bool add_to_bridge_step(int max_chunks);
   virtual void on_context_restored();
 
+  /**
+   * Copies the grids & counters (e.g., right after loading), so that the Map can be put back in place
+   * with restore(), instead of loading & adding it to the bridge again (e.g., to restart a game).
+   */
+  Snapshot snapshot() const;
+  /**
+   * Only the Spaces that differ from the snapshot are updated in the bridge (e.g., Dantares squares).
+   * Subclasses also put the Player back at the init pos & facing.
+   */
+  virtual void restore(const Snapshot& snapshot);
+
   bool move_thing(const Pos3i& from_pos,const Pos3i& to_pos);
   bool remove_thing(const Pos3i& pos);
   bool place_thing(SpaceType thing,const Pos3i& pos);
@@ -153,6 +200,18 @@ public:
   int grid_z() const;
   Size2i size() const;
   Size2i size(int z) const;
+  /**
+   * For scanning neighbors without bounds checks (see MapSpaces).
+   */
+  const MapSpaces& spaces() const;
+  /**
+   * Bit planes of the Spaces, kept in sync with them, for searching whole grids (see MapPlanes).
+   * For example, to check if the Player can reach the End:
+   *   @code
+   *   map.planes().can_reach(map.spaces(),map.player_init_pos(),MapPlanes::Plane::kEnd);
+   *   @endcode
+   */
+  const MapPlanes& planes() const;
   const Space* space(const Pos3i& pos) const;
 
   int total_cells() const;
@@ -173,6 +232,50 @@ protected:
   static inline const std::string kHeaderFmt = "[EkoScape/v{}]";
   static inline const std::regex kHeaderRegex{R"(^\s*\[EkoScape/v(\d+)\]\s*$)",std::regex::icase};
 
+  static constexpr char kBinMagic[4] = {'E','K','O','B'};
+  static constexpr std::uint32_t kBinByteOrder = 0x01020304;
+  static constexpr std::uint32_t kBinVersion = 1;
+
+  // Layout: [BinHeader][title][author][padding][BinGrid...][BinMark...][padding][spaces of each grid...].
+  struct BinHeader {
+    char magic[4]{};
+    std::uint32_t byte_order = 0;
+    std::uint32_t bin_version = 0;
+    std::int32_t version = 0; // Of the map (same as the text header).
+    float turning_speed = 0.0f;
+    float walking_speed = 0.0f;
+    std::int32_t robot_delay_millis = 0;
+    std::int32_t default_empty = 0;
+    std::int32_t grid_count = 0;
+    std::int32_t grid_z = 0;
+    std::int32_t player_x = 0;
+    std::int32_t player_y = 0;
+    std::int32_t player_z = 0;
+    std::int32_t player_facing = 0;
+    std::int32_t total_cells = 0; // Only informative; counted from the grids on load.
+    std::uint32_t mark_count = 0;
+    std::uint64_t title_offset = 0;
+    std::uint64_t title_size = 0;
+    std::uint64_t author_offset = 0;
+    std::uint64_t author_size = 0;
+    std::uint64_t grids_offset = 0;
+    std::uint64_t marks_offset = 0;
+  };
+
+  struct BinGrid {
+    std::int32_t w = 0;
+    std::int32_t h = 0;
+    std::uint64_t spaces_offset = 0;
+  };
+
+  // A space for SpaceCallback.
+  struct BinMark {
+    std::int32_t x = 0;
+    std::int32_t y = 0;
+    std::int32_t z = 0;
+    std::int32_t type = 0;
+  };
+
   int version_ = kSupportedVersions.max;
   std::string title_{};
   std::string author_{};
@@ -181,7 +284,8 @@ protected:
   SpaceType default_empty_ = SpaceType::kEmpty;
   Duration robot_delay_ = Duration::from_millis(900);
 
-  std::vector<std::unique_ptr<MapGrid>> grids_{};
+  MapSpaces spaces_{}; // All grids.
+  MapPlanes planes_{};
   int grid_z_ = -1;
 
   int total_cells_ = 0;
@@ -190,6 +294,11 @@ protected:
   Facing player_init_facing_ = Facings::kFallback;
 
   static bool parse_header(const std::string& line,int& version,bool warn = true);
+  static bool check_bin_header(const BinHeader& header);
+
+  void load_bin_file(const std::filesystem::path& file,const SpaceCallback& on_space,
+                     const DefaultEmptyCallback& on_default_empty,bool meta_only);
+  void set_bin_mark_type(const Pos3i& pos,SpaceType type);
 
   void load_metadata(TextReader& reader,std::string_view file);
   void load_grids(TextReader& reader,const SpaceCallback& on_space,
@@ -0,0 +1,298 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "map_index.h"
+
+#include "cybel/types/cybel_error.h"
+#include "cybel/util/tool_util.h"
+#include "cybel/util/tracer.h"
+
+#include "map/map.h"
+
+#include <fstream>
+#include <optional>
+#include <unordered_set>
+
+namespace ekoscape {
+
+MapIndex::MapIndex(std::filesystem::path file)
+  : file_(std::move(file)) {}
+
+std::vector<MapMeta> MapIndex::glob(const std::vector<std::filesystem::path>& maps_dirs) {
+  std::vector<MapMeta> maps{};
+  const std::atomic<bool> is_canceled{false};
+
+  glob(maps_dirs,[&](auto&& batch) {
+    maps.insert(maps.end(),std::make_move_iterator(batch.begin()),std::make_move_iterator(batch.end()));
+  },is_canceled);
+
+  return maps;
+}
+
+void MapIndex::glob(const std::vector<std::filesystem::path>& maps_dirs,const BatchCallback& on_batch,
+                    const std::atomic<bool>& is_canceled) {
+  const Tracer::Scope trace{"glob_maps","map"};
+  const std::scoped_lock lock{mutex_};
+
+  if(!is_loaded_) {
+    load();
+    is_loaded_ = true;
+  }
+
+  // Only the group folders are listed here; their files are crawled in parallel below.
+  std::vector<std::pair<std::filesystem::path,std::string>> groups{};
+
+  for(const auto& maps_dir : maps_dirs) {
+    std::error_code err_code{}; // For noexcept overload.
+
+    if(!is_directory(maps_dir,err_code)) { continue; }
+
+    try {
+      for(const auto& group_entry : std::filesystem::directory_iterator(maps_dir)) {
+        if(!group_entry.is_directory(err_code)) { continue; }
+
+        groups.emplace_back(group_entry.path(),group_entry.path().filename().string());
+      }
+    } catch(const std::filesystem::filesystem_error& e) {
+      std::cerr << "[WARN] Failed to crawl maps folder [" << maps_dir.string() << "]: " << e.what() << '.'
+                << std::endl;
+    }
+  }
+
+  // Merge in order (not in the order that the crawls finished), so the first map of a group/filename wins.
+  std::unordered_map<std::string,Entry> entries{};
+  std::unordered_set<std::string> map_keys{};
+  int map_count = 0;
+  int read_count = 0;
+
+  const auto merge = [&](GroupResult&& result) {
+    std::vector<MapMeta> batch{};
+    read_count += result.read_count;
+
+    for(auto& [path,entry] : result.entries) {
+      if(entry.is_map) {
+        auto map_key = entry.meta.group + '/' + entry.meta.file.filename().string();
+
+        if(map_keys.insert(std::move(map_key)).second) { batch.push_back(entry.meta); }
+      }
+
+      entries.insert_or_assign(std::move(path),std::move(entry));
+    }
+
+    map_count += static_cast<int>(batch.size());
+    if(!batch.empty() && !is_canceled.load(std::memory_order_relaxed)) { on_batch(std::move(batch)); }
+  };
+
+  // Whichever thread finishes a group merges it & any done groups after it, so the batches stream in order.
+  std::vector<std::optional<GroupResult>> results(groups.size());
+  std::size_t next_merge = 0;
+  std::mutex merge_mutex{};
+
+  ToolUtil::run_jobs(0,groups.size(),[&](std::size_t i) {
+    auto result = crawl_group(groups[i].first,groups[i].second,is_canceled);
+    const std::scoped_lock lock{merge_mutex};
+
+    results[i] = std::move(result);
+
+    for(; next_merge < results.size() && results[next_merge]; ++next_merge) {
+      merge(std::move(*results[next_merge]));
+      results[next_merge].reset();
+    }
+  });
+
+  if(is_canceled.load(std::memory_order_relaxed)) {
+    // Don't know which files were removed, so only keep what was read.
+    if(read_count <= 0) { return; }
+
+    for(auto& [path,entry] : entries) { entries_.insert_or_assign(path,std::move(entry)); }
+  } else {
+    // Any file read, added, or removed?
+    if(read_count <= 0 && entries.size() == entries_.size()) { return; }
+
+    entries_ = std::move(entries);
+  }
+
+  std::cout << "[INFO] Indexed [" << map_count << "] maps; read [" << read_count << "] new or changed files."
+            << std::endl;
+  save();
+}
+
+MapIndex::GroupResult MapIndex::crawl_group(const std::filesystem::path& group_dir,const std::string& group,
+                                            const std::atomic<bool>& is_canceled) const {
+  const Tracer::Scope trace{"crawl_map_group","map",group};
+  GroupResult result{};
+
+  try {
+    for(const auto& map_entry : std::filesystem::directory_iterator(group_dir)) {
+      if(is_canceled.load(std::memory_order_relaxed)) { break; }
+
+      std::error_code err_code{}; // For noexcept overload.
+
+      if(!map_entry.is_regular_file(err_code)) { continue; }
+
+      Stamp stamp{};
+      stamp.size = map_entry.file_size(err_code);
+      if(err_code) { continue; }
+      const auto mtime = map_entry.last_write_time(err_code);
+      if(err_code) { continue; }
+      stamp.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+
+      const auto& map_file = map_entry.path();
+      auto path = map_file.string();
+      const auto it = entries_.find(path); // Read-only while crawling, so no lock needed.
+
+      if(it != entries_.end() && it->second.stamp == stamp) {
+        result.entries.emplace_back(std::move(path),it->second);
+      } else {
+        result.entries.emplace_back(std::move(path),read_entry(map_file,group,stamp));
+        ++result.read_count;
+      }
+    }
+  } catch(const std::filesystem::filesystem_error& e) {
+    std::cerr << "[WARN] Failed to crawl maps group folder [" << group_dir.string() << "]: " << e.what()
+              << '.' << std::endl;
+  }
+
+  return result;
+}
+
+MapIndex::Entry MapIndex::read_entry(const std::filesystem::path& map_file,const std::string& group,
+                                     const Stamp& stamp) {
+  Entry entry{};
+  entry.stamp = stamp;
+
+  Map map{};
+
+  try {
+    map.load_file_meta(map_file);
+  } catch(const CybelError& e) {
+    // Only warn for broken maps, not for other files (e.g., a README), without opening every file twice.
+    if(Map::is_map_file(map_file)) { std::cerr << "[WARN] " << e.what() << std::endl; }
+
+    return entry;
+  }
+
+  entry.is_map = true;
+  entry.meta.group = group;
+  entry.meta.file = map_file;
+  entry.meta.version = map.version();
+  entry.meta.title = map.title();
+  entry.meta.author = map.author();
+
+  return entry;
+}
+
+void MapIndex::load() {
+  if(file_.empty()) { return; }
+
+  std::ifstream fin{file_,std::ios::in | std::ios::binary};
+
+  if(!fin) { return; } // Not saved yet.
+
+  // Each entry is 8 lines, since none of the values can have a newline.
+  const auto read_line = [&](std::string& line) {
+    if(!std::getline(fin,line)) { return false; }
+    if(!line.empty() && line.back() == '\r') { line.pop_back(); }
+
+    return true;
+  };
+
+  std::string line{};
+
+  if(!read_line(line) || line != kHeader) {
+    std::cerr << "[WARN] Invalid header in map index [" << file_.string() << "]; ignoring it." << std::endl;
+    return;
+  }
+
+  std::string path{};
+  std::array<std::string,7> fields{};
+
+  try {
+    while(read_line(path)) {
+      for(auto& field : fields) {
+        if(!read_line(field)) { throw CybelError{"Truncated entry [",path,"]."}; }
+      }
+
+      Entry entry{};
+      entry.stamp.size = std::stoull(fields[0]);
+      entry.stamp.mtime = std::stoll(fields[1]);
+      entry.is_map = (fields[2] == "1");
+
+      if(entry.is_map) {
+        entry.meta.group = std::move(fields[3]);
+        entry.meta.file = path;
+        entry.meta.version = std::stoi(fields[4]);
+        entry.meta.title = std::move(fields[5]);
+        entry.meta.author = std::move(fields[6]);
+      }
+
+      entries_.insert_or_assign(std::move(path),std::move(entry));
+    }
+  } catch(const std::exception& e) { // CybelError, std::invalid_argument, or std::out_of_range.
+    std::cerr << "[WARN] Invalid map index [" << file_.string() << "]: " << e.what() << " Ignoring it."
+              << std::endl;
+    entries_.clear();
+  }
+}
+
+void MapIndex::save() const {
+  if(file_.empty()) { return; }
+
+  // Write to a temp file first, so that a failed write doesn't leave a partial index.
+  auto temp_file = file_;
+  temp_file += ".tmp";
+
+  {
+    std::ofstream fout{temp_file,std::ios::out | std::ios::binary | std::ios::trunc};
+
+    if(!fout) {
+      std::cerr << "[WARN] Failed to open map index [" << temp_file.string() << "] for writing." << std::endl;
+      return;
+    }
+
+    fout << kHeader << '\n';
+
+    for(const auto& [path,entry] : entries_) {
+      const auto& meta = entry.meta;
+
+      // Just read it again next time.
+      if(path.find_first_of("\r\n") != std::string::npos ||
+         meta.title.find_first_of("\r\n") != std::string::npos ||
+         meta.author.find_first_of("\r\n") != std::string::npos) {
+        continue;
+      }
+
+      fout << path << '\n'
+           << entry.stamp.size << '\n'
+           << entry.stamp.mtime << '\n'
+           << (entry.is_map ? '1' : '0') << '\n'
+           << meta.group << '\n'
+           << meta.version << '\n'
+           << meta.title << '\n'
+           << meta.author << '\n';
+    }
+
+    fout.flush();
+
+    if(!fout) {
+      std::cerr << "[WARN] Failed to write map index [" << temp_file.string() << "]." << std::endl;
+      return;
+    }
+  }
+
+  std::error_code err_code{}; // For noexcept overload.
+  std::filesystem::rename(temp_file,file_,err_code);
+
+  if(err_code) {
+    std::cerr << "[WARN] Failed to save map index [" << file_.string() << "]: " << err_code.message() << '.'
+              << std::endl;
+  }
+}
+
+const std::filesystem::path& MapIndex::file() const { return file_; }
+
+} // namespace ekoscape
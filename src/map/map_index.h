@@ -0,0 +1,114 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_MAP_MAP_INDEX_H_
+#define EKOSCAPE_MAP_MAP_INDEX_H_
+
+#include "common.h"
+
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ekoscape {
+
+struct MapMeta {
+  std::string group{};
+  std::filesystem::path file{};
+  int version = 0;
+  std::string title{};
+  std::string author{};
+};
+
+/**
+ * Index of the metadata of the maps in the group folders of maps folders (e.g., `assets/maps/<group>/`),
+ * which is saved to a file so that only new or changed files (by size & modified time) are read again.
+ *
+ * Files that aren't maps (e.g., `.gitkeep`) are also indexed, so that they aren't read every time either.
+ *
+ * The group folders are crawled on a pool of threads (see ToolUtil::run_jobs()).
+ * It's thread-safe, but only one glob runs at a time.
+ */
+class MapIndex {
+public:
+  using BatchCallback = std::function<void(std::vector<MapMeta>&& maps)>;
+
+  static inline const std::string kFilename = "map_index.txt";
+
+  /**
+   * If `file` is empty, the index is only kept in memory.
+   */
+  explicit MapIndex(std::filesystem::path file = {});
+
+  MapIndex(const MapIndex& other) = delete;
+  MapIndex(MapIndex&& other) noexcept = delete;
+  virtual ~MapIndex() noexcept = default;
+
+  MapIndex& operator=(const MapIndex& other) = delete;
+  MapIndex& operator=(MapIndex&& other) noexcept = delete;
+
+  /**
+   * Returns the maps in the group folders of `maps_dirs`.
+   *
+   * If a map with the same group & filename is in more than one maps folder, the first one is used,
+   * so that the user can overwrite maps.
+   * The maps are in the order of `maps_dirs`, then of the folders (not sorted).
+   */
+  std::vector<MapMeta> glob(const std::vector<std::filesystem::path>& maps_dirs);
+  /**
+   * Same as the other glob(), but passes the maps of each group folder (in order) to `on_batch` as soon as
+   * they're ready, so that this can be run on a worker thread.
+   * `on_batch` is called from any of the crawl threads, but only one at a time.
+   *
+   * Stops early if `is_canceled` is set (e.g., from another thread). The files that were read are still
+   * indexed, but no files are removed from the index.
+   */
+  void glob(const std::vector<std::filesystem::path>& maps_dirs,const BatchCallback& on_batch,
+            const std::atomic<bool>& is_canceled);
+
+  const std::filesystem::path& file() const;
+
+private:
+  struct Stamp {
+    std::uintmax_t size = 0;
+    std::int64_t mtime = 0;
+
+    bool operator==(const Stamp& other) const = default;
+  };
+
+  struct Entry {
+    Stamp stamp{};
+    bool is_map = false;
+    MapMeta meta{};
+  };
+
+  struct GroupResult {
+    std::vector<std::pair<std::string,Entry>> entries{}; // Keyed by path, in folder order.
+    int read_count = 0; // Of new or changed files.
+  };
+
+  static inline const std::string kHeader = "[EkoScapeMapIndex/v1]";
+
+  std::filesystem::path file_{};
+
+  std::mutex mutex_{}; // For the vars below.
+  std::unordered_map<std::string,Entry> entries_{};
+  bool is_loaded_ = false;
+
+  static Entry read_entry(const std::filesystem::path& map_file,const std::string& group,const Stamp& stamp);
+
+  void load();
+  void save() const;
+  GroupResult crawl_group(const std::filesystem::path& group_dir,const std::string& group,
+                          const std::atomic<bool>& is_canceled) const;
+};
+
+} // namespace ekoscape
+#endif
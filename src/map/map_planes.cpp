@@ -0,0 +1,393 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "map_planes.h"
+
+#include "cybel/types/cybel_error.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace ekoscape {
+
+void MapPlanes::clear() { grids_.clear(); }
+
+void MapPlanes::build_grid(const MapSpaces& spaces,int z) {
+  if(z < 0 || z > grid_count()) {
+    throw CybelError{"Invalid grid [",z,"] for planes of [",grid_count(),"] grids."};
+  }
+  if(z == grid_count()) { grids_.emplace_back(); }
+
+  Grid& grid = grids_[static_cast<std::size_t>(z)];
+
+  grid.size = spaces.size(z);
+  grid.words_per_row = (grid.size.w + kWordBits - 1) / kWordBits;
+
+  const auto word_count = word_index(grid,0,grid.size.h); // Index past the last row.
+
+  for(auto& plane : grid.planes) { plane.assign(word_count,0); }
+
+  for(Pos3i pos{0,0,z}; pos.y < grid.size.h; ++pos.y) {
+    for(pos.x = 0; pos.x < grid.size.w; ++pos.x) {
+      const auto plane_bits = calc_plane_bits(spaces.unsafe_space(pos));
+      const auto i = word_index(grid,pos.x,pos.y);
+      const Word bit = Word{1} << (pos.x % kWordBits);
+
+      for(std::size_t p = 0; p < plane_bits.size(); ++p) {
+        if(plane_bits[p]) { grid.planes[p][i] |= bit; }
+      }
+    }
+  }
+}
+
+void MapPlanes::sync(const Pos3i& pos,const Space& space) {
+  if(!in_bounds(pos)) { return; }
+
+  Grid& grid = grids_[static_cast<std::size_t>(pos.z)];
+  const auto plane_bits = calc_plane_bits(space);
+  const auto i = word_index(grid,pos.x,pos.y);
+  const Word bit = Word{1} << (pos.x % kWordBits);
+
+  for(std::size_t p = 0; p < plane_bits.size(); ++p) {
+    if(plane_bits[p]) {
+      grid.planes[p][i] |= bit;
+    } else {
+      grid.planes[p][i] &= ~bit;
+    }
+  }
+}
+
+std::array<bool,MapPlanes::kPlaneCount> MapPlanes::calc_plane_bits(const Space& space) {
+  std::array<bool,kPlaneCount> plane_bits{};
+
+  plane_bits[to_i(Plane::kWalkable)] = space.is_walkable();
+  plane_bits[to_i(Plane::kPlayerWalkable)] = SpaceTypes::is_walkable(space.type());
+  plane_bits[to_i(Plane::kThing)] = space.has_thing();
+  plane_bits[to_i(Plane::kRobot)] = space.has_robot();
+  plane_bits[to_i(Plane::kCell)] = (space.thing_type() == SpaceType::kCell);
+  plane_bits[to_i(Plane::kEnd)] = (space.thing_type() == SpaceType::kEnd);
+  plane_bits[to_i(Plane::kPortal)] = space.is_portal();
+
+  return plane_bits;
+}
+
+std::vector<MapPlanes::Bits> MapPlanes::reach(const MapSpaces& spaces,const Pos3i& from_pos) const {
+  std::vector<Bits> reached(grids_.size());
+
+  for(std::size_t z = 0; z < grids_.size(); ++z) {
+    reached[z].assign(grids_[z].planes[to_i(Plane::kPlayerWalkable)].size(),0);
+  }
+
+  if(!in_bounds(from_pos)) { return reached; }
+
+  // The Player can start on a non-walkable Space (e.g., a default empty of White),
+  //     so seed its walkable neighbors too.
+  const Pos3i seed_poses[] = {
+    from_pos,
+    Pos3i{from_pos.x,from_pos.y + 1,from_pos.z}, // North.
+    Pos3i{from_pos.x,from_pos.y - 1,from_pos.z}, // South.
+    Pos3i{from_pos.x + 1,from_pos.y,from_pos.z}, // East.
+    Pos3i{from_pos.x - 1,from_pos.y,from_pos.z}, // West.
+  };
+
+  for(const auto& pos : seed_poses) {
+    if(!test(Plane::kPlayerWalkable,pos)) { continue; }
+
+    reached[static_cast<std::size_t>(pos.z)][word_index(grid(pos.z),pos.x,pos.y)] |=
+        Word{1} << (pos.x % kWordBits);
+  }
+
+  std::vector<std::uint8_t> pendings(grids_.size(),0);
+  std::array<bool,256> linked_portals{}; // Indexed by SpaceType as unsigned.
+  std::vector<SpaceType> new_portals{};
+
+  pendings[static_cast<std::size_t>(from_pos.z)] = 1;
+
+  // Fill each grid, then warp to the bros of any newly reached Portal types, until nothing new.
+  while(true) {
+    bool has_filled = false;
+
+    for(std::size_t z = 0; z < grids_.size(); ++z) {
+      if(pendings[z] == 0) { continue; }
+
+      pendings[z] = 0;
+      flood_fill(grids_[z],reached[z]);
+      has_filled = true;
+    }
+
+    if(!has_filled) { break; }
+
+    new_portals.clear();
+
+    for(std::size_t z = 0; z < grids_.size(); ++z) {
+      const Grid& grid = grids_[z];
+      const Bits& portals = grid.planes[to_i(Plane::kPortal)];
+
+      for(std::size_t i = 0; i < portals.size(); ++i) {
+        for(Word word = portals[i] & reached[z][i]; word != 0; word &= (word - 1)) {
+          const Pos3i pos = to_pos(grid,static_cast<int>(z),i,std::countr_zero(word));
+          const SpaceType type = spaces.unsafe_space(pos).empty_type();
+          auto& is_linked = linked_portals[static_cast<unsigned char>(type)];
+
+          if(!is_linked) {
+            is_linked = true;
+            new_portals.push_back(type);
+          }
+        }
+      }
+    }
+
+    if(new_portals.empty()) { break; }
+
+    for(std::size_t z = 0; z < grids_.size(); ++z) {
+      const Grid& grid = grids_[z];
+      const Bits& portals = grid.planes[to_i(Plane::kPortal)];
+
+      for(std::size_t i = 0; i < portals.size(); ++i) {
+        for(Word word = portals[i] & ~reached[z][i]; word != 0; word &= (word - 1)) {
+          const int bit_index = std::countr_zero(word);
+          const Pos3i pos = to_pos(grid,static_cast<int>(z),i,bit_index);
+          const SpaceType type = spaces.unsafe_space(pos).empty_type();
+
+          if(std::ranges::find(new_portals,type) == new_portals.end()) { continue; }
+
+          reached[z][i] |= Word{1} << bit_index;
+          pendings[z] = 1;
+        }
+      }
+    }
+  }
+
+  return reached;
+}
+
+bool MapPlanes::can_reach(const MapSpaces& spaces,const Pos3i& from_pos,Plane target) const {
+  const auto reached = reach(spaces,from_pos);
+
+  for(std::size_t z = 0; z < grids_.size(); ++z) {
+    const Bits& targets = grids_[z].planes[to_i(target)];
+
+    for(std::size_t i = 0; i < targets.size(); ++i) {
+      if((targets[i] & reached[z][i]) != 0) { return true; }
+    }
+  }
+
+  return false;
+}
+
+int MapPlanes::dist_to_nearest(const Pos3i& from_pos,Plane target) const {
+  if(!in_bounds(from_pos)) { return kUnreachable; }
+  if(test(target,from_pos)) { return 0; }
+
+  const Grid& grid = this->grid(from_pos.z);
+  const Bits& walkables = grid.planes[to_i(Plane::kPlayerWalkable)];
+  const Bits& targets = grid.planes[to_i(target)];
+  const auto row_size = static_cast<std::size_t>(grid.words_per_row);
+
+  Bits visited(walkables.size(),0);
+  Bits frontier(walkables.size(),0);
+  Bits next(walkables.size(),0);
+
+  const auto from_i = word_index(grid,from_pos.x,from_pos.y);
+  visited[from_i] = frontier[from_i] = Word{1} << (from_pos.x % kWordBits);
+
+  // Only the rows of the frontier (& the rows next to them) are stepped,
+  //     instead of the whole grid for each step.
+  int min_y = from_pos.y;
+  int max_y = from_pos.y;
+
+  for(int dist = 1; ; ++dist) {
+    const int begin_y = std::max(min_y - 1,0);
+    const int end_y = std::min(max_y + 1,grid.size.h - 1);
+    int next_min_y = grid.size.h;
+    int next_max_y = -1;
+    bool has_target = false;
+
+    for(int y = begin_y; y <= end_y; ++y) {
+      const auto row = static_cast<std::size_t>(y) * row_size;
+
+      for(std::size_t i = row; i < (row + row_size); ++i) {
+        const Word word = frontier[i];
+
+        // East & West (including across words), then North & South.
+        Word grown = word | (word << 1) | (word >> 1);
+        if(i > row) { grown |= frontier[i - 1] >> (kWordBits - 1); }
+        if((i + 1) < (row + row_size)) { grown |= frontier[i + 1] << (kWordBits - 1); }
+        if(y > 0) { grown |= frontier[i - row_size]; }
+        if((y + 1) < grid.size.h) { grown |= frontier[i + row_size]; }
+
+        const Word next_word = grown & walkables[i] & ~visited[i];
+        next[i] = next_word;
+
+        if(next_word != 0) {
+          next_min_y = std::min(next_min_y,y);
+          next_max_y = std::max(next_max_y,y);
+          has_target = has_target || ((next_word & targets[i]) != 0);
+        }
+      }
+    }
+
+    if(has_target) { return dist; }
+    if(next_max_y < 0) { return kUnreachable; }
+
+    for(int y = begin_y; y <= end_y; ++y) {
+      const auto row = static_cast<std::size_t>(y) * row_size;
+
+      for(std::size_t i = row; i < (row + row_size); ++i) { visited[i] |= next[i]; }
+    }
+    // Clear the old frontier, so that it can be reused for the next step (only rows in range are ever set).
+    for(int y = min_y; y <= max_y; ++y) {
+      const auto row = static_cast<std::size_t>(y) * row_size;
+
+      std::fill_n(frontier.begin() + static_cast<std::ptrdiff_t>(row),row_size,0);
+    }
+
+    frontier.swap(next);
+    min_y = next_min_y;
+    max_y = next_max_y;
+  }
+}
+
+void MapPlanes::flood_fill(const Grid& grid,Bits& reached) {
+  // Sweep up the rows & then back down, which fills most areas in one or two rounds;
+  //     it only needs more rounds for areas that wind back & forth vertically.
+  for(bool has_changed = true; has_changed;) {
+    has_changed = false;
+
+    for(int y = 0; y < grid.size.h; ++y) {
+      if(spread_row(grid,reached,y,y - 1)) { has_changed = true; }
+    }
+    for(int y = grid.size.h - 1; y >= 0; --y) {
+      if(spread_row(grid,reached,y,y + 1)) { has_changed = true; }
+    }
+  }
+}
+
+bool MapPlanes::spread_row(const Grid& grid,Bits& reached,int y,int from_y) {
+  const Bits& walkables = grid.planes[to_i(Plane::kPlayerWalkable)];
+  const auto row_size = static_cast<std::size_t>(grid.words_per_row);
+  const auto row = static_cast<std::size_t>(y) * row_size;
+  const bool has_from_row = (from_y >= 0 && from_y < grid.size.h);
+  const auto from_row = has_from_row ? (static_cast<std::size_t>(from_y) * row_size) : 0;
+  bool has_changed = false;
+
+  // Fill East (up the bits), carrying into the first bit of the next word.
+  Word carry = 0;
+
+  for(std::size_t i = 0; i < row_size; ++i) {
+    const Word mask = walkables[row + i];
+    Word& word = reached[row + i];
+    Word seeds = word | carry;
+
+    if(has_from_row) { seeds |= reached[from_row + i]; }
+
+    const Word filled = fill_up(seeds & mask,mask);
+
+    carry = filled >> (kWordBits - 1);
+    if(filled != word) { has_changed = true; }
+    word = filled;
+  }
+
+  // Fill West (down the bits), carrying into the last bit of the previous word.
+  carry = 0;
+
+  for(std::size_t i = row_size; i-- > 0;) {
+    const Word mask = walkables[row + i];
+    Word& word = reached[row + i];
+    const Word filled = fill_down((word | (carry << (kWordBits - 1))) & mask,mask);
+
+    carry = filled & 1;
+    if(filled != word) { has_changed = true; }
+    word = filled;
+  }
+
+  return has_changed;
+}
+
+MapPlanes::Word MapPlanes::fill_up(Word seeds,Word mask) {
+  // Kogge-Stone fill: each seed spreads through its run of mask bits in log2(64) steps.
+  seeds |= mask & (seeds << 1);
+  mask &= (mask << 1);
+  seeds |= mask & (seeds << 2);
+  mask &= (mask << 2);
+  seeds |= mask & (seeds << 4);
+  mask &= (mask << 4);
+  seeds |= mask & (seeds << 8);
+  mask &= (mask << 8);
+  seeds |= mask & (seeds << 16);
+  mask &= (mask << 16);
+  seeds |= mask & (seeds << 32);
+
+  return seeds;
+}
+
+MapPlanes::Word MapPlanes::fill_down(Word seeds,Word mask) {
+  seeds |= mask & (seeds >> 1);
+  mask &= (mask >> 1);
+  seeds |= mask & (seeds >> 2);
+  mask &= (mask >> 2);
+  seeds |= mask & (seeds >> 4);
+  mask &= (mask >> 4);
+  seeds |= mask & (seeds >> 8);
+  mask &= (mask >> 8);
+  seeds |= mask & (seeds >> 16);
+  mask &= (mask >> 16);
+  seeds |= mask & (seeds >> 32);
+
+  return seeds;
+}
+
+int MapPlanes::grid_count() const { return static_cast<int>(grids_.size()); }
+
+const Size2i& MapPlanes::size(int z) const { return grid(z).size; }
+
+int MapPlanes::words_per_row(int z) const { return grid(z).words_per_row; }
+
+const MapPlanes::Bits& MapPlanes::bits(Plane plane,int z) const { return grid(z).planes[to_i(plane)]; }
+
+bool MapPlanes::test(Plane plane,const Pos3i& pos) const {
+  if(!in_bounds(pos)) { return false; }
+
+  const Grid& grid = this->grid(pos.z);
+
+  return ((grid.planes[to_i(plane)][word_index(grid,pos.x,pos.y)] >> (pos.x % kWordBits)) & 1) != 0;
+}
+
+int MapPlanes::count(Plane plane,int z,const Bits& mask,bool invert_mask) const {
+  const Bits& bits = grid(z).planes[to_i(plane)];
+  int count = 0;
+
+  for(std::size_t i = 0; i < bits.size(); ++i) {
+    count += std::popcount(bits[i] & (invert_mask ? ~mask[i] : mask[i]));
+  }
+
+  return count;
+}
+
+std::size_t MapPlanes::word_index(const Grid& grid,int x,int y) {
+  return (static_cast<std::size_t>(y) * static_cast<std::size_t>(grid.words_per_row)) +
+         static_cast<std::size_t>(x / kWordBits);
+}
+
+Pos3i MapPlanes::to_pos(const Grid& grid,int z,std::size_t word_index,int bit_index) {
+  const auto row_size = static_cast<std::size_t>(grid.words_per_row);
+
+  return Pos3i{(static_cast<int>(word_index % row_size) * kWordBits) + bit_index,
+               static_cast<int>(word_index / row_size),z};
+}
+
+const MapPlanes::Grid& MapPlanes::grid(int z) const { return grids_[static_cast<std::size_t>(z)]; }
+
+bool MapPlanes::in_bounds(const Pos3i& pos) const {
+  if(pos.z < 0 || pos.z >= grid_count()) { return false; }
+
+  const Size2i& size = grid(pos.z).size;
+
+  return pos.x >= 0 && pos.x < size.w && pos.y >= 0 && pos.y < size.h;
+}
+
+} // namespace ekoscape
@@ -0,0 +1,124 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_MAP_MAP_PLANES_H_
+#define EKOSCAPE_MAP_MAP_PLANES_H_
+
+#include "common.h"
+
+#include "cybel/types/pos.h"
+#include "cybel/types/size.h"
+
+#include "map/map_spaces.h"
+#include "map/space.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * Bit planes (bitboards) of the traits of every Space of a Map, 64 Spaces per word,
+ * so that a whole grid can be searched a row of words at a time (e.g., flood fills),
+ * instead of Space by Space.
+ *
+ * Each row starts on a new word, so that the rows above & below are just whole words away.
+ * The bits past the width of a row are always 0.
+ *
+ * Map keeps these in sync with its Spaces (see Map.planes()).
+ *
+ * There's no plane for Ghosts, since they can go on any Space in bounds.
+ */
+class MapPlanes {
+public:
+  using Word = std::uint64_t;
+  using Bits = std::vector<Word>; // One plane of one grid.
+
+  enum class Plane : std::uint8_t {
+    kWalkable, // By the empty type, like Robots (see FlowField).
+    kPlayerWalkable, // By the type, like Dantares (a Thing on a White Space is walkable, until it's removed).
+    kThing,
+    kRobot,
+    kCell,
+    kEnd,
+    kPortal,
+  };
+
+  static constexpr int kPlaneCount = 7;
+  static constexpr int kWordBits = 64;
+  static constexpr int kUnreachable = std::numeric_limits<int>::max();
+
+  void clear();
+  /**
+   * Builds (or rebuilds) the planes of grid `z` from `spaces`.
+   * Grids must be added in order, so `z` can be at most grid_count().
+   */
+  void build_grid(const MapSpaces& spaces,int z);
+  /**
+   * Updates the bits of `pos` from `space`, after it changed.
+   * Ignores grids that haven't been built yet (e.g., while parsing).
+   */
+  void sync(const Pos3i& pos,const Space& space);
+
+  /**
+   * Returns the Spaces (per grid) that the Player can walk to from `from_pos` (see kPlayerWalkable),
+   * including through Portals (to all other Portals of the same type, on any grid).
+   *
+   * `from_pos` itself doesn't need to be walkable (e.g., the Player's init pos).
+   */
+  std::vector<Bits> reach(const MapSpaces& spaces,const Pos3i& from_pos) const;
+  bool can_reach(const MapSpaces& spaces,const Pos3i& from_pos,Plane target) const;
+  /**
+   * Returns the number of steps that the Player must walk from `from_pos` to the nearest Space in `target`
+   * on the same grid (not through Portals, since they warp randomly), else kUnreachable.
+   *
+   * Each step grows the whole frontier a row of words at a time, which is best for nearby targets
+   * (e.g., the nearest Cell); for far targets, a BFS Space by Space visits fewer words.
+   */
+  int dist_to_nearest(const Pos3i& from_pos,Plane target) const;
+
+  int grid_count() const;
+  /**
+   * Z must be valid (for all funcs below).
+   */
+  const Size2i& size(int z) const;
+  int words_per_row(int z) const;
+  const Bits& bits(Plane plane,int z) const;
+  bool test(Plane plane,const Pos3i& pos) const;
+  /**
+   * Returns the number of bits set in both `plane` & `mask` of grid `z` (e.g., Cells not in a reach).
+   */
+  int count(Plane plane,int z,const Bits& mask,bool invert_mask = false) const;
+
+private:
+  struct Grid {
+    Size2i size{};
+    int words_per_row = 0;
+    std::array<Bits,kPlaneCount> planes{};
+  };
+
+  std::vector<Grid> grids_{};
+
+  static constexpr std::size_t to_i(Plane plane) { return static_cast<std::size_t>(plane); }
+  static std::array<bool,kPlaneCount> calc_plane_bits(const Space& space);
+  static Word fill_up(Word seeds,Word mask);
+  static Word fill_down(Word seeds,Word mask);
+
+  static std::size_t word_index(const Grid& grid,int x,int y);
+  static Pos3i to_pos(const Grid& grid,int z,std::size_t word_index,int bit_index);
+  static void flood_fill(const Grid& grid,Bits& reached);
+  static bool spread_row(const Grid& grid,Bits& reached,int y,int from_y);
+
+  const Grid& grid(int z) const;
+  bool in_bounds(const Pos3i& pos) const;
+};
+
+} // namespace ekoscape
+#endif
@@ -0,0 +1,118 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "map_spaces.h"
+
+#include "cybel/types/cybel_error.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace ekoscape {
+
+// For raw_row().
+static_assert(std::is_trivially_copyable_v<Space>);
+static_assert(sizeof(Space) == 2);
+
+void MapSpaces::clear() {
+  grids_.clear();
+  spaces_.clear();
+}
+
+int MapSpaces::add_grid(const Size2i& size) {
+  if(size.w <= 0 || size.h <= 0) {
+    throw CybelError{"Grid size [",size,"] must at least be 1x1."};
+  }
+
+  const std::ptrdiff_t stride = size.w + 2;
+  const auto start = spaces_.size();
+  const auto area = static_cast<std::size_t>(stride) * static_cast<std::size_t>(size.h + 2);
+
+  Grid grid{};
+  grid.size = size;
+  grid.stride = stride;
+  grid.origin = start + static_cast<std::size_t>(stride) + 1;
+
+  // Fill the border & inside separately, instead of checking each Space.
+  spaces_.resize(start + area,kSentinel);
+
+  for(int y = 0; y < size.h; ++y) {
+    const auto row = spaces_.begin() + static_cast<std::ptrdiff_t>(grid.origin) + (y * stride);
+    std::fill(row,row + size.w,Space{});
+  }
+
+  grids_.push_back(grid);
+
+  return static_cast<int>(grids_.size()) - 1;
+}
+
+int MapSpaces::add_grid(const Size2i& size,std::span<const std::byte> raw_spaces) {
+  const auto row_size = static_cast<std::size_t>(size.w) * sizeof(Space);
+
+  if(size.w <= 0 || size.h <= 0 || raw_spaces.size() != (row_size * static_cast<std::size_t>(size.h))) {
+    throw CybelError{"Raw spaces of [",raw_spaces.size(),"] bytes don't match grid size [",size,"]."};
+  }
+
+  const int z = add_grid(size);
+  const Grid& grid = grids_.back();
+
+  for(int y = 0; y < size.h; ++y) {
+    std::memcpy(&spaces_[grid.origin + static_cast<std::size_t>(y * grid.stride)],
+                raw_spaces.data() + (static_cast<std::size_t>(y) * row_size),row_size);
+  }
+
+  return z;
+}
+
+void MapSpaces::shrink_to_fit() {
+  grids_.shrink_to_fit();
+  spaces_.shrink_to_fit();
+}
+
+int MapSpaces::grid_count() const { return static_cast<int>(grids_.size()); }
+
+bool MapSpaces::empty() const { return grids_.empty(); }
+
+const Size2i& MapSpaces::size(int z) const { return grid(z).size; }
+
+bool MapSpaces::in_bounds(const Pos3i& pos) const {
+  if(pos.z < 0 || pos.z >= static_cast<int>(grids_.size())) { return false; }
+
+  const Size2i& size = grid(pos.z).size;
+
+  return pos.x >= 0 && pos.x < size.w && pos.y >= 0 && pos.y < size.h;
+}
+
+MapSpaces::Offsets MapSpaces::neighbor_offsets(int z) const {
+  const std::ptrdiff_t stride = grid(z).stride;
+
+  return Offsets{stride,-stride,1,-1};
+}
+
+Space* MapSpaces::space(const Pos3i& pos) {
+  return in_bounds(pos) ? &spaces_[index_of(pos)] : nullptr;
+}
+
+const Space* MapSpaces::space(const Pos3i& pos) const {
+  return in_bounds(pos) ? &spaces_[index_of(pos)] : nullptr;
+}
+
+Space& MapSpaces::unsafe_space(const Pos3i& pos) { return spaces_[index_of(pos)]; }
+
+const Space& MapSpaces::unsafe_space(const Pos3i& pos) const { return spaces_[index_of(pos)]; }
+
+std::span<const std::byte> MapSpaces::raw_row(int z,int y) const {
+  const Grid& grid = this->grid(z);
+  const auto row = std::span{spaces_}.subspan(grid.origin + static_cast<std::size_t>(y * grid.stride),
+                                              static_cast<std::size_t>(grid.size.w));
+
+  return std::as_bytes(row);
+}
+
+const MapSpaces::Grid& MapSpaces::grid(int z) const { return grids_[static_cast<std::size_t>(z)]; }
+
+} // namespace ekoscape
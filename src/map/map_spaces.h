@@ -0,0 +1,112 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_MAP_MAP_SPACES_H_
+#define EKOSCAPE_MAP_MAP_SPACES_H_
+
+#include "common.h"
+
+#include "cybel/types/pos.h"
+#include "cybel/types/size.h"
+
+#include "map/space.h"
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * The Spaces of all grids of a Map in one contiguous allocation (grid after grid),
+ * where each grid is surrounded by a border of sentinel Spaces (kSentinel), which are never walkable.
+ *
+ * Like Dantares, the rows of a grid go from the bottom left (see Map).
+ *
+ * Because of the border, the 4 neighbors of any in-bounds pos can be looked up by index without any
+ * bounds checks (see index_of() & neighbor_offsets()). Any pos outside of the border must still be checked
+ * with in_bounds() or space() first.
+ *
+ * Example:
+ *   @code
+ *   const std::size_t index = spaces.index_of(pos); // Pos must be in bounds.
+ *
+ *   for(const auto offset : spaces.neighbor_offsets(pos.z)) {
+ *     if(spaces.at(index + offset).is_walkable()) {
+ *       // ...
+ *     }
+ *   }
+ *   @endcode
+ */
+class MapSpaces {
+public:
+  using Offsets = std::array<std::ptrdiff_t,4>;
+
+  static inline const Space kSentinel{SpaceType::kVoid};
+
+  void clear();
+  /**
+   * Returns the Z of the new grid, which is filled with default (empty) Spaces.
+   */
+  int add_grid(const Size2i& size);
+  /**
+   * Copies the Spaces from `raw_spaces` (rows without the border, like raw_row()),
+   * which must have exactly `size` Spaces.
+   */
+  int add_grid(const Size2i& size,std::span<const std::byte> raw_spaces);
+  void shrink_to_fit();
+
+  int grid_count() const;
+  bool empty() const;
+  /**
+   * Z must be valid.
+   */
+  const Size2i& size(int z) const;
+  bool in_bounds(const Pos3i& pos) const;
+
+  /**
+   * The pos can also be on the border (e.g., X of -1 or width), but Z must be valid.
+   */
+  std::size_t index_of(const Pos3i& pos) const {
+    const Grid& grid = grids_[static_cast<std::size_t>(pos.z)];
+
+    return static_cast<std::size_t>(static_cast<std::ptrdiff_t>(grid.origin) + (pos.y * grid.stride) + pos.x);
+  }
+  /**
+   * Offsets from an index to its neighbors: North(+Y), South(-Y), East(+X), & West(-X).
+   */
+  Offsets neighbor_offsets(int z) const;
+
+  Space* space(const Pos3i& pos);
+  const Space* space(const Pos3i& pos) const;
+  Space& unsafe_space(const Pos3i& pos);
+  const Space& unsafe_space(const Pos3i& pos) const;
+  // Inline, since these are used in hot loops.
+  Space& at(std::size_t index) { return spaces_[index]; }
+  const Space& at(std::size_t index) const { return spaces_[index]; }
+
+  /**
+   * A row of Spaces (without the border) in their in-memory layout, for saving as binary.
+   */
+  std::span<const std::byte> raw_row(int z,int y) const;
+
+private:
+  struct Grid {
+    Size2i size{};
+    std::ptrdiff_t stride = 0; // Width + border.
+    std::size_t origin = 0; // Index of (0,0), just inside the border.
+  };
+
+  std::vector<Grid> grids_{};
+  std::vector<Space> spaces_{};
+
+  const Grid& grid(int z) const;
+};
+
+} // namespace ekoscape
+#endif
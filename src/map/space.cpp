@@ -43,22 +43,4 @@ SpaceType Space::remove_thing() {
   return old_thing;
 }
 
-SpaceType Space::type() const {
-  return has_thing() ? thing_type_ : empty_type_;
-}
-
-SpaceType Space::empty_type() const { return empty_type_; }
-
-SpaceType Space::thing_type() const { return thing_type_; }
-
-bool Space::has_thing() const { return thing_type_ != SpaceType::kNil; }
-
-bool Space::has_robot() const { return SpaceTypes::is_robot(thing_type_); }
-
-bool Space::is_portal() const { return SpaceTypes::is_portal(empty_type_); }
-
-bool Space::is_walkable() const { return SpaceTypes::is_walkable(empty_type_); }
-
-bool Space::is_non_walkable() const { return SpaceTypes::is_non_walkable(empty_type_); }
-
 } // namespace ekoscape
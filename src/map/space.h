@@ -37,15 +37,18 @@ public:
    */
   SpaceType remove_thing();
 
-  SpaceType type() const;
-  SpaceType empty_type() const;
-  SpaceType thing_type() const;
-
-  bool has_thing() const;
-  bool has_robot() const;
-  bool is_portal() const;
-  bool is_walkable() const;
-  bool is_non_walkable() const;
+  // The getters are inline, since they're used in hot loops (e.g., scanning the neighbors of each Space).
+  SpaceType type() const { return has_thing() ? thing_type_ : empty_type_; }
+  SpaceType empty_type() const { return empty_type_; }
+  SpaceType thing_type() const { return thing_type_; }
+
+  bool has_thing() const { return thing_type_ != SpaceType::kNil; }
+  bool has_robot() const { return SpaceTypes::is_robot(thing_type_); }
+  bool is_portal() const { return SpaceTypes::is_portal(empty_type_); }
+  bool is_walkable() const { return SpaceTypes::is_walkable(empty_type_); }
+  bool is_non_walkable() const { return SpaceTypes::is_non_walkable(empty_type_); }
+
+  bool operator==(const Space& other) const = default;
 
 private:
   SpaceType empty_type_ = SpaceType::kEmpty;
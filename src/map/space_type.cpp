@@ -9,123 +9,13 @@
 
 namespace ekoscape {
 
-bool SpaceTypes::is_valid(SpaceType type) {
-  // NOTE: Don't use `default:` so that the compiler/IDE can catch new enum types.
-  switch(type) {
-    case SpaceType::kNil:
-      return false;
-
-    case SpaceType::kCell:
-    case SpaceType::kDeadSpace:
-    case SpaceType::kDeadSpaceGhost:
-    case SpaceType::kEmpty:
-    case SpaceType::kEnd:
-    case SpaceType::kEndWall:
-    case SpaceType::kFruit:
-    case SpaceType::kPlayerEast:
-    case SpaceType::kPlayerNorth:
-    case SpaceType::kPlayerSouth:
-    case SpaceType::kPlayerWest:
-    case SpaceType::kPortal0:
-    case SpaceType::kPortal1:
-    case SpaceType::kPortal2:
-    case SpaceType::kPortal3:
-    case SpaceType::kPortal4:
-    case SpaceType::kPortal5:
-    case SpaceType::kPortal6:
-    case SpaceType::kPortal7:
-    case SpaceType::kPortal8:
-    case SpaceType::kPortal9:
-    case SpaceType::kRobot:
-    case SpaceType::kRobotGhost:
-    case SpaceType::kRobotSnake:
-    case SpaceType::kRobotStatue:
-    case SpaceType::kRobotWorm:
-    case SpaceType::kVoid:
-    case SpaceType::kWall:
-    case SpaceType::kWallGhost:
-    case SpaceType::kWhite:
-    case SpaceType::kWhiteFloor:
-    case SpaceType::kWhiteGhost:
-      return true;
-  }
-
-  return false;
-}
-
-bool SpaceTypes::is_valid_empty(SpaceType type) {
-  // Cannot have 2+ things on a single space.
-  return is_valid(type) && !is_player(type) && !is_thing(type);
-}
-
-bool SpaceTypes::is_player(SpaceType type) {
-  switch(type) {
-    case SpaceType::kPlayerNorth:
-    case SpaceType::kPlayerSouth:
-    case SpaceType::kPlayerEast:
-    case SpaceType::kPlayerWest:
-      return true;
-
-    default: return false;
-  }
-}
-
-bool SpaceTypes::is_thing(SpaceType type) {
-  switch(type) {
-    case SpaceType::kCell:
-    case SpaceType::kEnd:
-    case SpaceType::kFruit:
-      return true;
-
-    default: return is_robot(type);
-  }
-}
-
-bool SpaceTypes::is_robot(SpaceType type) {
-  switch(type) {
-    case SpaceType::kRobot:
-    case SpaceType::kRobotGhost:
-    case SpaceType::kRobotSnake:
-    case SpaceType::kRobotStatue:
-    case SpaceType::kRobotWorm:
-      return true;
-
-    default: return false;
-  }
-}
-
-bool SpaceTypes::is_portal(SpaceType type) {
-  switch(type) {
-    case SpaceType::kPortal0:
-    case SpaceType::kPortal1:
-    case SpaceType::kPortal2:
-    case SpaceType::kPortal3:
-    case SpaceType::kPortal4:
-    case SpaceType::kPortal5:
-    case SpaceType::kPortal6:
-    case SpaceType::kPortal7:
-    case SpaceType::kPortal8:
-    case SpaceType::kPortal9:
-      return true;
-
-    default: return false;
-  }
-}
-
-bool SpaceTypes::is_walkable(SpaceType type) { return !is_non_walkable(type); }
-
-bool SpaceTypes::is_non_walkable(SpaceType type) {
-  switch(type) {
-    case SpaceType::kDeadSpace:
-    case SpaceType::kEndWall:
-    case SpaceType::kVoid:
-    case SpaceType::kWall:
-    case SpaceType::kWhite:
-      return true;
-
-    default: return false;
-  }
-}
+// Sanity checks of the table.
+static_assert(!SpaceTypes::is_valid(SpaceType::kNil) && SpaceTypes::is_walkable(SpaceType::kNil));
+static_assert(SpaceTypes::is_valid_empty(SpaceType::kEmpty) && !SpaceTypes::is_valid_empty(SpaceType::kCell));
+static_assert(SpaceTypes::is_thing(SpaceType::kRobotSnake) && SpaceTypes::is_robot(SpaceType::kRobotSnake));
+static_assert(SpaceTypes::is_portal(SpaceType::kPortal9) && !SpaceTypes::is_thing(SpaceType::kPortal9));
+static_assert(SpaceTypes::is_non_walkable(SpaceType::kVoid));
+static_assert(SpaceTypes::is_walkable(SpaceType::kWallGhost));
 
 Facing SpaceTypes::to_player_facing(SpaceType type) {
   switch(type) {
@@ -12,14 +12,16 @@
 
 #include "map/facing.h"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 namespace ekoscape {
 
 // If add a new type, need to update:
 // - assets/maps/README.md
-// - SpaceTypes::is_valid()
+// - SpaceTypes::calc_traits()
 // - GameScene.init_map_texs()
-// - [maybe] SpaceTypes::is_walkable()
-// - [maybe] SpaceTypes::is_non_walkable()
 // - [maybe] Map.parse_grid()
 enum class SpaceType : char {
   kNil            =   0, // Not for game users.
@@ -60,14 +62,115 @@ enum class SpaceType : char {
 namespace SpaceTypes {
   inline const SpaceType kFallback = SpaceType::kVoid;
 
-  bool is_valid(SpaceType type);
-  bool is_valid_empty(SpaceType type);
-  bool is_player(SpaceType type);
-  bool is_thing(SpaceType type);
-  bool is_robot(SpaceType type);
-  bool is_portal(SpaceType type);
-  bool is_walkable(SpaceType type);
-  bool is_non_walkable(SpaceType type);
+  // Bit flags for traits_of().
+  inline constexpr std::uint8_t kValidTrait = 1 << 0;
+  inline constexpr std::uint8_t kValidEmptyTrait = 1 << 1;
+  inline constexpr std::uint8_t kPlayerTrait = 1 << 2;
+  inline constexpr std::uint8_t kThingTrait = 1 << 3;
+  inline constexpr std::uint8_t kRobotTrait = 1 << 4;
+  inline constexpr std::uint8_t kPortalTrait = 1 << 5;
+  inline constexpr std::uint8_t kNonWalkableTrait = 1 << 6;
+
+  /**
+   * Only used to build kTraits at compile time; use traits_of() or the is_*() funcs instead.
+   */
+  constexpr std::uint8_t calc_traits(SpaceType type) {
+    std::uint8_t traits = 0;
+
+    // NOTE: Don't use `default:` so that the compiler/IDE can catch new enum types.
+    switch(type) {
+      case SpaceType::kNil:
+        break;
+
+      case SpaceType::kCell:
+      case SpaceType::kEnd:
+      case SpaceType::kFruit:
+        traits |= kValidTrait | kThingTrait;
+        break;
+
+      case SpaceType::kPlayerEast:
+      case SpaceType::kPlayerNorth:
+      case SpaceType::kPlayerSouth:
+      case SpaceType::kPlayerWest:
+        traits |= kValidTrait | kPlayerTrait;
+        break;
+
+      case SpaceType::kPortal0:
+      case SpaceType::kPortal1:
+      case SpaceType::kPortal2:
+      case SpaceType::kPortal3:
+      case SpaceType::kPortal4:
+      case SpaceType::kPortal5:
+      case SpaceType::kPortal6:
+      case SpaceType::kPortal7:
+      case SpaceType::kPortal8:
+      case SpaceType::kPortal9:
+        traits |= kValidTrait | kValidEmptyTrait | kPortalTrait;
+        break;
+
+      case SpaceType::kRobot:
+      case SpaceType::kRobotGhost:
+      case SpaceType::kRobotSnake:
+      case SpaceType::kRobotStatue:
+      case SpaceType::kRobotWorm:
+        traits |= kValidTrait | kThingTrait | kRobotTrait;
+        break;
+
+      case SpaceType::kDeadSpace:
+      case SpaceType::kEndWall:
+      case SpaceType::kVoid:
+      case SpaceType::kWall:
+      case SpaceType::kWhite:
+        traits |= kValidTrait | kValidEmptyTrait | kNonWalkableTrait;
+        break;
+
+      case SpaceType::kDeadSpaceGhost:
+      case SpaceType::kEmpty:
+      case SpaceType::kWallGhost:
+      case SpaceType::kWhiteFloor:
+      case SpaceType::kWhiteGhost:
+        traits |= kValidTrait | kValidEmptyTrait;
+        break;
+    }
+
+    return traits;
+  }
+
+  /**
+   * Traits of every `char` value (not just the valid types), indexed as unsigned.
+   */
+  inline constexpr auto kTraits = [] {
+    std::array<std::uint8_t,256> traits{};
+
+    for(std::size_t i = 0; i < traits.size(); ++i) {
+      traits[i] = calc_traits(static_cast<SpaceType>(static_cast<unsigned char>(i)));
+    }
+
+    return traits;
+  }();
+
+  /**
+   * A single load from kTraits, instead of a switch.
+   */
+  constexpr std::uint8_t traits_of(SpaceType type) { return kTraits[static_cast<unsigned char>(type)]; }
+
+  constexpr bool is_valid(SpaceType type) { return (traits_of(type) & kValidTrait) != 0; }
+
+  /**
+   * Cannot have 2+ things on a single space, so not a Player or thing.
+   */
+  constexpr bool is_valid_empty(SpaceType type) { return (traits_of(type) & kValidEmptyTrait) != 0; }
+
+  constexpr bool is_player(SpaceType type) { return (traits_of(type) & kPlayerTrait) != 0; }
+  constexpr bool is_thing(SpaceType type) { return (traits_of(type) & kThingTrait) != 0; }
+  constexpr bool is_robot(SpaceType type) { return (traits_of(type) & kRobotTrait) != 0; }
+  constexpr bool is_portal(SpaceType type) { return (traits_of(type) & kPortalTrait) != 0; }
+
+  /**
+   * Unlike the other funcs, an invalid type (e.g., kNil) is walkable.
+   */
+  constexpr bool is_walkable(SpaceType type) { return (traits_of(type) & kNonWalkableTrait) == 0; }
+  constexpr bool is_non_walkable(SpaceType type) { return (traits_of(type) & kNonWalkableTrait) != 0; }
 
   Facing to_player_facing(SpaceType type);
   SpaceType to_player(Facing facing);
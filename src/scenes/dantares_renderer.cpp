@@ -7,6 +7,8 @@
 
 #include "dantares_renderer.h"
 
+#include "cybel/types/cybel_error.h"
+
 namespace ekoscape {
 
 DantaresRenderer::DantaresRenderer(Renderer& renderer) noexcept
@@ -36,29 +38,56 @@ void DantaresRenderer::PopModelMatrix() {
   renderer_.pop_model_matrix();
 }
 
-GLuint DantaresRenderer::GenerateQuadLists(int count) {
-  return renderer_.gen_quad_buffers(count);
+GLuint DantaresRenderer::GenerateQuadBatch() {
+  return renderer_.gen_quad_batch();
+}
+
+void DantaresRenderer::DeleteQuadBatch(GLuint id) {
+  renderer_.delete_quad_batch(id);
+}
+
+void DantaresRenderer::CompileQuadBatch(GLuint id,const std::vector<QuadListData>& quads) {
+  quads_buf_.clear();
+  quads_buf_.reserve(quads.size());
+
+  for(const auto& data : quads) {
+    const auto it = tex_maps_.find(data.TextureID);
+    const bool is_mapped = (it != tex_maps_.end());
+
+    quads_buf_.push_back(Renderer::QuadBufferData{
+      .tex_handle = is_mapped ? it->second.handle : data.TextureID,
+      .src = is_mapped ? it->second.src : Renderer::kDefaultSrc,
+      .normal = Pos3f{data.Normal.X,data.Normal.Y,data.Normal.Z},
+      .vertices = {
+        Pos3f{data.Vertices[0].X,data.Vertices[0].Y,data.Vertices[0].Z},
+        Pos3f{data.Vertices[1].X,data.Vertices[1].Y,data.Vertices[1].Z},
+        Pos3f{data.Vertices[2].X,data.Vertices[2].Y,data.Vertices[2].Z},
+        Pos3f{data.Vertices[3].X,data.Vertices[3].Y,data.Vertices[3].Z},
+      },
+    });
+  }
+
+  renderer_.compile_quad_batch(id,quads_buf_);
 }
 
-void DantaresRenderer::DeleteQuadLists(GLuint id,int count) {
-  renderer_.delete_quad_buffers(id,count);
+void DantaresRenderer::DrawQuadBatch(GLuint id,int first,int count) {
+  renderer_.draw_quad_batch(id,first,count);
 }
 
-void DantaresRenderer::CompileQuadList(GLuint id,int index,const QuadListData& data) {
-  renderer_.compile_quad_buffer(id,index,Renderer::QuadBufferData{
-    .tex_handle = data.TextureID,
-    .normal = Pos3f{data.Normal.X,data.Normal.Y,data.Normal.Z},
-    .vertices = {
-      Pos3f{data.Vertices[0].X,data.Vertices[0].Y,data.Vertices[0].Z},
-      Pos3f{data.Vertices[1].X,data.Vertices[1].Y,data.Vertices[1].Z},
-      Pos3f{data.Vertices[2].X,data.Vertices[2].Y,data.Vertices[2].Z},
-      Pos3f{data.Vertices[3].X,data.Vertices[3].Y,data.Vertices[3].Z},
-    },
-  });
+GLuint DantaresRenderer::GetBatchTextureID(GLuint id) const {
+  const auto it = tex_maps_.find(id);
+
+  return (it != tex_maps_.end()) ? it->second.handle : id;
 }
 
-void DantaresRenderer::DrawQuadList(GLuint id,int index) {
-  renderer_.draw_quad_buffer(id,index);
+void DantaresRenderer::map_tex(const Texture& tex,const SpriteAtlas& atlas,std::size_t index) {
+  const Pos4f* src = atlas.src(index);
+
+  if(src == nullptr) { throw CybelError{"Invalid atlas index [",index,"] for texture [",tex.handle(),"]."}; }
+
+  tex_maps_[tex.handle()] = TexMap{atlas.tex().handle(),*src};
 }
 
+void DantaresRenderer::clear_tex_maps() { tex_maps_.clear(); }
+
 } // namespace ekoscape
@@ -11,6 +11,12 @@
 #include "common.h"
 
 #include "cybel/gfx/renderer.h"
+#include "cybel/gfx/sprite_atlas.h"
+#include "cybel/gfx/texture.h"
+#include "cybel/types/pos.h"
+
+#include <unordered_map>
+#include <vector>
 
 namespace ekoscape {
 
@@ -28,13 +34,30 @@ public:
   void PushModelMatrix() override;
   void PopModelMatrix() override;
 
-  GLuint GenerateQuadLists(int count) override;
-  void DeleteQuadLists(GLuint id,int count) override;
-  void CompileQuadList(GLuint id,int index,const QuadListData& data) override;
-  void DrawQuadList(GLuint id,int index) override;
+  GLuint GenerateQuadBatch() override;
+  void DeleteQuadBatch(GLuint id) override;
+  void CompileQuadBatch(GLuint id,const std::vector<QuadListData>& quads) override;
+  void DrawQuadBatch(GLuint id,int first,int count) override;
+  GLuint GetBatchTextureID(GLuint id) const override;
+
+  /**
+   * Draws the quads of `tex` from the cell at `index` of `atlas` instead,
+   * so that all of the textures in the atlas are drawn with one call (& texture bind) per group.
+   *
+   * Must be called before the chunks are generated, since the tex coords are compiled into the batches.
+   */
+  void map_tex(const Texture& tex,const SpriteAtlas& atlas,std::size_t index);
+  void clear_tex_maps();
 
 private:
+  struct TexMap {
+    GLuint handle = 0;
+    Pos4f src{};
+  };
+
   Renderer& renderer_;
+  std::unordered_map<GLuint,TexMap> tex_maps_{}; // Texture handle to atlas.
+  std::vector<Renderer::QuadBufferData> quads_buf_{}; // Reused to avoid re-allocating on each compile.
 };
 
 } // namespace ekoscape
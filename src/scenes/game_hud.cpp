@@ -7,6 +7,8 @@
 
 #include "game_hud.h"
 
+#include "cybel/util/profiler.h"
+
 #include "scenes/scene_action.h"
 
 #include <sstream>
@@ -110,41 +112,53 @@ void GameHud::draw_map_mod(Renderer& ren,const ViewDimens& dimens) {
 }
 
 void GameHud::draw_mini_map(Renderer& ren,Pos3i pos) {
+  static const auto kZoneId = Profiler::it().zone_id("mini_map");
+  const Profiler::Zone zone{kZoneId};
+
   pos.y += kMiniMapBlockSize.h;
 
   const Pos3i player_pos = map_.player_pos();
+  const MapSpaces& spaces = map_.spaces();
+  const Size2i& grid_size = spaces.size(player_pos.z);
+  Pos2i x_step{}; // Of the map pos per block in X.
+  Pos2i y_step{}; // Of the map pos per block in Y.
+
+  // "Rotate" the mini map according to the direction the player is facing.
+  // - Remember that the grid is flipped vertically in Map for the Y calculations.
+  switch(map_.player_facing()) {
+    case Facing::kNorth:
+      x_step = Pos2i{1,0};
+      y_step = Pos2i{0,-1};
+      break;
+
+    case Facing::kSouth:
+      x_step = Pos2i{-1,0};
+      y_step = Pos2i{0,1};
+      break;
+
+    case Facing::kEast:
+      x_step = Pos2i{0,-1};
+      y_step = Pos2i{-1,0};
+      break;
+
+    case Facing::kWest:
+      x_step = Pos2i{0,1};
+      y_step = Pos2i{1,0};
+      break;
+  }
+
   Pos3i block_pos = pos;
 
   for(int y = -kMiniMapHoodRadius.h; y <= kMiniMapHoodRadius.h; ++y,block_pos.y += kMiniMapBlockSize.h) {
     for(int x = -kMiniMapHoodRadius.w; x <= kMiniMapHoodRadius.w; ++x,block_pos.x += kMiniMapBlockSize.w) {
-      Pos3i map_pos = player_pos;
-
-      // "Rotate" the mini map according to the direction the player is facing.
-      // - Remember that the grid is flipped vertically in Map for the Y calculations.
-      switch(map_.player_facing()) {
-        case Facing::kNorth:
-          map_pos.x += x;
-          map_pos.y -= y;
-          break;
-
-        case Facing::kSouth:
-          map_pos.x -= x;
-          map_pos.y += y;
-          break;
-
-        case Facing::kEast:
-          map_pos.x -= y;
-          map_pos.y -= x;
-          break;
-
-        case Facing::kWest:
-          map_pos.x += y;
-          map_pos.y += x;
-          break;
-      }
-
-      const Space* space = map_.space(map_pos);
-      const SpaceType type = (space != nullptr) ? space->type() : SpaceType::kNil;
+      const Pos3i map_pos{
+        player_pos.x + (x * x_step.x) + (y * y_step.x),
+        player_pos.y + (x * x_step.y) + (y * y_step.y),
+        player_pos.z
+      };
+      const bool in_bounds = map_pos.x >= 0 && map_pos.x < grid_size.w && map_pos.y >= 0 &&
+                             map_pos.y < grid_size.h;
+      const SpaceType type = in_bounds ? spaces.at(spaces.index_of(map_pos)).type() : SpaceType::kNil;
       const Color4f* color = &mini_map_walkable_color_;
 
       switch(type) {
@@ -8,18 +8,17 @@
 #include "game_scene.h"
 
 #include "cybel/types/cybel_error.h"
-#include "cybel/util/rando.h"
+#include "cybel/util/profiler.h"
+#include "cybel/util/timer.h"
+#include "cybel/util/tracer.h"
 
 #include "core/input_action.h"
 #include "map/dantares_map.h"
-#include "scenes/dantares_renderer.h"
-
-#include <ranges>
 
 namespace ekoscape {
 
 GameScene::GameScene(GameContext& ctx,State& state,const std::filesystem::path& map_file)
-  : ctx_(ctx),state_(state) {
+  : ctx_(ctx),state_(state),map_file_(map_file),make_weird_(ctx.assets.is_weird()) {
   dantares_renderer_ = std::make_unique<DantaresRenderer>(ctx.cybel_engine.renderer());
 
   // Dantares2(...,SquareSize,FloorHeight,CeilingHeight).
@@ -30,90 +29,31 @@ GameScene::GameScene(GameContext& ctx,State& state,const std::filesystem::path&
   map_ = std::make_unique<DantaresMap>(*dantares_,[&](auto& /*dan*/,int /*z*/,int /*grid_id*/) {
     init_map_texs();
   });
-  robot_move_data_ = std::make_unique<Robot::MoveData>(*map_);
-
-  init_map(map_file);
-
-  // Extra delay to give some time for the Player to initially orient/adjust.
-  robot_move_time_ = map_->robot_delay() + kInitExtraRobotDelay;
-
-  hud_ = std::make_unique<GameHud>(ctx,*map_);
-  overlay_ = std::make_unique<GameOverlay>(ctx,*map_);
+  world_ = std::make_unique<GameWorld>(*map_,[&](auto event) { on_world_event(event); },ctx.rando.next_u64());
 }
 
-void GameScene::init_map(const std::filesystem::path& map_file) {
-  std::vector<Pos3i> cells{};
+void GameScene::load_scene_bg() {
+  world_->load_map(map_file_,make_weird_);
 
-  map_->load_file(
-    map_file,
-    [&](const auto& pos,SpaceType type) { return init_map_space(pos,type,cells); },
-    [&](const auto& pos,SpaceType type) { init_map_default_empty(pos,type); }
-  );
-  if(ctx_.assets.is_weird()) { make_map_weird(cells); }
-
-  std::cout << "[INFO] Map file ['" << map_file.string() << "'] w/ grids [" << map_->grid_count() << "]:\n"
+  std::cout << "[INFO] Map file ['" << map_file_.string() << "'] w/ grids [" << map_->grid_count() << "]:\n"
             << *map_ << std::endl;
 
-  map_->add_to_bridge();
+  map_->begin_add_to_bridge();
 }
 
-SpaceType GameScene::init_map_space(const Pos3i& pos,SpaceType type,std::vector<Pos3i>& cells) {
-  switch(type) {
-    case SpaceType::kCell:
-      cells.push_back(pos);
-      break;
+bool GameScene::load_scene_gl() {
+  const Timer timer{true};
 
-    default:
-      if(SpaceTypes::is_robot(type)) {
-        robots_.push_back(Robot::build(type,pos));
-      } else if(SpaceTypes::is_portal(type)) {
-        portal_to_pos_bag_[type].push_back(pos);
-      }
-      break;
+  // Generate the map's chunks for a bit each frame.
+  while(!map_->add_to_bridge_step(kLoadStepChunks)) {
+    if(timer.peek() >= kMaxLoadStepTime) { return false; }
   }
 
-  return type;
-}
+  // These use the assets (e.g., colors), which might change on the main thread, so not in load_scene_bg().
+  hud_ = std::make_unique<GameHud>(ctx_,*map_);
+  overlay_ = std::make_unique<GameOverlay>(ctx_,*map_);
 
-void GameScene::init_map_default_empty(const Pos3i& pos,SpaceType type) {
-  if(SpaceTypes::is_portal(type)) {
-    portal_to_pos_bag_[type].push_back(pos);
-  }
-}
-
-void GameScene::make_map_weird(std::vector<Pos3i>& cells) {
-  // For weird, flip Robots & Cells, where a random Cell becomes a random Robot.
-  // If we run out of Robots, then just use normal ones.
-
-  // First, flip all Robots to Cells in Map, because we might have more Robots than Cells.
-  for(auto& robot : robots_) {
-    map_->set_raw_thing(robot.pos(),SpaceType::kCell);
-  }
-
-  Rando::it().shuffle(robots_.begin(),robots_.end());
-  Rando::it().shuffle(cells.begin(),cells.end());
-
-  std::vector<Robot> new_robots{};
-
-  for(std::size_t robot_i = 0; const auto& cell_pos : cells) {
-    if(robot_i < robots_.size()) {
-      auto robot = std::move(robots_[robot_i]);
-      ++robot_i;
-
-      map_->set_raw_thing(cell_pos,robot.type());
-      robot.set_raw_pos(cell_pos);
-
-      new_robots.push_back(std::move(robot));
-    } else { // No Robots left.
-      auto robot = Robot::build_normal(cell_pos);
-
-      map_->set_raw_thing(cell_pos,robot.type());
-
-      new_robots.push_back(std::move(robot));
-    }
-  }
-
-  robots_ = std::move(new_robots);
+  return true;
 }
 
 void GameScene::init_map_texs() {
@@ -133,6 +73,16 @@ void GameScene::init_map_texs() {
   const auto* white_tex = a.styled_tex(StyledTexId::kWhite);
   const auto* white_ghost_tex = a.styled_tex(StyledTexId::kWhiteGhost);
 
+  // Draw the map from the atlas, so that it's one texture bind per group of faces, instead of per texture.
+  // - Re-mapped on every call, since the handles change on context restored.
+  const auto& atlas = a.styled_tex_atlas();
+
+  dantares_renderer_->clear_tex_maps();
+
+  for(std::size_t id = 0; id < static_cast<std::size_t>(StyledTexId::kMax); ++id) {
+    dantares_renderer_->map_tex(*a.styled_tex(static_cast<StyledTexId>(id)),atlas,id);
+  }
+
   set_space_texs(SpaceType::kCell,ceiling_tex,cell_tex,floor_tex);
   set_space_texs(SpaceType::kDeadSpace,dead_space_tex,nullptr,dead_space_tex);
   set_space_texs(SpaceType::kDeadSpaceGhost,dead_space_ghost_tex,nullptr,dead_space_ghost_tex);
@@ -164,36 +114,6 @@ void GameScene::init_map_texs() {
   set_space_texs(SpaceType::kWhiteGhost,white_ghost_tex);
 }
 
-void GameScene::init_scene(const ViewDimens& /*dimens*/) {
-  switch(game_phase_) {
-    case GamePhase::kShowMapInfo:
-      map_info_timer_.resume();
-      break;
-
-    case GamePhase::kPlay:
-      speedrun_timer_.resume();
-      break;
-
-    case GamePhase::kGameOver:
-      break;
-  }
-}
-
-void GameScene::on_scene_exit() {
-  switch(game_phase_) {
-    case GamePhase::kShowMapInfo:
-      map_info_timer_.pause();
-      break;
-
-    case GamePhase::kPlay:
-      speedrun_timer_.pause();
-      break;
-
-    case GamePhase::kGameOver:
-      break;
-  }
-}
-
 void GameScene::on_scene_context_restored() {
   try {
     map_->on_context_restored();
@@ -227,11 +147,15 @@ void GameScene::handle_scene_input(const std::vector<bool>& states,InputMan& /*i
   // Input states are stored because in Dantares you can't turn/walk while turning/walking,
   //     and without storing the states and trying again on the next frame,
   //     it feels unresponsive and frustrating.
-  const bool is_up = states[InputAction::kUp];
+  // They're also only applied on a logic tick (see handle_stored_inputs()), so that moving the Player
+  //     is in sync with the logic, no matter how many frames are drawn per tick.
+  stored_inputs_.is_up = states[InputAction::kUp];
   stored_inputs_.is_down = (stored_inputs_.is_down || states[InputAction::kDown]);
   stored_inputs_.is_left = (stored_inputs_.is_left || states[InputAction::kLeft]);
   stored_inputs_.is_right = (stored_inputs_.is_right || states[InputAction::kRight]);
+}
 
+void GameScene::handle_stored_inputs() {
   const bool is_walking = dantares_->IsWalking();
 
   // Must check Left/Right first, so that the Player can turn while walking forward/backward,
@@ -241,7 +165,7 @@ void GameScene::handle_scene_input(const std::vector<bool>& states,InputMan& /*i
       if(!is_walking) {
         dantares_->TurnLeft();
         stored_inputs_.is_left = false;
-      } // Else, try again on next frame.
+      } // Else, try again on next tick.
     } else {
       stored_inputs_.is_left = false;
     }
@@ -252,17 +176,17 @@ void GameScene::handle_scene_input(const std::vector<bool>& states,InputMan& /*i
     if(!is_walking) {
       dantares_->TurnRight();
       stored_inputs_.is_right = false;
-    } // Else, try again on next frame.
+    } // Else, try again on next tick.
 
     stored_inputs_.is_down = false;
-  } else if(game_phase_ == GamePhase::kPlay && player_warp_time_ <= Duration::kZero) {
+  } else if(game_phase_ == GamePhase::kPlay && world_->player_warp_time() <= Duration::kZero) {
     // Check Down first so that it can override continuously moving forward.
     if(stored_inputs_.is_down) {
-      if(!is_up) {
+      if(!stored_inputs_.is_up) {
         if(!is_walking) {
           dantares_->StepBackward();
           stored_inputs_.is_down = false;
-        } // Else, try again on next frame.
+        } // Else, try again on next tick.
       } else {
         stored_inputs_.is_down = false;
       }
@@ -280,215 +204,96 @@ int GameScene::update_scene_logic(const FrameStep& step,const ViewDimens& dimens
   }
 
   dantares_->UpdateDeltaTime(static_cast<float>(step.delta_time));
+  handle_stored_inputs();
 
-  if(game_phase_ == GamePhase::kShowMapInfo && map_info_timer_.peek() >= kMapInfoDuration) {
-    game_phase_ = GamePhase::kPlay;
-    robot_move_time_ += step.dpf;
-    speedrun_timer_.start();
-  }
-  if(game_phase_ != GamePhase::kShowMapInfo) {
-    update_player(step);
-    update_robots(step);
-  }
-
-  return update_mods(step,dimens);
-}
-
-void GameScene::update_player(const FrameStep& step) {
-  if(game_phase_ == GamePhase::kGameOver) { return; }
-
-  if(player_warp_time_ > Duration::kZero) {
-    player_warp_time_ -= step.dpf;
-    if(player_warp_time_ < Duration::kZero) { player_warp_time_.set_to_zero(); }
-  }
-  if(player_fruit_time_ > Duration::kZero) {
-    const auto prev_fruit_secs = player_fruit_time_.round_secs();
-
-    player_fruit_time_ -= step.dpf;
+  // The times are counted in ticks (not a real-time Timer), so that they're the same in a replay,
+  //     and so they're automatically paused while this scene isn't running.
+  if(game_phase_ == GamePhase::kShowMapInfo) {
+    map_info_time_ += step.dpf;
 
-    if(player_fruit_time_ < Duration::kZero) {
-      player_fruit_time_.set_to_zero();
-    } else {
-      const auto fruit_secs = player_fruit_time_.round_secs();
-
-      if(fruit_secs != prev_fruit_secs && fruit_secs <= kFruitWarnSecs) {
-        overlay_->flash(ctx_.assets.fruit_color());
-      }
+    if(map_info_time_ >= kMapInfoDuration) {
+      game_phase_ = GamePhase::kPlay;
+      world_->delay_robots(step.dpf);
     }
   }
+  if(game_phase_ != GamePhase::kShowMapInfo) {
+    if(game_phase_ == GamePhase::kPlay) { speedrun_time_ += step.dpf; }
 
-  const Pos3i player_pos = map_->player_pos();
-  SpaceType player_space_type = map_->player_space_type();
-
-  switch(player_space_type) {
-    case SpaceType::kCell:
-      map_->remove_thing(player_pos);
-      break;
-
-    // Check for End before Robots & Portals.
-    case SpaceType::kEnd:
-      game_over(true);
-      return;
-
-    // Check for Fruit before Robots.
-    case SpaceType::kFruit:
-      map_->remove_thing(player_pos);
-      overlay_->flash(ctx_.assets.fruit_color());
-      player_fruit_time_ = kFruitDuration;
-      break;
-
-    default: break;
+    world_->update(step);
   }
 
-  // The previous logic above might have updated the type/empty, so check/recheck here.
-  const Space* player_space = map_->player_space();
-  auto player_empty_type = SpaceType::kEmpty;
-  player_space_type = map_->player_space_type();
+  // Increment the Player's walking/turning after the World (Draw() doesn't move the Player).
+  dantares_->MovePlayer();
 
-  if(player_space == nullptr) {
-    std::cerr << "[ERROR] Player space is null for some reason." << std::endl;
-  } else {
-    player_empty_type = player_space->empty_type();
-  }
-
-  // Portals are like safe zones, so if the Player & a Robot are on a Portal, the Player shouldn't die.
-  //     Therefore, we check for Portals first.
-  if(SpaceTypes::is_portal(player_empty_type)) {
-    if(!player_warped_) {
-      const auto portal_bro = fetch_portal_bro(player_pos,player_empty_type,[&](const auto& pos) {
-        // Allow the Player to warp even if there's a Robot/Thing on the Portal.
-        return map_->space(pos) != nullptr;
-      });
+  const int action = update_mods(step,dimens);
 
-      if(portal_bro) {
-        map_->move_player(*portal_bro);
-        overlay_->flash(ctx_.assets.portal_color());
-        player_warped_ = true;
-        player_warp_time_ = kWarpDuration;
-      }
+  // Restart in place, instead of building a new GameScene & loading the Map again.
+  if(action == SceneAction::kRestart) {
+    try {
+      restart();
+    } catch(const CybelError& e) {
+      std::cerr << "[WARN] Failed to restart map in place: " << e.what() << std::endl;
+      return action; // Load it again instead.
     }
 
-    return;
+    return SceneAction::kNil;
   }
 
-  player_warped_ = false;
-
-  if(SpaceTypes::is_robot(player_space_type)) {
-    if(player_fruit_time_ > Duration::kZero) {
-      remove_robots_at(player_pos);
-    } else {
-      game_over(false);
-    }
-  }
+  return action;
 }
 
-void GameScene::game_over(bool player_hit_end) {
-  speedrun_timer_.pause();
-  game_phase_ = GamePhase::kGameOver;
-  player_hit_end_ = player_hit_end;
-
-  // Because of how high speeds are handled, we need to manually sync the correct Player pos,
-  //     since the pos might be beyond End, etc. after fully moving.
-  map_->sync_player_pos();
-
-  // Fade to death?
-  if(!player_hit_end_) { overlay_->fade_to(ctx_.assets.eko_color()); }
-  overlay_->game_over(player_hit_end_);
-}
+void GameScene::restart() {
+  const Tracer::Scope trace{"restart_game","scene"};
 
-void GameScene::update_robots(const FrameStep& step) {
-  // Remove dead Robots and age living Robots (only if lifespan was set).
-  auto dead_robots = std::ranges::remove_if(robots_,[&](auto& robot) {
-    if(robot.is_dead()) {
-      map_->remove_thing(robot.pos());
-      return true;
-    }
+  world_->restart(ctx_.rando.next_u64());
 
-    robot.age(step.delta_time);
-    return false;
-  });
-  robots_.erase(dead_robots.begin(),dead_robots.end());
+  game_phase_ = GamePhase::kShowMapInfo;
+  map_info_time_.set_to_zero();
+  stored_inputs_ = StoredInputs{};
+  speedrun_time_.set_to_zero();
 
-  move_robots(step);
+  hud_ = std::make_unique<GameHud>(ctx_,*map_);
+  overlay_ = std::make_unique<GameOverlay>(ctx_,*map_);
 }
 
-void GameScene::move_robots(const FrameStep& step) {
-  // Not time to move Robots?
-  if(robot_move_time_ > Duration::kZero) {
-    robot_move_time_ -= step.dpf;
-    return;
-  }
-
-  // Move Robots.
-  robot_move_data_->refresh(player_fruit_time_ > Duration::kZero);
-
-  for(auto& robot : robots_) {
-    robot.move(*robot_move_data_);
+void GameScene::on_world_event(GameWorld::Event event) {
+  switch(event) {
+    case GameWorld::Event::kAteFruit:
+    case GameWorld::Event::kFruitWarning:
+      overlay_->flash(ctx_.assets.fruit_color());
+      break;
 
-    // Warp Robots that are on Portals.
-    if(robot.portal_type() != SpaceType::kNil && !robot.warped()) {
-      const auto portal_bro = fetch_portal_bro(robot.pos(),robot.portal_type(),[&](const auto& pos) {
-        return robot.can_move_to(map_->space(pos));
-      });
+    case GameWorld::Event::kPlayerWarped:
+      overlay_->flash(ctx_.assets.portal_color());
+      break;
 
-      if(portal_bro) { robot.warp_to(*robot_move_data_,*portal_bro); }
-    }
+    case GameWorld::Event::kGameOver:
+      game_over();
+      break;
   }
-
-  // Add new Robots after the move loop, because we can't add new ones inside its loop.
-  std::ranges::move(robot_move_data_->new_robots,std::back_inserter(robots_));
-  robot_move_data_->new_robots.clear();
-
-  // Reset the move time.
-  robot_move_time_ = map_->robot_delay() + step.dpf;
 }
 
-void GameScene::remove_robots_at(const Pos3i& pos) {
-  map_->remove_thing(pos);
-
-  auto dead_robots = std::ranges::remove_if(robots_,[&](const auto& robot) {
-    return robot.pos() == pos;
-  });
-  robots_.erase(dead_robots.begin(),dead_robots.end());
-}
-
-std::optional<Pos3i> GameScene::fetch_portal_bro(const Pos3i& pos,SpaceType portal,
-                                                 const MoveChecker& can_move_to) {
-  const auto it = portal_to_pos_bag_.find(portal);
-  if(it == portal_to_pos_bag_.end()) { return std::nullopt; }
-
-  auto& bros = it->second;
-  if(bros.size() <= 1) { return std::nullopt; } // No bros. :(
-
-  if(bros.size() > 2) { // More than 1 bro?
-    // Try once without shuffling.
-    const auto& rand_bro_pos = bros[Rando::it().rand_size_t(bros.size())];
-
-    if(rand_bro_pos != pos && can_move_to(rand_bro_pos)) { return rand_bro_pos; }
-
-    Rando::it().shuffle(bros.begin(),bros.end());
-  }
-
-  for(const auto& bro_pos : bros) { // Find Luigi.
-    if(bro_pos != pos && can_move_to(bro_pos)) { return bro_pos; }
-  }
+void GameScene::game_over() {
+  game_phase_ = GamePhase::kGameOver;
 
-  return std::nullopt;
+  // Fade to death?
+  if(!world_->player_hit_end()) { overlay_->fade_to(ctx_.assets.eko_color()); }
+  overlay_->game_over(world_->player_hit_end());
 }
 
 int GameScene::update_mods(const FrameStep& step,const ViewDimens& dimens) {
   hud_->update_state(GameHud::State{
     .show_mini_map = state_.show_mini_map,
-    .player_fruit_time = player_fruit_time_,
-    .player_hit_end = player_hit_end_,
+    .player_fruit_time = world_->player_fruit_time(),
+    .player_hit_end = world_->player_hit_end(),
 
     .is_game_over = (game_phase_ == GamePhase::kGameOver),
-    .speedrun_time = speedrun_timer_.peek(),
+    .speedrun_time = speedrun_time_,
     .show_speedrun = state_.show_speedrun,
   });
   overlay_->update_state(GameOverlay::State{
     .is_map_info = (game_phase_ == GamePhase::kShowMapInfo),
-    .player_hit_end = player_hit_end_,
+    .player_hit_end = world_->player_hit_end(),
   });
 
   if((scene_action_ = hud_->update_scene_logic(step,dimens)) != SceneAction::kNil) {
@@ -504,20 +309,37 @@ int GameScene::update_mods(const FrameStep& step,const ViewDimens& dimens) {
 void GameScene::draw_scene(Renderer& ren,const ViewDimens& dimens) {
   ren.begin_3d_scene();
 
-  const bool move_player = ctx_.cybel_engine.is_logic_running();
+  // The Player is moved in update_scene_logic() at a fixed rate, so just interpolate between ticks here.
+  dantares_->SetDrawAlpha(ctx_.cybel_engine.is_logic_running() ? ctx_.cybel_engine.logic_alpha() : 0.0f);
 
-  if(player_hit_end_) {
-    // Even if fully transparent, continue to draw so that the Player can turn the mini map (just for fun).
-    ren.wrap_color(ctx_.assets.end_color().with_a(1.0f - overlay_->game_over_age()),[&] {
-      dantares_->Draw(kDantaresDist,move_player);
-    });
-  } else {
-    dantares_->Draw(kDantaresDist,move_player);
+  {
+    static const auto kZoneId = Profiler::it().zone_id("dantares_draw");
+    const Profiler::Zone zone{kZoneId};
+
+    if(world_->player_hit_end()) {
+      // Even if fully transparent, continue to draw so that the Player can turn the mini map (just for fun).
+      ren.wrap_color(ctx_.assets.end_color().with_a(1.0f - overlay_->game_over_age()),[&] {
+        dantares_->Draw(kDantaresDist,false);
+      });
+    } else {
+      dantares_->Draw(kDantaresDist,false);
+    }
   }
 
   ren.begin_2d_scene();
-  hud_->draw_scene(ren,dimens);
-  overlay_->draw_scene(ren,dimens);
+
+  {
+    static const auto kZoneId = Profiler::it().zone_id("hud");
+    const Profiler::Zone zone{kZoneId};
+
+    hud_->draw_scene(ren,dimens);
+  }
+  {
+    static const auto kZoneId = Profiler::it().zone_id("overlay");
+    const Profiler::Zone zone{kZoneId};
+
+    overlay_->draw_scene(ren,dimens);
+  }
 }
 
 // ReSharper disable once CppDFAUnreachableFunctionCall
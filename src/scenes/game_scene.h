@@ -14,19 +14,17 @@
 #include "cybel/scene/scene.h"
 #include "cybel/types/duration.h"
 #include "cybel/types/pos.h"
-#include "cybel/util/timer.h"
 
 #include "core/game_context.h"
 #include "map/map.h"
 #include "map/space_type.h"
+#include "scenes/dantares_renderer.h"
 #include "scenes/game_hud.h"
 #include "scenes/game_overlay.h"
 #include "scenes/scene_action.h"
-#include "world/robot.h"
+#include "world/game_world.h"
 
 #include <filesystem>
-#include <functional>
-#include <unordered_map>
 #include <vector>
 
 namespace ekoscape {
@@ -38,10 +36,13 @@ public:
     bool show_speedrun = true;
   };
 
+  /**
+   * The map is loaded by load_scene_bg() & load_scene_gl(), so set SceneBag::load_in_bg.
+   */
   explicit GameScene(GameContext& ctx,State& state,const std::filesystem::path& map_file);
 
-  void init_scene(const ViewDimens& dimens) override;
-  void on_scene_exit() override;
+  void load_scene_bg() override;
+  bool load_scene_gl() override;
   void on_scene_context_restored() override;
 
   void on_scene_input_event(input_id_t input_id,const ViewDimens& dimens) override;
@@ -58,59 +59,45 @@ private:
   };
 
   struct StoredInputs {
+    bool is_up = false;
     bool is_down = false;
     bool is_left = false;
     bool is_right = false;
   };
 
-  using MoveChecker = std::function<bool(const Pos3i&)>;
-
   static inline const Duration kMapInfoDuration = Duration::from_millis(2'500);
-  static inline const Duration kInitExtraRobotDelay = Duration::from_millis(1'000);
   static constexpr int kDantaresDist = 24; // Must be 2+.
-  static inline const Duration kWarpDuration = Duration::from_millis(750);
-  static inline const Duration kFruitDuration = Duration::from_millis(7'000);
-  static constexpr int kFruitWarnSecs = 2;
+  // For load_scene_gl(), so that the previous scene can keep drawing at 60 FPS.
+  static inline const Duration kMaxLoadStepTime = Duration::from_millis(4);
+  static constexpr int kLoadStepChunks = 16;
 
   GameContext& ctx_;
   State& state_;
   int scene_action_ = SceneAction::kNil;
 
-  std::unique_ptr<Dantares2::RendererClass> dantares_renderer_{};
+  std::filesystem::path map_file_{};
+  bool make_weird_ = false;
+
+  std::unique_ptr<DantaresRenderer> dantares_renderer_{};
   std::unique_ptr<Dantares2> dantares_{};
   std::unique_ptr<Map> map_{};
+  std::unique_ptr<GameWorld> world_{};
 
   GamePhase game_phase_ = GamePhase::kShowMapInfo;
-  Timer map_info_timer_{};
+  Duration map_info_time_{};
 
   StoredInputs stored_inputs_{};
-  bool player_hit_end_ = false;
-  bool player_warped_ = false;
-  Duration player_warp_time_{};
-  Duration player_fruit_time_{};
-  Timer speedrun_timer_{};
-
-  std::vector<Robot> robots_{};
-  Duration robot_move_time_{};
-  std::unique_ptr<Robot::MoveData> robot_move_data_{};
-  std::unordered_map<SpaceType,std::vector<Pos3i>> portal_to_pos_bag_{};
+  Duration speedrun_time_{};
 
   std::unique_ptr<GameHud> hud_{};
   std::unique_ptr<GameOverlay> overlay_{};
 
-  void init_map(const std::filesystem::path& map_file);
-  SpaceType init_map_space(const Pos3i& pos,SpaceType type,std::vector<Pos3i>& cells);
-  void init_map_default_empty(const Pos3i& pos,SpaceType type);
-  void make_map_weird(std::vector<Pos3i>& cells);
   void init_map_texs();
+  void restart();
 
-  void update_player(const FrameStep& step);
-  void game_over(bool player_hit_end);
-
-  void update_robots(const FrameStep& step);
-  void move_robots(const FrameStep& step);
-  void remove_robots_at(const Pos3i& pos);
-  std::optional<Pos3i> fetch_portal_bro(const Pos3i& pos,SpaceType portal,const MoveChecker& can_move_to);
+  void handle_stored_inputs();
+  void on_world_event(GameWorld::Event event);
+  void game_over();
 
   int update_mods(const FrameStep& step,const ViewDimens& dimens);
 
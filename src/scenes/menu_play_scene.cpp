@@ -22,6 +22,10 @@ MenuPlayScene::MenuPlayScene(GameContext& ctx,State& state)
   glob_maps();
 }
 
+MenuPlayScene::~MenuPlayScene() noexcept {
+  stop_glob_maps();
+}
+
 void MenuPlayScene::on_scene_input_event(input_id_t input_id,const ViewDimens& /*dimens*/) {
   switch(input_id) {
     case InputAction::kSelect:
@@ -29,7 +33,8 @@ void MenuPlayScene::on_scene_input_event(input_id_t input_id,const ViewDimens& /
         scene_action_ = SceneAction::kGoBack;
       } else {
         if(map_opts_.size() <= kNonMapOptCount) {
-          ctx_.cybel_engine.show_error("No map to select.");
+          // Still globbing? Then let the player try again in a bit.
+          if(!is_globbing_) { ctx_.cybel_engine.show_error("No map to select."); }
         } else {
           select_map();
           scene_action_ = SceneAction::kGoToGame;
@@ -68,6 +73,8 @@ void MenuPlayScene::on_scene_input_event(input_id_t input_id,const ViewDimens& /
 }
 
 int MenuPlayScene::update_scene_logic(const FrameStep& /*step*/,const ViewDimens& /*dimens*/) {
+  add_globbed_maps();
+
   return std::exchange(scene_action_,SceneAction::kNil);
 }
 
@@ -106,6 +113,12 @@ void MenuPlayScene::draw_scene(Renderer& ren,const ViewDimens& /*dimens*/) {
     if(max_len < opts_len) { // More options hidden at bottom?
       font.print_blanks(kUpDownArrowIndent);
       font.draw_menu_down_arrow();
+    } else if(is_globbing_) {
+      font.puts();
+    }
+    if(is_globbing_) {
+      font.print_blanks(kUpDownArrowIndent);
+      font.puts("scanning…");
     }
   });
 
@@ -114,69 +127,139 @@ void MenuPlayScene::draw_scene(Renderer& ren,const ViewDimens& /*dimens*/) {
 }
 
 void MenuPlayScene::glob_maps() {
-  static constexpr int kMaxTitleLen = 25;
-  static constexpr int kMaxGroupLen = 17;
+  stop_glob_maps();
 
   map_opts_.clear();
   map_opts_.emplace_back("< random map >");
   map_opts_.emplace_back("< go back >");
   map_opt_index_ = 0;
 
-  ctx_.assets.glob_maps_meta([&](const auto& group,const auto& map_file,const auto& map) {
-    MapOption opt{};
+  is_globbing_ = true;
+  can_restore_sel_ = !state_.is_rand_map;
+  is_glob_canceled_.store(false,std::memory_order_relaxed);
 
-    opt.group = group;
-    opt.file = map_file;
-    opt.title = map.title();
-    opt.text = utf8::StrUtil::ljust(utf8::StrUtil::ellipsize(opt.title,kMaxTitleLen),kMaxTitleLen) +
-               ' ' + utf8::StrUtil::ellipsize(opt.group,kMaxGroupLen);
+  {
+    const std::scoped_lock lock{glob_mutex_};
+    globbed_maps_.clear();
+    is_glob_done_ = false;
+  }
 
-    map_opts_.push_back(opt);
-  });
+  const auto glob = [this] {
+    try {
+      ctx_.assets.glob_maps_meta([this](auto&& maps) {
+        const std::scoped_lock lock{glob_mutex_};
+
+        globbed_maps_.insert(globbed_maps_.end(),std::make_move_iterator(maps.begin()),
+                             std::make_move_iterator(maps.end()));
+      },is_glob_canceled_);
+    } catch(const std::exception& e) { // Don't let it escape the thread.
+      std::cerr << "[WARN] Failed to glob maps: " << e.what() << std::endl;
+    }
+
+    const std::scoped_lock lock{glob_mutex_};
+    is_glob_done_ = true;
+  };
+
+#if defined(__EMSCRIPTEN__)
+  glob(); // No threads; the maps are still added in update_scene_logic().
+#else
+  if(ctx_.load_in_bg) {
+    map_globber_ = std::thread{glob};
+  } else {
+    // Else, which maps are on a tick (for the cursor & the random map) would depend on the thread's timing.
+    glob();
+    add_globbed_maps();
+  }
+#endif
+}
+
+void MenuPlayScene::stop_glob_maps() {
+  if(!map_globber_.joinable()) { return; }
+
+  is_glob_canceled_.store(true,std::memory_order_relaxed);
+  map_globber_.join();
+}
+
+void MenuPlayScene::add_globbed_maps() {
+  if(!is_globbing_) { return; }
+
+  std::vector<MapMeta> maps{};
+  bool is_done = false;
+
+  {
+    const std::scoped_lock lock{glob_mutex_};
+    maps.swap(globbed_maps_);
+    is_done = is_glob_done_;
+  }
+
+  for(auto& meta : maps) { add_map_opt(std::move(meta)); }
+
+  if(!is_done) { return; }
+
+  is_globbing_ = false;
+  if(map_globber_.joinable()) { map_globber_.join(); } // Already done, so won't block.
 
   if(map_opts_.size() <= kNonMapOptCount) {
     ctx_.cybel_engine.show_error("No maps were found/loaded in the sub folders of the maps folder [" +
                                  Assets::kMapsSubdir.string() + "].");
-    return;
   }
+}
 
-  // Sort by: non-core group, core group, & title.
-  std::sort(
-    map_opts_.begin() + kNonMapOptCount,map_opts_.end(),
-    [&](const auto& opt1,const auto& opt2) {
-      // Return true if opt1 < opt2.
+void MenuPlayScene::add_map_opt(MapMeta&& meta) {
+  static constexpr int kMaxTitleLen = 25;
+  static constexpr int kMaxGroupLen = 17;
 
-      const bool is_core_group1 = kCoreGroupToPriority.contains(opt1.group);
-      const bool is_core_group2 = kCoreGroupToPriority.contains(opt2.group);
+  MapOption opt{};
 
-      // Bubble non-core groups to top.
-      if(is_core_group1 && !is_core_group2) { return false; } // opt1 > opt2.
-      if(!is_core_group1 && is_core_group2) { return true; } // opt1 < opt2.
+  opt.group = std::move(meta.group);
+  opt.file = std::move(meta.file);
+  opt.title = std::move(meta.title);
+  opt.text = utf8::StrUtil::ljust(utf8::StrUtil::ellipsize(opt.title,kMaxTitleLen),kMaxTitleLen) +
+             ' ' + utf8::StrUtil::ellipsize(opt.group,kMaxGroupLen);
 
-      int group_cmp = 0;
+  // Insert in sorted order, so that the options don't jump around as more maps are added.
+  const auto it = std::upper_bound(map_opts_.begin() + kNonMapOptCount,map_opts_.end(),opt,is_map_opt_less);
+  const auto index = static_cast<int>(it - map_opts_.begin());
 
-      if(is_core_group1 && is_core_group2) {
-        group_cmp = kCoreGroupToPriority[opt1.group] - kCoreGroupToPriority[opt2.group];
-      } else {
-        group_cmp = utf8::StrUtil::casecmp_ascii(opt1.group,opt2.group);
-      }
+  // Select the correct map from the previous/current state.
+  const bool is_state_map = can_restore_sel_ && opt.file == state_.map_file;
 
-      if(group_cmp != 0) { return group_cmp < 0; }
-      return utf8::StrUtil::casecmp_ascii(opt1.title,opt2.title) < 0;
-    }
-  );
+  map_opts_.insert(it,std::move(opt));
 
-  // Select the correct map from the previous/current state.
-  if(!state_.is_rand_map) {
-    for(std::size_t i = 0; i < map_opts_.size(); ++i) {
-      if(map_opts_[i].file == state_.map_file) {
-        map_opt_index_ = static_cast<int>(i);
-        break;
-      }
-    }
+  if(is_state_map) {
+    map_opt_index_ = index;
+    can_restore_sel_ = false;
+  } else if(map_opt_index_ >= index) {
+    ++map_opt_index_; // Keep the same option selected.
   }
 }
 
+bool MenuPlayScene::is_map_opt_less(const MapOption& opt1,const MapOption& opt2) {
+  // Sort by: non-core group, core group, & title.
+  const bool is_core_group1 = kCoreGroupToPriority.contains(opt1.group);
+  const bool is_core_group2 = kCoreGroupToPriority.contains(opt2.group);
+
+  // Bubble non-core groups to top.
+  if(is_core_group1 && !is_core_group2) { return false; } // opt1 > opt2.
+  if(!is_core_group1 && is_core_group2) { return true; } // opt1 < opt2.
+
+  int group_cmp = 0;
+
+  if(is_core_group1 && is_core_group2) {
+    group_cmp = kCoreGroupToPriority[opt1.group] - kCoreGroupToPriority[opt2.group];
+  } else {
+    group_cmp = utf8::StrUtil::casecmp_ascii(opt1.group,opt2.group);
+  }
+
+  if(group_cmp != 0) { return group_cmp < 0; }
+
+  const int title_cmp = utf8::StrUtil::casecmp_ascii(opt1.title,opt2.title);
+
+  // The groups are crawled in parallel, so don't let the order of the batches decide ties.
+  if(title_cmp != 0) { return title_cmp < 0; }
+  return opt1.file < opt2.file;
+}
+
 void MenuPlayScene::prev_map_opt_group() {
   if(map_opts_.empty()) { return; }
 
@@ -206,6 +289,8 @@ void MenuPlayScene::next_map_opt_group() {
 }
 
 void MenuPlayScene::select_map_opt(int index,bool wrap) {
+  can_restore_sel_ = false; // The player chose.
+
   if(map_opts_.empty()) {
     map_opt_index_ = 0;
     return;
@@ -233,7 +318,7 @@ void MenuPlayScene::select_map() {
 
     // Try not to grab the same map as last time.
     for(int i = 0; i < 10; ++i) {
-      new_map_file = map_opts_.at(Rando::it().rand_size_t(kNonMapOptCount,map_opts_.size())).file;
+      new_map_file = map_opts_.at(ctx_.rando.rand_size_t(kNonMapOptCount,map_opts_.size())).file;
 
       if(new_map_file != state_.map_file) { break; }
     }
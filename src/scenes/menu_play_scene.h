@@ -13,9 +13,13 @@
 #include "cybel/scene/scene.h"
 
 #include "core/game_context.h"
+#include "map/map_index.h"
 #include "scenes/scene_action.h"
 
+#include <atomic>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -30,6 +34,13 @@ public:
 
   explicit MenuPlayScene(GameContext& ctx,State& state);
 
+  MenuPlayScene(const MenuPlayScene& other) = delete;
+  MenuPlayScene(MenuPlayScene&& other) noexcept = delete;
+  ~MenuPlayScene() noexcept override;
+
+  MenuPlayScene& operator=(const MenuPlayScene& other) = delete;
+  MenuPlayScene& operator=(MenuPlayScene&& other) noexcept = delete;
+
   void on_scene_input_event(input_id_t input_id,const ViewDimens& dimens) override;
   int update_scene_logic(const FrameStep& step,const ViewDimens& dimens) override;
   void draw_scene(Renderer& ren,const ViewDimens& dimens) override;
@@ -74,7 +85,23 @@ private:
   int map_opt_index_ = 0;
   std::vector<MapOption> map_opts_{};
 
+  // The maps are globbed on a worker thread (except on the Web & w/o GameContext.load_in_bg) & added to
+  //     map_opts_ in batches, so that the player can already scroll & select while scanning.
+  std::thread map_globber_{};
+  std::atomic<bool> is_glob_canceled_{false};
+  std::mutex glob_mutex_{}; // For the vars below.
+  std::vector<MapMeta> globbed_maps_{};
+  bool is_glob_done_ = false;
+
+  bool is_globbing_ = false;
+  bool can_restore_sel_ = false; // Until the player selects an option.
+
+  static bool is_map_opt_less(const MapOption& opt1,const MapOption& opt2);
+
   void glob_maps();
+  void stop_glob_maps();
+  void add_globbed_maps();
+  void add_map_opt(MapMeta&& meta);
   void prev_map_opt_group();
   void next_map_opt_group();
   void select_map_opt(int index,bool wrap);
@@ -21,4 +21,28 @@ bool SceneActions::is_menu(int action) {
   }
 }
 
+std::string_view SceneActions::name_of(int action) {
+  switch(action) {
+    case SceneAction::kNil: return "nil";
+    case SceneAction::kQuit: return "quit";
+    case SceneAction::kGoBack: return "go_back";
+    case SceneAction::kRestart: return "restart";
+    case SceneAction::kGoToMenu: return "menu";
+    case SceneAction::kGoToMenuPlay: return "menu_play";
+    case SceneAction::kGoToMenuCredits: return "menu_credits";
+    case SceneAction::kGoToGame: return "game";
+    case SceneAction::kGoToBoringWork: return "boring_work";
+
+    default: return "unknown";
+  }
+}
+
+int SceneActions::value_of(std::string_view name) {
+  for(int action = SceneAction::kNil; action <= SceneAction::kGoToBoringWork; ++action) {
+    if(name_of(action) == name) { return action; }
+  }
+
+  return SceneAction::kNil;
+}
+
 } // namespace ekoscape
@@ -10,6 +10,8 @@
 
 #include "common.h"
 
+#include <string_view>
+
 namespace ekoscape {
 
 namespace SceneAction {
@@ -28,6 +30,11 @@ namespace SceneAction {
 
 namespace SceneActions {
   bool is_menu(int action);
+  std::string_view name_of(int action);
+  /**
+   * Returns the action with the name (see name_of()), else kNil.
+   */
+  int value_of(std::string_view name);
 }
 
 } // namespace ekoscape
@@ -0,0 +1,176 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "game_sim.h"
+
+#include <utility>
+
+namespace ekoscape {
+
+GameSim::PhaseTimes& GameSim::PhaseTimes::operator+=(const PhaseTimes& other) {
+  load += other.load;
+  player_bot += other.player_bot;
+  update_player += other.update_player;
+  update_robots += other.update_robots;
+  move_robots += other.move_robots;
+
+  return *this;
+}
+
+GameSim::clock_t::duration GameSim::PhaseTimes::total_ticks() const {
+  return player_bot + update_player + update_robots + move_robots;
+}
+
+GameSim::GameSim(const std::filesystem::path& map_file,int logic_hz,bool make_weird,std::uint64_t seed)
+  : world_(map_,nullptr,seed),bot_rando_(Rando{seed}.split(kBotStream)) {
+  const auto start_time = clock_t::now();
+
+  world_.load_map(map_file,make_weird);
+  map_.add_to_bridge();
+
+  phase_times_.load = clock_t::now() - start_time;
+
+  if(logic_hz <= 0) { logic_hz = kDefaultLogicHz; }
+
+  // Same fixed step as CybelEngine's logic ticks.
+  step_.dpf = Duration::from_secs(1.0 / static_cast<double>(logic_hz));
+  step_.delta_time = step_.dpf.secs();
+
+  player_walk_duration_ = player_walk_duration(map_);
+  player_turn_duration_ = player_turn_duration(map_);
+
+  // Like GameScene, the Robots don't start moving until after the Map Info is shown.
+  world_.delay_robots(step_.dpf);
+}
+
+Duration GameSim::player_walk_duration(const Map& map) {
+  // Based on 60 FPS.
+  const float walking_speed = (map.walking_speed() > 0.0f) ? map.walking_speed() : 15.0f;
+
+  return Duration::from_secs(static_cast<double>(walking_speed) / 60.0);
+}
+
+Duration GameSim::player_turn_duration(const Map& map) {
+  // Based on 60 FPS.
+  const float turning_speed = (map.turning_speed() > 0.0f) ? map.turning_speed() : 5.0f;
+
+  return Duration::from_secs(static_cast<double>(90.0f / turning_speed) / 60.0);
+}
+
+long long GameSim::run(long long max_ticks) {
+  long long ticks = 0;
+
+  for(; ticks < max_ticks && !world_.is_game_over(); ++ticks) {
+    tick();
+  }
+
+  return ticks;
+}
+
+void GameSim::tick() {
+  auto time = clock_t::now();
+  auto prev_time = time;
+
+  update_player_bot();
+  time = clock_t::now();
+  phase_times_.player_bot += time - prev_time;
+  prev_time = time;
+
+  world_.update_player(step_);
+  time = clock_t::now();
+  phase_times_.update_player += time - prev_time;
+  prev_time = time;
+
+  world_.update_robots(step_);
+  time = clock_t::now();
+  phase_times_.update_robots += time - prev_time;
+  prev_time = time;
+
+  world_.move_robots(step_);
+  time = clock_t::now();
+  phase_times_.move_robots += time - prev_time;
+}
+
+void GameSim::set_player_moves(std::string moves) {
+  has_player_moves_ = true;
+  player_moves_ = std::move(moves);
+  player_move_index_ = 0;
+  player_blocked_moves_ = 0;
+}
+
+void GameSim::update_player_bot() {
+  if(world_.is_game_over()) { return; }
+
+  // Still walking/turning?
+  if(player_move_time_ > Duration::kZero) {
+    player_move_time_ -= step_.dpf;
+    return;
+  }
+  // Can't move while warping (see GameScene.handle_scene_input()).
+  if(world_.player_warp_time() > Duration::kZero) { return; }
+
+  if(has_player_moves_) {
+    update_player_moves();
+    return;
+  }
+
+  // Occasionally turn at random, else the bot could just walk back & forth in a long hallway forever.
+  if(!map_.can_player_step_forward() || bot_rando_.rand_int(8) == 0) {
+    if(bot_rando_.rand_bool()) {
+      map_.turn_player_left();
+    } else {
+      map_.turn_player_right();
+    }
+
+    player_move_time_ = player_turn_duration_;
+    return;
+  }
+
+  map_.step_player_forward();
+  player_move_time_ = player_walk_duration_;
+}
+
+void GameSim::update_player_moves() {
+  if(player_move_index_ >= player_moves_.size()) { return; }
+
+  switch(player_moves_[player_move_index_++]) {
+    case 'F':
+      if(!map_.step_player_forward()) {
+        ++player_blocked_moves_;
+        return;
+      }
+
+      player_move_time_ = player_walk_duration_;
+      break;
+
+    case 'L':
+      map_.turn_player_left();
+      player_move_time_ = player_turn_duration_;
+      break;
+
+    case 'R':
+      map_.turn_player_right();
+      player_move_time_ = player_turn_duration_;
+      break;
+
+    default:
+      ++player_blocked_moves_;
+      break;
+  }
+}
+
+const SimMap& GameSim::map() const { return map_; }
+
+const GameWorld& GameSim::world() const { return world_; }
+
+const GameSim::PhaseTimes& GameSim::phase_times() const { return phase_times_; }
+
+std::size_t GameSim::player_moves_left() const { return player_moves_.size() - player_move_index_; }
+
+int GameSim::player_blocked_moves() const { return player_blocked_moves_; }
+
+} // namespace ekoscape
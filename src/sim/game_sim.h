@@ -0,0 +1,114 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_SIM_GAME_SIM_H_
+#define EKOSCAPE_SIM_GAME_SIM_H_
+
+#include "common.h"
+
+#include "cybel/types/duration.h"
+#include "cybel/types/frame_step.h"
+#include "cybel/util/rando.h"
+
+#include "sim/sim_map.h"
+#include "world/game_world.h"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+
+namespace ekoscape {
+
+/**
+ * Runs a single game headlessly (no window, renderer, or Dantares) as fast as possible,
+ * using a simple bot for the Player that always walks forward & turns randomly when blocked
+ * (similar to the real game, where the Player always keeps moving forward).
+ *
+ * Each phase of a tick is timed separately, so that regressions can be narrowed down.
+ *
+ * The same seed always simulates the same game (the bot uses its own stream split from the seed).
+ *
+ * Instead of the random bot, the Player can also follow a list of moves (see set_player_moves()),
+ * such as a route from RouteSolver, to replay it against the Robots.
+ */
+class GameSim {
+public:
+  using clock_t = std::chrono::steady_clock;
+
+  struct PhaseTimes {
+    clock_t::duration load{};
+    clock_t::duration player_bot{};
+    clock_t::duration update_player{};
+    clock_t::duration update_robots{};
+    clock_t::duration move_robots{};
+
+    PhaseTimes& operator+=(const PhaseTimes& other);
+    clock_t::duration total_ticks() const;
+  };
+
+  static constexpr int kDefaultLogicHz = 120; // Same as the game.
+
+  /**
+   * How long the Player takes to walk 1 Space or turn 90 degrees in `map`,
+   * using the same formulas as Dantares (see Map.set_walking_speed() & Map.set_turning_speed()).
+   */
+  static Duration player_walk_duration(const Map& map);
+  static Duration player_turn_duration(const Map& map);
+
+  explicit GameSim(const std::filesystem::path& map_file,int logic_hz,bool make_weird = false,
+                   std::uint64_t seed = Rando::gen_seed());
+
+  GameSim(const GameSim& other) = delete;
+  GameSim(GameSim&& other) noexcept = delete;
+
+  GameSim& operator=(const GameSim& other) = delete;
+  GameSim& operator=(GameSim&& other) noexcept = delete;
+
+  /**
+   * Returns the number of ticks run, which is less than max_ticks if the game ended early.
+   */
+  long long run(long long max_ticks);
+  void tick();
+
+  /**
+   * Makes the Player follow `moves` (one per char: 'F'orward, 'L'eft, or 'R'ight), instead of the random bot.
+   * After the last move, the Player just stands still.
+   *
+   * A move that can't be done (e.g., walking into a wall) is skipped & counted (see player_blocked_moves()).
+   */
+  void set_player_moves(std::string moves);
+
+  const SimMap& map() const;
+  const GameWorld& world() const;
+  const PhaseTimes& phase_times() const;
+  std::size_t player_moves_left() const;
+  int player_blocked_moves() const;
+
+private:
+  static constexpr std::uint64_t kBotStream = 100; // Away from GameWorld's stream IDs.
+
+  SimMap map_{};
+  GameWorld world_;
+  Rando bot_rando_;
+  FrameStep step_{};
+  PhaseTimes phase_times_{};
+
+  Duration player_walk_duration_{};
+  Duration player_turn_duration_{};
+  Duration player_move_time_{};
+
+  bool has_player_moves_ = false;
+  std::string player_moves_{};
+  std::size_t player_move_index_ = 0;
+  int player_blocked_moves_ = 0;
+
+  void update_player_bot();
+  void update_player_moves();
+};
+
+} // namespace ekoscape
+#endif
@@ -0,0 +1,587 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "route_solver.h"
+
+#include "cybel/types/cybel_error.h"
+
+#include "map/facing.h"
+#include "sim/game_sim.h"
+#include "world/game_world.h"
+
+#include <algorithm>
+#include <cmath>
+#include <array>
+#include <utility>
+
+namespace ekoscape {
+
+RouteSolver::RouteSolver(const Map& map)
+  : map_(map),spaces_(map.spaces()) {
+  for(int z = 0; z < spaces_.grid_count(); ++z) {
+    const Size2i& size = spaces_.size(z);
+
+    grid_starts_.push_back(spaces_.index_of(Pos3i{-1,-1,z}));
+    space_count_ = spaces_.index_of(Pos3i{size.w,size.h,z}) + 1;
+
+    for(int y = 0; y < size.h; ++y) {
+      for(int x = 0; x < size.w; ++x) {
+        const std::size_t index = spaces_.index_of(Pos3i{x,y,z});
+        const Space& space = spaces_.at(index);
+
+        if(space.thing_type() == SpaceType::kCell) {
+          cells_.push_back(index);
+        } else if(space.thing_type() == SpaceType::kEnd) {
+          ends_.push_back(index);
+        }
+        if(space.is_portal()) { portal_to_indexes_[space.empty_type()].push_back(index); }
+      }
+    }
+  }
+
+  walk_cost_ = to_cost(GameSim::player_walk_duration(map));
+  turn_cost_ = to_cost(GameSim::player_turn_duration(map));
+  warp_cost_ = to_cost(GameWorld::kWarpDuration);
+}
+
+RouteSolver::Route RouteSolver::solve() const {
+  if(spaces_.empty()) { throw CybelError{"No grids in map [",map_.title(),"]."}; }
+
+  Route route{};
+  std::vector<Cost> costs{};
+
+  search(start_state(),costs);
+
+  if(end_cost(costs) == kNoCost) { throw CybelError{"The End can't be reached in map [",map_.title(),"]."}; }
+
+  // Cells that can't be reached can't be rescued, so leave them out instead of failing.
+  std::vector<std::size_t> cells{};
+
+  for(const auto cell : cells_) {
+    bool is_reachable = false;
+
+    for(State facing = 0; facing < kFacingCount; ++facing) {
+      if(costs[(cell * kFacingCount) + facing] != kNoCost) {
+        is_reachable = true;
+        break;
+      }
+    }
+
+    if(is_reachable) {
+      cells.push_back(cell);
+    } else {
+      ++route.unreachable_cell_count;
+    }
+  }
+
+  route.cell_count = static_cast<int>(cells.size());
+
+  if(cells.size() > static_cast<std::size_t>(kMaxCells)) {
+    throw CybelError{"Too many Cells [",cells.size(),"] in map [",map_.title(),"] to solve (max: ",kMaxCells,
+                     ")."};
+  }
+
+  const Legs legs = calc_legs(cells);
+
+  route.is_optimal = (cells.size() <= static_cast<std::size_t>(kMaxExactCells));
+
+  auto targets = route.is_optimal ? order_exactly(legs) : order_greedily(legs);
+  if(targets.size() != cells.size()) {
+    throw CybelError{"No route rescues all Cells & reaches the End in map [",map_.title(),"]."};
+  }
+
+  targets.push_back(legs.end_target());
+
+  Cost time = 0;
+  std::size_t key = 0;
+
+  for(const auto target : targets) {
+    const Cost cost = legs.cost(key,target);
+
+    if(cost == kNoCost) {
+      throw CybelError{"No route rescues all Cells & reaches the End in map [",map_.title(),"]."};
+    }
+
+    time += cost;
+    key = 1 + target;
+  }
+
+  State from = start_state();
+
+  for(const auto target : targets) {
+    const State to = to_state(cells,target);
+
+    append_leg(from,to,route);
+    from = to;
+  }
+
+  // The game is over as soon as the Player steps on the End (see GameSim), without finishing the walk.
+  time -= walk_cost_;
+
+  route.time = to_duration(time);
+  route.lower_bound = route.is_optimal ? route.time
+                                       : to_duration(std::min(time,calc_tree_bound(legs) - walk_cost_));
+
+  return route;
+}
+
+std::size_t RouteSolver::Legs::end_target() const { return target_count - 1; }
+
+RouteSolver::Cost RouteSolver::Legs::cost(std::size_t key,std::size_t target) const {
+  return costs[(key * target_count) + target];
+}
+
+RouteSolver::Cost RouteSolver::Legs::node_cost(std::size_t from_node,std::size_t to_node) const {
+  const std::size_t end_node = cell_count + 1;
+
+  if(from_node >= end_node || to_node == 0 || to_node > end_node) { return kNoCost; }
+
+  const std::size_t key_begin = (from_node == 0) ? 0 : (1 + ((from_node - 1) * kFacingCount));
+  const std::size_t key_end = (from_node == 0) ? 1 : (key_begin + kFacingCount);
+  const std::size_t target_begin = (to_node == end_node) ? end_target() : ((to_node - 1) * kFacingCount);
+  const std::size_t target_end = (to_node == end_node) ? (target_begin + 1) : (target_begin + kFacingCount);
+  Cost best = kNoCost;
+
+  for(std::size_t key = key_begin; key < key_end; ++key) {
+    for(std::size_t target = target_begin; target < target_end; ++target) {
+      best = std::min(best,cost(key,target));
+    }
+  }
+
+  return best;
+}
+
+RouteSolver::Cost RouteSolver::to_cost(const Duration& duration) {
+  return static_cast<Cost>(std::llround(duration.secs() * 1'000'000.0));
+}
+
+Duration RouteSolver::to_duration(Cost cost) {
+  return Duration::from_millis(static_cast<double>(cost) / 1'000.0);
+}
+
+std::vector<std::size_t> RouteSolver::order_exactly(const Legs& legs) {
+  // Held-Karp: best time to have rescued the Cells in `mask`, ending on target `t` (a Cell & facing).
+  const std::size_t cell_count = legs.cell_count;
+  const std::size_t state_count = cell_count * kFacingCount;
+  const std::size_t mask_count = std::size_t{1} << cell_count;
+  const std::size_t full_mask = mask_count - 1;
+  constexpr auto kNoPrev = std::numeric_limits<std::uint16_t>::max();
+
+  std::vector<Cost> best(mask_count * state_count,kNoCost);
+  std::vector<std::uint16_t> prevs(best.size(),kNoPrev);
+
+  for(std::size_t t = 0; t < state_count; ++t) {
+    best[((std::size_t{1} << (t / kFacingCount)) * state_count) + t] = legs.cost(0,t);
+  }
+
+  for(std::size_t mask = 1; mask < mask_count; ++mask) {
+    for(std::size_t t = 0; t < state_count; ++t) {
+      const Cost time = best[(mask * state_count) + t];
+      if(time == kNoCost) { continue; }
+
+      for(std::size_t u = 0; u < state_count; ++u) {
+        const std::size_t cell_bit = std::size_t{1} << (u / kFacingCount);
+        if((mask & cell_bit) != 0) { continue; }
+
+        const Cost leg = legs.cost(1 + t,u);
+        if(leg == kNoCost) { continue; }
+
+        const std::size_t next = ((mask | cell_bit) * state_count) + u;
+
+        if(time + leg < best[next]) {
+          best[next] = time + leg;
+          prevs[next] = static_cast<std::uint16_t>(t);
+        }
+      }
+    }
+  }
+
+  std::vector<std::size_t> targets{};
+  if(cell_count == 0) { return targets; }
+
+  Cost best_time = kNoCost;
+  std::size_t last = kNoPrev;
+
+  for(std::size_t t = 0; t < state_count; ++t) {
+    const Cost time = best[(full_mask * state_count) + t];
+    const Cost leg = legs.cost(1 + t,legs.end_target());
+
+    if(time != kNoCost && leg != kNoCost && time + leg < best_time) {
+      best_time = time + leg;
+      last = t;
+    }
+  }
+
+  if(last == kNoPrev) { return targets; } // No route.
+
+  for(std::size_t mask = full_mask; last != kNoPrev;) {
+    targets.push_back(last);
+
+    const std::size_t prev = prevs[(mask * state_count) + last];
+
+    mask &= ~(std::size_t{1} << (last / kFacingCount));
+    last = prev;
+  }
+
+  std::ranges::reverse(targets);
+
+  return targets;
+}
+
+std::vector<std::size_t> RouteSolver::order_greedily(const Legs& legs) {
+  // Nodes: 0 for the start, 1+ for each Cell, & then the End.
+  const std::size_t cell_count = legs.cell_count;
+  const std::size_t end_node = cell_count + 1;
+  std::vector<std::size_t> nodes{0};
+  std::vector<bool> is_visited(cell_count + 1,false);
+
+  // Nearest neighbor.
+  for(std::size_t i = 0; i < cell_count; ++i) {
+    std::size_t best_node = 0;
+    Cost best_time = kNoCost;
+
+    for(std::size_t node = 1; node <= cell_count; ++node) {
+      if(is_visited[node]) { continue; }
+
+      const Cost time = legs.node_cost(nodes.back(),node);
+
+      if(time < best_time) {
+        best_time = time;
+        best_node = node;
+      }
+    }
+
+    if(best_node == 0) { return {}; } // No route.
+
+    is_visited[best_node] = true;
+    nodes.push_back(best_node);
+  }
+
+  nodes.push_back(end_node);
+
+  // 2-opt: reverse any run of Cells that makes the route shorter, until none do.
+  //     The times are just estimates (see Legs.node_cost()), but pick_facings() finds the real ones.
+  const auto time_between = [&](std::size_t node1,std::size_t node2) {
+    return std::min(legs.node_cost(node1,node2),legs.node_cost(node2,node1));
+  };
+  const auto add_times = [](Cost time1,Cost time2) {
+    return (time1 == kNoCost || time2 == kNoCost) ? kNoCost : (time1 + time2);
+  };
+
+  for(bool is_shorter = true; is_shorter;) {
+    is_shorter = false;
+
+    for(std::size_t i = 1; i + 1 < nodes.size(); ++i) {
+      for(std::size_t j = i + 1; j + 1 < nodes.size(); ++j) {
+        const Cost old_time = add_times(time_between(nodes[i - 1],nodes[i]),
+                                        time_between(nodes[j],nodes[j + 1]));
+        const Cost new_time = add_times(time_between(nodes[i - 1],nodes[j]),
+                                        time_between(nodes[i],nodes[j + 1]));
+
+        if(new_time < old_time) {
+          std::reverse(nodes.begin() + static_cast<std::ptrdiff_t>(i),
+                       nodes.begin() + static_cast<std::ptrdiff_t>(j) + 1);
+          is_shorter = true;
+        }
+      }
+    }
+  }
+
+  std::vector<std::size_t> cells{};
+
+  for(std::size_t i = 1; i + 1 < nodes.size(); ++i) { cells.push_back(nodes[i] - 1); }
+
+  return pick_facings(legs,cells);
+}
+
+std::vector<std::size_t> RouteSolver::pick_facings(const Legs& legs,const std::vector<std::size_t>& cells) {
+  // Best time to each facing of each Cell in order (like order_exactly(), but for only 1 order).
+  const std::size_t facing_count = kFacingCount;
+  std::vector<Cost> best(cells.size() * facing_count,kNoCost);
+  std::vector<std::size_t> prevs(best.size(),0);
+
+  for(std::size_t i = 0; i < cells.size(); ++i) {
+    for(std::size_t facing = 0; facing < facing_count; ++facing) {
+      const std::size_t target = (cells[i] * facing_count) + facing;
+      Cost& time = best[(i * facing_count) + facing];
+
+      if(i == 0) {
+        time = legs.cost(0,target);
+        continue;
+      }
+
+      for(std::size_t prev = 0; prev < facing_count; ++prev) {
+        const Cost prev_time = best[((i - 1) * facing_count) + prev];
+        const Cost leg = legs.cost(1 + (cells[i - 1] * facing_count) + prev,target);
+
+        if(prev_time != kNoCost && leg != kNoCost && prev_time + leg < time) {
+          time = prev_time + leg;
+          prevs[(i * facing_count) + facing] = prev;
+        }
+      }
+    }
+  }
+
+  std::vector<std::size_t> targets{};
+  if(cells.empty()) { return targets; }
+
+  Cost best_time = kNoCost;
+  std::size_t facing = facing_count;
+  const std::size_t last = cells.size() - 1;
+
+  for(std::size_t f = 0; f < facing_count; ++f) {
+    const Cost time = best[(last * facing_count) + f];
+    const Cost leg = legs.cost(1 + (cells[last] * facing_count) + f,legs.end_target());
+
+    if(time != kNoCost && leg != kNoCost && time + leg < best_time) {
+      best_time = time + leg;
+      facing = f;
+    }
+  }
+
+  if(facing == facing_count) { return targets; } // No route.
+
+  for(std::size_t i = cells.size(); i-- > 0;) {
+    targets.push_back((cells[i] * facing_count) + facing);
+    facing = prevs[(i * facing_count) + facing];
+  }
+
+  std::ranges::reverse(targets);
+
+  return targets;
+}
+
+RouteSolver::Cost RouteSolver::calc_tree_bound(const Legs& legs) {
+  // Prim's, since all nodes are connected to each other.
+  const std::size_t node_count = legs.cell_count + 2;
+  std::vector<Cost> times(node_count,kNoCost);
+  std::vector<bool> is_in_tree(node_count,false);
+  Cost total_time = 0;
+
+  times[0] = 0;
+
+  for(std::size_t i = 0; i < node_count; ++i) {
+    std::size_t node = node_count;
+
+    for(std::size_t n = 0; n < node_count; ++n) {
+      if(!is_in_tree[n] && (node == node_count || times[n] < times[node])) { node = n; }
+    }
+
+    if(times[node] == kNoCost) { return kNoCost; }
+
+    is_in_tree[node] = true;
+    total_time += times[node];
+
+    for(std::size_t n = 0; n < node_count; ++n) {
+      if(is_in_tree[n]) { continue; }
+
+      const Cost time = std::min(legs.node_cost(node,n),legs.node_cost(n,node));
+      times[n] = std::min(times[n],time);
+    }
+  }
+
+  return total_time;
+}
+
+RouteSolver::State RouteSolver::start_state() const {
+  const auto index = spaces_.index_of(map_.player_init_pos());
+
+  return static_cast<State>((index * kFacingCount) +
+                            static_cast<std::size_t>(Facings::value_of(map_.player_init_facing())));
+}
+
+MapSpaces::Offsets RouteSolver::facing_offsets(std::size_t index) const {
+  const auto grid_it = std::ranges::upper_bound(grid_starts_,index);
+  const auto z = static_cast<int>(grid_it - grid_starts_.begin()) - 1;
+  const auto offsets = spaces_.neighbor_offsets(z);
+
+  // Facing values go clockwise: North(0), East(1), South(2), West(3).
+  return MapSpaces::Offsets{offsets[0],offsets[2],offsets[1],offsets[3]};
+}
+
+bool RouteSolver::is_walkable(std::size_t index) const {
+  // Like Dantares (see MapPlanes::Plane::kPlayerWalkable).
+  return SpaceTypes::is_walkable(spaces_.at(index).type());
+}
+
+bool RouteSolver::is_end(std::size_t index) const {
+  return spaces_.at(index).thing_type() == SpaceType::kEnd;
+}
+
+const std::vector<std::size_t>* RouteSolver::portal_bros(std::size_t index) const {
+  const Space& space = spaces_.at(index);
+  if(!space.is_portal()) { return nullptr; }
+
+  const auto it = portal_to_indexes_.find(space.empty_type());
+
+  // Like GameWorld.fetch_portal_bro(), which also has this Portal in the list.
+  return (it != portal_to_indexes_.end() && it->second.size() > 1) ? &it->second : nullptr;
+}
+
+RouteSolver::State RouteSolver::to_state(const std::vector<std::size_t>& cells,std::size_t target) const {
+  if(target == cells.size() * kFacingCount) { return kNoState; } // End.
+
+  return static_cast<State>((cells[target / kFacingCount] * kFacingCount) + (target % kFacingCount));
+}
+
+RouteSolver::Legs RouteSolver::calc_legs(const std::vector<std::size_t>& cells) const {
+  Legs legs{};
+  legs.cell_count = cells.size();
+  legs.target_count = (cells.size() * kFacingCount) + 1;
+  legs.costs.resize(legs.target_count * legs.target_count);
+
+  std::vector<Cost> costs{};
+
+  for(std::size_t key = 0; key < legs.target_count; ++key) {
+    search((key == 0) ? start_state() : to_state(cells,key - 1),costs);
+
+    for(std::size_t target = 0; target < legs.end_target(); ++target) {
+      legs.costs[(key * legs.target_count) + target] = costs[to_state(cells,target)];
+    }
+
+    legs.costs[(key * legs.target_count) + legs.end_target()] = end_cost(costs);
+  }
+
+  return legs;
+}
+
+void RouteSolver::search(State from,std::vector<Cost>& costs,std::vector<State>* prevs,State stop_at) const {
+  using Entry = std::pair<Cost,State>;
+
+  costs.assign(space_count_ * kFacingCount,kNoCost);
+  if(prevs != nullptr) { prevs->assign(costs.size(),kNoState); }
+
+  // Instead of a priority queue, there's a FIFO queue for each kind of move (turn, walk, & warp).
+  //     Each kind always adds the same cost & states are taken in order of cost,
+  //     so each queue stays sorted, & the next state is just the smallest of the 3 fronts.
+  std::array<std::vector<Entry>,3> queues{};
+  std::array<std::size_t,3> queue_heads{};
+
+  const auto relax = [&](std::size_t queue,State prev,std::size_t index,State facing,Cost cost) {
+    const auto state = static_cast<State>((index * kFacingCount) + facing);
+
+    if(cost < costs[state]) {
+      costs[state] = cost;
+      if(prevs != nullptr) { (*prevs)[state] = prev; }
+      queues[queue].emplace_back(cost,state);
+    }
+  };
+
+  const std::size_t from_index = from / kFacingCount;
+
+  costs[from] = 0;
+  queues[0].emplace_back(0,from);
+
+  while(true) {
+    std::size_t queue = queues.size();
+
+    for(std::size_t q = 0; q < queues.size(); ++q) {
+      if(queue_heads[q] >= queues[q].size()) { continue; }
+
+      const Cost front_cost = queues[q][queue_heads[q]].first;
+
+      if(queue == queues.size() || front_cost < queues[queue][queue_heads[queue]].first) { queue = q; }
+    }
+
+    if(queue == queues.size()) { break; } // All empty.
+
+    const auto [cost,state] = queues[queue][queue_heads[queue]++];
+
+    if(cost > costs[state]) { continue; } // Stale.
+    if(state == stop_at) { break; }
+
+    const std::size_t index = state / kFacingCount;
+    const State facing = state % kFacingCount;
+
+    if(index != from_index) {
+      if(is_end(index)) { continue; } // Game over.
+      // A Thing on a non-walkable Space (e.g., a Cell on White) can only be walked on until it's removed,
+      //     so it can be a target, but not walked through (going through a Cell is just another order).
+      if(spaces_.at(index).is_non_walkable()) { continue; }
+    }
+
+    relax(0,state,index,(facing + 3) % kFacingCount,cost + turn_cost_);
+    relax(0,state,index,(facing + 1) % kFacingCount,cost + turn_cost_);
+
+    const auto next_index = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index) +
+                                                     facing_offsets(index)[facing]);
+    if(!is_walkable(next_index)) { continue; }
+
+    const auto* bros = portal_bros(next_index);
+
+    // After warping, the Player doesn't warp again until stepping off of the Portals
+    //     (see GameWorld.update_player()), so only warp when coming from a non-Portal.
+    if(bros == nullptr || spaces_.at(index).is_portal()) {
+      relax(1,state,next_index,facing,cost + walk_cost_);
+      continue;
+    }
+
+    // The warp starts as soon as the Player steps on the Portal, so it overlaps the walk.
+    //     The bro is random, so this is the best case.
+    const Cost warp_cost = cost + std::max(walk_cost_,warp_cost_);
+
+    for(const auto bro : *bros) {
+      if(bro != next_index) { relax(2,state,bro,facing,warp_cost); }
+    }
+  }
+}
+
+RouteSolver::Cost RouteSolver::end_cost(const std::vector<Cost>& costs,State* end_state) const {
+  Cost best = kNoCost;
+
+  for(const auto end : ends_) {
+    for(State facing = 0; facing < kFacingCount; ++facing) {
+      const auto state = static_cast<State>((end * kFacingCount) + facing);
+
+      if(costs[state] < best) {
+        best = costs[state];
+        if(end_state != nullptr) { *end_state = state; }
+      }
+    }
+  }
+
+  return best;
+}
+
+void RouteSolver::append_leg(State from,State to,Route& route) const {
+  std::vector<Cost> costs{};
+  std::vector<State> prevs{};
+
+  search(from,costs,&prevs,to);
+  if(to == kNoState) { end_cost(costs,&to); }
+
+  std::vector<State> states{};
+
+  for(State state = to; state != from; state = prevs[state]) { states.push_back(state); }
+
+  std::ranges::reverse(states);
+
+  for(const auto state : states) {
+    const std::size_t index = from / kFacingCount;
+    const State facing = from % kFacingCount;
+
+    if(state / kFacingCount == index) {
+      route.moves += ((state % kFacingCount) == ((facing + 1) % kFacingCount)) ? 'R' : 'L';
+      ++route.turn_count;
+    } else {
+      const auto next_index = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(index) +
+                                                       facing_offsets(index)[facing]);
+
+      route.moves += 'F';
+      ++route.step_count;
+
+      if(state / kFacingCount != next_index) {
+        ++route.warp_count;
+        if(portal_bros(next_index)->size() > 2) { ++route.random_warp_count; }
+      }
+    }
+
+    from = state;
+  }
+}
+
+} // namespace ekoscape
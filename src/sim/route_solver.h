@@ -0,0 +1,155 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_SIM_ROUTE_SOLVER_H_
+#define EKOSCAPE_SIM_ROUTE_SOLVER_H_
+
+#include "common.h"
+
+#include "cybel/types/duration.h"
+
+#include "map/map.h"
+#include "map/map_spaces.h"
+#include "map/space_type.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * Solves the fastest route of a Map (headlessly) that rescues all Cells & then reaches the End,
+ * for verifying speedruns & ranking maps.
+ *
+ * The Player is modeled like the game: walking 1 Space & turning 90 degrees take the same time as in
+ * GameSim, stepping on a Portal warps to a bro (& waits for the warp), & the End ends the game
+ * (so routes between Cells never go through it). A Thing on a non-walkable Space (e.g., Fruit on White)
+ * is only walked on if it's a Cell, since it's gone after. Robots & Fruit timing are left out,
+ * so the time of the route is a lower bound of any real run (that doesn't eat Fruit on White),
+ * which also has to dodge the Robots.
+ *
+ * The search state is just a Space index (see MapSpaces) & a facing, kept in flat arrays (no hashing).
+ * First, the shortest times between all Cells (for each facing) are found with Dijkstra;
+ * then, the best order of Cells is found exactly with Held-Karp (dynamic programming over subsets)
+ * for up to kMaxExactCells. For more Cells, the route is only a good one (nearest neighbor & 2-opt),
+ * & the lower bound is from a minimum spanning tree of the Cells.
+ *
+ * Example:
+ *   @code
+ *   Map map{};
+ *   map.load_file("map.txt");
+ *
+ *   const RouteSolver::Route route = RouteSolver{map}.solve();
+ *
+ *   GameSim sim{"map.txt",GameSim::kDefaultLogicHz};
+ *   sim.set_player_moves(route.moves);
+ *   @endcode
+ *
+ * The moves are only for GameSim. They can't be turned into an input replay of the game (`--replay`),
+ * since a replay starts at the menus & follows the game's own ticks (e.g., Robot moves & warps).
+ */
+class RouteSolver {
+public:
+  struct Route {
+    std::string moves{}; // 'F'orward, 'L'eft, or 'R'ight (see GameSim.set_player_moves()).
+    Duration time{}; // Of the moves.
+    Duration lower_bound{}; // Same as the time, if optimal.
+    bool is_optimal = false;
+    int cell_count = 0;
+    int unreachable_cell_count = 0; // Left out of the route.
+    int step_count = 0;
+    int turn_count = 0;
+    int warp_count = 0;
+    int random_warp_count = 0; // Warps to 1 of 2+ bros, so a replay might go elsewhere.
+  };
+
+  static constexpr int kMaxExactCells = 12;
+  static constexpr int kMaxCells = 256;
+
+  explicit RouteSolver(const Map& map);
+
+  /**
+   * Throws a CybelError if the End can't be reached or if there are too many Cells (see kMaxCells).
+   */
+  Route solve() const;
+
+private:
+  using Cost = std::int64_t; // Microseconds.
+  using State = std::uint32_t; // Space index * 4 + facing value.
+
+  static constexpr Cost kNoCost = std::numeric_limits<Cost>::max();
+  static constexpr State kNoState = std::numeric_limits<State>::max();
+  static constexpr int kFacingCount = 4;
+
+  /**
+   * The shortest times from each key (the start, then each Cell per facing) to each target
+   * (each Cell per facing, then the End), where key `1 + t` is the same state as target `t`.
+   */
+  struct Legs {
+    std::size_t cell_count = 0;
+    std::size_t target_count = 0;
+    std::vector<Cost> costs{};
+
+    std::size_t end_target() const;
+    Cost cost(std::size_t key,std::size_t target) const;
+    /**
+     * Shortest time between 2 nodes (0 for the start, 1+ for each Cell, & then 1 for the End),
+     * for any facings.
+     */
+    Cost node_cost(std::size_t from_node,std::size_t to_node) const;
+  };
+
+  const Map& map_;
+  const MapSpaces& spaces_;
+  std::size_t space_count_ = 0;
+  std::vector<std::size_t> grid_starts_{}; // Index of the first Space (border) of each grid.
+  std::vector<std::size_t> cells_{};
+  std::vector<std::size_t> ends_{};
+  std::unordered_map<SpaceType,std::vector<std::size_t>> portal_to_indexes_{};
+  Cost walk_cost_ = 0;
+  Cost turn_cost_ = 0;
+  Cost warp_cost_ = 0;
+
+  static Cost to_cost(const Duration& duration);
+  static Duration to_duration(Cost cost);
+  /**
+   * These return the Cell targets in order (the End is always last).
+   */
+  static std::vector<std::size_t> order_exactly(const Legs& legs);
+  static std::vector<std::size_t> order_greedily(const Legs& legs);
+  static std::vector<std::size_t> pick_facings(const Legs& legs,const std::vector<std::size_t>& cells);
+  /**
+   * Weight of a minimum spanning tree of all nodes (see Legs.node_cost()),
+   * since any route must connect them all.
+   */
+  static Cost calc_tree_bound(const Legs& legs);
+
+  State start_state() const;
+  MapSpaces::Offsets facing_offsets(std::size_t index) const;
+  bool is_walkable(std::size_t index) const;
+  bool is_end(std::size_t index) const;
+  const std::vector<std::size_t>* portal_bros(std::size_t index) const;
+  State to_state(const std::vector<std::size_t>& cells,std::size_t target) const;
+
+  Legs calc_legs(const std::vector<std::size_t>& cells) const;
+
+  /**
+   * Finds the shortest times from `from` to all states (or just until `stop_at`).
+   * Ends aren't walked through, since the game would be over.
+   */
+  void search(State from,std::vector<Cost>& costs,std::vector<State>* prevs = nullptr,
+              State stop_at = kNoState) const;
+  Cost end_cost(const std::vector<Cost>& costs,State* end_state = nullptr) const;
+  void append_leg(State from,State to,Route& route) const;
+};
+
+} // namespace ekoscape
+#endif
@@ -0,0 +1,200 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// Standard console app, so don't let SDL2 hijack main().
+#ifndef SDL_MAIN_HANDLED
+#define SDL_MAIN_HANDLED
+#endif
+
+#include "common.h"
+
+#include "cybel/types/cybel_error.h"
+#include "cybel/util/rando.h"
+#include "cybel/util/tool_util.h"
+
+#include "sim/game_sim.h"
+
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * Headless simulator for measuring the tick throughput of the game logic (no window, GPU, or audio).
+ *
+ * Usage:
+ *   EkoScapeSim [--games N] [--ticks N] [--hz N] [--seed N] [--weird] <map file>...
+ *
+ * Each game's seed is split from the main seed by the map's index & the game's index,
+ * so a run can be reproduced exactly by passing the same seed (printed at the start).
+ */
+class SimMain {
+public:
+  int run(int argc,char** argv);
+
+private:
+  using clock_t = GameSim::clock_t;
+
+  int games_ = 100;
+  long long max_ticks_ = 10'000;
+  int logic_hz_ = GameSim::kDefaultLogicHz;
+  std::uint64_t seed_ = Rando::gen_seed();
+  bool make_weird_ = false;
+  std::vector<std::filesystem::path> map_files_{};
+
+  static void print_usage();
+  static void print_phase(std::string_view name,const clock_t::duration& time,long long ticks);
+
+  bool parse_args(int argc,char** argv);
+
+  void run_map(std::size_t map_index,GameSim::PhaseTimes& all_times,long long& all_ticks);
+};
+
+int SimMain::run(int argc,char** argv) {
+  if(!parse_args(argc,argv)) { return 1; }
+
+  GameSim::PhaseTimes all_times{};
+  long long all_ticks = 0;
+  const auto start_time = clock_t::now();
+
+  std::cout << "[INFO] Seed [" << seed_ << "].\n";
+
+  for(std::size_t i = 0; i < map_files_.size(); ++i) {
+    run_map(i,all_times,all_ticks);
+  }
+
+  const auto wall_time = clock_t::now() - start_time;
+  const double wall_secs = std::chrono::duration<double>(wall_time).count();
+
+  std::cout << "[INFO] Total: maps [" << map_files_.size() << "], games ["
+            << (static_cast<std::size_t>(games_) * map_files_.size()) << "], ticks [" << all_ticks << "], wall time [" << std::fixed << std::setprecision(3)
+            << wall_secs << "s].\n";
+  print_phase("total",all_times.total_ticks(),all_ticks);
+  print_phase("load",all_times.load,all_ticks);
+  print_phase("player_bot",all_times.player_bot,all_ticks);
+  print_phase("update_player",all_times.update_player,all_ticks);
+  print_phase("update_robots",all_times.update_robots,all_ticks);
+  print_phase("move_robots",all_times.move_robots,all_ticks);
+  std::cout << std::flush;
+
+  return 0;
+}
+
+void SimMain::print_usage() {
+  std::cout << "Usage: EkoScapeSim [options] <map file>...\n"
+               "\n"
+               "Options:\n"
+               "  --games N    Games to simulate per map (default: 100).\n"
+               "  --ticks N    Max ticks per game (default: 10000).\n"
+               "  --hz N       Logic ticks per simulated second (default: 120).\n"
+               "  --seed N     Seed for reproducing a run (default: random).\n"
+               "  --weird      Make the maps weird (like the game's weird mode).\n"
+               "  --help       Show this help.\n"
+            << std::flush;
+}
+
+void SimMain::print_phase(std::string_view name,const clock_t::duration& time,long long ticks) {
+  const double ms = ToolUtil::to_ms(time);
+  const double ns_per_tick = (ticks > 0)
+                             ? (std::chrono::duration<double,std::nano>(time).count() / static_cast<double>(ticks))
+                             : 0.0;
+  const double secs = ms / 1000.0;
+  const double ticks_per_sec = (secs > 0.0) ? (static_cast<double>(ticks) / secs) : 0.0;
+
+  std::cout << "[INFO]   " << std::left << std::setw(14) << name << std::right
+            << std::fixed << std::setprecision(3)
+            << std::setw(12) << ms << " ms"
+            << std::setw(12) << ns_per_tick << " ns/tick"
+            << std::setprecision(0) << std::setw(14) << ticks_per_sec << " ticks/s\n";
+}
+
+bool SimMain::parse_args(int argc,char** argv) {
+  for(int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    const std::string_view next_arg = (i + 1 < argc) ? std::string_view{argv[i + 1]} : std::string_view{};
+
+    if(arg == "--help" || arg == "-h") {
+      print_usage();
+      return false;
+    }
+    if(arg == "--games") {
+      if(!ToolUtil::parse_num(arg,next_arg,games_) || games_ <= 0) { return false; }
+      ++i;
+    } else if(arg == "--ticks") {
+      if(!ToolUtil::parse_num(arg,next_arg,max_ticks_) || max_ticks_ <= 0) { return false; }
+      ++i;
+    } else if(arg == "--hz") {
+      if(!ToolUtil::parse_num(arg,next_arg,logic_hz_) || logic_hz_ <= 0) { return false; }
+      ++i;
+    } else if(arg == "--seed") {
+      if(!ToolUtil::parse_num(arg,next_arg,seed_)) { return false; }
+      ++i;
+    } else if(arg == "--weird") {
+      make_weird_ = true;
+    } else if(arg.starts_with("--")) {
+      std::cerr << "[ERROR] Unknown option [" << arg << "]." << std::endl;
+      return false;
+    } else {
+      map_files_.emplace_back(arg);
+    }
+  }
+
+  if(map_files_.empty()) {
+    print_usage();
+    return false;
+  }
+
+  return true;
+}
+
+void SimMain::run_map(std::size_t map_index,GameSim::PhaseTimes& all_times,long long& all_ticks) {
+  const auto& map_file = map_files_[map_index];
+  const Rando map_rando = Rando{seed_}.split(map_index);
+  GameSim::PhaseTimes map_times{};
+  long long map_ticks = 0;
+  int wins = 0;
+  int deaths = 0;
+
+  for(int game = 0; game < games_; ++game) {
+    GameSim sim{map_file,logic_hz_,make_weird_,map_rando.split(static_cast<std::uint64_t>(game)).next_u64()};
+
+    map_ticks += sim.run(max_ticks_);
+    map_times += sim.phase_times();
+
+    if(sim.world().is_game_over()) {
+      if(sim.world().player_hit_end()) {
+        ++wins;
+      } else {
+        ++deaths;
+      }
+    }
+  }
+
+  std::cout << "[INFO] Map file ['" << map_file.string() << "']: games [" << games_ << "], ticks ["
+            << map_ticks << "], wins [" << wins << "], deaths [" << deaths << "], timeouts ["
+            << (games_ - wins - deaths) << "].\n";
+  print_phase("total",map_times.total_ticks(),map_ticks);
+
+  all_times += map_times;
+  all_ticks += map_ticks;
+}
+
+} // namespace ekoscape
+
+int main(int argc,char** argv) {
+  using namespace ekoscape;
+
+  try {
+    SimMain sim_main{};
+    return sim_main.run(argc,argv);
+  } catch(const CybelError& e) {
+    std::cerr << "[ERROR] " << e.what() << std::endl;
+    return 1;
+  }
+}
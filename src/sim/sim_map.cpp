@@ -0,0 +1,103 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "sim_map.h"
+
+#include "cybel/types/cybel_error.h"
+
+namespace ekoscape {
+
+Map& SimMap::clear_grids() {
+  Map::clear_grids();
+
+  player_pos_ = Pos3i{};
+  player_facing_ = Facings::kFallback;
+
+  return *this;
+}
+
+void SimMap::add_to_bridge() {
+  if(spaces_.empty()) { throw CybelError{"No grids in map [",title_,"]."}; }
+  if(player_init_pos_.z < 0 || player_init_pos_.z >= spaces_.grid_count()) {
+    throw CybelError{"Invalid player Z [",player_init_pos_.z,"] for map [",title_,"] of size [",
+                     spaces_.grid_count(),"]."};
+  }
+  if(!move_player(player_init_pos_)) {
+    throw CybelError{"Failed to set player pos (",player_init_pos_.x,',',player_init_pos_.y,',',
+                     player_init_pos_.z,") for map [",title_,"]."};
+  }
+
+  player_facing_ = player_init_facing_;
+}
+
+void SimMap::restore(const Snapshot& snapshot) {
+  Map::restore(snapshot);
+  add_to_bridge(); // Puts the Player back.
+}
+
+bool SimMap::move_player(const Pos3i& pos) {
+  if(!Map::move_player(pos)) { return false; } // Calls change_grid(z) if necessary.
+  if(space(pos) == nullptr) { return false; }
+
+  player_pos_ = pos;
+
+  return true;
+}
+
+bool SimMap::sync_player_pos() { return true; } // Always in sync.
+
+bool SimMap::step_player_forward() {
+  if(!can_player_step_forward()) { return false; }
+
+  player_pos_ = player_forward_pos();
+
+  return true;
+}
+
+void SimMap::turn_player_left() {
+  // Facing values go clockwise: North(0), East(1), South(2), West(3).
+  player_facing_ = Facings::to_facing((Facings::value_of(player_facing_) + 3) % 4);
+}
+
+void SimMap::turn_player_right() {
+  player_facing_ = Facings::to_facing((Facings::value_of(player_facing_) + 1) % 4);
+}
+
+bool SimMap::can_player_step_forward() const {
+  const Space* space = this->space(player_forward_pos());
+
+  // Like Dantares, by the type, so a Thing on a non-walkable Space (e.g., White) is walkable.
+  return space != nullptr && SpaceTypes::is_walkable(space->type());
+}
+
+Pos3i SimMap::player_forward_pos() const {
+  Pos3i pos = player_pos_;
+
+  // Origin (0,0) is from the bottom left (see Map), so North goes up.
+  switch(player_facing_) {
+    case Facing::kNorth: ++pos.y; break;
+    case Facing::kSouth: --pos.y; break;
+    case Facing::kEast:  ++pos.x; break;
+    case Facing::kWest:  --pos.x; break;
+  }
+
+  return pos;
+}
+
+Pos3i SimMap::player_pos() const { return player_pos_; }
+
+const Space* SimMap::player_space() const { return space(player_pos_); }
+
+SpaceType SimMap::player_space_type() const {
+  const Space* space = player_space();
+
+  return (space != nullptr) ? space->type() : SpaceType::kNil;
+}
+
+Facing SimMap::player_facing() const { return player_facing_; }
+
+} // namespace ekoscape
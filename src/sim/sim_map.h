@@ -0,0 +1,56 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_SIM_SIM_MAP_H_
+#define EKOSCAPE_SIM_SIM_MAP_H_
+
+#include "common.h"
+
+#include "cybel/types/pos.h"
+
+#include "map/facing.h"
+#include "map/map.h"
+#include "map/space.h"
+#include "map/space_type.h"
+
+namespace ekoscape {
+
+/**
+ * A Map that tracks the Player itself, instead of relying on Dantares (like DantaresMap),
+ * so that the game logic can be simulated without a window or renderer.
+ *
+ * The Player moves instantly one Space at a time; the caller is responsible for any walking/turning delays.
+ */
+class SimMap final : public Map {
+public:
+  Map& clear_grids() override;
+  void add_to_bridge() override;
+  void restore(const Snapshot& snapshot) override;
+
+  bool move_player(const Pos3i& pos) override;
+  bool sync_player_pos() override;
+
+  bool step_player_forward();
+  void turn_player_left();
+  void turn_player_right();
+
+  bool can_player_step_forward() const;
+
+  Pos3i player_pos() const override;
+  const Space* player_space() const override;
+  SpaceType player_space_type() const override;
+  Facing player_facing() const override;
+
+private:
+  Pos3i player_pos_{};
+  Facing player_facing_ = Facings::kFallback;
+
+  Pos3i player_forward_pos() const;
+};
+
+} // namespace ekoscape
+#endif
@@ -0,0 +1,209 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// Standard console app, so don't let SDL2 hijack main().
+#ifndef SDL_MAIN_HANDLED
+#define SDL_MAIN_HANDLED
+#endif
+
+#include "common.h"
+
+#include "cybel/types/cybel_error.h"
+#include "cybel/util/tool_util.h"
+
+#include "map/map.h"
+#include "tools/map_tool.h"
+
+#include <bit>
+#include <filesystem>
+#include <iomanip>
+#include <vector>
+
+namespace ekoscape {
+
+struct MapCheckReport {
+  std::filesystem::path file{};
+  bool is_map = true;
+  std::string error{};
+  std::string title{};
+  std::string author{};
+  int grid_count = 0;
+  int end_count = 0;
+  int reachable_end_count = 0;
+  int cell_count = 0;
+  int unreachable_cell_count = 0;
+  int robot_count = 0;
+  int unreachable_robot_count = 0;
+  int walkable_count = 0;
+  int dead_space_count = 0;
+  double load_ms = 0.0;
+  double check_ms = 0.0;
+
+  bool has_error() const;
+  bool has_warning() const;
+};
+
+/**
+ * Checks every map in the given files & folders (see MapTool) without playing them
+ * (e.g., for user-submitted maps), & writes a JSON report.
+ *
+ * For each map, from the Player's init pos (following Portals across grids):
+ * - Error: the map fails to load, or the End can't be reached.
+ * - Warning: Cells that can't be reached (so can't get a perfect score),
+ *   or Robots that can never get to the Player (except Ghosts, which can go through walls).
+ * - Dead space: walkable Spaces that can't be reached.
+ *
+ * Usage:
+ *   EkoScapeMapCheck [--jobs N] [--out FILE] [paths...]
+ */
+class MapCheck : public MapTool<MapCheckReport> {
+public:
+  explicit MapCheck();
+
+protected:
+  void run_map(Report& report) const override;
+  void write_report(std::ostream& out,const std::vector<Report>& reports,int thread_count,
+                    double total_ms) const override;
+
+private:
+  static void check_reach(const Map& map,Report& report);
+};
+
+bool MapCheckReport::has_error() const { return !error.empty(); }
+
+bool MapCheckReport::has_warning() const {
+  return unreachable_cell_count > 0 || unreachable_robot_count > 0;
+}
+
+MapCheck::MapCheck()
+  : MapTool("EkoScapeMapCheck","Checks","Checked") {}
+
+void MapCheck::run_map(Report& report) const {
+  Map map{};
+
+  auto start_time = clock_t::now();
+  map.load_file(report.file);
+  report.load_ms = ToolUtil::to_ms(clock_t::now() - start_time);
+
+  report.title = map.title();
+  report.author = map.author();
+  report.grid_count = map.grid_count();
+
+  start_time = clock_t::now();
+  check_reach(map,report);
+  report.check_ms = ToolUtil::to_ms(clock_t::now() - start_time);
+
+  if(report.end_count <= 0) {
+    report.error = "No End.";
+  } else if(report.reachable_end_count <= 0) {
+    report.error = "The End can't be reached.";
+  }
+}
+
+void MapCheck::check_reach(const Map& map,Report& report) {
+  using Plane = MapPlanes::Plane;
+
+  const MapPlanes& planes = map.planes();
+  const auto reached = planes.reach(map.spaces(),map.player_init_pos());
+
+  for(int z = 0; z < planes.grid_count(); ++z) {
+    const auto& reached_bits = reached[static_cast<std::size_t>(z)];
+    const int reachable_end_count = planes.count(Plane::kEnd,z,reached_bits);
+    const int unreachable_cell_count = planes.count(Plane::kCell,z,reached_bits,true);
+    const int dead_space_count = planes.count(Plane::kPlayerWalkable,z,reached_bits,true);
+
+    report.end_count += reachable_end_count + planes.count(Plane::kEnd,z,reached_bits,true);
+    report.reachable_end_count += reachable_end_count;
+    report.cell_count += planes.count(Plane::kCell,z,reached_bits) + unreachable_cell_count;
+    report.unreachable_cell_count += unreachable_cell_count;
+    report.walkable_count += planes.count(Plane::kPlayerWalkable,z,reached_bits) + dead_space_count;
+    report.dead_space_count += dead_space_count;
+
+    // Robots need their type (for Ghosts), so go through their bits.
+    const auto& robot_bits = planes.bits(Plane::kRobot,z);
+    const auto row_size = static_cast<std::size_t>(planes.words_per_row(z));
+
+    for(std::size_t i = 0; i < robot_bits.size(); ++i) {
+      for(auto word = robot_bits[i]; word != 0; word &= (word - 1)) {
+        const int bit_index = std::countr_zero(word);
+        const Pos3i pos{(static_cast<int>(i % row_size) * MapPlanes::kWordBits) + bit_index,
+                        static_cast<int>(i / row_size),z};
+        const SpaceType type = map.spaces().unsafe_space(pos).thing_type();
+
+        ++report.robot_count;
+
+        if(type == SpaceType::kRobotGhost || type == SpaceType::kRobotWorm) { continue; }
+        if((reached_bits[i] >> bit_index) & 1) { continue; }
+
+        ++report.unreachable_robot_count;
+      }
+    }
+  }
+}
+
+void MapCheck::write_report(std::ostream& out,const std::vector<Report>& reports,int thread_count,
+                            double total_ms) const {
+  int error_count = 0;
+  int warning_count = 0;
+
+  out << std::fixed << std::setprecision(3) << "{\n  \"maps\": [";
+
+  for(std::size_t i = 0; i < reports.size(); ++i) {
+    const auto& report = reports[i];
+
+    if(report.has_error()) { ++error_count; }
+    if(report.has_warning()) { ++warning_count; }
+
+    out << ((i == 0) ? "\n" : ",\n") << "    {\"file\": ";
+    ToolUtil::write_json_str(out,report.file.generic_string());
+    out << ", \"ok\": " << (report.has_error() ? "false" : "true") << ", \"error\": ";
+
+    if(report.has_error()) {
+      ToolUtil::write_json_str(out,report.error);
+    } else {
+      out << "null";
+    }
+
+    out << ", \"title\": ";
+    ToolUtil::write_json_str(out,report.title);
+    out << ", \"author\": ";
+    ToolUtil::write_json_str(out,report.author);
+    out << ", \"grids\": " << report.grid_count
+        << ", \"ends\": " << report.end_count
+        << ", \"reachable_ends\": " << report.reachable_end_count
+        << ", \"cells\": " << report.cell_count
+        << ", \"unreachable_cells\": " << report.unreachable_cell_count
+        << ", \"robots\": " << report.robot_count
+        << ", \"unreachable_robots\": " << report.unreachable_robot_count
+        << ", \"walkable_spaces\": " << report.walkable_count
+        << ", \"dead_spaces\": " << report.dead_space_count
+        << ", \"load_ms\": " << report.load_ms
+        << ", \"check_ms\": " << report.check_ms << '}';
+  }
+
+  out << (reports.empty() ? "],\n" : "\n  ],\n")
+      << "  \"summary\": {\"maps\": " << reports.size()
+      << ", \"errors\": " << error_count
+      << ", \"warnings\": " << warning_count
+      << ", \"threads\": " << thread_count
+      << ", \"total_ms\": " << total_ms << "}\n"
+      << "}\n";
+}
+
+} // namespace ekoscape
+
+int main(int argc,char** argv) {
+  using namespace ekoscape;
+
+  try {
+    MapCheck map_check{};
+    return map_check.run(argc,argv);
+  } catch(const CybelError& e) {
+    std::cerr << "[ERROR] " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,177 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// Standard console app, so don't let SDL2 hijack main().
+#ifndef SDL_MAIN_HANDLED
+#define SDL_MAIN_HANDLED
+#endif
+
+#include "common.h"
+
+#include "cybel/types/cybel_error.h"
+#include "cybel/util/tool_util.h"
+
+#include "map/map.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * Converts a map between the text format & the binary format (see Map::save_bin_file()),
+ * based on the output file's extension (Map::kBinExt for binary, else text).
+ *
+ * Usage:
+ *   EkoScapeMapConv [--rstrip] [--no-verify] <in file> <out file>
+ *
+ * By default, the output is loaded again & compared to the input (as text), to verify the conversion.
+ */
+class MapConv {
+public:
+  int run(int argc,char** argv);
+
+private:
+  using clock_t = std::chrono::steady_clock;
+
+  std::filesystem::path in_file_{};
+  std::filesystem::path out_file_{};
+  bool rstrip_ = false;
+  bool verify_ = true;
+
+  static void print_usage();
+  static double load_map(Map& map,const std::filesystem::path& file);
+  static std::string to_text(const Map& map,bool rstrip);
+
+  bool parse_args(int argc,char** argv);
+};
+
+int MapConv::run(int argc,char** argv) {
+  if(!parse_args(argc,argv)) { return 1; }
+
+  Map in_map{};
+  const double in_ms = load_map(in_map,in_file_);
+
+  if(Map::is_bin_map_file(out_file_)) {
+    in_map.save_bin_file(out_file_);
+  } else {
+    std::ofstream fout{out_file_,std::ios::out | std::ios::trunc};
+
+    if(!fout) { throw CybelError{"Failed to open map [",out_file_.string(),"] for writing."}; }
+
+    in_map.print(fout,rstrip_) << '\n';
+    fout.flush();
+
+    if(!fout) { throw CybelError{"Failed to write map [",out_file_.string(),"]."}; }
+  }
+
+  std::cout << "[INFO] Converted map [" << in_file_.string() << "] to [" << out_file_.string() << "].\n";
+
+  if(verify_) {
+    Map out_map{};
+    const double out_ms = load_map(out_map,out_file_);
+
+    if(to_text(out_map,true) != to_text(in_map,true) || out_map.total_cells() != in_map.total_cells()) {
+      std::cerr << "[ERROR] Converted map [" << out_file_.string() << "] doesn't match [" << in_file_.string()
+                << "]." << std::endl;
+      return 1;
+    }
+
+    std::cout << "[INFO] Verified; load time [" << std::fixed << std::setprecision(3) << in_ms << "] ms -> ["
+              << out_ms << "] ms.\n";
+  }
+
+  std::cout << std::flush;
+
+  return 0;
+}
+
+void MapConv::print_usage() {
+  std::cout << "Usage: EkoScapeMapConv [options] <in file> <out file>\n"
+               "\n"
+               "Converts to binary if <out file> ends with '" << Map::kBinExt.string() << "', else to text.\n"
+               "\n"
+               "Options:\n"
+               "  --rstrip      Strip trailing void spaces when converting to text.\n"
+               "  --no-verify   Don't load the output again to compare it to the input.\n"
+               "  --help        Show this help.\n"
+            << std::flush;
+}
+
+double MapConv::load_map(Map& map,const std::filesystem::path& file) {
+  const auto start_time = clock_t::now();
+
+  map.load_file(file);
+
+  return ToolUtil::to_ms(clock_t::now() - start_time);
+}
+
+std::string MapConv::to_text(const Map& map,bool rstrip) {
+  std::ostringstream out{};
+
+  map.print(out,rstrip);
+
+  return out.str();
+}
+
+bool MapConv::parse_args(int argc,char** argv) {
+  std::vector<std::filesystem::path> files{};
+
+  for(int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+
+    if(arg == "--help" || arg == "-h") {
+      print_usage();
+      return false;
+    }
+    if(arg == "--rstrip") {
+      rstrip_ = true;
+    } else if(arg == "--no-verify") {
+      verify_ = false;
+    } else if(arg.starts_with("--")) {
+      std::cerr << "[ERROR] Unknown option [" << arg << "]." << std::endl;
+      return false;
+    } else {
+      files.emplace_back(arg);
+    }
+  }
+
+  if(files.size() != 2) {
+    print_usage();
+    return false;
+  }
+
+  in_file_ = files[0];
+  out_file_ = files[1];
+
+  std::error_code err_code{}; // For noexcept overload.
+
+  if(std::filesystem::equivalent(in_file_,out_file_,err_code)) {
+    std::cerr << "[ERROR] In file & out file are the same [" << in_file_.string() << "]." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace ekoscape
+
+int main(int argc,char** argv) {
+  using namespace ekoscape;
+
+  try {
+    MapConv map_conv{};
+    return map_conv.run(argc,argv);
+  } catch(const CybelError& e) {
+    std::cerr << "[ERROR] " << e.what() << std::endl;
+    return 1;
+  }
+}
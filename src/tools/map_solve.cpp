@@ -0,0 +1,267 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+// Standard console app, so don't let SDL2 hijack main().
+#ifndef SDL_MAIN_HANDLED
+#define SDL_MAIN_HANDLED
+#endif
+
+#include "common.h"
+
+#include "cybel/types/cybel_error.h"
+#include "cybel/util/tool_util.h"
+
+#include "map/map.h"
+#include "sim/game_sim.h"
+#include "sim/route_solver.h"
+#include "tools/map_tool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <numeric>
+#include <vector>
+
+namespace ekoscape {
+
+struct MapSolveReport {
+  std::filesystem::path file{};
+  bool is_map = true;
+  std::string error{};
+  std::string title{};
+  std::string author{};
+  RouteSolver::Route route{};
+  double solve_ms = 0.0;
+  int verify_games = 0;
+  int verify_wins = 0;
+  int verify_deaths = 0;
+  double verify_best_secs = 0.0; // Of the wins.
+  int difficulty_rank = 0; // 1 for the hardest.
+
+  bool has_error() const;
+};
+
+/**
+ * Solves the fastest route of every map in the given files & folders (see MapTool, RouteSolver),
+ * & writes a JSON report, such as for checking speedrun times against the lower bound of each map,
+ * or for ranking the maps by difficulty.
+ *
+ * With `--verify N`, each route is also replayed in N headless games (see GameSim) against the Robots,
+ * which the route doesn't dodge, so the wins show how hard the map is to play at that speed.
+ *
+ * Usage:
+ *   EkoScapeMapSolve [--jobs N] [--out FILE] [--moves DIR] [--verify N] [paths...]
+ */
+class MapSolve : public MapTool<MapSolveReport> {
+public:
+  explicit MapSolve();
+
+protected:
+  void run_map(Report& report) const override;
+  void end_maps(std::vector<Report>& reports) const override;
+  void write_report(std::ostream& out,const std::vector<Report>& reports,int thread_count,
+                    double total_ms) const override;
+
+  void print_opts_usage() const override;
+  int parse_opt(std::string_view opt,std::string_view value) override;
+
+private:
+  std::filesystem::path moves_dir_{};
+  int verify_games_ = 0;
+
+  static void rank(std::vector<Report>& reports);
+
+  void verify(Report& report) const;
+  void write_moves(const Report& report) const;
+};
+
+bool MapSolveReport::has_error() const { return !error.empty(); }
+
+MapSolve::MapSolve()
+  : MapTool("EkoScapeMapSolve","Solves the fastest route of","Solved") {}
+
+void MapSolve::run_map(Report& report) const {
+  Map map{};
+  map.load_file(report.file);
+
+  report.title = map.title();
+  report.author = map.author();
+
+  const auto start_time = clock_t::now();
+  report.route = RouteSolver{map}.solve();
+  report.solve_ms = ToolUtil::to_ms(clock_t::now() - start_time);
+
+  if(verify_games_ > 0) { verify(report); }
+  if(!moves_dir_.empty()) { write_moves(report); }
+}
+
+void MapSolve::verify(Report& report) const {
+  const int logic_hz = GameSim::kDefaultLogicHz;
+  // Plenty of time for the Player to wait out warps, etc.
+  const double max_secs = (report.route.time.secs() * 2.0) + 10.0;
+  const auto max_ticks = static_cast<long long>(std::ceil(max_secs * logic_hz));
+
+  report.verify_games = verify_games_;
+
+  for(int game = 0; game < verify_games_; ++game) {
+    // Same seeds for every map & run, so the reports can be compared.
+    GameSim sim{report.file,logic_hz,false,static_cast<std::uint64_t>(game)};
+
+    sim.set_player_moves(report.route.moves);
+
+    const auto ticks = sim.run(max_ticks);
+
+    if(!sim.world().is_game_over()) { continue; }
+    if(!sim.world().player_hit_end()) {
+      ++report.verify_deaths;
+      continue;
+    }
+
+    const double secs = static_cast<double>(ticks) / static_cast<double>(logic_hz);
+
+    if(report.verify_wins == 0 || secs < report.verify_best_secs) { report.verify_best_secs = secs; }
+    ++report.verify_wins;
+  }
+}
+
+void MapSolve::write_moves(const Report& report) const {
+  // Keep the folders of the map, so that maps with the same name don't clash.
+  auto file = moves_dir_ / report.file.relative_path();
+  file += ".moves";
+
+  std::filesystem::create_directories(file.parent_path());
+
+  std::ofstream fout{file,std::ios::out | std::ios::binary | std::ios::trunc};
+  if(!fout) { throw CybelError{"Failed to open moves [",file.string(),"] for writing."}; }
+
+  fout << report.route.moves << '\n';
+  fout.flush();
+  if(!fout) { throw CybelError{"Failed to write moves [",file.string(),"]."}; }
+}
+
+void MapSolve::end_maps(std::vector<Report>& reports) const { rank(reports); }
+
+void MapSolve::rank(std::vector<Report>& reports) {
+  std::vector<std::size_t> order(reports.size());
+  std::iota(order.begin(),order.end(),std::size_t{0});
+
+  std::erase_if(order,[&](std::size_t i) { return reports[i].has_error(); });
+
+  // Hardest first: lowest win rate (if verified), then the longest route.
+  std::ranges::stable_sort(order,[&](std::size_t i1,std::size_t i2) {
+    const Report& report1 = reports[i1];
+    const Report& report2 = reports[i2];
+
+    // Same number of games for all, so just compare the wins.
+    if(report1.verify_wins != report2.verify_wins) { return report1.verify_wins < report2.verify_wins; }
+
+    return report1.route.lower_bound > report2.route.lower_bound;
+  });
+
+  for(std::size_t i = 0; i < order.size(); ++i) {
+    reports[order[i]].difficulty_rank = static_cast<int>(i) + 1;
+  }
+}
+
+void MapSolve::write_report(std::ostream& out,const std::vector<Report>& reports,int thread_count,
+                            double total_ms) const {
+  int error_count = 0;
+
+  out << std::fixed << std::setprecision(3) << "{\n  \"maps\": [";
+
+  for(std::size_t i = 0; i < reports.size(); ++i) {
+    const auto& report = reports[i];
+    const auto& route = report.route;
+
+    out << ((i == 0) ? "\n" : ",\n") << "    {\"file\": ";
+    ToolUtil::write_json_str(out,report.file.generic_string());
+    out << ", \"ok\": " << (report.has_error() ? "false" : "true") << ", \"error\": ";
+
+    if(report.has_error()) {
+      ++error_count;
+      ToolUtil::write_json_str(out,report.error);
+      out << '}';
+      continue;
+    }
+
+    out << "null, \"title\": ";
+    ToolUtil::write_json_str(out,report.title);
+    out << ", \"author\": ";
+    ToolUtil::write_json_str(out,report.author);
+    out << ", \"difficulty_rank\": " << report.difficulty_rank
+        << ", \"cells\": " << route.cell_count
+        << ", \"unreachable_cells\": " << route.unreachable_cell_count
+        << ", \"is_optimal\": " << (route.is_optimal ? "true" : "false")
+        << ", \"lower_bound_secs\": " << route.lower_bound.secs()
+        << ", \"route_secs\": " << route.time.secs()
+        << ", \"steps\": " << route.step_count
+        << ", \"turns\": " << route.turn_count
+        << ", \"warps\": " << route.warp_count
+        << ", \"random_warps\": " << route.random_warp_count
+        << ", \"solve_ms\": " << report.solve_ms;
+
+    if(verify_games_ > 0) {
+      out << ", \"verify\": {\"games\": " << report.verify_games
+          << ", \"wins\": " << report.verify_wins
+          << ", \"deaths\": " << report.verify_deaths
+          << ", \"best_secs\": ";
+
+      if(report.verify_wins > 0) {
+        out << report.verify_best_secs;
+      } else {
+        out << "null";
+      }
+
+      out << '}';
+    }
+
+    out << '}';
+  }
+
+  out << (reports.empty() ? "],\n" : "\n  ],\n")
+      << "  \"summary\": {\"maps\": " << reports.size()
+      << ", \"errors\": " << error_count
+      << ", \"threads\": " << thread_count
+      << ", \"total_ms\": " << total_ms << "}\n"
+      << "}\n";
+}
+
+void MapSolve::print_opts_usage() const {
+  std::cout << "  --moves DIR  Write the moves of each route (for GameSim) to DIR/<map file>.moves.\n"
+               "  --verify N   Replay each route in N games against the Robots (default: 0).\n";
+}
+
+int MapSolve::parse_opt(std::string_view opt,std::string_view value) {
+  if(opt == "--moves") { return ToolUtil::parse_path(opt,value,moves_dir_) ? 2 : -1; }
+  if(opt == "--verify") {
+    if(!ToolUtil::parse_num(opt,value,verify_games_)) { return -1; }
+    if(verify_games_ < 0) {
+      std::cerr << "[ERROR] Invalid number [" << value << "] for option [" << opt << "]." << std::endl;
+      return -1;
+    }
+
+    return 2;
+  }
+
+  return 0;
+}
+
+} // namespace ekoscape
+
+int main(int argc,char** argv) {
+  using namespace ekoscape;
+
+  try {
+    MapSolve map_solve{};
+    return map_solve.run(argc,argv);
+  } catch(const CybelError& e) {
+    std::cerr << "[ERROR] " << e.what() << std::endl;
+    return 1;
+  }
+}
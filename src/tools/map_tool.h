@@ -0,0 +1,260 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_TOOLS_MAP_TOOL_H_
+#define EKOSCAPE_TOOLS_MAP_TOOL_H_
+
+#include "common.h"
+
+#include "cybel/types/cybel_error.h"
+#include "cybel/util/tool_util.h"
+
+#include "map/map.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <string_view>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * Base of the tools that run each map in the given files & folders (default: `assets/maps`)
+ * on a pool of worker threads (see ToolUtil::run_jobs()), & write a JSON report.
+ *
+ * Folders are searched recursively for map files (see Map::is_map_file()); files given directly are
+ * always run. Exits with 1 if any map has an error.
+ *
+ * `ReportT` must have `file`, `is_map`, `error`, & `has_error()`.
+ */
+template <typename ReportT>
+class MapTool {
+public:
+  virtual ~MapTool() noexcept = default;
+
+  int run(int argc,char** argv);
+
+protected:
+  using Report = ReportT;
+  using clock_t = std::chrono::steady_clock;
+
+  static inline const std::filesystem::path kDefaultMapsDir = "assets/maps";
+
+  /**
+   * @param name   Name of the binary (e.g., `EkoScapeMapCheck`).
+   * @param action What it does to the maps, for the usage (e.g., `Checks`).
+   * @param done   For the info line (e.g., `Checked`).
+   */
+  explicit MapTool(std::string_view name,std::string_view action,std::string_view done);
+
+  /**
+   * Runs `report.file` on a worker thread. Throwing sets `report.error`, so that one bad map doesn't stop
+   * the workers.
+   */
+  virtual void run_map(Report& report) const = 0;
+  /**
+   * Called after all maps have run (e.g., to rank them).
+   */
+  virtual void end_maps(std::vector<Report>& reports) const;
+  virtual void write_report(std::ostream& out,const std::vector<Report>& reports,int thread_count,
+                            double total_ms) const = 0;
+
+  /**
+   * Prints the lines of any extra options for print_usage().
+   */
+  virtual void print_opts_usage() const;
+  /**
+   * Parses an extra option, with `value` being the next arg (empty if none).
+   * Returns the number of args used (1 w/o the value, 2 with it), 0 if unknown, or -1 if invalid
+   * (after printing an error).
+   */
+  virtual int parse_opt(std::string_view opt,std::string_view value);
+
+private:
+  struct Job {
+    std::filesystem::path file{};
+    bool is_given = false; // Given directly, instead of found in a folder.
+  };
+
+  std::string_view name_{};
+  std::string_view action_{};
+  std::string_view done_{};
+
+  std::vector<std::filesystem::path> paths_{};
+  std::filesystem::path out_file_{};
+  int thread_count_ = 0; // 0 for the number of hardware threads.
+
+  void print_usage() const;
+  bool parse_args(int argc,char** argv);
+  std::vector<Job> glob_jobs() const;
+  Report run_job(const Job& job) const;
+};
+
+template <typename ReportT>
+MapTool<ReportT>::MapTool(std::string_view name,std::string_view action,std::string_view done)
+  : name_(name),action_(action),done_(done) {}
+
+template <typename ReportT>
+int MapTool<ReportT>::run(int argc,char** argv) {
+  if(!parse_args(argc,argv)) { return 1; }
+
+  const auto start_time = clock_t::now();
+  const auto jobs = glob_jobs();
+  std::vector<Report> reports(jobs.size());
+
+  const int thread_count = ToolUtil::run_jobs(thread_count_,jobs.size(),[&](std::size_t i) {
+    reports[i] = run_job(jobs[i]);
+  });
+
+  std::erase_if(reports,[](const auto& report) { return !report.is_map; });
+  end_maps(reports);
+
+  const double total_ms = ToolUtil::to_ms(clock_t::now() - start_time);
+
+  if(out_file_.empty()) {
+    write_report(std::cout,reports,thread_count,total_ms);
+    std::cout << std::flush;
+  } else {
+    std::ofstream fout{out_file_,std::ios::out | std::ios::binary | std::ios::trunc};
+    if(!fout) { throw CybelError{"Failed to open report [",out_file_.string(),"] for writing."}; }
+
+    write_report(fout,reports,thread_count,total_ms);
+    fout.flush();
+    if(!fout) { throw CybelError{"Failed to write report [",out_file_.string(),"]."}; }
+
+    const auto error_count = std::ranges::count_if(reports,[](const auto& report) {
+      return report.has_error();
+    });
+
+    std::cout << "[INFO] " << done_ << " [" << reports.size() << "] maps with [" << thread_count
+              << "] threads in [" << std::fixed << std::setprecision(3) << total_ms << "] ms; ["
+              << error_count << "] with errors. Wrote report [" << out_file_.string() << "]." << std::endl;
+  }
+
+  return std::ranges::any_of(reports,[](const auto& report) { return report.has_error(); }) ? 1 : 0;
+}
+
+template <typename ReportT>
+typename MapTool<ReportT>::Report MapTool<ReportT>::run_job(const Job& job) const {
+  Report report{};
+  report.file = job.file;
+
+  // Only check the header of files found in folders (e.g., skip a README).
+  if(!job.is_given && !Map::is_map_file(job.file)) {
+    report.is_map = false;
+    return report;
+  }
+
+  // Not just CybelError, so that one bad map doesn't stop the workers.
+  try {
+    run_map(report);
+  } catch(const std::exception& e) {
+    report.error = e.what();
+  }
+
+  return report;
+}
+
+template <typename ReportT>
+void MapTool<ReportT>::end_maps(std::vector<Report>& /*reports*/) const {}
+
+template <typename ReportT>
+std::vector<typename MapTool<ReportT>::Job> MapTool<ReportT>::glob_jobs() const {
+  std::vector<Job> jobs{};
+
+  for(const auto& path : paths_) {
+    std::error_code err_code{}; // For noexcept overload.
+
+    if(!std::filesystem::is_directory(path,err_code)) {
+      jobs.push_back(Job{path,true});
+      continue;
+    }
+
+    try {
+      for(const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+        if(entry.is_regular_file(err_code)) { jobs.push_back(Job{entry.path(),false}); }
+      }
+    } catch(const std::filesystem::filesystem_error& e) {
+      std::cerr << "[WARN] Failed to search folder [" << path.string() << "]: " << e.what() << '.'
+                << std::endl;
+    }
+  }
+
+  // Folders aren't listed in any order, so sort for the same report each time.
+  std::ranges::stable_sort(jobs,[](const auto& job1,const auto& job2) { return job1.file < job2.file; });
+
+  return jobs;
+}
+
+template <typename ReportT>
+void MapTool<ReportT>::print_usage() const {
+  std::cout << "Usage: " << name_ << " [options] [paths...]\n"
+               "\n"
+            << action_ << " the map files & folders of maps (default: '" << kDefaultMapsDir.string()
+            << "'),\n"
+               "and writes a JSON report. Exits with 1 if any map has an error.\n"
+               "\n"
+               "Options:\n"
+               "  --jobs N     Number of threads (default: number of hardware threads).\n"
+               "  --out FILE   Write the report to FILE, instead of to stdout.\n";
+  print_opts_usage();
+  std::cout << "  --help       Show this help.\n"
+            << std::flush;
+}
+
+template <typename ReportT>
+void MapTool<ReportT>::print_opts_usage() const {}
+
+template <typename ReportT>
+bool MapTool<ReportT>::parse_args(int argc,char** argv) {
+  for(int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    const std::string_view next_arg = (i + 1 < argc) ? std::string_view{argv[i + 1]} : std::string_view{};
+
+    if(arg == "--help" || arg == "-h") {
+      print_usage();
+      return false;
+    }
+    if(arg == "--jobs") {
+      if(!ToolUtil::parse_num(arg,next_arg,thread_count_)) { return false; }
+      if(thread_count_ < 1) {
+        std::cerr << "[ERROR] Invalid number [" << next_arg << "] for option [" << arg << "]." << std::endl;
+        return false;
+      }
+
+      ++i;
+    } else if(arg == "--out") {
+      if(!ToolUtil::parse_path(arg,next_arg,out_file_)) { return false; }
+      ++i;
+    } else if(arg.starts_with("--")) {
+      const int arg_count = parse_opt(arg,next_arg);
+
+      if(arg_count < 0) { return false; }
+      if(arg_count == 0) {
+        std::cerr << "[ERROR] Unknown option [" << arg << "]." << std::endl;
+        return false;
+      }
+
+      i += arg_count - 1;
+    } else {
+      paths_.emplace_back(arg);
+    }
+  }
+
+  if(paths_.empty()) { paths_.push_back(kDefaultMapsDir); }
+
+  return true;
+}
+
+template <typename ReportT>
+int MapTool<ReportT>::parse_opt(std::string_view /*opt*/,std::string_view /*value*/) { return 0; }
+
+} // namespace ekoscape
+#endif
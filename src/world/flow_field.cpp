@@ -0,0 +1,167 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "flow_field.h"
+
+namespace ekoscape {
+
+int FlowField::manhattan_dist(const Pos3i& from_pos,const Pos3i& to_pos) {
+  return std::abs(to_pos.x - from_pos.x) + std::abs(to_pos.y - from_pos.y);
+}
+
+void FlowField::update(const Map& map,const Pos3i& player_pos) {
+  const int z = player_pos.z;
+
+  if(z < 0 || z >= map.grid_count()) { return; }
+  if(static_cast<int>(grids_.size()) != map.grid_count()) {
+    grids_.clear();
+    grids_.resize(static_cast<std::size_t>(map.grid_count()));
+  }
+
+  GridField& grid = grids_[static_cast<std::size_t>(z)];
+  const Pos2i source{player_pos.x,player_pos.y};
+
+  if(grid.size != map.size(z) || grid.walkables == nullptr) { init_grid(map,z); }
+
+  // Set every time, in case the planes of the Map were moved (e.g., after a new grid was added).
+  grid.walkables = &map.planes().bits(MapPlanes::Plane::kWalkable,z);
+
+  if(!grid.has_source || grid.bias >= kMaxBias) {
+    rebuild(grid,source);
+  } else if(source != grid.source) {
+    // If the Player warped to a separate area of the grid, then the old field is useless.
+    if(grid.dist(source) == kUnreachable) {
+      rebuild(grid,source);
+    } else {
+      shift(grid,source);
+    }
+  }
+}
+
+void FlowField::init_grid(const Map& map,int z) {
+  GridField& grid = grids_[static_cast<std::size_t>(z)];
+
+  grid.size = map.size(z);
+  grid.words_per_row = static_cast<std::size_t>(map.planes().words_per_row(z));
+  grid.dists.assign(static_cast<std::size_t>(grid.size.area()),kUnreachable);
+  grid.has_source = false;
+  grid.bias = 0;
+}
+
+void FlowField::rebuild(GridField& grid,const Pos2i& source) {
+  std::ranges::fill(grid.dists,kUnreachable);
+  grid.bias = 0;
+  grid.source = source;
+  grid.has_source = true;
+
+  if(!grid.is_walkable(source)) { return; }
+
+  grid.dists[grid.index_of(source)] = 0;
+  queue_.clear();
+  queue_.push_back(source);
+
+  // Plain BFS, since every step costs the same.
+  for(std::size_t i = 0; i < queue_.size(); ++i) {
+    const Pos2i pos = queue_[i];
+    const int next_dist = grid.dists[grid.index_of(pos)] + 1;
+
+    for(const auto& vel : kNeighborVels) {
+      const Pos2i next_pos{pos.x + vel.x,pos.y + vel.y};
+
+      if(!grid.is_walkable(next_pos)) { continue; }
+
+      int& dist = grid.dists[grid.index_of(next_pos)];
+
+      if(dist == kUnreachable) {
+        dist = next_dist;
+        queue_.push_back(next_pos);
+      }
+    }
+  }
+}
+
+void FlowField::shift(GridField& grid,const Pos2i& source) {
+  // Going from the new source to the old source & then following the old field is always a valid path,
+  //     so every dist can be at most `old_dist + step_count` (triangle inequality).
+  // Adding step_count to the bias applies this upper bound to every dist at once.
+  //
+  // Then a BFS from the new source only needs to continue through Spaces that beat their upper bound,
+  //     since every Space on a shortest path to such a Space must also beat its own upper bound.
+  // Everything else (the Spaces "behind" the Player) is already correct from the bias.
+  const int step_count = grid.dist(source);
+
+  grid.bias += step_count;
+  grid.source = source;
+  grid.dists[grid.index_of(source)] = -grid.bias; // Actual dist of 0.
+
+  queue_.clear();
+  queue_.push_back(source);
+
+  for(std::size_t i = 0; i < queue_.size(); ++i) {
+    const Pos2i pos = queue_[i];
+    const int next_dist = grid.dist(pos) + 1;
+
+    for(const auto& vel : kNeighborVels) {
+      const Pos2i next_pos{pos.x + vel.x,pos.y + vel.y};
+
+      if(!grid.is_walkable(next_pos)) { continue; }
+
+      // Already visited Spaces will always fail this check, since a BFS visits in order of dist.
+      if(next_dist < grid.dist(next_pos)) {
+        grid.dists[grid.index_of(next_pos)] = next_dist - grid.bias;
+        queue_.push_back(next_pos);
+      }
+    }
+  }
+}
+
+void FlowField::clear() {
+  grids_.clear();
+  queue_.clear();
+}
+
+int FlowField::dist(const Pos3i& pos) const {
+  if(pos.z < 0 || pos.z >= static_cast<int>(grids_.size())) { return kUnreachable; }
+
+  const GridField& grid = grids_[static_cast<std::size_t>(pos.z)];
+  const Pos2i pos2{pos.x,pos.y};
+
+  if(!grid.has_source || !grid.in_bounds(pos2)) { return kUnreachable; }
+
+  return grid.dist(pos2);
+}
+
+bool FlowField::has_source(int z) const {
+  if(z < 0 || z >= static_cast<int>(grids_.size())) { return false; }
+
+  return grids_[static_cast<std::size_t>(z)].has_source;
+}
+
+std::size_t FlowField::GridField::index_of(const Pos2i& pos) const {
+  return static_cast<std::size_t>(pos.x + (pos.y * size.w));
+}
+
+bool FlowField::GridField::in_bounds(const Pos2i& pos) const {
+  return pos.x >= 0 && pos.x < size.w && pos.y >= 0 && pos.y < size.h;
+}
+
+bool FlowField::GridField::is_walkable(const Pos2i& pos) const {
+  if(!in_bounds(pos)) { return false; }
+
+  const auto word = (*walkables)[(static_cast<std::size_t>(pos.y) * words_per_row) +
+                                 static_cast<std::size_t>(pos.x / MapPlanes::kWordBits)];
+
+  return ((word >> (pos.x % MapPlanes::kWordBits)) & 1) != 0;
+}
+
+int FlowField::GridField::dist(const Pos2i& pos) const {
+  const int dist = dists[index_of(pos)];
+
+  return (dist == kUnreachable) ? kUnreachable : (dist + bias);
+}
+
+} // namespace ekoscape
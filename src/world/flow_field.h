@@ -0,0 +1,94 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_WORLD_FLOW_FIELD_H_
+#define EKOSCAPE_WORLD_FLOW_FIELD_H_
+
+#include "common.h"
+
+#include "cybel/types/pos.h"
+#include "cybel/types/size.h"
+
+#include "map/map.h"
+
+#include <limits>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * Distance field (per grid) of the number of walkable steps to the Player,
+ * which is shared by all Robots, instead of each Robot searching for the Player itself.
+ *
+ * The field is only for Robots that must walk around walls.
+ * Ghosts can go through walls, so their distance is simply the Manhattan distance (see manhattan_dist()).
+ *
+ * Each grid keeps the last Player pos that was on it, so that Robots can still go towards
+ * where the Player was last seen after the Player leaves the grid (e.g., through a Portal).
+ *
+ * Walkability is read from the walkable plane of the Map (see Map.planes()), 64 Spaces per word,
+ * so no copy of it is needed (only Things move around, and Robots block each other, not the field).
+ */
+class FlowField {
+public:
+  static constexpr int kUnreachable = std::numeric_limits<int>::max();
+
+  static int manhattan_dist(const Pos3i& from_pos,const Pos3i& to_pos);
+
+  /**
+   * If the Player moved within the same grid (e.g., one Space), then the field is updated incrementally,
+   * which only visits the Spaces that got closer to the Player; else, it's fully rebuilt.
+   */
+  void update(const Map& map,const Pos3i& player_pos);
+  void clear();
+
+  /**
+   * Returns kUnreachable if out of bounds, non-walkable, or can't get to the Player's (last) pos.
+   */
+  int dist(const Pos3i& pos) const;
+  bool has_source(int z) const;
+
+private:
+  class GridField {
+  public:
+    Size2i size{};
+    const MapPlanes::Bits* walkables = nullptr; // Of the Map; set on each update.
+    std::size_t words_per_row = 0;
+
+    bool has_source = false;
+    Pos2i source{};
+
+    // The actual distance is `dist + bias`, so that an incremental update doesn't need to touch every dist.
+    std::vector<int> dists{};
+    int bias = 0;
+
+    std::size_t index_of(const Pos2i& pos) const;
+    bool in_bounds(const Pos2i& pos) const;
+    bool is_walkable(const Pos2i& pos) const;
+    int dist(const Pos2i& pos) const;
+  };
+
+  static inline const std::array<Pos2i,4> kNeighborVels{
+    Pos2i{ 0, 1}, // North.
+    Pos2i{ 0,-1}, // South.
+    Pos2i{ 1, 0}, // East.
+    Pos2i{-1, 0}, // West.
+  };
+
+  // Reset the bias every so often, instead of worrying about overflow.
+  static constexpr int kMaxBias = 1 << 24;
+
+  std::vector<GridField> grids_{};
+  std::vector<Pos2i> queue_{}; // Reused for each BFS to avoid allocs.
+
+  void init_grid(const Map& map,int z);
+  void rebuild(GridField& grid,const Pos2i& source);
+  void shift(GridField& grid,const Pos2i& source);
+};
+
+} // namespace ekoscape
+#endif
@@ -0,0 +1,337 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "game_world.h"
+
+#include "cybel/util/profiler.h"
+
+namespace ekoscape {
+
+GameWorld::GameWorld(Map& map,const OnEvent& on_event,std::uint64_t seed)
+  : map_(map),on_event_(on_event),seed_(seed),rando_(seed),portal_rando_(rando_.split(kPortalStream)),
+    robot_move_data_(map) {}
+
+void GameWorld::load_map(const std::filesystem::path& file,bool make_weird) {
+  std::vector<RobotSpawn> spawns{};
+  std::vector<Pos3i> cells{};
+
+  map_.load_file(
+    file,
+    [&](const auto& pos,SpaceType type) { return init_map_space(pos,type,spawns,cells); },
+    [&](const auto& pos,SpaceType type) { init_map_default_empty(pos,type); }
+  );
+  if(make_weird) { make_map_weird(spawns,cells); }
+
+  spawn_robots(spawns);
+
+  init_snapshot_.map = map_.snapshot();
+  init_snapshot_.spawns = std::move(spawns);
+  init_snapshot_.portal_to_pos_bag = portal_to_pos_bag_;
+}
+
+void GameWorld::restart(std::uint64_t seed) {
+  seed_ = seed;
+  rando_.seed(seed);
+  portal_rando_ = rando_.split(kPortalStream);
+
+  map_.restore(init_snapshot_.map);
+  portal_to_pos_bag_ = init_snapshot_.portal_to_pos_bag; // Shuffled while playing.
+  spawn_robots(init_snapshot_.spawns);
+
+  is_game_over_ = false;
+  player_hit_end_ = false;
+  player_warped_ = false;
+  player_warp_time_.set_to_zero();
+  player_fruit_time_.set_to_zero();
+}
+
+void GameWorld::spawn_robots(const std::vector<RobotSpawn>& spawns) {
+  // The store can only be sized after all grids have been loaded.
+  robots_.reset(map_,rando_.split(kRobotStream));
+
+  for(const auto& spawn : spawns) {
+    robots_.add(spawn.type,spawn.pos);
+  }
+
+  // Extra delay to give some time for the Player to initially orient/adjust.
+  robot_move_time_ = map_.robot_delay() + kInitExtraRobotDelay;
+}
+
+SpaceType GameWorld::init_map_space(const Pos3i& pos,SpaceType type,std::vector<RobotSpawn>& spawns,
+                                    std::vector<Pos3i>& cells) {
+  switch(type) {
+    case SpaceType::kCell:
+      cells.push_back(pos);
+      break;
+
+    default:
+      if(SpaceTypes::is_robot(type)) {
+        spawns.push_back(RobotSpawn{type,pos});
+      } else if(SpaceTypes::is_portal(type)) {
+        portal_to_pos_bag_[type].push_back(pos);
+      }
+      break;
+  }
+
+  return type;
+}
+
+void GameWorld::init_map_default_empty(const Pos3i& pos,SpaceType type) {
+  if(SpaceTypes::is_portal(type)) {
+    portal_to_pos_bag_[type].push_back(pos);
+  }
+}
+
+void GameWorld::make_map_weird(std::vector<RobotSpawn>& spawns,std::vector<Pos3i>& cells) {
+  // For weird, flip Robots & Cells, where a random Cell becomes a random Robot.
+  // If we run out of Robots, then just use normal ones.
+
+  // First, flip all Robots to Cells in Map, because we might have more Robots than Cells.
+  for(const auto& spawn : spawns) {
+    map_.set_raw_thing(spawn.pos,SpaceType::kCell);
+  }
+
+  Rando weird_rando = rando_.split(kWeirdStream);
+
+  weird_rando.shuffle(spawns.begin(),spawns.end());
+  weird_rando.shuffle(cells.begin(),cells.end());
+
+  std::vector<RobotSpawn> new_spawns{};
+
+  for(std::size_t spawn_i = 0; const auto& cell_pos : cells) {
+    // No Robots left?
+    const SpaceType type = (spawn_i < spawns.size()) ? spawns[spawn_i++].type : SpaceType::kRobot;
+
+    map_.set_raw_thing(cell_pos,type);
+    new_spawns.push_back(RobotSpawn{type,cell_pos});
+  }
+
+  spawns = std::move(new_spawns);
+}
+
+void GameWorld::delay_robots(const Duration& duration) {
+  robot_move_time_ += duration;
+}
+
+void GameWorld::update(const FrameStep& step) {
+  static const auto kPlayerZoneId = Profiler::it().zone_id("update_player");
+  static const auto kRobotsZoneId = Profiler::it().zone_id("update_robots");
+  static const auto kMoveRobotsZoneId = Profiler::it().zone_id("move_robots");
+
+  {
+    const Profiler::Zone zone{kPlayerZoneId};
+    update_player(step);
+  }
+  {
+    const Profiler::Zone zone{kRobotsZoneId};
+    update_robots(step);
+  }
+  {
+    const Profiler::Zone zone{kMoveRobotsZoneId};
+    move_robots(step);
+  }
+}
+
+void GameWorld::update_player(const FrameStep& step) {
+  if(is_game_over_) { return; }
+
+  if(player_warp_time_ > Duration::kZero) {
+    player_warp_time_ -= step.dpf;
+    if(player_warp_time_ < Duration::kZero) { player_warp_time_.set_to_zero(); }
+  }
+  if(player_fruit_time_ > Duration::kZero) {
+    const auto prev_fruit_secs = player_fruit_time_.round_secs();
+
+    player_fruit_time_ -= step.dpf;
+
+    if(player_fruit_time_ < Duration::kZero) {
+      player_fruit_time_.set_to_zero();
+    } else {
+      const auto fruit_secs = player_fruit_time_.round_secs();
+
+      if(fruit_secs != prev_fruit_secs && fruit_secs <= kFruitWarnSecs) {
+        emit(Event::kFruitWarning);
+      }
+    }
+  }
+
+  const Pos3i player_pos = map_.player_pos();
+  SpaceType player_space_type = map_.player_space_type();
+
+  switch(player_space_type) {
+    case SpaceType::kCell:
+      map_.remove_thing(player_pos);
+      break;
+
+    // Check for End before Robots & Portals.
+    case SpaceType::kEnd:
+      game_over(true);
+      return;
+
+    // Check for Fruit before Robots.
+    case SpaceType::kFruit:
+      map_.remove_thing(player_pos);
+      player_fruit_time_ = kFruitDuration;
+      emit(Event::kAteFruit);
+      break;
+
+    default: break;
+  }
+
+  // The previous logic above might have updated the type/empty, so check/recheck here.
+  const Space* player_space = map_.player_space();
+  auto player_empty_type = SpaceType::kEmpty;
+  player_space_type = map_.player_space_type();
+
+  if(player_space == nullptr) {
+    std::cerr << "[ERROR] Player space is null for some reason." << std::endl;
+  } else {
+    player_empty_type = player_space->empty_type();
+  }
+
+  // Portals are like safe zones, so if the Player & a Robot are on a Portal, the Player shouldn't die.
+  //     Therefore, we check for Portals first.
+  if(SpaceTypes::is_portal(player_empty_type)) {
+    if(!player_warped_) {
+      // Allow the Player to warp even if there's a Robot/Thing on the Portal.
+      // - The bros are from the Map, so they're always in bounds.
+      const auto portal_bro = fetch_portal_bro(player_pos,player_empty_type,[](const auto& /*pos*/) {
+        return true;
+      });
+
+      if(portal_bro) {
+        map_.move_player(*portal_bro);
+        player_warped_ = true;
+        player_warp_time_ = kWarpDuration;
+        emit(Event::kPlayerWarped);
+      }
+    }
+
+    return;
+  }
+
+  player_warped_ = false;
+
+  if(SpaceTypes::is_robot(player_space_type)) {
+    if(player_fruit_time_ > Duration::kZero) {
+      remove_robots_at(player_pos);
+    } else {
+      game_over(false);
+    }
+  }
+}
+
+void GameWorld::game_over(bool player_hit_end) {
+  is_game_over_ = true;
+  player_hit_end_ = player_hit_end;
+
+  // Because of how high speeds are handled, we need to manually sync the correct Player pos,
+  //     since the pos might be beyond End, etc. after fully moving.
+  map_.sync_player_pos();
+
+  emit(Event::kGameOver);
+}
+
+void GameWorld::update_robots(const FrameStep& step) {
+  // Remove dead Robots and age living Robots (only if lifespan was set).
+  // - Go backwards, since removing swaps the last Robot into the removed one's place.
+  for(std::size_t i = robots_.size(); i-- > 0;) {
+    Robot robot{robots_,robots_.ids()[i]};
+
+    if(robot.is_dead()) {
+      map_.remove_thing(robot.pos());
+      robots_.remove(robot.id());
+    } else {
+      robot.age(step.delta_time);
+    }
+  }
+}
+
+void GameWorld::move_robots(const FrameStep& step) {
+  // Not time to move Robots?
+  if(robot_move_time_ > Duration::kZero) {
+    robot_move_time_ -= step.dpf;
+    return;
+  }
+
+  // Move Robots.
+  robot_move_data_.refresh(player_fruit_time_ > Duration::kZero);
+
+  // New Robots (snake tails) are added to the end while moving, so only move the current ones.
+  const std::size_t robot_count = robots_.size();
+  const MapSpaces& spaces = map_.spaces();
+
+  for(std::size_t i = 0; i < robot_count; ++i) {
+    Robot robot{robots_,robots_.ids()[i]};
+
+    robot.move(robot_move_data_);
+
+    // Warp Robots that are on Portals.
+    if(robot.portal_type() != SpaceType::kNil && !robot.warped()) {
+      // The bros are from the Map, so they're always in bounds.
+      const auto portal_bro = fetch_portal_bro(robot.pos(),robot.portal_type(),[&](const auto& pos) {
+        return robot.can_move_to(spaces.unsafe_space(pos));
+      });
+
+      if(portal_bro) { robot.warp_to(robot_move_data_,*portal_bro); }
+    }
+  }
+
+  // Reset the move time.
+  robot_move_time_ = map_.robot_delay() + step.dpf;
+}
+
+void GameWorld::remove_robots_at(const Pos3i& pos) {
+  map_.remove_thing(pos);
+  robots_.remove_at(pos);
+}
+
+std::optional<Pos3i> GameWorld::fetch_portal_bro(const Pos3i& pos,SpaceType portal,
+                                                 const MoveChecker& can_move_to) {
+  const auto it = portal_to_pos_bag_.find(portal);
+  if(it == portal_to_pos_bag_.end()) { return std::nullopt; }
+
+  auto& bros = it->second;
+  if(bros.size() <= 1) { return std::nullopt; } // No bros. :(
+
+  if(bros.size() > 2) { // More than 1 bro?
+    // Try once without shuffling.
+    const auto& rand_bro_pos = bros[portal_rando_.rand_size_t(bros.size())];
+
+    if(rand_bro_pos != pos && can_move_to(rand_bro_pos)) { return rand_bro_pos; }
+
+    portal_rando_.shuffle(bros.begin(),bros.end());
+  }
+
+  for(const auto& bro_pos : bros) { // Find Luigi.
+    if(bro_pos != pos && can_move_to(bro_pos)) { return bro_pos; }
+  }
+
+  return std::nullopt;
+}
+
+void GameWorld::emit(Event event) {
+  if(on_event_) { on_event_(event); }
+}
+
+Map& GameWorld::map() { return map_; }
+
+const Map& GameWorld::map() const { return map_; }
+
+bool GameWorld::is_game_over() const { return is_game_over_; }
+
+bool GameWorld::player_hit_end() const { return player_hit_end_; }
+
+const Duration& GameWorld::player_warp_time() const { return player_warp_time_; }
+
+const Duration& GameWorld::player_fruit_time() const { return player_fruit_time_; }
+
+const RobotStore& GameWorld::robots() const { return robots_; }
+
+std::uint64_t GameWorld::seed() const { return seed_; }
+
+} // namespace ekoscape
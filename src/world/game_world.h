@@ -0,0 +1,163 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_WORLD_GAME_WORLD_H_
+#define EKOSCAPE_WORLD_GAME_WORLD_H_
+
+#include "common.h"
+
+#include "cybel/types/duration.h"
+#include "cybel/types/frame_step.h"
+#include "cybel/types/pos.h"
+#include "cybel/util/rando.h"
+
+#include "map/map.h"
+#include "map/space_type.h"
+#include "world/robot.h"
+#include "world/robot_store.h"
+
+#include <filesystem>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace ekoscape {
+
+/**
+ * The game logic (Player, Robots, Portals, Fruit, etc.) without any graphics,
+ * so that it can be shared between GameScene & the headless simulator.
+ *
+ * The Player's pos is controlled by the Map (e.g., DantaresMap), so this class only reacts to it.
+ *
+ * All randomness is drawn from streams split from the seed, so the same seed, Map, & Player moves
+ * will always replay the same game.
+ *
+ * Example:
+ *   @code
+ *   GameWorld world{map,[&](GameWorld::Event event) {
+ *     // Flash the screen, etc...
+ *   }};
+ *
+ *   world.load_map("map.txt");
+ *   map.add_to_bridge();
+ *
+ *   while(!world.is_game_over()) {
+ *     // Move the Player in the Map...
+ *     world.update(step);
+ *   }
+ *   @endcode
+ */
+class GameWorld {
+public:
+  enum class Event : std::uint8_t {
+    kAteFruit,
+    kFruitWarning,
+    kPlayerWarped,
+    kGameOver,
+  };
+
+  using OnEvent = std::function<void(Event)>;
+
+  static inline const Duration kInitExtraRobotDelay = Duration::from_millis(1'000);
+  static inline const Duration kWarpDuration = Duration::from_millis(750);
+  static inline const Duration kFruitDuration = Duration::from_millis(7'000);
+  static constexpr int kFruitWarnSecs = 2;
+
+  explicit GameWorld(Map& map,const OnEvent& on_event = nullptr,std::uint64_t seed = Rando::gen_seed());
+
+  GameWorld(const GameWorld& other) = delete;
+  GameWorld(GameWorld&& other) noexcept = delete;
+
+  GameWorld& operator=(const GameWorld& other) = delete;
+  GameWorld& operator=(GameWorld&& other) noexcept = delete;
+
+  /**
+   * Doesn't call Map.add_to_bridge(), since the caller might want to output the Map first, etc.
+   */
+  void load_map(const std::filesystem::path& file,bool make_weird = false);
+  /**
+   * Puts the Map, Robots, & Portals back to how they were right after load_map() (without loading it again),
+   * & resets the Player, using `seed` for the new random streams.
+   *
+   * Only the Spaces that changed are updated in the Map's bridge (see Map::restore()).
+   * If the Map was made weird, the same weird Robots are kept.
+   */
+  void restart(std::uint64_t seed);
+
+  void delay_robots(const Duration& duration);
+
+  /**
+   * Calls update_player(), update_robots(), & move_robots() in order.
+   */
+  void update(const FrameStep& step);
+  void update_player(const FrameStep& step);
+  void update_robots(const FrameStep& step);
+  void move_robots(const FrameStep& step);
+
+  Map& map();
+  const Map& map() const;
+  bool is_game_over() const;
+  bool player_hit_end() const;
+  const Duration& player_warp_time() const;
+  const Duration& player_fruit_time() const;
+  const RobotStore& robots() const;
+  std::uint64_t seed() const;
+
+private:
+  struct RobotSpawn {
+    SpaceType type = SpaceType::kNil;
+    Pos3i pos{};
+  };
+
+  using MoveChecker = std::function<bool(const Pos3i&)>;
+
+  // The initial state from load_map(), for restart().
+  struct Snapshot {
+    Map::Snapshot map{};
+    std::vector<RobotSpawn> spawns{};
+    std::unordered_map<SpaceType,std::vector<Pos3i>> portal_to_pos_bag{};
+  };
+
+  // Stream IDs for split().
+  static constexpr std::uint64_t kWeirdStream = 1;
+  static constexpr std::uint64_t kPortalStream = 2;
+  static constexpr std::uint64_t kRobotStream = 3;
+
+  Map& map_;
+  OnEvent on_event_{};
+  std::uint64_t seed_ = 0;
+  Rando rando_;
+  Rando portal_rando_;
+
+  bool is_game_over_ = false;
+  bool player_hit_end_ = false;
+  bool player_warped_ = false;
+  Duration player_warp_time_{};
+  Duration player_fruit_time_{};
+
+  RobotStore robots_{};
+  Duration robot_move_time_{};
+  Robot::MoveData robot_move_data_;
+  std::unordered_map<SpaceType,std::vector<Pos3i>> portal_to_pos_bag_{};
+
+  Snapshot init_snapshot_{};
+
+  SpaceType init_map_space(const Pos3i& pos,SpaceType type,std::vector<RobotSpawn>& spawns,
+                           std::vector<Pos3i>& cells);
+  void init_map_default_empty(const Pos3i& pos,SpaceType type);
+  void make_map_weird(std::vector<RobotSpawn>& spawns,std::vector<Pos3i>& cells);
+  void spawn_robots(const std::vector<RobotSpawn>& spawns);
+
+  void game_over(bool player_hit_end);
+  void remove_robots_at(const Pos3i& pos);
+  std::optional<Pos3i> fetch_portal_bro(const Pos3i& pos,SpaceType portal,const MoveChecker& can_move_to);
+
+  void emit(Event event);
+};
+
+} // namespace ekoscape
+#endif
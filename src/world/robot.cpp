@@ -17,55 +17,34 @@ Robot::MoveData::MoveData(Map& map)
 void Robot::MoveData::refresh(bool player_ate_fruit) {
   player_pos = map.player_pos();
   this->player_ate_fruit = player_ate_fruit;
-}
-
-Robot Robot::build(SpaceType type,const Pos3i& pos,float lifespan) noexcept {
-  switch(type) {
-    case SpaceType::kRobotStatue: return build_statue(pos,lifespan);
-    case SpaceType::kRobot: return build_normal(pos,lifespan);
-    case SpaceType::kRobotGhost: return build_ghost(pos,lifespan);
-    case SpaceType::kRobotSnake: return build_snake(pos,lifespan);
-    case SpaceType::kRobotWorm: return build_worm(pos,lifespan);
-
-    default:
-      std::cerr << "[WARN] Tried to build invalid Robot type [" << SpaceTypes::value_of(type)
-                << "]; building Normal instead." << std::endl;
-      return build_normal(pos,lifespan);
-  }
-}
-
-Robot Robot::build_statue(const Pos3i& pos,float lifespan) noexcept {
-  return Robot{SpaceType::kRobotStatue,pos,kLikeStatue,lifespan};
-}
-
-Robot Robot::build_normal(const Pos3i& pos,float lifespan) noexcept {
-  return Robot{SpaceType::kRobot,pos,kLikeNormal,lifespan};
-}
 
-Robot Robot::build_ghost(const Pos3i& pos,float lifespan) noexcept {
-  return Robot{SpaceType::kRobotGhost,pos,kLikeGhost,lifespan};
+  flow_field.update(map,player_pos);
 }
 
-Robot Robot::build_snake(const Pos3i& pos,float lifespan) noexcept {
-  return Robot{SpaceType::kRobotSnake,pos,kLikeSnake,lifespan};
-}
+int Robot::moves_like_of(SpaceType type) {
+  switch(type) {
+    case SpaceType::kRobotStatue: return kLikeStatue;
+    case SpaceType::kRobot: return kLikeNormal;
+    case SpaceType::kRobotGhost: return kLikeGhost;
+    case SpaceType::kRobotSnake: return kLikeSnake;
+    case SpaceType::kRobotWorm: return kLikeSnake | kLikeGhost;
 
-Robot Robot::build_worm(const Pos3i& pos,float lifespan) noexcept {
-  return Robot{SpaceType::kRobotWorm,pos,kLikeSnake | kLikeGhost,lifespan};
+    default: return 0;
+  }
 }
 
-Robot::Robot(SpaceType type,const Pos3i& pos,int moves_like,float lifespan) noexcept
-  : type_(type),pos_(pos),moves_like_(moves_like),lifespan_(lifespan) {}
+Robot::Robot(RobotStore& store,RobotStore::id_t id) noexcept
+  : store_(store),id_(id),i_(static_cast<std::size_t>(id)) {}
 
 bool Robot::move(MoveData& data) {
-  if(moves_like_ & kLikeStatue) { return false; }
+  if(moves_like() & kLikeStatue) { return false; }
 
-  if(pos_.z == data.player_pos.z) {
-    last_seen_player_pos_ = data.player_pos;
+  if(pos().z == data.player_pos.z) {
+    last_seen_player_pos() = data.player_pos;
     return move_smart(data);
   }
   // Go towards the pos where we last saw the Player on our Z/grid.
-  if(last_seen_player_pos_.z >= 0) {
+  if(last_seen_player_pos().z >= 0) {
     return move_smart(data);
   }
 
@@ -73,66 +52,63 @@ bool Robot::move(MoveData& data) {
 }
 
 bool Robot::move_smart(MoveData& data) {
-  const bool on_player_x = (pos_.x == last_seen_player_pos_.x);
-  const bool on_player_y = (pos_.y == last_seen_player_pos_.y);
-
-  if(on_player_x && on_player_y) {
+  const bool is_ghost = (moves_like() & kLikeGhost);
+  const Pos3i pos = this->pos(); // Copy, since the store might grow from a snake's tail.
+  Pos3i& last_seen_player_pos = this->last_seen_player_pos();
+
+  // Ghosts can go through walls, so the straight-line (Manhattan) distance is the real distance.
+  // Everyone else follows the shared flow field of our grid, which goes towards the Player's last pos on it.
+  const auto dist_to_player = [&](const Pos3i& from_pos) {
+    return is_ghost ? FlowField::manhattan_dist(from_pos,last_seen_player_pos) : data.flow_field.dist(from_pos);
+  };
+  const int dist = dist_to_player(pos);
+
+  if(dist == 0) {
     // Move randomly again, to try to hit a Portal nearby if the last seen pos is off.
-    last_seen_player_pos_.z = -1;
+    last_seen_player_pos.z = -1;
     return move_rand(data);
   }
+  // Walled off from the Player?
+  if(dist == FlowField::kUnreachable) { return move_rand(data); }
 
-  int x_vel;
-  int y_vel;
+  struct MoveOption {
+    Pos3i pos{};
+    int dist = 0;
+  };
 
-  if(pos_.x < last_seen_player_pos_.x) {
-    x_vel = 1;
-  } else if(pos_.x > last_seen_player_pos_.x) {
-    x_vel = -1;
-  } else {
-    x_vel = Rando::it().rand_bool() ? 1 : -1;
-  }
-  if(pos_.y < last_seen_player_pos_.y) {
-    y_vel = 1;
-  } else if(pos_.y > last_seen_player_pos_.y) {
-    y_vel = -1;
-  } else {
-    y_vel = Rando::it().rand_bool() ? 1 : -1;
-  }
+  std::array<MoveOption,kMoveVels.size()> opts{};
 
-  if(data.player_ate_fruit) {
-    // Try to get away.
-    x_vel = -x_vel;
-    y_vel = -y_vel;
+  for(std::size_t i = 0; i < opts.size(); ++i) {
+    const auto& vel = kMoveVels[i];
+    auto& opt = opts[i];
+
+    opt.pos = Pos3i{pos.x + vel.x,pos.y + vel.y,pos.z};
+    opt.dist = dist_to_player(opt.pos);
   }
 
-  // We can't move diagonally, since the player can't either (it's only fair),
-  //     so pick either X or Y (not both), von-Neumann style.
+  // Shuffle first, so that ties are picked randomly (stable sort keeps the shuffled order of ties),
+  //     since I like the randomness.
+  rando().shuffle(opts.begin(),opts.end());
 
-  // We pick randomly, but instead, we could do by whichever one is farther away,
-  //     but I like the randomness.
-  const bool try_x_first = Rando::it().rand_bool();
+  if(data.player_ate_fruit) {
+    // Try to get away.
+    std::ranges::stable_sort(opts,[&](const auto& opt1,const auto& opt2) {
+      // Unreachable is always worst, even when running away.
+      if(opt1.dist == FlowField::kUnreachable) { return false; }
+      if(opt2.dist == FlowField::kUnreachable) { return true; }
 
-  // Try normally.
-  if(try_x_first) {
-    if(!on_player_x && try_move(data,x_vel,0)) { return true; }
-    if(!on_player_y && try_move(data,0,y_vel)) { return true; }
+      return opt1.dist > opt2.dist;
+    });
   } else {
-    if(!on_player_y && try_move(data,0,y_vel)) { return true; }
-    if(!on_player_x && try_move(data,x_vel,0)) { return true; }
+    std::ranges::stable_sort(opts,[&](const auto& opt1,const auto& opt2) { return opt1.dist < opt2.dist; });
   }
 
-  // Just make a move (if not stuck), so try the opposites.
-  if(try_x_first) {
-    if(on_player_x && try_move(data,x_vel,0)) { return true; }
-    if(on_player_y && try_move(data,0,y_vel)) { return true; }
-    if(try_move(data,-x_vel,0)) { return true; }
-    if(try_move(data,0,-y_vel)) { return true; }
-  } else {
-    if(on_player_y && try_move(data,0,y_vel)) { return true; }
-    if(on_player_x && try_move(data,x_vel,0)) { return true; }
-    if(try_move(data,0,-y_vel)) { return true; }
-    if(try_move(data,-x_vel,0)) { return true; }
+  // Go in the best direction, but if blocked (e.g., by another Robot), then just make a move (if not stuck).
+  // We can't move diagonally, since the player can't either (it's only fair).
+  for(const auto& opt : opts) {
+    if(opt.dist != FlowField::kUnreachable && try_move(data,opt.pos.x - pos.x,opt.pos.y - pos.y)) {
+      return true;
+    }
   }
 
   return false;
@@ -140,16 +116,18 @@ bool Robot::move_smart(MoveData& data) {
 
 bool Robot::move_rand(MoveData& data) {
   // ReSharper disable once CppDFAUnreachableCode
-  if constexpr(rand_move_vels_.empty()) { return false; }
+  if constexpr(kMoveVels.empty()) { return false; }
 
   // Try once without shuffling.
-  const auto& rand_move_vel = rand_move_vels_[Rando::it().rand_size_t(rand_move_vels_.size())];
+  const auto& rand_move_vel = kMoveVels[rando().rand_size_t(kMoveVels.size())];
 
   if(try_move(data,rand_move_vel.x,rand_move_vel.y)) { return true; }
 
-  Rando::it().shuffle(rand_move_vels_.begin(),rand_move_vels_.end());
+  // Shuffle a copy, so that Robots (& separate games) don't share any state.
+  auto move_vels = kMoveVels;
+  rando().shuffle(move_vels.begin(),move_vels.end());
 
-  for(const auto& move_vel : rand_move_vels_) {
+  for(const auto& move_vel : move_vels) {
     if(try_move(data,move_vel.x,move_vel.y)) { return true; }
   }
 
@@ -157,22 +135,29 @@ bool Robot::move_rand(MoveData& data) {
 }
 
 bool Robot::try_move(MoveData& data,int x_vel,int y_vel) {
-  const Pos3i to_pos{pos_.x + x_vel,pos_.y + y_vel,pos_.z};
-  const Space* to_space = data.map.space(to_pos);
+  const Pos3i from_pos = pos(); // Store origin for snake's tail.
+  const Pos3i to_pos{from_pos.x + x_vel,from_pos.y + y_vel,from_pos.z};
+  const MapSpaces& spaces = data.map.spaces();
+
+  // A step from our (in-bounds) pos is at most on the sentinel border, so no bounds check.
+  // - Ghosts can move onto the border (no Thing), but then move_thing() fails (out of bounds).
+  const Space& to_space = spaces.at(spaces.index_of(to_pos));
 
   if(!can_move_to(to_space)) { return false; }
-  if(!data.map.move_thing(pos_,to_pos)) { return false; }
+  if(!data.map.move_thing(from_pos,to_pos)) { return false; }
+
+  store_.move_to(id_,to_pos);
 
-  const auto from_pos = pos_; // Store origin for snake's tail.
-  pos_ = to_pos;
-  portal_type_ = to_space->is_portal() ? to_space->empty_type() : SpaceType::kNil;
+  auto& portal_type = store_.portal_types_[i_];
+  portal_type = to_space.is_portal() ? to_space.empty_type() : SpaceType::kNil;
 
-  if(portal_type_ == SpaceType::kNil) {
-    warped_ = false;
+  if(portal_type == SpaceType::kNil) {
+    store_.warpeds_[i_] = 0;
 
-    if((moves_like_ & kLikeSnake) && data.map.place_thing(SpaceType::kRobotStatue,from_pos)) {
+    if((moves_like() & kLikeSnake) && data.map.place_thing(SpaceType::kRobotStatue,from_pos)) {
       // Grow tail.
-      data.new_robots.push_back(build_statue(from_pos,kSnakeTailLifespan));
+      // - The store might grow, but we only use IDs (not refs), so this is safe.
+      store_.add(SpaceType::kRobotStatue,from_pos,kSnakeTailLifespan);
     }
   }
 
@@ -181,44 +166,56 @@ bool Robot::try_move(MoveData& data,int x_vel,int y_vel) {
 
 // ReSharper disable once CppParameterMayBeConstPtrOrRef
 bool Robot::warp_to(MoveData& data,const Pos3i& to_pos) {
-  if(pos_ != to_pos) {
+  if(pos() != to_pos) {
     if(!can_move_to(data.map.space(to_pos))) { return false; }
-    if(!data.map.move_thing(pos_,to_pos)) { return false; }
+    if(!data.map.move_thing(pos(),to_pos)) { return false; }
+
+    store_.move_to(id_,to_pos);
   }
 
-  pos_ = to_pos;
-  warped_ = true;
-  last_seen_player_pos_.z = -1; // Move randomly again, in case the Player isn't on this new Z/grid.
+  store_.warpeds_[i_] = 1;
+  last_seen_player_pos().z = -1; // Move randomly again, in case the Player isn't on this new Z/grid.
 
   return true;
 }
 
 void Robot::age(double delta_time) {
-  if(lifespan_ <= 0.0f) { return; } // Besides immortality, prevent divide by 0.
+  const float lifespan = store_.lifespans_[i_];
+  if(lifespan <= 0.0f) { return; } // Besides immortality, prevent divide by 0.
 
   // Divide by lifespan to normalize to [0,1].
-  age_ += (static_cast<float>(delta_time) / lifespan_);
+  store_.ages_[i_] += (static_cast<float>(delta_time) / lifespan);
 }
 
-void Robot::set_raw_pos(const Pos3i& pos) { pos_ = pos; }
+RobotStore::id_t Robot::id() const { return id_; }
 
-bool Robot::is_alive() const { return lifespan_ <= 0.0f || age_ <= 1.0f; }
+bool Robot::is_alive() const { return store_.lifespans_[i_] <= 0.0f || store_.ages_[i_] <= 1.0f; }
 
 bool Robot::is_dead() const { return !is_alive(); }
 
-SpaceType Robot::type() const { return type_; }
+SpaceType Robot::type() const { return store_.types_[i_]; }
 
-const Pos3i& Robot::pos() const { return pos_; }
+const Pos3i& Robot::pos() const { return store_.poses_[i_]; }
 
-SpaceType Robot::portal_type() const { return portal_type_; }
+SpaceType Robot::portal_type() const { return store_.portal_types_[i_]; }
 
-bool Robot::warped() const { return warped_; }
+bool Robot::warped() const { return store_.warpeds_[i_] != 0; }
 
 bool Robot::can_move_to(const Space* space) const {
-  if(space == nullptr || space->has_thing()) { return false; }
-  if(!(moves_like_ & kLikeGhost) && space->is_non_walkable()) { return false; }
+  return space != nullptr && can_move_to(*space);
+}
+
+bool Robot::can_move_to(const Space& space) const {
+  if(space.has_thing()) { return false; }
+  if(!(moves_like() & kLikeGhost) && space.is_non_walkable()) { return false; }
 
   return true;
 }
 
+int Robot::moves_like() const { return store_.moves_likes_[i_]; }
+
+Pos3i& Robot::last_seen_player_pos() { return store_.last_seen_player_poses_[i_]; }
+
+Rando& Robot::rando() { return store_.randos_[i_]; }
+
 } // namespace ekoscape
@@ -11,15 +11,22 @@
 #include "common.h"
 
 #include "cybel/types/pos.h"
+#include "cybel/util/rando.h"
 
 #include "map/map.h"
 #include "map/space.h"
 #include "map/space_type.h"
-
-#include <vector>
+#include "world/flow_field.h"
+#include "world/robot_store.h"
 
 namespace ekoscape {
 
+/**
+ * View of a Robot in a RobotStore by ID, for the Robot logic.
+ *
+ * This is cheap to create, so create one on the fly as needed, but don't store it,
+ * since the ID is recycled after the Robot is removed from the store.
+ */
 class Robot {
 public:
   class MoveData {
@@ -27,26 +34,29 @@ public:
     Map& map;
     Pos3i player_pos{};
     bool player_ate_fruit = false;
-    std::vector<Robot> new_robots{};
+
+    /**
+     * Shared by all Robots & updated once per move in refresh().
+     */
+    FlowField flow_field{};
 
     explicit MoveData(Map& map);
 
     void refresh(bool player_ate_fruit);
   };
 
-  static Robot build(SpaceType type,const Pos3i& pos,float lifespan = kDefaultLifespan) noexcept;
-  static Robot build_statue(const Pos3i& pos,float lifespan = kDefaultLifespan) noexcept;
-  static Robot build_normal(const Pos3i& pos,float lifespan = kDefaultLifespan) noexcept;
-  static Robot build_ghost(const Pos3i& pos,float lifespan = kDefaultLifespan) noexcept;
-  static Robot build_snake(const Pos3i& pos,float lifespan = kDefaultLifespan) noexcept;
-  static Robot build_worm(const Pos3i& pos,float lifespan = kDefaultLifespan) noexcept;
+  /**
+   * Returns 0 if not a Robot type.
+   */
+  static int moves_like_of(SpaceType type);
+
+  explicit Robot(RobotStore& store,RobotStore::id_t id) noexcept;
 
   bool move(MoveData& data);
   bool warp_to(MoveData& data,const Pos3i& to_pos);
   void age(double delta_time);
 
-  void set_raw_pos(const Pos3i& pos);
-
+  RobotStore::id_t id() const;
   bool is_alive() const;
   bool is_dead() const;
   SpaceType type() const;
@@ -54,6 +64,7 @@ public:
   SpaceType portal_type() const;
   bool warped() const;
   bool can_move_to(const Space* space) const;
+  bool can_move_to(const Space& space) const;
 
 private:
   static inline const int kLikeStatue = 1 << 0; // No movement.
@@ -61,26 +72,21 @@ private:
   static inline const int kLikeGhost = 1 << 2; // Can go through walls.
   static inline const int kLikeSnake = 1 << 3; // Leaves behind a tail of statues.
 
-  static inline const float kDefaultLifespan = 0.0f; // 0.0f is immortal.
   static inline const float kSnakeTailLifespan = 9.0f;
-  static inline std::array<Pos2i,4> rand_move_vels_{
+  static inline const std::array<Pos2i,4> kMoveVels{
     Pos2i{ 0,-1}, // North.
     Pos2i{ 0, 1}, // South.
     Pos2i{ 1, 0}, // East.
     Pos2i{-1, 0}, // West.
   };
 
-  SpaceType type_ = SpaceType::kNil;
-  Pos3i pos_{};
-  int moves_like_ = 0;
-  float lifespan_ = kDefaultLifespan;
-  float age_ = 0.0f;
-
-  Pos3i last_seen_player_pos_{0,0,-1};
-  SpaceType portal_type_ = SpaceType::kNil;
-  bool warped_ = false;
+  RobotStore& store_;
+  RobotStore::id_t id_{};
+  std::size_t i_{}; // ID as an index into the store.
 
-  explicit Robot(SpaceType type,const Pos3i& pos,int moves_like,float lifespan) noexcept;
+  int moves_like() const;
+  Pos3i& last_seen_player_pos();
+  Rando& rando();
 
   bool move_smart(MoveData& data);
   bool move_rand(MoveData& data);
@@ -0,0 +1,177 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "robot_store.h"
+
+#include "world/robot.h"
+
+namespace ekoscape {
+
+void RobotStore::reset(const Map& map,const Rando& rando) {
+  types_.clear();
+  poses_.clear();
+  moves_likes_.clear();
+  lifespans_.clear();
+  ages_.clear();
+  last_seen_player_poses_.clear();
+  portal_types_.clear();
+  warpeds_.clear();
+  randos_.clear();
+  id_to_live_index_.clear();
+
+  live_ids_.clear();
+  free_ids_.clear();
+  rando_ = rando;
+  spawn_count_ = 0;
+
+  grid_indexes_.clear();
+  grid_indexes_.resize(static_cast<std::size_t>(std::max(map.grid_count(),0)));
+
+  for(int z = 0; z < static_cast<int>(grid_indexes_.size()); ++z) {
+    auto& grid = grid_indexes_[static_cast<std::size_t>(z)];
+
+    grid.size = map.size(z);
+    grid.ids.assign(static_cast<std::size_t>(grid.size.area()),kNilId);
+  }
+}
+
+RobotStore::id_t RobotStore::add(SpaceType type,const Pos3i& pos,float lifespan) {
+  id_t* index_id = index_id_at(pos);
+  if(index_id == nullptr || *index_id != kNilId) { return kNilId; }
+
+  int moves_like = Robot::moves_like_of(type);
+
+  if(moves_like == 0) {
+    std::cerr << "[WARN] Tried to add invalid Robot type [" << SpaceTypes::value_of(type)
+              << "]; adding Normal instead." << std::endl;
+
+    type = SpaceType::kRobot;
+    moves_like = Robot::moves_like_of(type);
+  }
+
+  const id_t id = alloc_id();
+  const auto i = static_cast<std::size_t>(id);
+
+  types_[i] = type;
+  poses_[i] = pos;
+  moves_likes_[i] = moves_like;
+  lifespans_[i] = lifespan;
+  ages_[i] = 0.0f;
+  last_seen_player_poses_[i] = Pos3i{0,0,-1};
+  portal_types_[i] = SpaceType::kNil;
+  warpeds_[i] = 0;
+  randos_[i] = rando_.split(spawn_count_++);
+
+  id_to_live_index_[i] = live_ids_.size();
+  live_ids_.push_back(id);
+  *index_id = id;
+
+  return id;
+}
+
+RobotStore::id_t RobotStore::alloc_id() {
+  if(!free_ids_.empty()) {
+    const id_t id = free_ids_.back();
+    free_ids_.pop_back();
+
+    return id;
+  }
+
+  const auto id = static_cast<id_t>(types_.size());
+
+  types_.emplace_back();
+  poses_.emplace_back();
+  moves_likes_.emplace_back();
+  lifespans_.emplace_back();
+  ages_.emplace_back();
+  last_seen_player_poses_.emplace_back();
+  portal_types_.emplace_back();
+  warpeds_.emplace_back();
+  randos_.emplace_back(0);
+  id_to_live_index_.emplace_back(kNilIndex);
+
+  return id;
+}
+
+bool RobotStore::remove(id_t id) {
+  if(!contains(id)) { return false; }
+
+  const auto i = static_cast<std::size_t>(id);
+  id_t* index_id = index_id_at(poses_[i]);
+
+  if(index_id != nullptr && *index_id == id) { *index_id = kNilId; }
+
+  // Swap-remove from the dense list.
+  const std::size_t live_index = id_to_live_index_[i];
+  const id_t last_id = live_ids_.back();
+
+  live_ids_[live_index] = last_id;
+  id_to_live_index_[static_cast<std::size_t>(last_id)] = live_index;
+  live_ids_.pop_back();
+
+  id_to_live_index_[i] = kNilIndex;
+  free_ids_.push_back(id);
+
+  return true;
+}
+
+bool RobotStore::remove_at(const Pos3i& pos) { return remove(id_at(pos)); }
+
+bool RobotStore::move_to(id_t id,const Pos3i& pos) {
+  if(!contains(id)) { return false; }
+
+  const auto i = static_cast<std::size_t>(id);
+  if(poses_[i] == pos) { return true; }
+
+  id_t* to_id = index_id_at(pos);
+  if(to_id == nullptr || *to_id != kNilId) { return false; }
+
+  id_t* from_id = index_id_at(poses_[i]);
+  if(from_id != nullptr && *from_id == id) { *from_id = kNilId; }
+
+  *to_id = id;
+  poses_[i] = pos;
+
+  return true;
+}
+
+RobotStore::id_t* RobotStore::index_id_at(const Pos3i& pos) {
+  if(pos.z < 0 || pos.z >= static_cast<int>(grid_indexes_.size())) { return nullptr; }
+
+  auto& grid = grid_indexes_[static_cast<std::size_t>(pos.z)];
+  const std::size_t index = grid.index_of(pos);
+
+  return (index != kNilIndex) ? &grid.ids[index] : nullptr;
+}
+
+std::size_t RobotStore::GridIndex::index_of(const Pos3i& pos) const {
+  if(pos.x < 0 || pos.x >= size.w || pos.y < 0 || pos.y >= size.h) { return kNilIndex; }
+
+  return static_cast<std::size_t>(pos.x + (pos.y * size.w));
+}
+
+RobotStore::id_t RobotStore::id_at(const Pos3i& pos) const {
+  if(pos.z < 0 || pos.z >= static_cast<int>(grid_indexes_.size())) { return kNilId; }
+
+  const auto& grid = grid_indexes_[static_cast<std::size_t>(pos.z)];
+  const std::size_t index = grid.index_of(pos);
+
+  return (index != kNilIndex) ? grid.ids[index] : kNilId;
+}
+
+bool RobotStore::contains(id_t id) const {
+  return static_cast<std::size_t>(id) < id_to_live_index_.size() &&
+         id_to_live_index_[static_cast<std::size_t>(id)] != kNilIndex;
+}
+
+std::size_t RobotStore::size() const { return live_ids_.size(); }
+
+bool RobotStore::empty() const { return live_ids_.empty(); }
+
+const std::vector<RobotStore::id_t>& RobotStore::ids() const { return live_ids_; }
+
+} // namespace ekoscape
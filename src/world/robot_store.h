@@ -0,0 +1,128 @@
+/*
+ * This file is part of EkoScape.
+ * Copyright (c) 2025 Bradley Whited
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EKOSCAPE_WORLD_ROBOT_STORE_H_
+#define EKOSCAPE_WORLD_ROBOT_STORE_H_
+
+#include "common.h"
+
+#include "cybel/types/pos.h"
+#include "cybel/types/size.h"
+#include "cybel/util/rando.h"
+
+#include "map/map.h"
+#include "map/space_type.h"
+
+#include <limits>
+#include <vector>
+
+namespace ekoscape {
+
+class Robot;
+
+/**
+ * Container of all Robots, stored as a structure of arrays (SoA) by ID,
+ * with an index by pos for O(1) lookup.
+ *
+ * Adding & removing are O(1):
+ * - Removed IDs (slots) are recycled through a free list.
+ * - Living IDs are kept in a dense list (see ids()) for iterating,
+ *   which is swap-removed, so the order of Robots isn't stable.
+ *
+ * Each Robot gets its own random stream, split from the store's stream by spawn order (not by ID,
+ * since IDs are recycled), so that a Robot's moves don't depend on how many numbers other Robots drew.
+ *
+ * Use Robot as a view to access/move a Robot by ID.
+ *
+ * Example:
+ *   @code
+ *   RobotStore robots{};
+ *
+ *   robots.reset(map,Rando{seed}); // Must call after loading the Map (sizes the pos index).
+ *   robots.add(SpaceType::kRobot,Pos3i{1,2,0});
+ *
+ *   for(std::size_t i = 0; i < robots.size(); ++i) {
+ *     Robot robot{robots,robots.ids()[i]};
+ *     // ...
+ *   }
+ *   @endcode
+ */
+class RobotStore {
+public:
+  using id_t = std::uint32_t;
+
+  static constexpr id_t kNilId = std::numeric_limits<id_t>::max();
+
+  explicit RobotStore() noexcept = default;
+
+  RobotStore(const RobotStore& other) = delete;
+  RobotStore(RobotStore&& other) noexcept = default;
+
+  RobotStore& operator=(const RobotStore& other) = delete;
+  RobotStore& operator=(RobotStore&& other) noexcept = default;
+
+  /**
+   * Removes all Robots & sizes the pos index to the Map's grids.
+   * Each new Robot's random stream is split from `rando`.
+   */
+  void reset(const Map& map,const Rando& rando);
+
+  /**
+   * Returns kNilId if the pos is out of bounds or already has a Robot.
+   */
+  id_t add(SpaceType type,const Pos3i& pos,float lifespan = 0.0f);
+  bool remove(id_t id);
+  bool remove_at(const Pos3i& pos);
+  bool move_to(id_t id,const Pos3i& pos);
+
+  id_t id_at(const Pos3i& pos) const;
+  bool contains(id_t id) const;
+  std::size_t size() const;
+  bool empty() const;
+
+  /**
+   * Dense list of living IDs for iterating.
+   */
+  const std::vector<id_t>& ids() const;
+
+private:
+  friend class Robot;
+
+  static constexpr std::size_t kNilIndex = std::numeric_limits<std::size_t>::max();
+
+  class GridIndex {
+  public:
+    Size2i size{};
+    std::vector<id_t> ids{};
+
+    std::size_t index_of(const Pos3i& pos) const;
+  };
+
+  // SoA (by ID).
+  std::vector<SpaceType> types_{};
+  std::vector<Pos3i> poses_{};
+  std::vector<int> moves_likes_{};
+  std::vector<float> lifespans_{};
+  std::vector<float> ages_{};
+  std::vector<Pos3i> last_seen_player_poses_{};
+  std::vector<SpaceType> portal_types_{};
+  std::vector<std::uint8_t> warpeds_{};
+  std::vector<Rando> randos_{};
+  std::vector<std::size_t> id_to_live_index_{}; // Index into live_ids_, else kNilIndex.
+
+  std::vector<id_t> live_ids_{};
+  std::vector<id_t> free_ids_{};
+  std::vector<GridIndex> grid_indexes_{};
+  Rando rando_{0};
+  std::uint64_t spawn_count_ = 0;
+
+  id_t* index_id_at(const Pos3i& pos);
+  id_t alloc_id();
+};
+
+} // namespace ekoscape
+#endif
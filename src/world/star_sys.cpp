@@ -11,11 +11,13 @@
 
 namespace ekoscape {
 
-Color4f StarSys::rand_color() {
+Color4f StarSys::rand_color() { return rand_color(Rando::it()); }
+
+Color4f StarSys::rand_color(Rando& rando) {
   // ReSharper disable once CppDFAUnreachableCode
   if constexpr(kColors.empty()) { return Color4f::kWhite; }
 
-  return kColors[Rando::it().rand_size_t(kColors.size())];
+  return kColors[rando.rand_size_t(kColors.size())];
 }
 
 void StarSys::init(const ViewDimens& view_dimens,bool is_flying) {
@@ -28,13 +30,13 @@ void StarSys::init(const ViewDimens& view_dimens,bool is_flying) {
     birth_star(star);
 
     // The following logic is only on init, not birth, else stars appear "popping" in & out.
-    star.age = Rando::it().rand_float();
-    if(Rando::it().rand_bool()) { star.fade().past_lives = 1; }
+    star.age = rando_.rand_float();
+    if(rando_.rand_bool()) { star.fade().past_lives = 1; }
   }
 }
 
 void StarSys::birth_star(Particle& star) {
-  auto& r = Rando::it();
+  auto& r = rando_;
 
   if(is_flying_) {
     star.lifespan = r.rand_float(0.0f,2.0f);
@@ -57,9 +59,9 @@ void StarSys::birth_star(Particle& star) {
   star.baby_size.h = star.baby_size.w;
   star.elder_size.w = r.rand_float(75.0f,100.0f);
   star.elder_size.h = star.elder_size.w;
-  star.baby_color = rand_color();
+  star.baby_color = rand_color(r);
   star.baby_color.a = 0.1f;
-  star.elder_color = rand_color();
+  star.elder_color = rand_color(r);
   star.elder_color.a = 1.0f;
 
   star.birth();
@@ -80,10 +82,10 @@ void StarSys::update(const FrameStep& step) {
       star.fade();
 
       if(!is_flying_) {
-        if(Rando::it().rand_bool()) { star.pos_vel.x = -star.pos_vel.x; }
-        if(Rando::it().rand_bool()) { star.pos_vel.y = -star.pos_vel.y; }
+        if(rando_.rand_bool()) { star.pos_vel.x = -star.pos_vel.x; }
+        if(rando_.rand_bool()) { star.pos_vel.y = -star.pos_vel.y; }
       }
-      if(Rando::it().rand_bool()) { star.spin_vel = -star.spin_vel; }
+      if(rando_.rand_bool()) { star.spin_vel = -star.spin_vel; }
 
       star.rebirth();
     } else {
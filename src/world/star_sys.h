@@ -15,6 +15,7 @@
 #include "cybel/types/color.h"
 #include "cybel/types/frame_step.h"
 #include "cybel/types/view_dimens.h"
+#include "cybel/util/rando.h"
 #include "cybel/vfx/particle.h"
 
 #include <vector>
@@ -24,6 +25,7 @@ namespace ekoscape {
 class StarSys {
 public:
   static Color4f rand_color();
+  static Color4f rand_color(Rando& rando);
 
   void init(const ViewDimens& view_dimens,bool is_flying = false);
 
@@ -51,6 +53,7 @@ private:
   ViewDimens view_dimens_{};
   bool is_flying_ = false;
   std::vector<Particle> stars_{};
+  Rando rando_{}; // Own stream, so that stars don't draw from the global one.
 
   void birth_star(Particle& star);
 };
@@ -19,10 +19,17 @@
 
 #include "Dantares2.h"
 
+#include<algorithm>
 #include<iomanip>
+#include<iterator>
 #include<ranges>
 #include<utility>
 
+Dantares2::GLuint Dantares2::RendererClass::GetBatchTextureID(GLuint TextureID) const
+{
+    return TextureID;
+}
+
 Dantares2::Dantares2(RendererClass &Renderer, float SquareSize, float FloorHeight, float CeilingHeight)
     : Renderer(&Renderer),
       SqSize(SquareSize),
@@ -68,6 +75,7 @@ void Dantares2::MoveFrom(Dantares2 &&Other) noexcept
     WalkOffset = std::exchange(Other.WalkOffset, 0.0f);
     TurnOffset = std::exchange(Other.TurnOffset, 0.0f);
     DegreesTurned = std::exchange(Other.DegreesTurned, 0.0f);
+    DrawAlpha = std::exchange(Other.DrawAlpha, 0.0f);
 
     for (int x = 0; x < MAXMAPS; x++)
     {
@@ -365,104 +373,214 @@ bool Dantares2::GenerateMap()
         return false;
     }
 
-    const float Offset = SqSize / 2.0f;
+    auto &Map = *Maps[CurrentMap];
 
-    for (const auto &Seeker: std::views::values(Maps[CurrentMap]->SpaceInfo))
+    Map.MakeChunksDirty();
+
+    for (int ChunkY = 0; ChunkY < Map.ChunkYSize; ChunkY++)
+    {
+        for (int ChunkX = 0; ChunkX < Map.ChunkXSize; ChunkX++)
+        {
+            GenerateChunk(Map, ChunkX, ChunkY);
+        }
+    }
+
+    return true;
+}
+
+bool Dantares2::GenerateMapChunks(int First, int Count)
+{
+    if (CurrentMap == -1)                                                //No active map.
     {
-        Seeker->GenerateQuadLists();
+        return false;
+    }
+
+    auto &Map = *Maps[CurrentMap];
+    const int Total = Map.ChunkXSize * Map.ChunkYSize;
+    const int Last = (Count >= Total - First) ? Total : (First + Count);  //Avoid overflow.
+
+    for (int Chunk = std::max(First, 0); Chunk < Last; Chunk++)
+    {
+        GenerateChunk(Map, Chunk % Map.ChunkXSize, Chunk / Map.ChunkXSize);
+    }
+
+    return true;
+}
+
+int Dantares2::GetChunkCount() const
+{
+    if (CurrentMap == -1)                                                //No active map.
+    {
+        return 0;
+    }
 
-        if (Seeker->CeilingTexture != 0)
+    const auto &Map = *Maps[CurrentMap];
+
+    return Map.ChunkXSize * Map.ChunkYSize;
+}
+
+void Dantares2::GenerateChunk(MapClass &Map, int ChunkX, int ChunkY)
+{
+    auto &FaceQuads = ChunkFaceQuads;                                    //Reused to avoid re-allocating.
+    auto &Quads = ChunkQuads;
+    auto &Chunk = Map.GetChunk(ChunkX, ChunkY);
+    const float Offset = SqSize / 2.0f;
+    const int MinX = ChunkX * CHUNK_SIZE;
+    const int MinY = ChunkY * CHUNK_SIZE;
+    const int MaxX = std::min(MinX + CHUNK_SIZE, Map.XSize);
+    const int MaxY = std::min(MinY + CHUNK_SIZE, Map.YSize);
+    FaceQuads.clear();
+    FaceQuads.reserve(static_cast<std::size_t>((MaxX - MinX) * (MaxY - MinY) * 2));
+
+    //Same positions that the squares were translated to in the original Draw(), but baked into
+    //the vertices, so that no model matrix updates are needed per square.
+    //Y is the outer loop, since the cells are stored row by row.
+    for (int y = MinY; y < MaxY; y++)
+    {
+        const float Z = -static_cast<float>(y) * SqSize;
+        const int YRow = y - MinY;
+
+        for (int x = MinX; x < MaxX; x++)
         {
-            Renderer->CompileQuadList(
-                Seeker->QuadList, SpaceClass::FACE_CEILING,
-                RendererClass::QuadListData{
+            const SpaceClass *Seeker = Map.FindSpace(x, y);
+
+            if (Seeker == nullptr)
+            {
+                continue;
+            }
+
+            const float X = static_cast<float>(x) * SqSize;
+            const int XRow = x - MinX;
+
+            if (Seeker->CeilingTexture != 0)
+            {
+                FaceQuads.push_back(FaceQuad{SpaceClass::FACE_CEILING, YRow, {
                     .TextureID = Seeker->CeilingTexture,
                     .Normal = {0.0f, -1.0f, 0.0f},
                     .Vertices = {
-                        {-Offset, Ceiling, -Offset},
-                        { Offset, Ceiling, -Offset},
-                        { Offset, Ceiling,  Offset},
-                        {-Offset, Ceiling,  Offset}
+                        {X - Offset, Ceiling, Z - Offset},
+                        {X + Offset, Ceiling, Z - Offset},
+                        {X + Offset, Ceiling, Z + Offset},
+                        {X - Offset, Ceiling, Z + Offset}
                     }
-                }
-            );
-        }
+                }});
+            }
 
-        if (Seeker->FloorTexture != 0)
-        {
-            Renderer->CompileQuadList(
-                Seeker->QuadList, SpaceClass::FACE_FLOOR,
-                RendererClass::QuadListData{
+            if (Seeker->FloorTexture != 0)
+            {
+                FaceQuads.push_back(FaceQuad{SpaceClass::FACE_FLOOR, YRow, {
                     .TextureID = Seeker->FloorTexture,
                     .Normal = {0.0f, 1.0f, 0.0f},
                     .Vertices = {
-                        {-Offset, Floor, -Offset},
-                        { Offset, Floor, -Offset},
-                        { Offset, Floor,  Offset},
-                        {-Offset, Floor,  Offset}
+                        {X - Offset, Floor, Z - Offset},
+                        {X + Offset, Floor, Z - Offset},
+                        {X + Offset, Floor, Z + Offset},
+                        {X - Offset, Floor, Z + Offset}
                     }
-                }
-            );
-        }
+                }});
+            }
 
-        if (Seeker->WallTexture != 0)
-        {
-            Renderer->CompileQuadList(
-                Seeker->QuadList, SpaceClass::FACE_WALL_NEAR,
-                RendererClass::QuadListData{
+            if (Seeker->WallTexture != 0)
+            {
+                FaceQuads.push_back(FaceQuad{SpaceClass::FACE_WALL_NEAR, YRow, {
                     .TextureID = Seeker->WallTexture,
                     .Normal = {0.0f, 0.0f, 1.0f},
                     .Vertices = {
-                        {-Offset, Floor,   Offset},
-                        { Offset, Floor,   Offset},
-                        { Offset, Ceiling, Offset},
-                        {-Offset, Ceiling, Offset}
+                        {X - Offset, Floor,   Z + Offset},
+                        {X + Offset, Floor,   Z + Offset},
+                        {X + Offset, Ceiling, Z + Offset},
+                        {X - Offset, Ceiling, Z + Offset}
                     }
-                }
-            );
-            Renderer->CompileQuadList(
-                Seeker->QuadList, SpaceClass::FACE_WALL_RIGHT,
-                RendererClass::QuadListData{
+                }});
+                FaceQuads.push_back(FaceQuad{SpaceClass::FACE_WALL_RIGHT, XRow, {
                     .TextureID = Seeker->WallTexture,
                     .Normal = {1.0f, 0.0f, 0.0f},
                     .Vertices = {
-                        {Offset, Floor,    Offset},
-                        {Offset, Floor,   -Offset},
-                        {Offset, Ceiling, -Offset},
-                        {Offset, Ceiling,  Offset}
+                        {X + Offset, Floor,   Z + Offset},
+                        {X + Offset, Floor,   Z - Offset},
+                        {X + Offset, Ceiling, Z - Offset},
+                        {X + Offset, Ceiling, Z + Offset}
                     }
-                }
-            );
-            Renderer->CompileQuadList(
-                Seeker->QuadList, SpaceClass::FACE_WALL_FAR,
-                RendererClass::QuadListData{
+                }});
+                FaceQuads.push_back(FaceQuad{SpaceClass::FACE_WALL_FAR, YRow, {
                     .TextureID = Seeker->WallTexture,
                     .Normal = {0.0f, 0.0f, -1.0f},
                     .Vertices = {
-                        { Offset, Floor,   -Offset},
-                        {-Offset, Floor,   -Offset},
-                        {-Offset, Ceiling, -Offset},
-                        { Offset, Ceiling, -Offset}
+                        {X + Offset, Floor,   Z - Offset},
+                        {X - Offset, Floor,   Z - Offset},
+                        {X - Offset, Ceiling, Z - Offset},
+                        {X + Offset, Ceiling, Z - Offset}
                     }
-                }
-            );
-            Renderer->CompileQuadList(
-                Seeker->QuadList, SpaceClass::FACE_WALL_LEFT,
-                RendererClass::QuadListData{
+                }});
+                FaceQuads.push_back(FaceQuad{SpaceClass::FACE_WALL_LEFT, XRow, {
                     .TextureID = Seeker->WallTexture,
                     .Normal = {-1.0f, 0.0f, 0.0f},
                     .Vertices = {
-                        {-Offset, Floor,   -Offset},
-                        {-Offset, Floor,    Offset},
-                        {-Offset, Ceiling,  Offset},
-                        {-Offset, Ceiling, -Offset}
+                        {X - Offset, Floor,   Z - Offset},
+                        {X - Offset, Floor,   Z + Offset},
+                        {X - Offset, Ceiling, Z + Offset},
+                        {X - Offset, Ceiling, Z - Offset}
                     }
-                }
-            );
+                }});
+            }
         }
     }
 
-    return true;
+    for (auto &FQuad: FaceQuads)
+    {
+        FQuad.BatchTextureID = Renderer->GetBatchTextureID(FQuad.Data.TextureID);
+    }
+
+    //Group by face & texture, then sort by row, so that each group's visible rows are contiguous.
+    std::sort(FaceQuads.begin(), FaceQuads.end(), [](const FaceQuad &A, const FaceQuad &B)
+    {
+        if (A.Face != B.Face)
+        {
+            return A.Face < B.Face;
+        }
+
+        if (A.BatchTextureID != B.BatchTextureID)
+        {
+            return A.BatchTextureID < B.BatchTextureID;
+        }
+
+        return A.Row < B.Row;
+    });
+
+    Quads.clear();
+    Quads.reserve(FaceQuads.size());
+    Chunk.Groups.clear();
+
+    for (std::size_t i = 0; i < FaceQuads.size(); i++)
+    {
+        const auto &FQuad = FaceQuads[i];
+
+        if (i == 0 || FQuad.Face != FaceQuads[i - 1].Face ||
+            FQuad.BatchTextureID != FaceQuads[i - 1].BatchTextureID)
+        {
+            Chunk.Groups.push_back(ChunkClass::GroupData{.Face = FQuad.Face});
+            std::fill(std::begin(Chunk.Groups.back().RowStarts), std::end(Chunk.Groups.back().RowStarts),
+                      static_cast<int>(i));
+        }
+
+        //All rows after this one start after this quad (until overwritten by the next quad).
+        auto &RowStarts = Chunk.Groups.back().RowStarts;
+
+        for (int Row = FQuad.Row + 1; Row <= CHUNK_SIZE; Row++)
+        {
+            RowStarts[Row] = static_cast<int>(i) + 1;
+        }
+
+        Quads.push_back(FQuad.Data);
+    }
+
+    if (Chunk.QuadBatch == 0)
+    {
+        Chunk.GenerateQuadBatch();
+    }
+
+    Renderer->CompileQuadBatch(Chunk.QuadBatch, Quads);
+    Chunk.IsDirty = false;
 }
 
 void Dantares2::UpdateDeltaTime(float DT)
@@ -470,6 +588,11 @@ void Dantares2::UpdateDeltaTime(float DT)
     DeltaTime = DT / TARGET_DELTA_TIME;
 }
 
+void Dantares2::SetDrawAlpha(float Alpha)
+{
+    DrawAlpha = std::clamp(Alpha, 0.0f, 1.0f);
+}
+
 bool Dantares2::Draw(int Distance, bool MovePlayer)
 {
     if (CurrentMap == -1)                                                //No active map.
@@ -482,11 +605,38 @@ bool Dantares2::Draw(int Distance, bool MovePlayer)
     const int HalfDistance = Distance / 2;
     const auto CameraXf = static_cast<float>(CameraX);
     const auto CameraYf = static_cast<float>(CameraY);
+    float WalkOffsetf = WalkOffset;
+    float TurnOffsetf = TurnOffset;
+
+    //Draw ahead by a fraction of the next MovePlayer(), clamped to where it would stop.
+    if (DrawAlpha > 0.0f)
+    {
+        const float WalkStep = WalkSpeed * DeltaTime * DrawAlpha;
+        const float TurnStep = std::min(TurnSpeed * DeltaTime * DrawAlpha, std::max(90.0f - DegreesTurned, 0.0f));
+
+        if (WalkOffsetf > 0.0f)
+        {
+            WalkOffsetf = std::min(WalkOffsetf + WalkStep, SqSize);
+        }
+        else if (WalkOffsetf < 0.0f)
+        {
+            WalkOffsetf = std::max(WalkOffsetf - WalkStep, -SqSize);
+        }
+
+        if (Turning > 0)
+        {
+            TurnOffsetf += TurnStep;
+        }
+        else if (Turning < 0)
+        {
+            TurnOffsetf -= TurnStep;
+        }
+    }
 
     Renderer->BeginDraw();
 
     Renderer->TranslateModelMatrix(0.0f, 0.0f, -(SqSize / 2.0f));
-    Renderer->RotateModelMatrix(static_cast<float>(CameraFacing) * 90.0f + TurnOffset, 0.0f, 1.0f, 0.0f);
+    Renderer->RotateModelMatrix(static_cast<float>(CameraFacing) * 90.0f + TurnOffsetf, 0.0f, 1.0f, 0.0f);
 
     switch (CameraFacing)
     {
@@ -494,11 +644,11 @@ bool Dantares2::Draw(int Distance, bool MovePlayer)
         case DIR_SOUTH:
             if (Walking == DIR_EAST || Walking == DIR_WEST)
             {
-                Renderer->TranslateModelMatrix(-(CameraXf * SqSize + WalkOffset), 0.0f, CameraYf * SqSize);
+                Renderer->TranslateModelMatrix(-(CameraXf * SqSize + WalkOffsetf), 0.0f, CameraYf * SqSize);
             }
             else
             {
-                Renderer->TranslateModelMatrix(-(CameraXf * SqSize), 0.0f, CameraYf * SqSize + WalkOffset);
+                Renderer->TranslateModelMatrix(-(CameraXf * SqSize), 0.0f, CameraYf * SqSize + WalkOffsetf);
             }
             break;
 
@@ -506,229 +656,130 @@ bool Dantares2::Draw(int Distance, bool MovePlayer)
         case DIR_WEST:
             if (Walking == DIR_NORTH || Walking == DIR_SOUTH)
             {
-                Renderer->TranslateModelMatrix(-(CameraXf * SqSize), 0.0f, CameraYf * SqSize + WalkOffset);
+                Renderer->TranslateModelMatrix(-(CameraXf * SqSize), 0.0f, CameraYf * SqSize + WalkOffsetf);
             }
             else
             {
-                Renderer->TranslateModelMatrix(-(CameraXf * SqSize + WalkOffset), 0.0f, CameraYf * SqSize);
+                Renderer->TranslateModelMatrix(-(CameraXf * SqSize + WalkOffsetf), 0.0f, CameraYf * SqSize);
             }
             break;
     }
 
+    //The area of squares to draw, with max exclusive.
+    int MinX = 0;
+    int MaxX = 0;
+    int MinY = 0;
+    int MaxY = 0;
+    //The rows (see ChunkClass::GroupData) of each face that are facing the player, with max exclusive.
+    int FaceMinRows[SpaceClass::FACE_COUNT] = {};
+    int FaceMaxRows[SpaceClass::FACE_COUNT] = {};
+
+    const auto SetFaceRows = [&](int Face, int MinRow, int MaxRow)
+    {
+        FaceMinRows[Face] = MinRow;
+        FaceMaxRows[Face] = MaxRow;
+    };
+
     switch (CameraFacing)
     {
         case DIR_NORTH:
-            for (int x = (CameraX > Distance) ? (CameraX - Distance) : 0;
-                 x < XBound && x < (CameraX + Distance); x++)
-            {
-                Renderer->PushModelMatrix();
-                Renderer->TranslateModelMatrix(static_cast<float>(x) * SqSize, 0.0f, SqSize);
-
-                for (int y = (CameraY > HalfDistance) ? (CameraY - HalfDistance) : 0;
-                     y < YBound && y < (CameraY + Distance); y++)
-                {
-                    if (y == (CameraY - HalfDistance))
-                    {
-                        Renderer->TranslateModelMatrix(0.0f, 0.0f, -(SqSize * static_cast<float>(y)));
-                    }
-
-                    Renderer->TranslateModelMatrix(0.0f, 0.0f, -SqSize);
-                    Renderer->UpdateModelMatrix();
-
-                    const SpaceClass *Seeker = Maps[CurrentMap]->FindSpace(x, y);
-
-                    if (Seeker->WallTexture != 0)
-                    {
-                        if (y >= CameraY)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_NEAR);
-                        }
-
-                        if (x < CameraX)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_RIGHT);
-                        }
-                        else if (x > CameraX)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_LEFT);
-                        }
-                    }
-
-                    if (Seeker->FloorTexture != 0)
-                    {
-                        Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_FLOOR);
-                    }
-
-                    if (Seeker->CeilingTexture != 0)
-                    {
-                        Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_CEILING);
-                    }
-                }
-
-                Renderer->PopModelMatrix();
-            }
+            MinX = CameraX - Distance;
+            MaxX = CameraX + Distance;
+            MinY = CameraY - HalfDistance;
+            MaxY = CameraY + Distance;
+
+            SetFaceRows(SpaceClass::FACE_WALL_NEAR, CameraY, MaxY);
+            SetFaceRows(SpaceClass::FACE_WALL_RIGHT, MinX, CameraX);
+            SetFaceRows(SpaceClass::FACE_WALL_LEFT, CameraX + 1, MaxX);
             break;
 
         case DIR_EAST:
-            for (int x = (CameraX > HalfDistance) ? (CameraX - HalfDistance) : 0;
-                 x < XBound && x < (CameraX + Distance); x++)
-            {
-                Renderer->PushModelMatrix();
-                Renderer->TranslateModelMatrix(static_cast<float>(x) * SqSize, 0.0f, SqSize);
-
-                for (int y = (CameraY > Distance) ? (CameraY - Distance) : 0;
-                     y < YBound && y < (CameraY + Distance); y++)
-                {
-                    if (y == (CameraY - Distance))
-                    {
-                        Renderer->TranslateModelMatrix(0.0f, 0.0f, -(SqSize * static_cast<float>(y)));
-                    }
-
-                    Renderer->TranslateModelMatrix(0.0f, 0.0f, -SqSize);
-                    Renderer->UpdateModelMatrix();
-
-                    const SpaceClass *Seeker = Maps[CurrentMap]->FindSpace(x, y);
-
-                    if (Seeker->WallTexture != 0)
-                    {
-                        if (x >= CameraX)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_LEFT);
-                        }
-
-                        if (y > CameraY)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_NEAR);
-                        }
-                        else if (y < CameraY)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_FAR);
-                        }
-                    }
-
-                    if (Seeker->FloorTexture != 0)
-                    {
-                        Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_FLOOR);
-                    }
-
-                    if (Seeker->CeilingTexture != 0)
-                    {
-                        Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_CEILING);
-                    }
-                }
-
-                Renderer->PopModelMatrix();
-            }
+            MinX = CameraX - HalfDistance;
+            MaxX = CameraX + Distance;
+            MinY = CameraY - Distance;
+            MaxY = CameraY + Distance;
+
+            SetFaceRows(SpaceClass::FACE_WALL_LEFT, CameraX, MaxX);
+            SetFaceRows(SpaceClass::FACE_WALL_NEAR, CameraY + 1, MaxY);
+            SetFaceRows(SpaceClass::FACE_WALL_FAR, MinY, CameraY);
             break;
 
         case DIR_SOUTH:
-            for (int x = (CameraX > Distance) ? (CameraX - Distance) : 0;
-                 x < XBound && x < (CameraX + Distance); x++)
-            {
-                Renderer->PushModelMatrix();
-                Renderer->TranslateModelMatrix(static_cast<float>(x) * SqSize, 0.0f, SqSize);
-
-                for (int y = (CameraY > Distance) ? (CameraY - Distance) : 0;
-                     y < YBound && y < (CameraY + HalfDistance); y++)
-                {
-                    if (y == (CameraY - Distance))
-                    {
-                        Renderer->TranslateModelMatrix(0.0f, 0.0f, -(SqSize * static_cast<float>(y)));
-                    }
-
-                    Renderer->TranslateModelMatrix(0.0f, 0.0f, -SqSize);
-                    Renderer->UpdateModelMatrix();
+            MinX = CameraX - Distance;
+            MaxX = CameraX + Distance;
+            MinY = CameraY - Distance;
+            MaxY = CameraY + HalfDistance;
+
+            SetFaceRows(SpaceClass::FACE_WALL_FAR, MinY, CameraY + 1);
+            SetFaceRows(SpaceClass::FACE_WALL_LEFT, CameraX + 1, MaxX);
+            SetFaceRows(SpaceClass::FACE_WALL_RIGHT, MinX, CameraX);
+            break;
 
-                    const SpaceClass *Seeker = Maps[CurrentMap]->FindSpace(x, y);
+        case DIR_WEST:
+            MinX = CameraX - Distance;
+            MaxX = CameraX + HalfDistance;
+            MinY = CameraY - Distance;
+            MaxY = CameraY + Distance;
+
+            SetFaceRows(SpaceClass::FACE_WALL_RIGHT, MinX, CameraX + 1);
+            SetFaceRows(SpaceClass::FACE_WALL_FAR, MinY, CameraY);
+            SetFaceRows(SpaceClass::FACE_WALL_NEAR, CameraY + 1, MaxY);
+            break;
+    }
 
-                    if (Seeker->WallTexture != 0)
-                    {
-                        if (y <= CameraY)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_FAR);
-                        }
-
-                        if (x > CameraX)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_LEFT);
-                        }
-                        else if (x < CameraX)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_RIGHT);
-                        }
-                    }
+    MinX = std::max(MinX, 0);
+    MaxX = std::min(MaxX, XBound);
+    MinY = std::max(MinY, 0);
+    MaxY = std::min(MaxY, YBound);
 
-                    if (Seeker->FloorTexture != 0)
-                    {
-                        Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_FLOOR);
-                    }
+    SetFaceRows(SpaceClass::FACE_FLOOR, MinY, MaxY);
+    SetFaceRows(SpaceClass::FACE_CEILING, MinY, MaxY);
 
-                    if (Seeker->CeilingTexture != 0)
-                    {
-                        Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_CEILING);
-                    }
-                }
+    //The vertices are already in world space, so only the camera's transformations are needed.
+    Renderer->UpdateModelMatrix();
 
-                Renderer->PopModelMatrix();
-            }
-            break;
+    if (MinX < MaxX && MinY < MaxY)
+    {
+        auto &Map = *Maps[CurrentMap];
 
-        case DIR_WEST:
-            for (int x = (CameraX > Distance) ? (CameraX - Distance) : 0;
-                 x < XBound && x < (CameraX + HalfDistance); x++)
+        for (int ChunkX = MinX / CHUNK_SIZE; ChunkX <= (MaxX - 1) / CHUNK_SIZE; ChunkX++)
+        {
+            for (int ChunkY = MinY / CHUNK_SIZE; ChunkY <= (MaxY - 1) / CHUNK_SIZE; ChunkY++)
             {
-                Renderer->PushModelMatrix();
-                Renderer->TranslateModelMatrix(static_cast<float>(x) * SqSize, 0.0f, SqSize);
+                auto &Chunk = Map.GetChunk(ChunkX, ChunkY);
 
-                for (int y = (CameraY > Distance) ? (CameraY - Distance) : 0;
-                     y < YBound && y < (CameraY + Distance); y++)
+                if (Chunk.IsDirty)                                       //Squares changed.
                 {
-                    if (y == (CameraY - Distance))
-                    {
-                        Renderer->TranslateModelMatrix(0.0f, 0.0f, -(SqSize * static_cast<float>(y)));
-                    }
-
-                    Renderer->TranslateModelMatrix(0.0f, 0.0f, -SqSize);
-                    Renderer->UpdateModelMatrix();
+                    GenerateChunk(Map, ChunkX, ChunkY);
+                }
 
-                    const SpaceClass *Seeker = Maps[CurrentMap]->FindSpace(x, y);
+                for (const auto &Group: Chunk.Groups)
+                {
+                    const bool IsXRow = (Group.Face == SpaceClass::FACE_WALL_LEFT ||
+                                         Group.Face == SpaceClass::FACE_WALL_RIGHT);
+                    const int ChunkRow = (IsXRow ? ChunkX : ChunkY) * CHUNK_SIZE;
+                    const int MinRow = std::clamp(FaceMinRows[Group.Face] - ChunkRow, 0, CHUNK_SIZE);
+                    const int MaxRow = std::clamp(FaceMaxRows[Group.Face] - ChunkRow, 0, CHUNK_SIZE);
 
-                    if (Seeker->WallTexture != 0)
+                    if (MinRow >= MaxRow)
                     {
-                        if (x <= CameraX)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_RIGHT);
-                        }
-
-                        if (y < CameraY)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_FAR);
-                        }
-                        else if (y > CameraY)
-                        {
-                            Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_WALL_NEAR);
-                        }
+                        continue;
                     }
 
-                    if (Seeker->FloorTexture != 0)
-                    {
-                        Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_FLOOR);
-                    }
+                    const int First = Group.RowStarts[MinRow];
+                    const int Count = Group.RowStarts[MaxRow] - First;
 
-                    if (Seeker->CeilingTexture != 0)
+                    if (Count > 0)
                     {
-                        Renderer->DrawQuadList(Seeker->QuadList, SpaceClass::FACE_CEILING);
+                        Renderer->DrawQuadBatch(Chunk.QuadBatch, First, Count);
                     }
                 }
-
-                Renderer->PopModelMatrix();
             }
-            break;
+        }
     }
 
-    //Retain the transformations made to the model matrix.
+    //The transformations made to the model matrix are retained.
     //This allows the user to insert other objects into the map.
-    Renderer->UpdateModelMatrix();
     Renderer->EndDraw();
 
     if (MovePlayer)
@@ -1269,18 +1320,35 @@ void Dantares2::PrintDebugInfo(std::ostream &Out) const
     Out << std::endl;
 }
 
-Dantares2::SpaceClass::SpaceClass(RendererClass *Renderer, int Type) noexcept
-    : Renderer(Renderer),
-      SpaceType(Type)
+Dantares2::SpaceClass::SpaceClass(int Type) noexcept
+    : SpaceType(Type)
+{
+}
+
+void Dantares2::SpaceClass::PrintDebugInfo(std::ostream &Out, int Indent) const
+{
+    const std::string Ind(static_cast<std::size_t>(Indent), ' ');
+    const std::string Indl = '\n' + Ind;
+
+    Out << Ind  << "SpaceType:         " << SpaceType
+        << Indl << "FloorTexture:      " << FloorTexture
+        << Indl << "CeilingTexture:    " << CeilingTexture
+        << Indl << "WallTexture:       " << WallTexture
+        ;
+    Out.flush();
+}
+
+Dantares2::ChunkClass::ChunkClass(RendererClass *Renderer) noexcept
+    : Renderer(Renderer)
 {
 }
 
-Dantares2::SpaceClass::SpaceClass(SpaceClass &&Other) noexcept
+Dantares2::ChunkClass::ChunkClass(ChunkClass &&Other) noexcept
 {
     MoveFrom(std::move(Other));
 }
 
-Dantares2::SpaceClass &Dantares2::SpaceClass::operator = (SpaceClass &&Other) noexcept
+Dantares2::ChunkClass &Dantares2::ChunkClass::operator = (ChunkClass &&Other) noexcept
 {
     if (this != &Other)
     {
@@ -1290,61 +1358,51 @@ Dantares2::SpaceClass &Dantares2::SpaceClass::operator = (SpaceClass &&Other) no
     return *this;
 }
 
-void Dantares2::SpaceClass::MoveFrom(SpaceClass &&Other) noexcept
+void Dantares2::ChunkClass::MoveFrom(ChunkClass &&Other) noexcept
 {
-    DeleteQuadLists();
+    DeleteQuadBatch();
 
     Renderer = std::exchange(Other.Renderer, nullptr);
-    SpaceType = std::exchange(Other.SpaceType, 0);
-    FloorTexture = std::exchange(Other.FloorTexture, 0);
-    CeilingTexture = std::exchange(Other.CeilingTexture, 0);
-    WallTexture = std::exchange(Other.WallTexture, 0);
-    QuadList = std::exchange(Other.QuadList, 0);
+    QuadBatch = std::exchange(Other.QuadBatch, 0);
+    IsDirty = std::exchange(Other.IsDirty, true);
+    Groups = std::move(Other.Groups);
 }
 
-Dantares2::SpaceClass::~SpaceClass() noexcept
+Dantares2::ChunkClass::~ChunkClass() noexcept
 {
-    DeleteQuadLists();
+    DeleteQuadBatch();
 }
 
-void Dantares2::SpaceClass::DeleteQuadLists() noexcept
+void Dantares2::ChunkClass::DeleteQuadBatch() noexcept
 {
-    if (QuadList != 0)
+    if (QuadBatch != 0)
     {
-        Renderer->DeleteQuadLists(QuadList, FACE_COUNT);
-        QuadList = 0;
+        Renderer->DeleteQuadBatch(QuadBatch);
+        QuadBatch = 0;
     }
 }
 
-void Dantares2::SpaceClass::GenerateQuadLists()
-{
-    DeleteQuadLists();
-
-    QuadList = Renderer->GenerateQuadLists(FACE_COUNT);
-}
-
-void Dantares2::SpaceClass::PrintDebugInfo(std::ostream &Out, int Indent) const
+void Dantares2::ChunkClass::GenerateQuadBatch()
 {
-    const std::string Ind(static_cast<std::size_t>(Indent), ' ');
-    const std::string Indl = '\n' + Ind;
+    DeleteQuadBatch();
 
-    Out << Ind  << "Renderer:          " << Renderer
-        << Indl << "SpaceType:         " << SpaceType
-        << Indl << "FloorTexture:      " << FloorTexture
-        << Indl << "CeilingTexture:    " << CeilingTexture
-        << Indl << "WallTexture:       " << WallTexture
-        << Indl << "QuadList:          " << QuadList
-        ;
-    Out.flush();
+    QuadBatch = Renderer->GenerateQuadBatch();
 }
 
 Dantares2::MapClass::MapClass(RendererClass *Renderer, int MaxX, int MaxY)
     : Renderer(Renderer),
       XSize(MaxX),
       YSize(MaxY),
-      MapArray(static_cast<std::size_t>(MaxX), std::vector(static_cast<std::size_t>(MaxY), 0)),
-      WalkArray(static_cast<std::size_t>(MaxX), std::vector(static_cast<std::size_t>(MaxY), true))
+      ChunkXSize((MaxX + CHUNK_SIZE - 1) / CHUNK_SIZE),
+      ChunkYSize((MaxY + CHUNK_SIZE - 1) / CHUNK_SIZE),
+      Cells(static_cast<std::size_t>(MaxX * MaxY))
 {
+    Chunks.reserve(static_cast<std::size_t>(ChunkXSize * ChunkYSize));
+
+    for (int i = 0; i < (ChunkXSize * ChunkYSize); i++)
+    {
+        Chunks.emplace_back(Renderer);
+    }
 }
 
 Dantares2::MapClass::MapClass(MapClass &&Other) noexcept
@@ -1365,11 +1423,15 @@ Dantares2::MapClass &Dantares2::MapClass::operator = (MapClass &&Other) noexcept
 void Dantares2::MapClass::MoveFrom(MapClass &&Other) noexcept
 {
     Renderer = std::exchange(Other.Renderer, nullptr);
-    MapArray = std::move(Other.MapArray);
-    WalkArray = std::move(Other.WalkArray);
-    SpaceInfo = std::move(Other.SpaceInfo);
+    Cells = std::move(Other.Cells);
+    Chunks = std::move(Other.Chunks);
+    SpaceInfo = std::move(Other.SpaceInfo);                              //The spaces' addresses don't change.
+    std::copy(std::begin(Other.SpaceTable), std::end(Other.SpaceTable), std::begin(SpaceTable));
+    std::fill(std::begin(Other.SpaceTable), std::end(Other.SpaceTable), nullptr);
     XSize = std::exchange(Other.XSize, 0);
     YSize = std::exchange(Other.YSize, 0);
+    ChunkXSize = std::exchange(Other.ChunkXSize, 0);
+    ChunkYSize = std::exchange(Other.ChunkYSize, 0);
 }
 
 Dantares2::SpaceClass &Dantares2::MapClass::AddSpaceIfAbsent(int SpaceID)
@@ -1378,7 +1440,12 @@ Dantares2::SpaceClass &Dantares2::MapClass::AddSpaceIfAbsent(int SpaceID)
 
     if (IsNew || !It->second)
     {
-        It->second = std::make_unique<SpaceClass>(Renderer, SpaceID);
+        It->second = std::make_unique<SpaceClass>(SpaceID);
+
+        if (SpaceID >= 0 && SpaceID < SPACE_TABLE_SIZE)
+        {
+            SpaceTable[SpaceID] = It->second.get();
+        }
     }
 
     return *It->second;
@@ -1391,6 +1458,11 @@ Dantares2::SpaceClass *Dantares2::MapClass::FindSpace(int XCoord, int YCoord)
 
 Dantares2::SpaceClass *Dantares2::MapClass::FindSpace(int SpaceID)
 {
+    if (SpaceID >= 0 && SpaceID < SPACE_TABLE_SIZE)                      //Fast path (no hashing).
+    {
+        return SpaceTable[SpaceID];
+    }
+
     const auto It = SpaceInfo.find(SpaceID);
 
     if (It == SpaceInfo.end())
@@ -1403,22 +1475,51 @@ Dantares2::SpaceClass *Dantares2::MapClass::FindSpace(int SpaceID)
 
 void Dantares2::MapClass::ChangeSquare(int XCoord, int YCoord, int NewType)
 {
-    MapArray[static_cast<std::size_t>(XCoord)][static_cast<std::size_t>(YCoord)] = NewType;
+    int &Square = GetCell(XCoord, YCoord).SpaceType;
+
+    if (Square != NewType)
+    {
+        Square = NewType;
+        GetChunk(XCoord / CHUNK_SIZE, YCoord / CHUNK_SIZE).IsDirty = true;  //Regenerate on next Draw().
+    }
 }
 
 void Dantares2::MapClass::ChangeWalkability(int XCoord, int YCoord, bool Walkable)
 {
-    WalkArray[static_cast<std::size_t>(XCoord)][static_cast<std::size_t>(YCoord)] = Walkable;
+    GetCell(XCoord, YCoord).IsWalkable = Walkable;
+}
+
+Dantares2::ChunkClass &Dantares2::MapClass::GetChunk(int ChunkX, int ChunkY)
+{
+    return Chunks[static_cast<std::size_t>(ChunkY * ChunkXSize + ChunkX)];
+}
+
+void Dantares2::MapClass::MakeChunksDirty()
+{
+    for (auto &Chunk: Chunks)
+    {
+        Chunk.IsDirty = true;
+    }
 }
 
 int Dantares2::MapClass::GetSpaceType(int XCoord, int YCoord) const
 {
-    return MapArray[static_cast<std::size_t>(XCoord)][static_cast<std::size_t>(YCoord)];
+    return GetCell(XCoord, YCoord).SpaceType;
 }
 
 bool Dantares2::MapClass::SpaceIsWalkable(int XCoord, int YCoord) const
 {
-    return WalkArray[static_cast<std::size_t>(XCoord)][static_cast<std::size_t>(YCoord)];
+    return GetCell(XCoord, YCoord).IsWalkable;
+}
+
+Dantares2::CellData &Dantares2::MapClass::GetCell(int XCoord, int YCoord)
+{
+    return Cells[static_cast<std::size_t>(YCoord * XSize + XCoord)];
+}
+
+const Dantares2::CellData &Dantares2::MapClass::GetCell(int XCoord, int YCoord) const
+{
+    return Cells[static_cast<std::size_t>(YCoord * XSize + XCoord)];
 }
 
 void Dantares2::MapClass::PrintDebugInfo(std::ostream &Out, int Indent) const
@@ -1429,12 +1530,14 @@ void Dantares2::MapClass::PrintDebugInfo(std::ostream &Out, int Indent) const
     Out << Ind  << "Renderer:    " << Renderer
         << Indl << "XSize:       " << XSize
         << Indl << "YSize:       " << YSize
+        << Indl << "ChunkXSize:  " << ChunkXSize
+        << Indl << "ChunkYSize:  " << ChunkYSize
         ;
 
     Indent *= 2;
     Indl = '\n' + std::string(static_cast<std::size_t>(Indent), ' ');
 
-    Out << Indl << "{MapArray} = " << MapArray.data();
+    Out << Indl << "{Cells} = " << Cells.data();
     for (int y = 0; y < YSize; y++)
     {
         Out << Indl;
@@ -1444,7 +1547,7 @@ void Dantares2::MapClass::PrintDebugInfo(std::ostream &Out, int Indent) const
         }
     }
 
-    Out << Indl << "{WalkArray} = " << WalkArray.data();
+    Out << Indl << "{Walkability}";
     for (int y = 0; y < YSize; y++)
     {
         Out << Indl;
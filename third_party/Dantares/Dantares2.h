@@ -56,16 +56,34 @@ public:
         virtual void PushModelMatrix() = 0;
         virtual void PopModelMatrix() = 0;
 
-        virtual GLuint GenerateQuadLists(int Count) = 0;
-        virtual void DeleteQuadLists(GLuint ID, int Count) = 0;
-        virtual void CompileQuadList(GLuint ID, int Index, const QuadListData &Data) = 0;
-        virtual void DrawQuadList(GLuint ID, int Index) = 0;
+        virtual GLuint GenerateQuadBatch() = 0;
+        virtual void DeleteQuadBatch(GLuint ID) = 0;
+        virtual void CompileQuadBatch(GLuint ID, const std::vector<QuadListData> &Quads) = 0;
+        virtual void DrawQuadBatch(GLuint ID, int First, int Count) = 0;
+        /*  A quad batch is a list of quads in world space, stored in one buffer, so that
+            many quads can be drawn with one call.  CompileQuadBatch() replaces all of the
+            quads in the batch.  DrawQuadBatch() draws Count quads starting at First, all
+            with the texture of the First quad, so the quads are grouped by texture
+            (see GetBatchTextureID()).
+        */
+
+        virtual GLuint GetBatchTextureID(GLuint TextureID) const;
+        /*  Returns the texture that quads of TextureID are actually drawn with, such as an
+            atlas that contains it (the renderer then maps the tex coords in CompileQuadBatch()).
+            Quads are grouped by this, so that all of the textures of an atlas are drawn with
+            one call.  Defaults to TextureID.
+        */
     };
 
     static constexpr int MAXMAPS = 10;
     //The maximum number of maps the engine will store.
     //Adjust this to fit your preferences.
 
+    static constexpr int CHUNK_SIZE = 16;
+    //The width & height in squares of each chunk of the map that is batched together.
+    //Larger chunks mean fewer draw calls, but more squares drawn outside of the
+    //draw distance and more work to regenerate a chunk when a square changes.
+
     static constexpr float TARGET_DELTA_TIME = 1.0f / 60.0f;
     //The delta time (1 second / FPS) in seconds that the original Engine targeted.
     //It's used to adjust the received value in UpdateDeltaTime() so that the
@@ -326,14 +344,36 @@ public:
     */
 
     bool GenerateMap();
-    /*  Creates an OpenGL display list for the currently active map.  You must call
-        this function at least once before drawing your map.  Any changes to the map's
-        texture information will require a call to this function to reflect the changes.
-        Try to avoid needless calls to this function.
+    /*  Creates the quad batches for the currently active map, one per chunk of
+        CHUNK_SIZE x CHUNK_SIZE squares.  You must call this function at least once
+        before drawing your map.  Any changes to the map's texture information will
+        require a call to this function to reflect the changes.  Try to avoid needless
+        calls to this function.
+
+        Changing squares (ChangeSquare()) doesn't require calling this function, as
+        only the changed squares' chunks will be regenerated on the next Draw().
+
+        Returns - Function returns true if successful, and false otherwise.
+    */
+
+    bool GenerateMapChunks(int First, int Count);
+    /*  Same as GenerateMap(), but only creates the quad batches of some of the chunks
+        of the currently active map, so that a big map can be generated over several
+        frames.  The chunks are numbered row by row, from 0 to GetChunkCount() - 1.
+
+        Parameters:
+        int First - The number of the first chunk to generate.
+        int Count - The number of chunks to generate, which is clamped to the last chunk.
 
         Returns - Function returns true if successful, and false otherwise.
     */
 
+    int GetChunkCount() const;
+    /*  Retrieves the number of chunks of the currently active map.
+
+        Returns - Returns the number of chunks.  Returns 0 if no map is active.
+    */
+
     void UpdateDeltaTime(float DT);
     /*  Updates the internal delta time in seconds for speed calculations.
         This value is also adjusted by TARGET_DELTA_TIME.
@@ -348,6 +388,17 @@ public:
         float DT - The new delta time in seconds to use.
     */
 
+    void SetDrawAlpha(float Alpha);
+    /*  Sets how far (from 0.0 to 1.0) the next call to MovePlayer() is drawn ahead of the
+        current movement, for when MovePlayer() is called at a fixed rate separately from Draw().
+        Since walking/turning is linear, this interpolates smoothly between movement updates.
+
+        Should be 0.0 (the default) if using Draw(..., true).
+
+        Parameters:
+        float Alpha - The fraction of the next movement update to draw.
+    */
+
     bool Draw(int Distance=10, bool MovePlayer=true);
     /*  Draws the active map.  After the function exits, the modelview matrix will retain
         the transformations made by this function.  This will allow you to insert other
@@ -585,34 +636,62 @@ protected:
         static constexpr int FACE_FLOOR      = 4;
         static constexpr int FACE_CEILING    = 5;
 
-        explicit SpaceClass(RendererClass *Renderer, int Type) noexcept;
-
-        SpaceClass(const SpaceClass &Copy) = delete;
-        SpaceClass(SpaceClass &&Other) noexcept;
-        SpaceClass &operator = (const SpaceClass &Copy) = delete;
-        SpaceClass &operator = (SpaceClass &&Other) noexcept;
-        virtual ~SpaceClass() noexcept;
-
-        void GenerateQuadLists();
+        explicit SpaceClass(int Type) noexcept;
 
         void PrintDebugInfo(std::ostream &Out = std::cout, int Indent = 0) const;
 
-        RendererClass *Renderer = nullptr;
         int SpaceType = 0;                                               //The type of the space.
         GLuint FloorTexture = 0;                                         //Floor texture ID.
         GLuint CeilingTexture = 0;                                       //Ceiling texture ID.
         GLuint WallTexture = 0;                                          //Wall texture ID.
-        GLuint QuadList = 0;                                             //Quad list for the space.
+    };
+
+    //A square of a map.
+    struct CellData
+    {
+        int SpaceType = 0;                                               //The type of the space.
+        bool IsWalkable = true;                                          //Walkability of the space.
+    };
+
+    //Class for a chunk of CHUNK_SIZE x CHUNK_SIZE squares, whose faces are stored in one quad batch.
+    class ChunkClass
+    {
+    public:
+        //Quads of one face type & texture, sorted by row.
+        //Rows are along the Y axis, except for left & right walls, which are along the X axis,
+        //so that only the rows of faces that are facing the player can be drawn.
+        struct GroupData
+        {
+            int Face = 0;                                                //SpaceClass::FACE_*.
+            int RowStarts[CHUNK_SIZE + 1] = {};                          //Index of the first quad of each row.
+        };
+
+        explicit ChunkClass(RendererClass *Renderer) noexcept;
+
+        ChunkClass(const ChunkClass &Copy) = delete;
+        ChunkClass(ChunkClass &&Other) noexcept;
+        ChunkClass &operator = (const ChunkClass &Copy) = delete;
+        ChunkClass &operator = (ChunkClass &&Other) noexcept;
+        virtual ~ChunkClass() noexcept;
+
+        void GenerateQuadBatch();
+
+        RendererClass *Renderer = nullptr;
+        GLuint QuadBatch = 0;                                            //Quad batch for the chunk.
+        bool IsDirty = true;                                             //Needs to be regenerated.
+        std::vector<GroupData> Groups{};
 
     private:
-        void MoveFrom(SpaceClass &&Other) noexcept;
-        void DeleteQuadLists() noexcept;
+        void MoveFrom(ChunkClass &&Other) noexcept;
+        void DeleteQuadBatch() noexcept;
     };
 
     //Class for storing maps.
     class MapClass
     {
     public:
+        static constexpr int SPACE_TABLE_SIZE = 256;                     //Space IDs of [0,256) (i.e., chars) are dense.
+
         explicit MapClass(RendererClass *Renderer, int MaxX, int MaxY);  //Constructor sets map size.
 
         MapClass(const MapClass &Copy) = delete;
@@ -628,23 +707,31 @@ protected:
         void ChangeSquare(int XCoord, int YCoord, int NewType);
         void ChangeWalkability(int XCoord, int YCoord, bool Walkable);
 
+        ChunkClass &GetChunk(int ChunkX, int ChunkY);
+        void MakeChunksDirty();
+
         int GetSpaceType(int XCoord, int YCoord) const;
         bool SpaceIsWalkable(int XCoord, int YCoord) const;
 
         void PrintDebugInfo(std::ostream &Out = std::cout, int Indent = 0) const;
 
         RendererClass *Renderer = nullptr;
-        //Map of space information.
+        //Map of space information (owner of the spaces in SpaceTable).
         std::unordered_map<int, std::unique_ptr<SpaceClass>> SpaceInfo{};
         int XSize = 0;                                                   //Map width.
         int YSize = 0;                                                   //Map height.
+        int ChunkXSize = 0;                                              //Map width in chunks.
+        int ChunkYSize = 0;                                              //Map height in chunks.
 
     protected:
-        std::vector<std::vector<int>> MapArray{};                        //Array for the map.
-        std::vector<std::vector<bool>> WalkArray{};                      //Array for walkability.
+        std::vector<CellData> Cells{};                                   //Squares, row by row (Y).
+        SpaceClass *SpaceTable[SPACE_TABLE_SIZE] = {};                   //Spaces of SpaceInfo, indexed by ID.
+        std::vector<ChunkClass> Chunks{};                                //Chunks, row by row (Y).
 
     private:
         void MoveFrom(MapClass &&Other) noexcept;
+        CellData &GetCell(int XCoord, int YCoord);
+        const CellData &GetCell(int XCoord, int YCoord) const;
     };
 
     RendererClass *Renderer = nullptr;
@@ -681,11 +768,25 @@ protected:
     //Degrees between directions when turning.
     float DegreesTurned = 0.0f;
     //Tracking variable for surface hiding while turning.
+    float DrawAlpha = 0.0f;
+    //Fraction of the next movement update to draw ahead.
     std::unique_ptr<MapClass> Maps[MAXMAPS]{};
     //Pointers to the stored maps.
 
 private:
+    struct FaceQuad
+    {
+        int Face = 0;                                                    //SpaceClass::FACE_*.
+        int Row = 0;                                                     //Row within the chunk.
+        RendererClass::QuadListData Data{};
+        GLuint BatchTextureID = 0;                                       //See GetBatchTextureID().
+    };
+
+    std::vector<FaceQuad> ChunkFaceQuads{};                              //Scratch for GenerateChunk().
+    std::vector<RendererClass::QuadListData> ChunkQuads{};               //Scratch for GenerateChunk().
+
     void MoveFrom(Dantares2 &&Other) noexcept;
+    void GenerateChunk(MapClass &Map, int ChunkX, int ChunkY);
 };
 
 #endif